@@ -14,6 +14,7 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <random>
 #include <set>
 #include <unordered_set>
@@ -23,8 +24,6 @@ using namespace ProtocolCraft;
 
 Status GetAllChestsAround(BehaviourClient& c)
 {
-    std::vector<Position> chests_pos;
-
     std::shared_ptr<LocalPlayer> local_player = c.GetLocalPlayer();
     std::shared_ptr<World> world = c.GetWorld();
 
@@ -34,35 +33,7 @@ Status GetAllChestsAround(BehaviourClient& c)
         static_cast<int>(std::floor(local_player->GetZ()))
     );
 
-    Position checked_position;
-    {
-        auto all_chunks = world->GetChunks();
-        for (auto it = all_chunks->begin(); it != all_chunks->end(); ++it)
-        {
-            for (int x = 0; x < CHUNK_WIDTH; ++x)
-            {
-                checked_position.x = x;
-                for (int y = 0; y < it->second.GetHeight(); ++y)
-                {
-                    checked_position.y = y + it->second.GetMinY();
-                    for (int z = 0; z < CHUNK_WIDTH; ++z)
-                    {
-                        checked_position.z = z;
-                        const Blockstate* block = it->second.GetBlock(checked_position);
-                        if (block != nullptr && block->GetName() == "minecraft:chest")
-                        {
-                            const Position world_position(
-                                it->first.first * CHUNK_WIDTH + x,
-                                y + world->GetMinY(),
-                                it->first.second * CHUNK_WIDTH + z
-                            );
-                            chests_pos.push_back(world_position);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    const std::vector<Position> chests_pos = world->FindBlocks(std::unordered_set<std::string>{ "minecraft:chest" }, player_position, std::numeric_limits<int>::max());
 
     c.GetBlackboard().Set("World.ChestsPos", chests_pos);
 
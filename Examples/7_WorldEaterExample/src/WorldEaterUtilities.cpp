@@ -44,42 +44,15 @@ bool IdentifyBaseCampLayout(SimpleBehaviourClient& client)
     }
 
     std::shared_ptr<World> world = client.GetWorld();
-    Position current_position;
-    // Loop through all loaded blocks to find the one we are looking for
+    // Search through all loaded blocks to find the ones we are looking for
+    for (auto& [name, positions] : found_blocks)
     {
-        auto all_chunks = world->GetChunks();
-        for (const auto& [coords, chunk] : *all_chunks)
+        positions = world->FindBlocks(std::unordered_set<std::string>{ name }, Position(0, 0, 0), std::numeric_limits<int>::max());
+        if (bot_index == 0)
         {
-            for (int y = chunk.GetMinY(); y < chunk.GetMinY() + chunk.GetHeight(); ++y)
+            for (const Position& pos : positions)
             {
-                current_position.y = y;
-                for (int z = 0; z < CHUNK_WIDTH; ++z)
-                {
-                    current_position.z = z;
-                    for (int x = 0; x < CHUNK_WIDTH; ++x)
-                    {
-                        current_position.x = x;
-                        const Blockstate* blockstate = chunk.GetBlock(current_position);
-                        if (blockstate == nullptr)
-                        {
-                            continue;
-                        }
-
-                        if (const auto it = found_blocks.find(blockstate->GetName()); it != found_blocks.end())
-                        {
-                            const Position world_coordinates(
-                                coords.first * CHUNK_WIDTH + x,
-                                y,
-                                coords.second * CHUNK_WIDTH + z
-                            );
-                            it->second.push_back(world_coordinates);
-                            if (bot_index == 0)
-                            {
-                                LOG_INFO(blockstate->GetName() << "(" << block_item_mapping.at(blockstate->GetName()) << ") found at " << world_coordinates);
-                            }
-                        }
-                    }
-                }
+                LOG_INFO(name << "(" << block_item_mapping.at(name) << ") found at " << pos);
             }
         }
     }
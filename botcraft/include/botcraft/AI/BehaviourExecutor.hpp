@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Utilities/Fiber.hpp"
+
+namespace Botcraft
+{
+    /// @brief A pool of threads stepping the behaviour trees of many clients.
+    /// Each client tree runs in a fiber (see TemplatedBehaviourClient::SetBehaviourExecutor)
+    /// resumed by the executor until its next Yield. Clients are assigned to the
+    /// threads round-robin and always stepped by the same thread.
+    /// The same executor can be shared by any number of clients
+    class BehaviourExecutor
+    {
+    public:
+        /// @brief Start the executor threads
+        /// @param num_threads Number of threads, if 0, use the number of hardware threads
+        /// @param step_period_ Min time between two steps of the same client
+        /// @param fiber_stack_size_ Size of the stack of each client fiber, in bytes.
+        /// This is a hard limit: the whole behaviour tree of a client, including
+        /// pathfinding and all the tasks it calls, runs on this stack, which can't
+        /// grow. Overflowing it crashes the process (see Utilities::Fiber)
+        BehaviourExecutor(const size_t num_threads = 0,
+            const std::chrono::steady_clock::duration step_period_ = std::chrono::milliseconds(10),
+            const size_t fiber_stack_size_ = Utilities::Fiber::default_stack_size);
+        ~BehaviourExecutor();
+
+        BehaviourExecutor(const BehaviourExecutor&) = delete;
+        BehaviourExecutor& operator=(const BehaviourExecutor&) = delete;
+
+        /// @brief Add a function called at each step, always on the same thread
+        /// @param step Function called every step period, returning false to be removed
+        /// @return An id that can be used to wait for the removal
+        size_t Add(std::function<bool()>&& step);
+
+        /// @brief Wait until a step function returns false and is removed.
+        /// Must not be called from the executor threads
+        /// @param id Id returned by Add
+        void WaitRemoved(const size_t id);
+
+        size_t GetNumThreads() const;
+
+        size_t GetFiberStackSize() const;
+
+    private:
+        void Run(const size_t index);
+
+    private:
+        const std::chrono::steady_clock::duration step_period;
+        const size_t fiber_stack_size;
+
+        std::vector<std::thread> threads;
+
+        std::mutex steps_mutex;
+        std::condition_variable removed_condition;
+        /// @brief Steps added to each thread and not picked yet
+        std::vector<std::vector<std::pair<size_t, std::function<bool()> > > > added_steps;
+        /// @brief Ids of all the steps not removed yet
+        std::unordered_set<size_t> active_ids;
+        size_t next_id;
+        std::atomic<size_t> next_thread;
+        bool running;
+    };
+} // Botcraft
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botcraft/AI/PathfindingEngine.hpp"
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    class World;
+    class WorldView;
+
+    /// @brief Long distance pathfinding, on top of a PathfindingEngine.
+    /// The world is split in 16x16x16 sections. For each section, the
+    /// walkable exits to the neighbouring sections (portals) are computed
+    /// once and kept until a block changes around it (see World::GetBlockChanges).
+    /// A high-level A* runs on the graph of portals, then each leg of
+    /// the route is refined with a block-level search. The portals only
+    /// use simple moves (walking, climbing, falling, no jump), if a leg
+    /// can't be followed, its portal is ignored until the section changes.
+    /// Short paths are directly searched with the block-level engine.
+    /// Not thread-safe, use one pathfinder per thread.
+    class HierarchicalPathfinder
+    {
+    public:
+        /// @brief Default min start-end distance to use the portal graph
+        static constexpr int default_min_distance = 64;
+        /// @brief Default max number of portals expanded by one high-level search
+        static constexpr size_t default_budget = 16384;
+
+        HierarchicalPathfinder();
+        ~HierarchicalPathfinder();
+
+        HierarchicalPathfinder(const HierarchicalPathfinder&) = delete;
+        HierarchicalPathfinder& operator=(const HierarchicalPathfinder&) = delete;
+
+        /// @brief Compute a path between start and end. See FindPath in PathfindingTask.hpp for details
+        /// @param world World to search the path in
+        /// @param takes_damage If true, hazardous blocks are avoided
+        /// @param start Start position
+        /// @param end End position
+        /// @param dist_tolerance Stop the search earlier if you get closer than dist_tolerance from the end position
+        /// @param min_end_dist Desired minimal checkboard distance between the final position and goal
+        /// @param min_end_dist_xz Same as min_end_dist but only considering the XZ plane
+        /// @param allow_jump If true, allow to jump above 1-wide gaps
+        /// @return A vector of <feet block position, Y position> to go through to reach end +/- min_end_dist. If not possible, will return a path to get as close as possible
+        std::vector<std::pair<Position, float>> FindPath(const World& world, const bool takes_damage, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump);
+
+        /// @brief Get the block-level engine used to refine the legs and search short paths
+        PathfindingEngine& GetEngine();
+
+        int GetMinDistance() const;
+        void SetMinDistance(const int min_distance_);
+
+        size_t GetBudget() const;
+        void SetBudget(const size_t budget_);
+
+        /// @brief Remove all the sections of the portal graph
+        void Clear();
+
+        /// @brief Get the number of sections currently in the portal graph
+        size_t GetNumSections() const;
+        /// @brief Get the number of portals expanded during the last high-level search, 0 if not used
+        size_t GetLastVisitCount() const;
+        /// @brief Get the waypoints of the last high-level route, empty if not used
+        const std::vector<Position>& GetLastWaypoints() const;
+
+    private:
+        struct Exit;
+        struct Section;
+        struct RouteNode;
+
+        /// @brief Drop the sections depending on blocks modified since the last call
+        void Update(const World& world, const bool takes_damage);
+
+        /// @brief Get a section, computing its portals on first access
+        Section* GetSection(const Position& pos);
+        void BuildSection(Section& section);
+        /// @brief Get the walking cost from a block of a section to each of its exits
+        const std::vector<std::pair<uint32_t, int> >& GetExitCosts(Section& section, const Position& from);
+
+        /// @brief Search a route in the portal graph
+        /// @param route Output, portals from start (excluded) to the last one before end
+        /// @return True if the route gets close enough to end
+        bool SearchRoute(const Position& start, const Position& end, std::vector<uint32_t>& route);
+
+    private:
+        PathfindingEngine engine;
+        int min_distance;
+        size_t budget;
+        size_t last_visit_count;
+        std::vector<Position> last_waypoints;
+
+        /// @brief World and options the sections have been computed for.
+        /// World is identified by its instance id (see World::GetInstanceId), 0 if the graph can't be reused
+        unsigned long long int graph_world_id;
+        bool graph_takes_damage;
+        unsigned long long int graph_revision;
+        int min_y;
+        int max_y;
+        std::vector<std::pair<Position, Position> > changes;
+
+        /// @brief Sections of the graph, indexed by a packed section coordinate
+        std::unordered_map<uint64_t, std::unique_ptr<Section> > sections;
+        /// @brief Read view used while sections are built, only valid during FindPath
+        WorldView* world_view;
+
+        /// @brief Nodes of the last high-level search
+        std::vector<RouteNode> route_nodes;
+        std::unordered_map<Position, uint32_t> route_index;
+        std::vector<std::pair<int, uint32_t> > route_open;
+
+        /// @brief Scratch buffers used to search in a section
+        std::vector<int> local_costs;
+        std::vector<std::pair<int, uint16_t> > local_open;
+    };
+} // Botcraft
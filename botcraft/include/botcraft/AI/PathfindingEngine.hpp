@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    class World;
+    class WorldView;
+
+    /// @brief A* search of a walking path in a World, used by FindPath.
+    /// All the search memory (nodes, open list, block cache) is kept between
+    /// two searches, so an engine should be reused rather than recreated.
+    /// Not thread-safe, use one engine per thread.
+    ///
+    /// Two optional mechanisms avoid searching again from scratch:
+    /// - a path cache, returning a previous path if start is on it and no block
+    ///   changed around it since (see World::GetBlockChanges)
+    /// - incremental replanning, reusing the search tree of the previous call
+    ///   (same world, goal and options) if start has been expanded in it.
+    ///   Only the parts of the tree depending on modified blocks are searched again
+    class PathfindingEngine
+    {
+    public:
+        /// @brief Default max number of nodes expanded by one search
+        static constexpr size_t default_budget = 30000;
+
+        /// @param budget_ Max number of nodes expanded by one search
+        /// @param cache_size_ Max number of paths kept in the cache, 0 to disable it
+        /// @param incremental_ If true, reuse the previous search tree when possible
+        PathfindingEngine(const size_t budget_ = default_budget, const size_t cache_size_ = 0, const bool incremental_ = false);
+        ~PathfindingEngine();
+
+        PathfindingEngine(const PathfindingEngine&) = delete;
+        PathfindingEngine& operator=(const PathfindingEngine&) = delete;
+
+        /// @brief Compute a path between start and end. See FindPath in PathfindingTask.hpp for details
+        /// @param world World to search the path in
+        /// @param takes_damage If true, hazardous blocks are avoided
+        /// @param start Start position
+        /// @param end End position
+        /// @param dist_tolerance Stop the search earlier if you get closer than dist_tolerance from the end position
+        /// @param min_end_dist Desired minimal checkboard distance between the final position and goal
+        /// @param min_end_dist_xz Same as min_end_dist but only considering the XZ plane
+        /// @param allow_jump If true, allow to jump above 1-wide gaps
+        /// @return A vector of <feet block position, Y position> to go through to reach end +/- min_end_dist. If not possible, will return a path to get as close as possible
+        std::vector<std::pair<Position, float>> FindPath(const World& world, const bool takes_damage, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump);
+
+        size_t GetBudget() const;
+        void SetBudget(const size_t budget_);
+
+        size_t GetCacheSize() const;
+        void SetCacheSize(const size_t cache_size_);
+
+        bool IsIncremental() const;
+        void SetIncremental(const bool incremental_);
+
+        /// @brief Remove all the cached paths and the previous search tree
+        void Clear();
+
+        /// @brief Get the number of nodes expanded during the last search, 0 if the path was cached
+        size_t GetLastVisitCount() const;
+
+    private:
+        class PathfindingBlockstate;
+        struct Page;
+        struct Node;
+        struct OpenEntry;
+        struct CachedPath;
+
+        void Reset();
+        /// @brief Remove all the nodes, but keep the block cache
+        void ResetNodes();
+
+        /// @brief Run A* until the end criteria are met or the budget is exhausted
+        void Search(const bool allow_jump, const bool end_is_inside_solid);
+
+        /// @brief Look for a valid cached path going through query start, with the same world, end and options
+        /// @param world World of the query
+        /// @return True if found, in which case output is set to the path from query start
+        bool GetCachedPath(const World& world, const CachedPath& query, std::vector<std::pair<Position, float>>& output);
+        void AddCachedPath(CachedPath&& entry);
+
+        /// @brief Update the previous search tree after some blocks changed and
+        /// the start moved, so the search can be resumed
+        /// @return False if the tree can't be reused
+        bool Repair(const Position& start);
+        /// @brief Forget the classification of all the blocks in an area
+        void InvalidateBlocks(const Position& min, const Position& max);
+        /// @brief Get the node at a given position and height, invalid_index if not found
+        uint32_t FindNode(const Position& pos, const float height);
+        /// @brief Insert a node in the chain of its block
+        void LinkNode(const uint32_t index);
+        /// @brief Update the best end candidates with a new node
+        void UpdateBestCandidates(const uint32_t index);
+
+        /// @brief Get the cache page of the section containing a block
+        Page* GetPage(const Position& pos);
+        /// @brief Get the classification of a block, computed on first access
+        PathfindingBlockstate GetState(const Position& pos);
+        PathfindingBlockstate GetState(Page* page, const Position& pos);
+        /// @brief Get the classification of count blocks, going down from top
+        void GetColumn(const Position& top, const int count, PathfindingBlockstate* output);
+
+        /// @brief Add a node or update it if the new cost is better
+        void AddNode(const Position& pos, const float height, const float cost, const uint32_t parent);
+
+        void HeapPush(const uint32_t index);
+        uint32_t HeapPop();
+        void HeapSiftUp(size_t i);
+        void HeapSiftDown(size_t i);
+        static bool HeapLess(const OpenEntry& a, const OpenEntry& b);
+
+        void Expand(const uint32_t index, const bool allow_jump);
+
+    private:
+        size_t budget;
+        size_t last_visit_count;
+
+        size_t cache_size;
+        bool incremental;
+
+        // Search parameters, kept after the search for incremental replanning
+        WorldView* world_view;
+        bool takes_damage;
+        int min_y;
+        Position search_start;
+        Position search_end;
+        int search_dist_tolerance;
+        int search_min_end_dist;
+        int search_min_end_dist_xz;
+        bool search_allow_jump;
+
+        /// @brief Instance id of the world of the current search tree, 0 if it can't be reused
+        unsigned long long int tree_world_id;
+        /// @brief Block revision of the world when the tree was built
+        unsigned long long int tree_revision;
+        /// @brief Block changes since tree_revision
+        std::vector<std::pair<Position, Position> > changes;
+        /// @brief Scratch buffers used to repair the tree
+        std::vector<uint8_t> repair_states;
+        std::vector<uint32_t> repair_indices;
+        std::vector<uint32_t> repair_children;
+        std::vector<Node> repair_nodes;
+
+        /// @brief Last paths found, for the path cache
+        std::vector<CachedPath> cache;
+        unsigned long long int cache_clock;
+
+        /// @brief Block cache, one page per 16x16x16 section,
+        /// indexed by a packed section coordinate
+        std::vector<std::unique_ptr<Page>> pages;
+        size_t used_pages;
+        std::unordered_map<uint64_t, Page*> page_index;
+        /// @brief Direct-mapped cache in front of page_index, covering 4x4x4 neighbouring sections
+        std::array<std::pair<uint64_t, Page*>, 64> page_cache;
+
+        /// @brief All the nodes of the current search, indexed by their creation order
+        std::vector<Node> nodes;
+        /// @brief Binary heap of the open nodes, ordered by score
+        std::vector<OpenEntry> open;
+        /// @brief One bit per node, set once the node is expanded
+        std::vector<uint64_t> closed;
+
+        /// @brief Node matching the end criteria the closest to start
+        uint32_t best_suitable;
+        int best_suitable_dist;
+        int best_suitable_dist_start;
+        /// @brief Node the closest to end
+        uint32_t best_closest;
+        int best_closest_dist;
+        int best_closest_dist_start;
+    };
+} // Botcraft
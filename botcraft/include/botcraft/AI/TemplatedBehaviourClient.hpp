@@ -3,8 +3,10 @@
 #include <atomic>
 
 #include "botcraft/AI/BehaviourClient.hpp"
+#include "botcraft/AI/BehaviourExecutor.hpp"
 #include "botcraft/AI/BehaviourTree.hpp"
 #include "botcraft/Network/NetworkManager.hpp"
+#include "botcraft/Utilities/Fiber.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 #include "botcraft/Utilities/SleepUtilities.hpp"
 #if USE_GUI
@@ -41,6 +43,7 @@ namespace Botcraft
             BehaviourClient(use_renderer_)
         {
             swap_tree = false;
+            behaviour_executor_id = 0;
         }
 
         virtual ~TemplatedBehaviourClient()
@@ -58,6 +61,11 @@ namespace Botcraft
             {
                 behaviour_thread.join();
             }
+            // The executor unwinds the tree on its own thread then removes it
+            if (behaviour_fiber != nullptr)
+            {
+                behaviour_executor->WaitRemoved(behaviour_executor_id);
+            }
         }
 
         /// @brief Save the given tree to replace the current one as soon as possible.
@@ -76,6 +84,22 @@ namespace Botcraft
         /// can be interrupted.
         virtual void Yield() override
         {
+            if (behaviour_fiber != nullptr)
+            {
+                // Give control back to the executor, until the next step
+                Utilities::Fiber::Suspend();
+                std::lock_guard<std::mutex> lock(behaviour_mutex);
+                if (should_be_closed)
+                {
+                    throw Interrupted();
+                }
+                else if (swap_tree)
+                {
+                    throw SwapTree();
+                }
+                return;
+            }
+
             std::unique_lock<std::mutex> lock(behaviour_mutex);
             behaviour_cond_var.notify_all();
             behaviour_cond_var.wait(lock);
@@ -89,9 +113,25 @@ namespace Botcraft
             }
         }
 
-        /// @brief Start the behaviour thread loop.
+        /// @brief Run the behaviour tree of this client in a fiber stepped by a shared
+        /// executor instead of on a dedicated thread. Yield then only suspends the fiber,
+        /// without any thread synchronization. Must be called before StartBehaviour
+        /// @param behaviour_executor_ The executor to use, or nullptr to use a dedicated thread
+        void SetBehaviourExecutor(const std::shared_ptr<BehaviourExecutor>& behaviour_executor_)
+        {
+            behaviour_executor = behaviour_executor_;
+        }
+
+        /// @brief Start the behaviour thread loop, or add it to the behaviour executor if one is set.
         void StartBehaviour()
         {
+            if (behaviour_executor != nullptr)
+            {
+                behaviour_fiber = std::make_unique<Utilities::Fiber>([this]() { TreeLoop(); }, behaviour_executor->GetFiberStackSize());
+                behaviour_executor_id = behaviour_executor->Add([this]() { return FiberStep(); });
+                return;
+            }
+
             tree_loop_ready = false;
             behaviour_thread = std::thread(&TemplatedBehaviourClient<TDerived>::TreeLoop, this);
 
@@ -106,11 +146,21 @@ namespace Botcraft
         /// disconnected from the server.
         void RunBehaviourUntilClosed()
         {
-            if (!behaviour_thread.joinable())
+            if (!IsBehaviourStarted())
             {
                 StartBehaviour();
             }
 
+            // Steps are done by the executor
+            if (behaviour_fiber != nullptr)
+            {
+                while (!should_be_closed)
+                {
+                    Utilities::SleepFor(std::chrono::milliseconds(10));
+                }
+                return;
+            }
+
             // Main behaviour loop
             while (!should_be_closed)
             {
@@ -125,9 +175,10 @@ namespace Botcraft
 
         /// @brief Perform one step of the behaviour tree.
         /// Don't forget to call StartBehaviour before.
+        /// Does nothing if a behaviour executor is set, as it performs the steps.
         void BehaviourStep()
         {
-            if (should_be_closed || !network_manager || network_manager->GetConnectionState() != ProtocolCraft::ConnectionState::Play)
+            if (behaviour_fiber != nullptr || should_be_closed || !network_manager || network_manager->GetConnectionState() != ProtocolCraft::ConnectionState::Play)
             {
                 return;
             }
@@ -149,7 +200,7 @@ namespace Botcraft
         void SyncAction(const int timeout_ms, Args&&... args)
         {
             // Make sure the behaviour thread is running
-            if (!behaviour_thread.joinable())
+            if (!IsBehaviourStarted())
             {
                 StartBehaviour();
             }
@@ -264,9 +315,41 @@ namespace Botcraft
 #endif
 
     private:
+        bool IsBehaviourStarted() const
+        {
+            return behaviour_thread.joinable() || behaviour_fiber != nullptr;
+        }
+
+        /// @brief Called by the behaviour executor, resume the tree fiber until its next Yield
+        /// @return False once the tree is stopped and can be removed from the executor
+        bool FiberStep()
+        {
+            if (should_be_closed)
+            {
+                // Resume it one last time, so Yield throws Interrupted and the tree stack is unwound
+                if (behaviour_fiber->IsStarted())
+                {
+                    behaviour_fiber->Resume();
+                }
+                return false;
+            }
+
+            if (!network_manager || network_manager->GetConnectionState() != ProtocolCraft::ConnectionState::Play)
+            {
+                return true;
+            }
+
+            // Finished if the tree has been stopped by an exception
+            return !behaviour_fiber->Resume();
+        }
+
         void TreeLoop()
         {
-            Logger::GetInstance().RegisterThread("Behaviour - " + GetNetworkManager()->GetMyName());
+            // Executor threads are shared, they are already registered
+            if (behaviour_fiber == nullptr)
+            {
+                Logger::GetInstance().RegisterThread("Behaviour - " + GetNetworkManager()->GetMyName());
+            }
             tree_loop_ready = true;
             while (true)
             {
@@ -320,5 +403,10 @@ namespace Botcraft
         std::mutex behaviour_mutex;
 
         std::atomic<bool> tree_loop_ready;
+
+        /// @brief If not null, the tree runs in behaviour_fiber, stepped by this executor
+        std::shared_ptr<BehaviourExecutor> behaviour_executor;
+        std::unique_ptr<Utilities::Fiber> behaviour_fiber;
+        size_t behaviour_executor_id;
     };
 } // namespace Botcraft
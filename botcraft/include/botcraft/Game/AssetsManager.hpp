@@ -4,6 +4,7 @@
 #include "botcraft/Game/World/Blockstate.hpp"
 #include "botcraft/Game/Inventory/Item.hpp"
 
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -34,6 +35,11 @@ namespace Botcraft
         /// @param name Name of the blockstate
         /// @return A blockstate matching the given name, or default block if not found
         const Blockstate* GetBlockstate(const std::string& name) const;
+        /// @brief Same as GetBlockstate(id)->GetWalkability(), but reading a flat table
+        /// instead of the blockstate itself
+        /// @param id Blockstate id
+        /// @return Walkability of this blockstate
+        Walkability GetWalkability(const BlockstateId id) const;
         
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
         const std::unordered_map<unsigned char, std::unique_ptr<Biome> >& Biomes() const;
@@ -59,6 +65,7 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
         void FlattenBlocks();
 #endif
+        void LoadWalkabilities();
         void LoadBiomesFile();
         void LoadItemsFile();
 #if USE_GUI
@@ -66,6 +73,17 @@ namespace Botcraft
 #endif
         void ClearCaches();
 
+#if !USE_GUI
+        /// @brief Load blockstates, biomes and items from a bundle written by SaveBundle
+        /// @param path Path of the bundle file
+        /// @return True if loaded, false if the bundle is missing, invalid, older than the json files or written by another build
+        bool LoadBundle(const std::string& path);
+        /// @brief Write loaded blockstates, biomes and items in a binary bundle,
+        /// so next startups don't have to parse the json files and the models
+        /// @param path Path of the bundle file
+        void SaveBundle(const std::string& path) const;
+#endif
+
 #if USE_GUI
         void UpdateModelsWithAtlasData();
 #endif
@@ -78,6 +96,10 @@ namespace Botcraft
         std::vector<const Blockstate*> flattened_blockstates;
         size_t flattened_blockstates_size;
 #endif
+        /// @brief Walkability of all blockstates, indexed by id (id << 4 | metadata before 1.13)
+        std::vector<Walkability> walkabilities;
+        /// @brief Walkability of the blockstate returned for unknown ids
+        Walkability default_walkability;
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
         std::unordered_map<unsigned char, std::unique_ptr<Biome> > biomes;
 #else
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "protocolCraft/Handler.hpp"
 
 namespace Botcraft
 {
     class NetworkManager;
+    class DecodePool;
+    class NetworkPool;
     
     /// @brief The base client handling connection with a server.
     /// Only processes packets required to maintain the connection.
@@ -19,6 +24,14 @@ namespace Botcraft
         /// @param login If login is empty, will try to connect with a Microsoft account
         /// @param force_microsoft_account If true, then Microsoft auth flow will be used. In this case, login is used as key to cache the credentials
         void Connect(const std::string& address, const std::string& login, const bool force_microsoft_account = false);
+
+        /// @brief Feed a packet capture to this client instead of connecting to a server.
+        /// Packets sent by the client are dropped. Once the whole capture has been processed,
+        /// the network manager connection state is set to None
+        /// @param capture_path Path of a capture recorded with SetCapturePath
+        /// @param login Name of the player
+        /// @param real_time If true, packets are replayed with their captured timing, otherwise as fast as possible
+        void Replay(const std::string& capture_path, const std::string& login, const bool real_time = false);
         virtual void Disconnect();
 
         bool GetShouldBeClosed() const;
@@ -26,6 +39,23 @@ namespace Botcraft
 
         std::shared_ptr<NetworkManager> GetNetworkManager() const;
 
+        /// @brief Set a pool used to decode heavy packets (chunks, light) outside
+        /// of the network processing thread. Must be called before Connect.
+        /// The same pool can be shared by multiple clients
+        /// @param decode_pool_ The pool to use, or nullptr to decode everything on the network processing thread
+        void SetDecodePool(const std::shared_ptr<DecodePool>& decode_pool_);
+
+        /// @brief Set a pool of network threads shared by multiple clients. The connection
+        /// and the packet processing of this client will run on one of the pool threads
+        /// instead of on dedicated threads. Must be called before Connect
+        /// @param network_pool_ The pool to use, or nullptr to use dedicated threads
+        void SetNetworkPool(const std::shared_ptr<NetworkPool>& network_pool_);
+
+        /// @brief Record all the packets received from the server in a capture file that can
+        /// be replayed later with Replay. Must be called before Connect
+        /// @param capture_path_ Path of the capture file, or empty to disable capture
+        void SetCapturePath(const std::string& capture_path_);
+
         /// @brief Send a message in the game chat
         /// @param msg The message to send
         void SendChatMessage(const std::string& msg);
@@ -51,6 +81,9 @@ namespace Botcraft
         
     protected:
         std::shared_ptr<NetworkManager> network_manager;
+        std::shared_ptr<DecodePool> decode_pool;
+        std::shared_ptr<NetworkPool> network_pool;
+        std::string capture_path;
 
         bool should_be_closed;
     };
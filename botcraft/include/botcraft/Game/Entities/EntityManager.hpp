@@ -1,16 +1,25 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "protocolCraft/Handler.hpp"
 
+#include "botcraft/Game/Entities/EntityPredictor.hpp"
+#include "botcraft/Game/Vector3.hpp"
 #include "botcraft/Utilities/ScopeLockedWrapper.hpp"
 
 namespace Botcraft
 {
+    class AABB;
     class Entity;
+    enum class EntityType;
     class LocalPlayer;
 
     class EntityManager : public ProtocolCraft::Handler
@@ -29,6 +38,30 @@ namespace Botcraft
         /// as soon as you don't need it.
         Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock> GetEntities() const;
 
+        /// @brief Get all the entities with their position within a given distance, local player excluded
+        /// @param center Center of the sphere
+        /// @param radius Max distance to center
+        /// @param type If set, only entities of this type are returned
+        /// @return The entities, in no particular order
+        std::vector<std::shared_ptr<Entity>> QueryRadius(const Vector3<double>& center, const double radius, const std::optional<EntityType> type = std::nullopt) const;
+
+        /// @brief Get all the entities with their position inside a box, local player excluded
+        /// @param aabb The box
+        /// @param type If set, only entities of this type are returned
+        /// @return The entities, in no particular order
+        std::vector<std::shared_ptr<Entity>> QueryAABB(const AABB& aabb, const std::optional<EntityType> type = std::nullopt) const;
+
+        /// @brief Get the k entities the closest to a position, local player excluded
+        /// @param pos Position to search around
+        /// @param k Max number of entities to return
+        /// @param type If set, only entities of this type are considered
+        /// @return Up to k entities, sorted by increasing distance
+        std::vector<std::shared_ptr<Entity>> Nearest(const Vector3<double>& pos, const size_t k, const std::optional<EntityType> type = std::nullopt) const;
+
+        /// @brief Get the dead reckoning of all the entities (local player excluded),
+        /// to know where they are between two server updates or where they will be soon
+        const EntityPredictor& GetPredictor() const;
+
     protected:
         virtual void Handle(ProtocolCraft::ClientboundLoginPacket& msg) override;
         virtual void Handle(ProtocolCraft::ClientboundPlayerPositionPacket& msg) override;
@@ -66,6 +99,17 @@ namespace Botcraft
         virtual void Handle(ProtocolCraft::ClientboundUpdateMobEffectPacket& msg) override;
         virtual void Handle(ProtocolCraft::ClientboundRemoveMobEffectPacket& msg) override;
 
+    private:
+        /// @brief Add an entity to the spatial index, or move it to another cell. entity_manager_mutex must be locked
+        void IndexEntity(const int id, const std::shared_ptr<Entity>& entity, const Vector3<double>& position);
+        /// @brief Remove an entity from the spatial index. entity_manager_mutex must be locked
+        void UnindexEntity(const int id);
+        /// @brief Move an already indexed entity after its position changed
+        void UpdateEntityIndex(const int id, const Vector3<double>& position);
+        /// @brief Call f(const std::shared_ptr<Entity>&, const Vector3<double>& position) on all the indexed entities
+        /// in the cells overlapping a box. entity_manager_mutex must be locked
+        template<class F>
+        void ForEachIndexedEntity(const Vector3<double>& min, const Vector3<double>& max, const std::optional<EntityType> type, F&& f) const;
 
     private:
         std::unordered_map<int, std::shared_ptr<Entity> > entities;
@@ -73,5 +117,15 @@ namespace Botcraft
         std::shared_ptr<LocalPlayer> local_player;
 
         mutable std::shared_mutex entity_manager_mutex;
+
+        /// @brief Size of the cubic cells of the spatial index, in blocks
+        static constexpr int index_cell_size = 8;
+        /// @brief Entities (local player excluded) bucketed by cell of the spatial index,
+        /// indexed by a packed cell coordinate
+        std::unordered_map<uint64_t, std::vector<std::pair<int, std::shared_ptr<Entity> > > > index_cells;
+        /// @brief For each indexed entity, its cell and its position in the cell
+        std::unordered_map<int, std::pair<uint64_t, size_t> > indexed_entities;
+
+        EntityPredictor predictor;
     };
 } // Botcraft
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "botcraft/Game/Vector3.hpp"
+
+namespace Botcraft
+{
+    class Entity;
+
+    /// @brief Dead reckoning of the entities between two server updates.
+    /// For each tracked entity, the last known position is kept with a
+    /// velocity estimate, either sent by the server or computed from the
+    /// last position updates. Positions at any time are then extrapolated
+    /// with a simple physics model (gravity and drag) depending on the
+    /// entity type. Collisions with the world are not simulated, so the
+    /// extrapolation is limited to max_prediction_ticks after the last update.
+    /// Thread-safe, updated by EntityManager when packets are received.
+    class EntityPredictor
+    {
+    public:
+        /// @brief Duration of one server tick
+        static constexpr std::chrono::milliseconds tick_duration = std::chrono::milliseconds(50);
+        /// @brief Max number of ticks positions are extrapolated after the last update
+        static constexpr double max_prediction_ticks = 20.0;
+
+        /// @brief Physics applied to an entity between two updates, velocity
+        /// is in blocks/tick. Each tick, gravity is applied, then the entity
+        /// moves, then its velocity is multiplied by the inertia
+        struct MotionModel
+        {
+            /// @brief Vertical acceleration while not on ground, in blocks/tick²
+            double gravity = 0.0;
+            /// @brief Horizontal velocity multiplier while not on ground
+            double horizontal_inertia = 1.0;
+            /// @brief Vertical velocity multiplier while not on ground
+            double vertical_inertia = 1.0;
+            /// @brief Horizontal velocity multiplier while on ground
+            double ground_inertia = 1.0;
+        };
+
+        /// @brief Get the physics used to extrapolate an entity movements
+        static MotionModel GetMotionModel(const Entity& entity);
+
+        /// @brief Start tracking an entity, or reset it if already tracked
+        /// @param id Entity id
+        /// @param model Physics used to extrapolate its movements
+        /// @param position Current position
+        /// @param velocity Current velocity, in blocks/tick
+        /// @param time Time of the update
+        void AddEntity(const int id, const MotionModel& model, const Vector3<double>& position, const Vector3<double>& velocity, const std::chrono::steady_clock::time_point& time);
+        void RemoveEntity(const int id);
+        void Clear();
+
+        /// @brief Register a new position for an entity, its velocity
+        /// estimate is updated from the previous known position
+        void UpdatePosition(const int id, const Vector3<double>& position, const bool on_ground, const std::chrono::steady_clock::time_point& time);
+        /// @brief Move an entity without updating its velocity estimate (teleportation)
+        void SetPosition(const int id, const Vector3<double>& position, const bool on_ground, const std::chrono::steady_clock::time_point& time);
+        /// @brief Set the velocity of an entity, as sent by the server
+        /// @param velocity Velocity, in blocks/tick
+        void SetVelocity(const int id, const Vector3<double>& velocity, const std::chrono::steady_clock::time_point& time);
+
+        /// @brief Get the extrapolated position of an entity
+        /// @param id Entity id
+        /// @param time Time to get the position at
+        /// @return The position, or std::nullopt if the entity is not tracked
+        std::optional<Vector3<double>> PredictPosition(const int id, const std::chrono::steady_clock::time_point& time) const;
+        /// @brief Get the extrapolated velocity of an entity, in blocks/tick
+        std::optional<Vector3<double>> PredictVelocity(const int id, const std::chrono::steady_clock::time_point& time) const;
+        /// @brief Extrapolate the position of all the tracked entities at once
+        /// @param time Time to get the positions at
+        /// @return <id, position> for all the tracked entities, in no particular order
+        std::vector<std::pair<int, Vector3<double>>> PredictPositions(const std::chrono::steady_clock::time_point& time) const;
+
+        /// @brief Get where to aim to hit an entity with a projectile going in straight line
+        /// @param id Entity id
+        /// @param origin Projectile start position
+        /// @param speed Projectile speed, in blocks/tick
+        /// @param time Time the projectile is launched
+        /// @return The position the entity is predicted to be when the projectile reaches it, std::nullopt if not tracked
+        std::optional<Vector3<double>> PredictInterception(const int id, const Vector3<double>& origin, const double speed, const std::chrono::steady_clock::time_point& time) const;
+
+        size_t GetNumEntities() const;
+
+    private:
+        /// @brief Get the number of ticks elapsed since the last update of entity at index
+        double ElapsedTicks(const size_t index, const std::chrono::steady_clock::time_point& time) const;
+        /// @brief Compute position and velocity of entity at index after ticks ticks
+        void Extrapolate(const size_t index, const double ticks, Vector3<double>& position, Vector3<double>& velocity) const;
+
+    private:
+        mutable std::shared_mutex predictor_mutex;
+
+        /// @brief Index of each entity in the following arrays
+        std::unordered_map<int, size_t> indices;
+
+        // State of the tracked entities, stored as structure of arrays
+        // so PredictPositions goes through contiguous data
+        std::vector<int> ids;
+        std::vector<double> position_x;
+        std::vector<double> position_y;
+        std::vector<double> position_z;
+        std::vector<double> velocity_x;
+        std::vector<double> velocity_y;
+        std::vector<double> velocity_z;
+        /// @brief Time of the last update. Kept as time points and not ticks
+        /// so elapsed times are computed exactly from integer durations
+        std::vector<std::chrono::steady_clock::time_point> update_times;
+        std::vector<char> on_ground;
+        /// @brief True if the current velocity has been sent by the server since the last position update
+        std::vector<char> server_velocity;
+        std::vector<MotionModel> models;
+    };
+} // Botcraft
@@ -17,7 +17,18 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 6;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_radius",
+#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
+            "data_color",
+#endif
+            "data_waiting",
+            "data_particle",
+#if PROTOCOL_VERSION < 341 /* < 1.13 */
+            "data_particle_argument1",
+            "data_particle_argument2",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 
     public:
@@ -13,7 +13,28 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 15;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+#if PROTOCOL_VERSION < 764 /* < 1.20.2 */
+            "data_interpolation_start_delta_ticks_id",
+            "data_interpolation_duration_id",
+#else
+            "data_transformation_interpolation_start_delta_ticks_id",
+            "data_transformation_interpolation_duration_id",
+            "data_pos_rot_interpolation_duration_id",
+#endif
+            "data_translation_id",
+            "data_scale_id",
+            "data_left_rotation_id",
+            "data_right_rotation_id",
+            "data_billboard_render_constraints_id",
+            "data_brightness_override_id",
+            "data_view_range_id",
+            "data_shadow_radius_id",
+            "data_shadow_strength_id",
+            "data_width_id",
+            "data_height_id",
+            "data_glow_color_override_id",
+        } };
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 
     public:
@@ -9,7 +9,13 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 5;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_text_id",
+            "data_line_width_id",
+            "data_background_color_id",
+            "data_text_opacity_id",
+            "data_style_flags_id",
+        } };
         static constexpr int hierarchy_metadata_count = DisplayEntity::metadata_count + DisplayEntity::hierarchy_metadata_count;
 
     public:
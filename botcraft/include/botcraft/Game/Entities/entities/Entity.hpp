@@ -1,11 +1,16 @@
 #pragma once
 
 #include <any>
+#include <array>
 #include <chrono>
 #include <map>
 #include <memory>
 #include <optional>
 #include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "protocolCraft/Types/Chat/Chat.hpp"
@@ -58,9 +63,36 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 6;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_shared_flags_id",
+            "data_air_supply_id",
+            "data_custom_name",
+            "data_custom_name_visible",
+            "data_silent",
+            "data_no_gravity",
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "data_pose",
+#endif
+#if PROTOCOL_VERSION > 754 /* > 1.16.5 */
+            "data_ticks_frozen",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = 0;
 
+        /// @brief Get the position of a metadata in a class metadata_names, see METADATA_INDEX in MetadataIndex.hpp
+        template<size_t N>
+        static constexpr int MetadataIndex(const std::array<std::string_view, N>& names, const std::string_view name)
+        {
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (names[i] == name)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            throw std::out_of_range("Unknown metadata name");
+        }
+
     public:
         Entity();
         virtual ~Entity();
@@ -215,11 +247,28 @@ namespace Botcraft
 #endif
 
         // Factory stuff
+        /// @brief Create a new entity of the given type. Short-lived entities (items,
+        /// experience orbs, projectiles...) are allocated from a pool, as they
+        /// are created and removed in large numbers around farms. Any weak_ptr left
+        /// on a pooled entity keeps its memory in use after the entity is destroyed
         static std::shared_ptr<Entity> CreateEntity(const EntityType type);
 #if PROTOCOL_VERSION < 458 /* < 1.14 */
         static std::shared_ptr<Entity> CreateObjectEntity(const ObjectEntityType type);
 #endif
 
+        /// @brief Allocation statistics of the pool used for short-lived entities
+        struct PoolStats
+        {
+            /// @brief Number of pooled entities currently alive
+            size_t num_in_use;
+            /// @brief Number of entities created in the memory of a previously destroyed one
+            size_t num_reused;
+            /// @brief Number of entities the pool can hold without allocating more memory
+            size_t num_blocks;
+        };
+        /// @brief Get the current statistics of the entity pool, shared by all the pooled types
+        static PoolStats GetPoolStats();
+
     protected:
 #if USE_GUI
         virtual void InitializeFaces();
@@ -238,6 +287,8 @@ namespace Botcraft
         virtual double GetHeightImpl() const;
 
     protected:
+        static constexpr size_t num_equipment_slots = static_cast<size_t>(EquipmentSlot::Helmet) + 1;
+
         mutable std::shared_mutex entity_mutex;
 
         int entity_id;
@@ -247,13 +298,15 @@ namespace Botcraft
         float pitch;
         Vector3<double> speed;
         bool on_ground;
-        /// @brief Items on this entity. Note that for the local player
-        /// this will **NOT** be populated. Check corresponding
-        /// player inventory slots instead.
-        std::map<EquipmentSlot, ProtocolCraft::Slot> equipments;
+        /// @brief Items on this entity, indexed by EquipmentSlot. Only
+        /// allocated when a non empty item is set, most entities never
+        /// have any. Note that for the local player this will **NOT** be
+        /// populated. Check corresponding player inventory slots instead.
+        std::unique_ptr<std::array<ProtocolCraft::Slot, num_equipment_slots>> equipments;
         std::vector<EntityEffect> effects;
 
-        std::map<std::string, std::any> metadata;
+        /// @brief Metadata values, indexed by metadata id (hierarchy_metadata_count + position in metadata_names of the class)
+        std::vector<std::any> metadata;
 
 #if USE_GUI
         //All the faces of this model
@@ -9,7 +9,11 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 3;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_width_id",
+            "data_height_id",
+            "data_response_id",
+        } };
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 
     public:
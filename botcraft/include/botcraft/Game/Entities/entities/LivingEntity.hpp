@@ -23,7 +23,23 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 5;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_living_entity_flags",
+            "data_health_id",
+#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
+            "data_effect_color_id",
+#else
+            "data_effect_particles",
+#endif
+            "data_effect_ambience_id",
+            "data_arrow_count_id",
+#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
+            "data_stinger_count_id",
+#endif
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "sleeping_pos_id",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 
     public:
@@ -9,7 +9,12 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 4;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_type_id",
+            "is_lying",
+            "relax_state_one",
+            "data_collar_color",
+        } };
         static constexpr int hierarchy_metadata_count = TamableAnimalEntity::metadata_count + TamableAnimalEntity::hierarchy_metadata_count;
 
     public:
@@ -9,7 +9,12 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 4;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_type_id",
+            "data_flags_id",
+            "data_trusted_id_0",
+            "data_trusted_id_1",
+        } };
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
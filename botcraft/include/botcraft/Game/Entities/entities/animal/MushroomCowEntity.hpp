@@ -9,7 +9,9 @@ namespace Botcraft
     protected:
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_type",
+        } };
 #else
         static constexpr int metadata_count = 0;
 #endif
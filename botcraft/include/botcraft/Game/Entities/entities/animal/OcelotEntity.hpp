@@ -16,7 +16,13 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "data_trusting",
+#else
+            "data_type_id",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
@@ -9,7 +9,14 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 6;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "unhappy_counter",
+            "sneeze_counter",
+            "eat_counter",
+            "main_gene_id",
+            "hidden_gene_id",
+            "data_id_flags",
+        } };
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
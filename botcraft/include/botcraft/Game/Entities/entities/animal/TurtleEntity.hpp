@@ -9,7 +9,14 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 6;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "home_pos",
+            "has_egg",
+            "laying_egg",
+            "travel_pos",
+            "going_home",
+            "travelling",
+        } };
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
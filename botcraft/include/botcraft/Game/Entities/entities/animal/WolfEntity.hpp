@@ -17,7 +17,19 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 3;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+#if PROTOCOL_VERSION < 499 /* < 1.15 */
+            "data_health_id",
+#endif
+            "data_interested_id",
+            "data_collar_color",
+#if PROTOCOL_VERSION > 578 /* > 1.15.2 */
+            "data_remaining_anger_time",
+#endif
+#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
+            "data_variant_id",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = TamableAnimalEntity::metadata_count + TamableAnimalEntity::hierarchy_metadata_count;
 
     public:
@@ -13,7 +13,13 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 1;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_is_screaming_goat",
+#if PROTOCOL_VERSION > 758 /* > 1.18.2 */
+            "data_has_left_horn",
+            "data_has_right_horn",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = AnimalEntity::metadata_count + AnimalEntity::hierarchy_metadata_count;
 
     public:
@@ -12,7 +12,13 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 2;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_strength_id",
+#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
+            "data_swag_id",
+#endif
+            "data_variant_id",
+        } };
         static constexpr int hierarchy_metadata_count = AbstractChestedHorseEntity::metadata_count + AbstractChestedHorseEntity::hierarchy_metadata_count;
 
     public:
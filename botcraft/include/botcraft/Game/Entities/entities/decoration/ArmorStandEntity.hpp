@@ -8,7 +8,15 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 7;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_client_flags",
+            "data_head_pose",
+            "data_body_pose",
+            "data_left_arm_pose",
+            "data_right_arm_pose",
+            "data_left_leg_pose",
+            "data_right_leg_pose",
+        } };
         static constexpr int hierarchy_metadata_count = LivingEntity::metadata_count + LivingEntity::hierarchy_metadata_count;
 
     public:
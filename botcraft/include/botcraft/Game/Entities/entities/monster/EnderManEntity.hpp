@@ -12,7 +12,13 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 2;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_carry_state",
+            "data_creepy",
+#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
+            "data_stared_at",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = MonsterEntity::metadata_count + MonsterEntity::hierarchy_metadata_count;
 
     public:
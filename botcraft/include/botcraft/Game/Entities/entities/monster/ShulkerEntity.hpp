@@ -12,7 +12,14 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 4;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_attach_face_id",
+#if PROTOCOL_VERSION < 755 /* < 1.17 */
+            "data_attach_pos_id",
+#endif
+            "data_peek_id",
+            "data_color_id",
+        } };
         static constexpr int hierarchy_metadata_count = AbstractGolemEntity::metadata_count + AbstractGolemEntity::hierarchy_metadata_count;
 
     public:
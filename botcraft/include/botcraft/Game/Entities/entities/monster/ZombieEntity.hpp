@@ -14,7 +14,16 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 3;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_baby_id",
+            "data_special_type_id",
+#if PROTOCOL_VERSION < 405 /* < 1.14 */
+            "data_are_hands_up",
+#endif
+#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
+            "data_drowned_conversion_id",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = MonsterEntity::metadata_count + MonsterEntity::hierarchy_metadata_count;
 
     public:
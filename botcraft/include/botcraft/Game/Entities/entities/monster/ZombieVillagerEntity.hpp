@@ -11,7 +11,14 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 2;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_converting_id",
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "data_villager_data",
+#else
+            "data_villager_profession_id"
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = ZombieEntity::metadata_count + ZombieEntity::hierarchy_metadata_count;
 
     public:
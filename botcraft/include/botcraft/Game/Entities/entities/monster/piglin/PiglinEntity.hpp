@@ -21,7 +21,14 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 4;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_baby_id",
+#if PROTOCOL_VERSION < 737 /* < 1.16.2 */
+            "data_immune_to_zombification",
+#endif
+            "data_is_charging_crossbow",
+            "data_is_dancing",
+        } };
 #if PROTOCOL_VERSION > 736 /* > 1.16.1 */
         static constexpr int hierarchy_metadata_count = AbstractPiglinEntity::metadata_count + AbstractPiglinEntity::hierarchy_metadata_count;
 #else
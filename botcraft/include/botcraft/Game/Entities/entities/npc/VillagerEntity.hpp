@@ -19,7 +19,13 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 1;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "data_villager_data",
+#else
+            "data_villager_profession_id",
+#endif
+        } };
 #if PROTOCOL_VERSION > 477 /* > 1.14 */
         static constexpr int hierarchy_metadata_count = AbstractVillagerEntity::metadata_count + AbstractVillagerEntity::hierarchy_metadata_count;
 #else
@@ -9,7 +9,14 @@ namespace Botcraft
     {
     protected:
         static constexpr int metadata_count = 6;
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_player_absorption_id",
+            "data_score_id",
+            "data_player_mode_customisation",
+            "data_player_main_hand",
+            "data_shoulder_left",
+            "data_shoulder_right",
+        } };
         static constexpr int hierarchy_metadata_count = LivingEntity::metadata_count + LivingEntity::hierarchy_metadata_count;
 
     public:
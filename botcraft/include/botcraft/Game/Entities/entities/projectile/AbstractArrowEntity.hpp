@@ -24,7 +24,15 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 1;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "id_flags",
+#if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
+            "data_owneruuid_id",
+#endif
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "pierce_level",
+#endif
+        } };
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
         static constexpr int hierarchy_metadata_count = ProjectileEntity::metadata_count + ProjectileEntity::hierarchy_metadata_count;
 #else
@@ -21,7 +21,13 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 2;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "data_id_fireworks_item",
+            "data_attached_to_target",
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+            "data_shot_at_angle",
+#endif
+        } };
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
         static constexpr int hierarchy_metadata_count = ProjectileEntity::metadata_count + ProjectileEntity::hierarchy_metadata_count;
 #else
@@ -13,7 +13,12 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 1;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+            "id_loyalty",
+#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
+            "id_foil",
+#endif
+        } };
         static constexpr int hierarchy_metadata_count = AbstractArrowEntity::metadata_count + AbstractArrowEntity::hierarchy_metadata_count;
 
     public:
@@ -20,7 +20,16 @@ namespace Botcraft
 #else
         static constexpr int metadata_count = 3;
 #endif
-        static const std::array<std::string, metadata_count> metadata_names;
+        static constexpr std::array<std::string_view, metadata_count> metadata_names{ {
+#if PROTOCOL_VERSION < 765 /* < 1.20.3 */
+            "data_id_hurt",
+            "data_id_hurtdir",
+            "data_id_damage",
+#endif
+            "data_id_display_block",
+            "data_id_display_offset",
+            "data_id_custom_display",
+        } };
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         static constexpr int hierarchy_metadata_count = Entity::metadata_count + Entity::hierarchy_metadata_count;
 #else
@@ -15,6 +15,7 @@ namespace Botcraft
     class EntityManager;
     class LocalPlayer;
     class PhysicsManager;
+    class TickScheduler;
 
 #if USE_GUI
     namespace Renderer
@@ -37,6 +38,11 @@ namespace Botcraft
 
         void SetSharedWorld(const std::shared_ptr<World> world_);
 
+        /// @brief Run the physics of this client on a scheduler shared by multiple
+        /// clients instead of on a dedicated thread. Must be called before Connect
+        /// @param tick_scheduler_ The scheduler to use, or nullptr to use a dedicated thread
+        void SetTickScheduler(const std::shared_ptr<TickScheduler>& tick_scheduler_);
+
         bool GetAutoRespawn() const;
         void SetAutoRespawn(const bool b);
 
@@ -82,6 +88,7 @@ namespace Botcraft
         std::shared_ptr<EntityManager> entity_manager;
         std::shared_ptr<InventoryManager> inventory_manager;
         std::shared_ptr<PhysicsManager> physics_manager;
+        std::shared_ptr<TickScheduler> tick_scheduler;
 #if USE_GUI
         // If true, opens a window to display the view
         // from the bot. Only one renderer can be active
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "protocolCraft/Handler.hpp"
 
@@ -15,6 +16,7 @@ namespace Botcraft
     class InventoryManager;
     class LocalPlayer;
     class NetworkManager;
+    class TickScheduler;
     class World;
 
     class Item;
@@ -41,7 +43,9 @@ namespace Botcraft
         );
         ~PhysicsManager();
 
-        void StartPhysics();
+        /// @brief Start running physics ticks and sending the position to the server
+        /// @param tick_scheduler_ If not null, ticks are run by this scheduler, otherwise on a dedicated thread
+        void StartPhysics(const std::shared_ptr<TickScheduler>& tick_scheduler_ = nullptr);
         void StopPhysics();
 
     protected:
@@ -50,6 +54,8 @@ namespace Botcraft
 
     private:
         void Physics();
+        /// @brief Run one physics tick if the player is in game
+        void Step();
 
         /// @brief Follow minecraft physics related flow in LocalPlayer tick function
         void PhysicsTick();
@@ -98,7 +104,13 @@ namespace Botcraft
         int ticks_since_last_position_sent;
 
         std::thread thread_physics; // Thread running to compute position and send it to the server every 50 ms (20 ticks/s)
+        /// @brief If not null, ticks are run by this scheduler instead of thread_physics
+        std::shared_ptr<TickScheduler> tick_scheduler;
+        size_t tick_scheduler_id;
 
         const Item* elytra_item;
+
+        /// @brief Colliders buffer reused by CollideBoundingBox to avoid allocating at each call, only used by the physics thread
+        mutable std::vector<AABB> colliders_buffer;
     };
 } // Botcraft
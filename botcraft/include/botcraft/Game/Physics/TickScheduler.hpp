@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Botcraft
+{
+    /// @brief Timing statistics of the ticks run by a TickScheduler
+    struct TickStats
+    {
+        /// @brief Number of ticks run
+        unsigned long long int ticks = 0;
+        /// @brief Number of ticks skipped because a task was late by more than a tick period
+        unsigned long long int missed_ticks = 0;
+        /// @brief Number of ticks that took longer than a tick period to run
+        unsigned long long int overruns = 0;
+        /// @brief Sum of the delays between the tick deadlines and the actual tick starts
+        std::chrono::microseconds total_jitter = std::chrono::microseconds(0);
+        /// @brief Max delay between a tick deadline and the actual tick start
+        std::chrono::microseconds max_jitter = std::chrono::microseconds(0);
+        /// @brief Longest tick
+        std::chrono::microseconds max_duration = std::chrono::microseconds(0);
+    };
+
+    /// @brief Run periodic tasks (e.g. physics of many bots) on a small pool of
+    /// worker threads instead of one sleeping thread per task. Each task has its
+    /// own deadlines, every tick period after its registration. Due ticks are
+    /// run in deadline order by whichever worker is free, so an expensive task
+    /// only delays the others if all the workers are busy. A task is never run
+    /// by two workers at the same time
+    class TickScheduler
+    {
+    public:
+        /// @brief Start the worker threads
+        /// @param num_threads Number of worker threads, if 0, use the number of hardware threads
+        /// @param tick_period_ Time between two ticks of the same task
+        TickScheduler(const size_t num_threads = 0, const std::chrono::steady_clock::duration tick_period_ = std::chrono::milliseconds(50));
+        ~TickScheduler();
+
+        TickScheduler(const TickScheduler&) = delete;
+        TickScheduler& operator=(const TickScheduler&) = delete;
+
+        /// @brief Add a task to run every tick, the first tick is run as soon as possible
+        /// @param tick Function called at each tick. Exceptions are logged and don't stop the task
+        /// @return An id to unregister the task
+        size_t Register(std::function<void()>&& tick);
+
+        /// @brief Stop running a task. If the task is currently running on another thread,
+        /// wait for the end of its tick. Can be called from the task itself
+        /// @param id Id returned by Register
+        void Unregister(const size_t id);
+
+        size_t GetNumThreads() const;
+
+        std::chrono::steady_clock::duration GetTickPeriod() const;
+
+        /// @brief Get the statistics of all the ticks run since construction or last ResetStats
+        TickStats GetStats() const;
+
+        void ResetStats();
+
+    private:
+        void Run(const size_t index);
+
+    private:
+        struct Task
+        {
+            std::function<void()> tick;
+            bool running = false;
+            bool removed = false;
+        };
+
+        struct ScheduledTick
+        {
+            std::chrono::steady_clock::time_point deadline;
+            size_t id;
+
+            bool operator>(const ScheduledTick& other) const
+            {
+                return deadline > other.deadline;
+            }
+        };
+
+        const std::chrono::steady_clock::duration tick_period;
+
+        std::vector<std::thread> threads;
+
+        mutable std::mutex tasks_mutex;
+        /// @brief Notified when a new tick is scheduled or when stopping
+        std::condition_variable tasks_condition;
+        /// @brief Notified when a removed task finishes its last tick
+        std::condition_variable removed_condition;
+        std::unordered_map<size_t, Task> tasks;
+        std::priority_queue<ScheduledTick, std::vector<ScheduledTick>, std::greater<ScheduledTick> > schedule;
+        size_t next_id;
+        bool running;
+
+        TickStats stats;
+    };
+} // Botcraft
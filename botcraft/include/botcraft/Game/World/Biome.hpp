@@ -27,6 +27,9 @@ namespace Botcraft
         ~Biome();
 
         const std::string& GetName() const;
+        float GetTemperature() const;
+        float GetRainfall() const;
+        BiomeType GetBiomeType() const;
         
         // Height is the y value of the block
         const unsigned int GetColorMultiplier(const int height, const bool is_grass) const;
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <bitset>
+#include <cmath>
 #include <deque>
 #include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "protocolCraft/BinaryReadWrite.hpp"
 #include "protocolCraft/Utilities/Json.hpp"
 
 #include "botcraft/Game/Enums.hpp"
@@ -95,6 +99,44 @@ namespace Botcraft
         ProtocolCraft::Json::Value colliders = ProtocolCraft::Json::Value();
     };
 
+    /// @brief What pathfinding needs to know about a blockstate, packed in one
+    /// byte. Computed once when the blockstate is loaded, so pathfinding doesn't
+    /// have to go through the blockstate flags and colliders for each block
+    class Walkability
+    {
+    public:
+        enum class Kind : unsigned char
+        {
+            Empty = 0,
+            Solid,
+            Climbable,
+            /// @brief Water, lava or non solid waterlogged block
+            Fluid
+        };
+
+        /// @brief Default is an empty block, same as an unloaded one
+        Walkability() = default;
+        /// @param kind Kind of block
+        /// @param hazardous True if this block can hurt when walking in/on it
+        /// @param top_height Top of the colliders above the bottom of the block, stored in 1/16 of block (the vanilla models grid)
+        Walkability(const Kind kind, const bool hazardous, const float top_height)
+        {
+            const int top = std::clamp(static_cast<int>(std::round(top_height * 16.0f)), 0, 31);
+            value = static_cast<unsigned char>(static_cast<unsigned char>(kind) | (hazardous << 2) | (top << 3));
+        }
+
+        Kind GetKind() const { return static_cast<Kind>(value & 0x03); }
+        bool IsHazardous() const { return value & 0x04; }
+        /// @brief Get the top of the colliders above the bottom of the block
+        float GetTopHeight() const { return (value >> 3) / 16.0f; }
+
+        bool operator==(const Walkability& other) const { return value == other.value; }
+        bool operator!=(const Walkability& other) const { return value != other.value; }
+
+    private:
+        unsigned char value = 0;
+    };
+
     class Blockstate
     {
     public:
@@ -107,6 +149,14 @@ namespace Botcraft
         /// @param model_ The model of this blockstate
         Blockstate(const BlockstateProperties& properties, const Model& model_);
 
+#if !USE_GUI
+        /// @brief Create a blockstate from the data written by WriteBinary, without reading any file
+        /// @param iter Iterator to read the data from
+        /// @param length Number of bytes available from iter
+        /// @param models_mapping Index of the models read by ReadModelsBinary
+        Blockstate(ProtocolCraft::ReadIterator& iter, size_t& length, const std::vector<size_t>& models_mapping);
+#endif
+
         BlockstateId GetId() const;
         const Model& GetModel(const unsigned short index) const;
         unsigned char GetModelId(const Position& pos) const;
@@ -116,6 +166,48 @@ namespace Botcraft
         Vector3<double> GetHorizontalOffsetAtPos(const Position& pos) const;
         std::set<AABB> GetCollidersAtPos(const Position& pos) const;
 
+        /// @brief Call a function on each collider of this blockstate at a given position,
+        /// without building any container. Colliders are visited in the same order as
+        /// the ones returned by GetCollidersAtPos
+        /// @param pos Block position
+        /// @param f Function called as f(const AABB& collider), if it returns a bool, false stops the iteration
+        template<class F>
+        void ForEachColliderAtPos(const Position& pos, F&& f) const
+        {
+            const unsigned char model_id = GetModelId(pos);
+            const unsigned short end = colliders_offsets[model_id + 1];
+            if (colliders_offsets[model_id] == end)
+            {
+                return;
+            }
+            const Vector3<double> offset = GetHorizontalOffsetAtPos(pos);
+            for (unsigned short i = colliders_offsets[model_id]; i < end; ++i)
+            {
+                if constexpr (std::is_same_v<std::invoke_result_t<F&, const AABB&>, bool>)
+                {
+                    if (!f(colliders[i] + offset))
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    f(colliders[i] + offset);
+                }
+            }
+        }
+
+        /// @brief Copy the colliders of this blockstate at a given position
+        /// @param pos Block position
+        /// @param out Output iterator the colliders are written to (e.g. std::back_inserter of a reused vector)
+        /// @return Output iterator past the last written collider
+        template<class OutputIt>
+        OutputIt CopyCollidersAtPos(const Position& pos, OutputIt out) const
+        {
+            ForEachColliderAtPos(pos, [&out](const AABB& collider) { *out++ = collider; });
+            return out;
+        }
+
         bool IsAir() const;
         bool IsSolid() const;
         bool IsTransparent() const;
@@ -145,6 +237,7 @@ namespace Botcraft
         /// @brief Get fluid height for this block. Does not take into account neighbouring blocks
         /// @return Height of fluid in this block, between 0 and 1
         float GetFluidHeight() const;
+        Walkability GetWalkability() const;
 
         /// @brief Compute the amount of time (in s) required to mine this block
         /// @param tool_type The tool used to mine
@@ -168,11 +261,24 @@ namespace Botcraft
 
 #if USE_GUI
         static void UpdateModelsWithAtlasData(const Renderer::Atlas* atlas);
+#else
+        /// @brief Write this blockstate with its flags and models already resolved.
+        /// Models are written as indices, see WriteModelsBinary
+        void WriteBinary(ProtocolCraft::WriteContainer& container) const;
+        /// @brief Write the colliders of all the loaded models
+        static void WriteModelsBinary(ProtocolCraft::WriteContainer& container);
+        /// @brief Read the models written by WriteModelsBinary
+        /// @return Index of each read model in the loaded ones, to give to the binary constructor
+        static std::vector<size_t> ReadModelsBinary(ProtocolCraft::ReadIterator& iter, size_t& length);
 #endif
 
     private:
         void LoadProperties(const BlockstateProperties& properties);
         void LoadWeightedModels(const std::deque<std::pair<Model, int>>& models_to_load);
+        /// @brief Copy the colliders of all the models in colliders/colliders_offsets and compute walkability
+        void FlattenModels();
+        /// @brief Compute walkability from the flags and the colliders of all the models
+        void ComputeWalkability();
         bool GetBoolFromCondition(const ProtocolCraft::Json::Value& condition) const;
         /// @brief Check if a given string condition match this blockstate variables
         /// @param condition String to check, example: "layers=1"
@@ -232,12 +338,18 @@ namespace Botcraft
         float hardness;
         float friction;
         TintType tint_type;
+        Walkability walkability;
         const std::string* m_name;
 
         std::vector<size_t> models_indices;
         std::vector<int> models_weights;
         int weights_sum;
 
+        /// @brief Colliders of all the models of this blockstate, stored contiguously.
+        /// Colliders of model i are in [colliders_offsets[i], colliders_offsets[i + 1][
+        std::vector<AABB> colliders;
+        std::vector<unsigned short> colliders_offsets;
+
         std::vector<BestTool> best_tools;
 
         std::map<const std::string*, const std::string*, string_ptr_compare> variables; // map is smaller in RAM than unordered_map
@@ -8,6 +8,7 @@
 
 #include "botcraft/Game/Enums.hpp"
 #include "botcraft/Game/World/Blockstate.hpp"
+#include "botcraft/Network/LoaderId.hpp"
 #include "protocolCraft/Types/NBT/NBT.hpp"
 #include "protocolCraft/Types/BlockEntityInfo.hpp"
 
@@ -30,6 +31,8 @@ namespace Botcraft
         Chunk(const int min_y_, const unsigned int height_, const size_t dim_index, const bool has_sky_light_);
 #endif
         Chunk(const Chunk& c);
+        Chunk(Chunk&& c) = default;
+        Chunk& operator=(Chunk&& c) = default;
 
         static Position BlockCoordsToChunkCoords(const Position& pos);
 
@@ -70,12 +73,24 @@ namespace Botcraft
         unsigned char GetSkyLight(const Position& pos) const;
         void SetSkyLight(const Position& pos, const unsigned char v);
 
+        /// @brief Replace the light values of a whole section
+        /// @param section_y Index of the section in the chunk
+        /// @param data Nibble array of 2048 bytes (4 bits per block, x then z then y), or empty to set all light values to 0
+        /// @param sky If true, set sky light, block light otherwise
+        void LoadSectionLight(const int section_y, const std::vector<char>& data, const bool sky);
+
         size_t GetDimensionIndex() const;
         bool GetHasSkyLight() const;
 
         bool HasSection(const int y) const;
         void AddSection(const int y);
 
+        /// @brief Get shared pointers to all the sections of this chunk. Shared sections
+        /// are copied by the chunk before any block modification, so the blocks
+        /// of the returned sections will never change
+        /// @return A vector with one pointer per section, nullptr for empty sections
+        std::vector<std::shared_ptr<const Section> > ShareSections() const;
+
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
         const Biome* GetBiome(const int x, const int z) const;
         void SetBiome(const int x, const int z, const int b);
@@ -91,16 +106,21 @@ namespace Botcraft
 #endif
         void UpdateNeighbour(Chunk* const neighbour, const Orientation direction);
 
-        /// @brief Add a thread to the loaders list
-        /// @param thread_id Id of the thread
-        void AddLoader(const std::thread::id& thread_id);
-        /// @brief Remove a thread from the loaders list
-        /// @param thread_id Id of the thread
+        /// @brief Add a loader to the loaders list
+        /// @param loader_id Id of the loader
+        void AddLoader(const LoaderId loader_id);
+        /// @brief Remove a loader from the loaders list
+        /// @param loader_id Id of the loader
         /// @return Number of remaining loaders
-        size_t RemoveLoader(const std::thread::id& thread_id);
+        size_t RemoveLoader(const LoaderId loader_id);
+        /// @brief Get all loaders in the loaders list
+        /// @return A set of loader ids
+        const std::unordered_set<LoaderId>& GetLoaders() const;
         
     private:
         bool IsInsideChunk(const Position& pos, const bool ignore_gui_borders) const;
+        /// @brief Copy a section if it's shared, before modifying its blocks
+        void DetachSection(const int y);
 #if PROTOCOL_VERSION > 756 /* > 1.17.1 */
         void LoadSectionBiomeData(const int section_y, ProtocolCraft::ReadIterator& iter, size_t& length);
 #endif
@@ -123,6 +143,6 @@ namespace Botcraft
 #if USE_GUI
         bool modified_since_last_rendered;
 #endif
-        std::unordered_set<std::thread::id> loaded_from;
+        std::unordered_set<LoaderId> loaded_from;
     };
 } // Botcraft
@@ -0,0 +1,384 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Botcraft
+{
+    /// @brief Map from chunk coordinates to T, used for the world terrain.
+    /// Open addressing table with linear probing over packed 64 bits keys.
+    /// Values are allocated separately so their address never changes
+    /// while they are in the map. Erased slots are marked as deleted
+    /// instead of moving other entries, so erasing while iterating
+    /// (either with it = erase(it) or erase(it++)) is safe.
+    /// Get also uses a per-thread cache of the last lookup, as
+    /// successive lookups very often hit the same chunk.
+    /// Like std::unordered_map, this class is not thread-safe.
+    template<class T>
+    class ChunkIndex
+    {
+    public:
+        using key_type = std::pair<int, int>;
+        using mapped_type = T;
+        using value_type = std::pair<const std::pair<int, int>, T>;
+        using size_type = size_t;
+
+    private:
+        struct Slot
+        {
+            unsigned long long int key = 0;
+            std::unique_ptr<value_type> value;
+            bool deleted = false;
+        };
+
+        template<bool IsConst>
+        class Iterator
+        {
+            friend class ChunkIndex;
+            using SlotPtr = std::conditional_t<IsConst, const Slot*, Slot*>;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ChunkIndex::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+            using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+            Iterator() = default;
+            // Allow iterator to const_iterator conversion
+            template<bool WasConst, class = std::enable_if_t<IsConst && !WasConst> >
+            Iterator(const Iterator<WasConst>& other) : current(other.current), last(other.last) {}
+
+            reference operator*() const { return *current->value; }
+            pointer operator->() const { return current->value.get(); }
+
+            Iterator& operator++()
+            {
+                ++current;
+                SkipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator output = *this;
+                ++(*this);
+                return output;
+            }
+
+            bool operator==(const Iterator& other) const { return current == other.current; }
+            bool operator!=(const Iterator& other) const { return current != other.current; }
+
+        private:
+            Iterator(SlotPtr current_, SlotPtr last_) : current(current_), last(last_)
+            {
+                SkipEmpty();
+            }
+
+            void SkipEmpty()
+            {
+                while (current != last && current->value == nullptr)
+                {
+                    ++current;
+                }
+            }
+
+        private:
+            SlotPtr current = nullptr;
+            SlotPtr last = nullptr;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        ChunkIndex()
+        {
+            generation = NextGeneration();
+        }
+
+        ChunkIndex(ChunkIndex&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        ChunkIndex& operator=(ChunkIndex&& other) noexcept
+        {
+            slots = std::move(other.slots);
+            num_values = other.num_values;
+            num_deleted = other.num_deleted;
+            other.slots.clear();
+            other.num_values = 0;
+            other.num_deleted = 0;
+            generation = NextGeneration();
+            other.generation = NextGeneration();
+            return *this;
+        }
+
+        ChunkIndex(const ChunkIndex&) = delete;
+        ChunkIndex& operator=(const ChunkIndex&) = delete;
+
+        size_t size() const { return num_values; }
+        bool empty() const { return num_values == 0; }
+
+        iterator begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+        iterator end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+        const_iterator begin() const { return const_iterator(slots.data(), slots.data() + slots.size()); }
+        const_iterator end() const { return const_iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        iterator find(const key_type& key)
+        {
+            const size_t index = FindSlot(PackKey(key.first, key.second));
+            return index == npos ? end() : iterator(slots.data() + index, slots.data() + slots.size());
+        }
+
+        const_iterator find(const key_type& key) const
+        {
+            const size_t index = FindSlot(PackKey(key.first, key.second));
+            return index == npos ? end() : const_iterator(slots.data() + index, slots.data() + slots.size());
+        }
+
+        size_t count(const key_type& key) const
+        {
+            return FindSlot(PackKey(key.first, key.second)) == npos ? 0 : 1;
+        }
+
+        T& at(const key_type& key)
+        {
+            T* value = Get(key.first, key.second);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("Chunk not found in ChunkIndex");
+            }
+            return *value;
+        }
+
+        const T& at(const key_type& key) const
+        {
+            const T* value = Get(key.first, key.second);
+            if (value == nullptr)
+            {
+                throw std::out_of_range("Chunk not found in ChunkIndex");
+            }
+            return *value;
+        }
+
+        /// @brief Get the value at chunk coordinates, using this thread last lookup if it's the same chunk
+        /// @param x Chunk X coordinate
+        /// @param z Chunk Z coordinate
+        /// @return A pointer to the value, or nullptr if not present
+        T* Get(const int x, const int z)
+        {
+            return const_cast<T*>(static_cast<const ChunkIndex*>(this)->Get(x, z));
+        }
+
+        /// @brief Get the value at chunk coordinates, using this thread last lookup if it's the same chunk
+        /// @param x Chunk X coordinate
+        /// @param z Chunk Z coordinate
+        /// @return A pointer to the value, or nullptr if not present
+        const T* Get(const int x, const int z) const
+        {
+            // Generations are unique across all indices and change
+            // with any insertion/deletion, so a matching generation
+            // means the cached pointer is still valid
+            struct LastHit
+            {
+                unsigned long long int generation = 0;
+                unsigned long long int key = 0;
+                const value_type* value = nullptr;
+            };
+            static thread_local LastHit last_hit;
+
+            const unsigned long long int key = PackKey(x, z);
+            if (last_hit.generation == generation && last_hit.key == key)
+            {
+                return last_hit.value == nullptr ? nullptr : &last_hit.value->second;
+            }
+
+            const size_t index = FindSlot(key);
+            last_hit.generation = generation;
+            last_hit.key = key;
+            last_hit.value = index == npos ? nullptr : slots[index].value.get();
+            return last_hit.value == nullptr ? nullptr : &last_hit.value->second;
+        }
+
+        /// @brief Insert a value if the key is not already present
+        /// @return An iterator to the value with this key, and true if the insertion took place
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace(value.first, std::move(value.second));
+        }
+
+        /// @brief Construct a value in place if the key is not already present. Arguments are not moved from otherwise
+        /// @return An iterator to the value with this key, and true if the insertion took place
+        template<class... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            const unsigned long long int packed_key = PackKey(key.first, key.second);
+            size_t index = FindSlot(packed_key);
+            if (index != npos)
+            {
+                return { iterator(slots.data() + index, slots.data() + slots.size()), false };
+            }
+
+            std::unique_ptr<value_type> value = std::make_unique<value_type>(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            index = InsertSlot(packed_key);
+            slots[index].value = std::move(value);
+            return { iterator(slots.data() + index, slots.data() + slots.size()), true };
+        }
+
+        /// @brief Erase the value pointed by an iterator
+        /// @return An iterator to the next value
+        iterator erase(const_iterator it)
+        {
+            Slot* slot = slots.data() + (it.current - slots.data());
+            slot->value.reset();
+            slot->deleted = true;
+            num_values -= 1;
+            num_deleted += 1;
+            generation = NextGeneration();
+            return iterator(slot + 1, slots.data() + slots.size());
+        }
+
+        size_t erase(const key_type& key)
+        {
+            const size_t index = FindSlot(PackKey(key.first, key.second));
+            if (index == npos)
+            {
+                return 0;
+            }
+            erase(const_iterator(slots.data() + index, slots.data() + slots.size()));
+            return 1;
+        }
+
+        void clear()
+        {
+            slots.clear();
+            num_values = 0;
+            num_deleted = 0;
+            generation = NextGeneration();
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        static constexpr size_t min_capacity = 16;
+
+        static unsigned long long int PackKey(const int x, const int z)
+        {
+            return (static_cast<unsigned long long int>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(z);
+        }
+
+        static size_t Hash(unsigned long long int key)
+        {
+            // splitmix64 finalizer, neighbouring chunks end up in unrelated slots
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdULL;
+            key ^= key >> 33;
+            key *= 0xc4ceb9fe1a85ec53ULL;
+            key ^= key >> 33;
+            return static_cast<size_t>(key);
+        }
+
+        static unsigned long long int NextGeneration()
+        {
+            static std::atomic<unsigned long long int> next_generation = 1;
+            return next_generation.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        size_t FindSlot(const unsigned long long int key) const
+        {
+            if (slots.empty())
+            {
+                return npos;
+            }
+
+            const size_t mask = slots.size() - 1;
+            for (size_t index = Hash(key) & mask; ; index = (index + 1) & mask)
+            {
+                const Slot& slot = slots[index];
+                if (slot.value != nullptr)
+                {
+                    if (slot.key == key)
+                    {
+                        return index;
+                    }
+                }
+                else if (!slot.deleted)
+                {
+                    return npos;
+                }
+            }
+        }
+
+        /// @brief Get a free slot for a key not already in the table, growing it if needed
+        size_t InsertSlot(const unsigned long long int key)
+        {
+            // Keep at most 3/4 of the slots used, deleted ones included,
+            // so probing always ends on an empty slot
+            if ((num_values + num_deleted + 1) * 4 > slots.size() * 3)
+            {
+                size_t new_capacity = min_capacity;
+                while ((num_values + 1) * 2 > new_capacity)
+                {
+                    new_capacity *= 2;
+                }
+                Rehash(new_capacity);
+            }
+
+            const size_t mask = slots.size() - 1;
+            size_t index = Hash(key) & mask;
+            while (slots[index].value != nullptr)
+            {
+                index = (index + 1) & mask;
+            }
+            if (slots[index].deleted)
+            {
+                slots[index].deleted = false;
+                num_deleted -= 1;
+            }
+            slots[index].key = key;
+            num_values += 1;
+            generation = NextGeneration();
+            return index;
+        }
+
+        void Rehash(const size_t new_capacity)
+        {
+            std::vector<Slot> old_slots = std::move(slots);
+            slots = std::vector<Slot>(new_capacity);
+            num_deleted = 0;
+
+            const size_t mask = new_capacity - 1;
+            for (Slot& slot : old_slots)
+            {
+                if (slot.value == nullptr)
+                {
+                    continue;
+                }
+                size_t index = Hash(slot.key) & mask;
+                while (slots[index].value != nullptr)
+                {
+                    index = (index + 1) & mask;
+                }
+                slots[index].key = slot.key;
+                slots[index].value = std::move(slot.value);
+            }
+            generation = NextGeneration();
+        }
+
+    private:
+        std::vector<Slot> slots;
+        size_t num_values = 0;
+        size_t num_deleted = 0;
+        /// @brief Unique id of the current state of the table, used to validate per-thread caches
+        unsigned long long int generation = 0;
+    };
+} // Botcraft
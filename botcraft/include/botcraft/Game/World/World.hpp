@@ -1,15 +1,25 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "botcraft/Game/Enums.hpp"
 #include "botcraft/Game/World/Blockstate.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/ChunkIndex.hpp"
 #include "botcraft/Game/Vector3.hpp"
+#include "botcraft/Network/DecodePool.hpp"
+#include "botcraft/Network/LoaderId.hpp"
 #include "botcraft/Utilities/ScopeLockedWrapper.hpp"
 
 #include "protocolCraft/Handler.hpp"
@@ -21,10 +31,8 @@ namespace std
     {
         inline size_t operator()(const pair<int, int>& p) const
         {
-            hash<float> hasher;
-            size_t value = hasher(p.first);
-            value ^= hasher(p.second) + 0x9e3779b9 + (value << 6) + (value >> 2);
-            return value;
+            // Hash both coordinates packed in 64 bits
+            return hash<unsigned long long int>()(static_cast<unsigned long long int>(static_cast<unsigned int>(p.first)) << 32 | static_cast<unsigned int>(p.second));
         }
     };
 }
@@ -32,9 +40,28 @@ namespace std
 namespace Botcraft
 {
     class Biome;
+    struct TerrainView;
+    struct TerrainChunkView;
 
-    class World : public ProtocolCraft::Handler
+    /// @brief Timing statistics about chunk data loading, all durations in nanoseconds
+    struct ChunkLoadStats
     {
+        /// @brief Number of chunks loaded
+        size_t num_chunks = 0;
+        /// @brief Time spent decoding chunk data, without holding the world lock
+        long long int decode_total_ns = 0;
+        long long int decode_max_ns = 0;
+        /// @brief Time spent waiting to acquire the exclusive world lock
+        long long int lock_wait_total_ns = 0;
+        long long int lock_wait_max_ns = 0;
+        /// @brief Time during which the exclusive world lock was held to insert the chunk
+        long long int lock_hold_total_ns = 0;
+        long long int lock_hold_max_ns = 0;
+    };
+
+    class World : public ProtocolCraft::Handler, public PacketPreparer
+    {
+        friend class WorldView;
     public:
         /// @brief
         /// @param is_shared_ If true, this world can be shared by multiple bot
@@ -43,7 +70,7 @@ namespace Botcraft
 
         ~World();
 
-        /// @brief Check if a position is in a loaded chunk. Thread-safe
+        /// @brief Check if a position is in a loaded chunk. Thread-safe, lock-free
         /// @param pos Block position
         /// @return True if the chunk is loaded, false otherwise
         bool IsLoaded(const Position& pos) const;
@@ -81,25 +108,25 @@ namespace Botcraft
         /// @param x X chunk coordinate
         /// @param z Z chunk coordinate
         /// @param dim Dimension in which the chunk is added
-        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void LoadChunk(const int x, const int z, const Dimension dim, const std::thread::id& loader_id = std::this_thread::get_id());
+        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current connection id, or current thread id if not called while processing packets
+        void LoadChunk(const int x, const int z, const Dimension dim, const LoaderId loader_id = GetCurrentLoaderId());
 #else
         /// @brief Add a chunk at given coordinates. If already exists in another dimension, will be erased first. Thread-safe
         /// @param x X chunk coordinate
         /// @param z Z chunk coordinate
         /// @param dim Dimension in which the chunk is added
-        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void LoadChunk(const int x, const int z, const std::string& dim, const std::thread::id& loader_id = std::this_thread::get_id());
+        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current connection id, or current thread id if not called while processing packets
+        void LoadChunk(const int x, const int z, const std::string& dim, const LoaderId loader_id = GetCurrentLoaderId());
 #endif
         /// @brief Remove a chunk at given coordinates. Thread-safe
         /// @param x X chunk coordinate
         /// @param z Z chunk coordinate
-        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void UnloadChunk(const int x, const int z, const std::thread::id& loader_id = std::this_thread::get_id());
+        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current connection id, or current thread id if not called while processing packets
+        void UnloadChunk(const int x, const int z, const LoaderId loader_id = GetCurrentLoaderId());
 
         /// @brief Remove all chunks from memory
-        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current thread id
-        void UnloadAllChunks(const std::thread::id& loader_id = std::this_thread::get_id());
+        /// @param loader_id Id of the loader of this chunk (used for shared worlds), default: current connection id, or current thread id if not called while processing packets
+        void UnloadAllChunks(const LoaderId loader_id = GetCurrentLoaderId());
 
 
         /// @brief Set block at given pos. Does nothing if pos is not loaded. Thread-safe
@@ -107,32 +134,69 @@ namespace Botcraft
         /// @param id Id of the desired block
         void SetBlock(const Position& pos, const BlockstateId id);
 
-        /// @brief Get the blockstate at a given position. Thread-safe
+        /// @brief Get the blockstate at a given position. Thread-safe, lock-free
         /// @param pos Position of the block
         /// @return A const pointer to the blockstate at position, nullptr if not loaded
         const Blockstate* GetBlock(const Position& pos) const;
 
-        /// @brief Get blockstates for a set of positions. More efficient than calling multiple times GetBlock. Thread-safe
+        /// @brief Get blockstates for a set of positions. More efficient than calling multiple times GetBlock. Thread-safe, lock-free
         /// @param pos Positions of the blocks
         /// @return A vector of const pointer to the blockstate at each position, nullptr if not loaded
         std::vector<const Blockstate*> GetBlocks(const std::vector<Position>& pos) const;
 
-        /// @brief Get all colliders that could collide with a given AABB. Thread-safe
+        /// @brief Get all colliders that could collide with a given AABB. Thread-safe, lock-free
         /// @param aabb AABB of the blocks to search for
         /// @param movement Optional movement vector that will be added to the AABB
         /// @return A vector of solid colliders
         std::vector<AABB> GetColliders(const AABB& aabb, const Vector3<double>& movement = Vector3<double>(0.0)) const;
 
-        /// @brief Get the flow of fluid at a given position
+        /// @brief Get all colliders that could collide with a given AABB, reusing an output buffer. Thread-safe, lock-free
+        /// @param aabb AABB of the blocks to search for
+        /// @param movement Movement vector that will be added to the AABB
+        /// @param output Vector cleared then filled with the solid colliders, its capacity is kept between calls
+        void GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output) const;
+
+        /// @brief Get the flow of fluid at a given position. Thread-safe, lock-free
         /// @param pos Block position
         /// @return A Vector3 of fluid flow
         Vector3<double> GetFlow(const Position& pos);
 
+        /// @brief Find blocks matching a predicate around a position, without looping through
+        /// all the loaded blocks. Thread-safe, lock-free
+        /// @param predicate Function called once per different blockstate found in the searched sections
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned positions
+        /// @param max_count Max number of positions to return
+        /// @return Positions of the matching blocks, sorted by distance to center
+        std::vector<Position> FindBlocks(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius, const size_t max_count = std::numeric_limits<size_t>::max()) const;
+
+        /// @brief Find blocks with a given name around a position. Thread-safe, lock-free
+        /// @param names Names of the blocks to search for (e.g. "minecraft:chest")
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned positions
+        /// @param max_count Max number of positions to return
+        /// @return Positions of the matching blocks, sorted by distance to center
+        std::vector<Position> FindBlocks(const std::unordered_set<std::string>& names, const Position& center, const int radius, const size_t max_count = std::numeric_limits<size_t>::max()) const;
+
+        /// @brief Find the nearest block matching a predicate. Thread-safe, lock-free
+        /// @param predicate Function called once per different blockstate found in the searched sections
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned position
+        /// @return The position of the nearest matching block, or empty if not found
+        std::optional<Position> FindNearest(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius) const;
+
+        /// @brief Find the nearest block with a given name. Thread-safe, lock-free
+        /// @param names Names of the blocks to search for (e.g. "minecraft:chest")
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned position
+        /// @return The position of the nearest matching block, or empty if not found
+        std::optional<Position> FindNearest(const std::unordered_set<std::string>& names, const Position& center, const int radius) const;
+
         /// @brief Get a read-only locked version of all the loaded chunks
-        /// @return Basically an object you can use as a std::unordered_map<std::pair<int, int>, Chunk>*.
+        /// @return Basically an object you can use as a ChunkIndex<Chunk>*.
         /// **ALL WORLD UPDATE WILL BE BLOCKED WHILE THIS OBJECT IS ALIVE**, make sure it goes out of scope
         /// as soon as you don't need it.
-        Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock> GetChunks() const;
+        Utilities::ScopeLockedWrapper<const ChunkIndex<Chunk>, std::shared_mutex, std::shared_lock> GetChunks() const;
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
         /// @brief Set biome of given block column. Does nothing if not loaded. Thread-safe
@@ -254,17 +318,51 @@ namespace Botcraft
         int GetNextWorldInteractionSequenceId();
 #endif
 
-        /// @brief Check if an AABB collides in the world
+        /// @brief Check if an AABB collides in the world. Thread-safe, lock-free
         /// @param aabb AABB to check against the world
         /// @param fluid_collide if true, will count fluids as collision
         /// @return True if collision false otherwise
         bool IsFree(const AABB& aabb, const bool fluid_collide) const;
 
-        /// @brief Get the block position supporting an aabb
+        /// @brief Get the block position supporting an aabb. Thread-safe, lock-free
         /// @param aabb The entity AABB
         /// @return The block position the AABB is on, or empty if no block is found
         std::optional<Position> GetSupportingBlockPos(const AABB& aabb) const;
 
+        /// @brief Get timing statistics about chunk loading. Thread-safe
+        /// @return A copy of the current stats
+        ChunkLoadStats GetChunkLoadStats() const;
+
+        /// @brief Reset chunk loading statistics. Thread-safe
+        void ResetChunkLoadStats();
+
+        /// @brief Get an id unique to this World instance, never reused even after it is destroyed.
+        /// Anything caching data computed from a World should use it rather than its address
+        /// @return This World id, never 0
+        unsigned long long int GetInstanceId() const;
+
+        /// @brief Get the current block revision, incremented each time blocks are
+        /// modified or a chunk is loaded/unloaded. Thread-safe, lock-free
+        /// @return Current block revision
+        unsigned long long int GetBlockRevision() const;
+
+        /// @brief Get the areas modified after a given revision. Thread-safe
+        /// @param revision A revision previously returned by GetBlockRevision
+        /// @param output Cleared then filled with the <min, max> corners (included) of the modified areas
+        /// @return False if the modifications since revision are not all known anymore,
+        /// in which case everything should be considered as modified
+        bool GetBlockChanges(const unsigned long long int revision, std::vector<std::pair<Position, Position> >& output) const;
+
+        /// @brief Decode chunk data in a detached chunk, to be inserted when
+        /// the packet is handled. Called from the decode pool. Thread-safe
+        /// @param msg Parsed message
+        /// @param id Id of the packet, used to find the decoded chunk when it's handled
+        virtual void Prepare(ProtocolCraft::Message& msg, const PreparedPacketId id) override;
+
+        /// @brief Drop data decoded for a packet that will never be handled. Thread-safe
+        /// @param id Id of the prepared packet
+        virtual void DiscardPrepared(const PreparedPacketId id) override;
+
     protected:
         virtual void Handle(ProtocolCraft::ClientboundLoginPacket& msg) override;
         virtual void Handle(ProtocolCraft::ClientboundRespawnPacket& msg) override;
@@ -289,14 +387,31 @@ namespace Botcraft
 
     private:
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-        void LoadChunkImpl(const int x, const int z, const Dimension dim, const std::thread::id& loader_id);
+        void LoadChunkImpl(const int x, const int z, const Dimension dim, const LoaderId loader_id);
 #else
-        void LoadChunkImpl(const int x, const int z, const std::string& dim, const std::thread::id& loader_id);
+        void LoadChunkImpl(const int x, const int z, const std::string& dim, const LoaderId loader_id);
 #endif
-        void UnloadChunkImpl(const int x, const int z, const std::thread::id& loader_id);
+        void UnloadChunkImpl(const int x, const int z, const LoaderId loader_id);
 
         void SetBlockImpl(const Position& pos, const BlockstateId id);
-        const Blockstate* GetBlockImpl(const Position& pos) const;
+        /// @brief Flag a chunk whose blocks have been modified, or which has been added/removed. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        void MarkChunkModified(const int x, const int z);
+
+        /// @brief Add a modified area to the block changes. Not thread-safe
+        /// @param min Min corner of the area
+        /// @param max Max corner of the area
+        void RecordBlockChange(const Position& min, const Position& max);
+        /// @brief Add a whole chunk column to the block changes. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        void RecordChunkChange(const int x, const int z);
+
+        /// @brief Publish new read-only views for all the chunks flagged as modified,
+        /// and free the old views no reader can still be using. Must be called before
+        /// releasing the exclusive world lock after any block modification
+        void PublishTerrainView();
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
         void SetCurrentDimensionImpl(const Dimension dimension);
@@ -355,6 +470,24 @@ namespace Botcraft
         void LoadBiomesInChunk(const int x, const int z, const std::vector<int>& biomes);
 #endif
 
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        /// @brief Decode all the data of a chunk packet in a detached chunk, without modifying the terrain. Thread-safe
+        /// @param msg Chunk packet
+        /// @return The decoded chunk
+        Chunk DecodeChunk(const ProtocolCraft::ClientboundLevelChunkWithLightPacket& msg);
+
+        /// @brief Insert a fully loaded chunk in the terrain, replacing any existing one
+        /// but keeping its loaders if it's in the same dimension. Not thread-safe
+        /// @param x Chunk X
+        /// @param z Chunk Z
+        /// @param chunk Detached chunk to insert
+        /// @param loader_id Id of the loader of this chunk
+        void InsertChunkImpl(const int x, const int z, Chunk&& chunk, const LoaderId loader_id);
+#endif
+
+        /// @brief Add timings of one chunk load to the stats. Thread-safe
+        void RecordChunkLoad(const long long int decode_ns, const long long int lock_wait_ns, const long long int lock_hold_ns);
+
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 719 /* < 1.16 */
         void UpdateChunkLight(const int x, const int z, const Dimension dim, const int light_mask, const int empty_light_mask, const std::vector<std::vector<char> >& data, const bool sky);
 #elif PROTOCOL_VERSION > 718 /* > 1.15.2 */ && PROTOCOL_VERSION < 755 /* < 1.17 */
@@ -365,6 +498,16 @@ namespace Botcraft
             const std::vector<std::vector<char> >& data, const bool sky);
 #endif
 
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 755 /* < 1.17 */
+        /// @brief Load light data into a chunk. Doesn't access the terrain
+        static void LoadLightInChunk(Chunk& chunk, const int light_mask, const int empty_light_mask, const std::vector<std::vector<char> >& data, const bool sky);
+#elif PROTOCOL_VERSION > 754 /* > 1.16.5 */
+        /// @brief Load light data into a chunk. Doesn't access the terrain
+        static void LoadLightInChunk(Chunk& chunk,
+            const std::vector<unsigned long long int>& light_mask, const std::vector<unsigned long long int>& empty_light_mask,
+            const std::vector<std::vector<char> >& data, const bool sky);
+#endif
+
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
         size_t GetDimIndex(const Dimension dim);
 #else
@@ -372,9 +515,50 @@ namespace Botcraft
 #endif
 
     private:
-        std::unordered_map<std::pair<int, int>, Chunk> terrain;
+        ChunkIndex<Chunk> terrain;
         mutable std::shared_mutex world_mutex;
 
+        /// @brief Read-only copy of the terrain blocks, used by block queries
+        /// without taking world_mutex. Replaced with world_mutex held
+        std::atomic<const TerrainView*> terrain_view;
+        /// @brief Owner of the current terrain view
+        std::unique_ptr<TerrainView> published_terrain_view;
+        /// @brief Owner of the current chunk views
+        ChunkIndex<std::unique_ptr<const TerrainChunkView> > published_chunk_views;
+        /// @brief Chunks modified since the last publication
+        std::vector<std::pair<int, int> > modified_chunks;
+        struct RetiredTerrainViews
+        {
+            /// @brief Epoch in which these views have been replaced
+            unsigned long long int epoch;
+            std::unique_ptr<const TerrainView> terrain;
+            std::vector<std::unique_ptr<const TerrainChunkView> > chunks;
+        };
+        /// @brief Replaced views that may still be used by some readers, oldest first
+        std::vector<RetiredTerrainViews> retired_terrain_views;
+
+        /// @brief Last modified areas, block_changes[i] is the change of revision block_changes_start + i + 1
+        std::deque<std::pair<Position, Position> > block_changes;
+        unsigned long long int block_changes_start;
+        std::atomic<unsigned long long int> block_revision;
+        /// @brief Unique id of this instance, see GetInstanceId
+        const unsigned long long int instance_id;
+
+        ChunkLoadStats chunk_load_stats;
+        mutable std::mutex chunk_load_stats_mutex;
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        struct PreparedChunk
+        {
+            Chunk chunk;
+            long long int decode_ns;
+        };
+        /// @brief Chunks decoded on the decode pool, waiting for their packet to be handled.
+        /// Indexed by packet id and not by message address, as messages can be reused
+        std::unordered_map<PreparedPacketId, PreparedChunk> prepared_chunks;
+        std::mutex prepared_chunks_mutex;
+#endif
+
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */ && PROTOCOL_VERSION < 757 /* < 1.18 */
         std::unordered_map<std::pair<int, int>, ProtocolCraft::ClientboundLightUpdatePacket> delayed_light_updates;
 #endif
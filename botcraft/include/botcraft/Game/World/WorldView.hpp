@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "botcraft/Game/Physics/AABB.hpp"
+#include "botcraft/Game/Vector3.hpp"
+#include "botcraft/Utilities/EpochReclamation.hpp"
+
+namespace Botcraft
+{
+    class Blockstate;
+    class Walkability;
+    class World;
+    struct TerrainView;
+    struct TerrainChunkView;
+
+    /// @brief Scoped read access to the blocks of a World, for code reading
+    /// many blocks in a row (pathfinding, physics, area scans...). The view
+    /// is acquired once and the current chunk is cached, so each block
+    /// access costs neither a lock nor a chunk lookup.
+    /// Blocks modified while the view is alive may or may not be seen
+    /// as modified, a view is not a consistent snapshot of the world.
+    /// **Replaced world data can't be freed while a view is alive**, keep
+    /// it short-lived (one task step, one physics tick). Not thread-safe,
+    /// use one view per thread.
+    class WorldView
+    {
+    public:
+        /// @brief Create a view on the current state of a world
+        /// @param world World to read, must outlive the view
+        WorldView(const World& world);
+
+        WorldView(const WorldView&) = delete;
+        WorldView& operator=(const WorldView&) = delete;
+
+        /// @brief Check if a position is in a loaded chunk
+        /// @param pos Block position
+        /// @return True if the chunk is loaded, false otherwise
+        bool IsLoaded(const Position& pos);
+
+        /// @brief Get the blockstate at a given position
+        /// @param pos Position of the block
+        /// @return A const pointer to the blockstate at position, nullptr if not loaded
+        const Blockstate* GetBlock(const Position& pos);
+
+        /// @brief Get the walkability of the block at a given position, without going through its blockstate
+        /// @param pos Position of the block
+        /// @return Walkability of the block, empty if not loaded
+        Walkability GetWalkability(const Position& pos);
+
+        /// @brief Call a function on the 6 blocks sharing a face with a given position
+        /// @param pos Center position
+        /// @param f Function called as f(const Position& neighbour_pos, const Blockstate* neighbour),
+        /// if it returns a bool, false stops the iteration
+        template<class F>
+        void ForEachNeighbour(const Position& pos, F&& f)
+        {
+            static const std::array<Position, 6> offsets = {
+                Position(-1, 0, 0), Position(1, 0, 0),
+                Position(0, -1, 0), Position(0, 1, 0),
+                Position(0, 0, -1), Position(0, 0, 1)
+            };
+            for (const Position& offset : offsets)
+            {
+                const Position neighbour_pos = pos + offset;
+                if (!Call(f, neighbour_pos, GetBlock(neighbour_pos)))
+                {
+                    return;
+                }
+            }
+        }
+
+        /// @brief Call a function on all the blocks of a box, y then z then x
+        /// @param min Min corner of the box, included
+        /// @param max Max corner of the box, included
+        /// @param f Function called as f(const Position& pos, const Blockstate* block),
+        /// if it returns a bool, false stops the iteration
+        template<class F>
+        void ForEachBlockInBox(const Position& min, const Position& max, F&& f)
+        {
+            Position pos;
+            for (pos.y = min.y; pos.y <= max.y; ++pos.y)
+            {
+                for (pos.z = min.z; pos.z <= max.z; ++pos.z)
+                {
+                    for (pos.x = min.x; pos.x <= max.x; ++pos.x)
+                    {
+                        if (!Call(f, pos, GetBlock(pos)))
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+        }
+
+        /// @brief Check if an AABB collides in the world
+        /// @param aabb AABB to check against the world
+        /// @param fluid_collide if true, will count fluids as collision
+        /// @return True if collision false otherwise
+        bool IsFree(const AABB& aabb, const bool fluid_collide);
+
+        /// @brief Get all colliders that could collide with a given AABB
+        /// @param aabb AABB of the blocks to search for
+        /// @param movement Optional movement vector that will be added to the AABB
+        /// @return A vector of solid colliders
+        std::vector<AABB> GetColliders(const AABB& aabb, const Vector3<double>& movement = Vector3<double>(0.0));
+
+        /// @brief Get all colliders that could collide with a given AABB, reusing an output buffer
+        /// @param aabb AABB of the blocks to search for
+        /// @param movement Movement vector that will be added to the AABB
+        /// @param output Vector cleared then filled with the solid colliders, its capacity is kept between calls
+        void GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output);
+
+        /// @brief Get the block position supporting an aabb
+        /// @param aabb The entity AABB
+        /// @return The block position the AABB is on, or empty if no block is found
+        std::optional<Position> GetSupportingBlockPos(const AABB& aabb);
+
+        /// @brief Get the flow of fluid at a given position
+        /// @param pos Block position
+        /// @return A Vector3 of fluid flow
+        Vector3<double> GetFlow(const Position& pos);
+
+        /// @brief Find blocks matching a predicate around a position. Sections are first filtered
+        /// using their palette, so the cost depends on the number of sections that may contain a
+        /// matching block rather than on the searched volume
+        /// @param predicate Function called once per different blockstate found in the searched sections
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned positions
+        /// @param max_count Max number of positions to return
+        /// @return Positions of the matching blocks, sorted by distance to center
+        std::vector<Position> FindBlocks(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius, const size_t max_count = std::numeric_limits<size_t>::max());
+
+        /// @brief Find blocks with a given name around a position
+        /// @param names Names of the blocks to search for (e.g. "minecraft:chest")
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned positions
+        /// @param max_count Max number of positions to return
+        /// @return Positions of the matching blocks, sorted by distance to center
+        std::vector<Position> FindBlocks(const std::unordered_set<std::string>& names, const Position& center, const int radius, const size_t max_count = std::numeric_limits<size_t>::max());
+
+        /// @brief Find the nearest block matching a predicate
+        /// @param predicate Function called once per different blockstate found in the searched sections
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned position
+        /// @return The position of the nearest matching block, or empty if not found
+        std::optional<Position> FindNearest(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius);
+
+        /// @brief Find the nearest block with a given name
+        /// @param names Names of the blocks to search for (e.g. "minecraft:chest")
+        /// @param center Center of the search
+        /// @param radius Max distance between center and returned position
+        /// @return The position of the nearest matching block, or empty if not found
+        std::optional<Position> FindNearest(const std::unordered_set<std::string>& names, const Position& center, const int radius);
+
+    private:
+        template<class F>
+        static bool Call(F& f, const Position& pos, const Blockstate* block)
+        {
+            if constexpr (std::is_same_v<std::invoke_result_t<F&, const Position&, const Blockstate*>, bool>)
+            {
+                return f(pos, block);
+            }
+            else
+            {
+                f(pos, block);
+                return true;
+            }
+        }
+
+        /// @brief Get the view of a chunk, using the cached one if possible
+        const TerrainChunkView* GetChunkView(const int chunk_x, const int chunk_z);
+
+    private:
+        Utilities::EpochReadGuard guard;
+        const TerrainView* terrain;
+
+        bool has_cached_chunk;
+        int cached_chunk_x;
+        int cached_chunk_z;
+        const TerrainChunkView* cached_chunk;
+    };
+} // Botcraft
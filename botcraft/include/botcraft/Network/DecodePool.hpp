@@ -0,0 +1,94 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ProtocolCraft
+{
+    class Message;
+}
+
+namespace Botcraft
+{
+    /// @brief Id given to a packet when it's sent to a DecodePool, unique
+    /// across all connections so data prepared for it can't be mixed up with
+    /// another packet, even if its Message object is reused. 0 is never used
+    using PreparedPacketId = std::uint64_t;
+
+    /// @brief Get a new prepared packet id, different from all the previous ones
+    PreparedPacketId NewPreparedPacketId();
+
+    /// @brief Get the id of the prepared packet being dispatched on this thread
+    /// @return The packet id, 0 if the packet being dispatched has not been prepared
+    PreparedPacketId GetCurrentPreparedPacketId();
+
+    /// @brief Set the id returned by GetCurrentPreparedPacketId on this thread, until destroyed
+    class ScopedPreparedPacketId
+    {
+    public:
+        ScopedPreparedPacketId(const PreparedPacketId id);
+        ~ScopedPreparedPacketId();
+
+        ScopedPreparedPacketId(const ScopedPreparedPacketId&) = delete;
+        ScopedPreparedPacketId& operator=(const ScopedPreparedPacketId&) = delete;
+
+    private:
+        PreparedPacketId previous_id;
+    };
+
+    /// @brief Interface for handlers that can do the heavy part of their
+    /// processing of a packet on a DecodePool worker, before the packet
+    /// is dispatched in order on the network processing thread
+    class PacketPreparer
+    {
+    public:
+        virtual ~PacketPreparer() = default;
+
+        /// @brief Called on a DecodePool worker once msg has been parsed.
+        /// Must be thread-safe and not change any state visible from
+        /// the handlers, as other packets may be dispatched meanwhile.
+        /// When the message is dispatched, GetCurrentPreparedPacketId returns id
+        /// @param msg The parsed message
+        /// @param id Id of the packet
+        virtual void Prepare(ProtocolCraft::Message& msg, const PreparedPacketId id) = 0;
+
+        /// @brief Called on the network processing thread when a prepared
+        /// message will never be dispatched (e.g. connection closed)
+        /// @param id Id of the prepared packet
+        virtual void DiscardPrepared(const PreparedPacketId id) = 0;
+    };
+
+    /// @brief A pool of worker threads used to decode heavy packets
+    /// (chunks, light) outside of the network processing threads.
+    /// The same pool can be shared by any number of NetworkManager
+    class DecodePool
+    {
+    public:
+        /// @brief Start the worker threads
+        /// @param num_threads Number of worker threads, if 0, use the number of hardware threads
+        DecodePool(const size_t num_threads = 0);
+        ~DecodePool();
+
+        /// @brief Queue a task to be run on one of the workers. Tasks are started in submission order
+        /// @param task The task to run
+        void Submit(std::function<void()>&& task);
+
+        size_t GetNumThreads() const;
+
+    private:
+        void Run(const size_t index);
+
+    private:
+        std::vector<std::thread> threads;
+
+        std::queue<std::function<void()> > tasks;
+        std::mutex tasks_mutex;
+        std::condition_variable tasks_condition;
+        bool running;
+    };
+} // Botcraft
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Botcraft
+{
+    /// @brief Id of whatever loaded a chunk in a World, so chunks of
+    /// a World shared by several connections are only unloaded once
+    /// none of them need it anymore. Each NetworkManager has its own, as
+    /// connections using a NetworkPool share their processing threads
+    using LoaderId = std::uint64_t;
+
+    /// @brief Get a new loader id, different from all the previous ones
+    LoaderId NewLoaderId();
+
+    /// @brief Get the loader id of the connection whose packets are being
+    /// processed on this thread, or an id unique to this thread otherwise
+    LoaderId GetCurrentLoaderId();
+
+    /// @brief Set the loader id returned by GetCurrentLoaderId on this thread, until destroyed
+    class ScopedLoaderId
+    {
+    public:
+        ScopedLoaderId(const LoaderId id);
+        ~ScopedLoaderId();
+
+        ScopedLoaderId(const ScopedLoaderId&) = delete;
+        ScopedLoaderId& operator=(const ScopedLoaderId&) = delete;
+
+    private:
+        LoaderId previous_id;
+    };
+} // Botcraft
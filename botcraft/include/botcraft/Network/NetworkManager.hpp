@@ -1,38 +1,65 @@
 #pragma once
 
 #include "protocolCraft/Handler.hpp"
+#include "protocolCraft/MessageFactory.hpp"
 #include "protocolCraft/enums.hpp"
 
+#include <atomic>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <future>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 
+#include "botcraft/Network/DecodePool.hpp"
+#include "botcraft/Network/LoaderId.hpp"
 #if PROTOCOL_VERSION > 759 /* > 1.19 */
 #include "botcraft/Network/LastSeenMessagesTracker.hpp"
 #endif
-#if PROTOCOL_VERSION > 760 /* > 1.19.2 */
-#include <atomic>
-#endif
 
 namespace Botcraft
 {
     class TCP_Com;
     class Authentifier;
+    class NetworkPool;
+    struct ProcessingStrand;
+    class PacketCaptureWriter;
+    class PacketCaptureReader;
 
     class NetworkManager : public ProtocolCraft::Handler
     {
     public:
-        NetworkManager(const std::string& address, const std::string& login, const bool force_microsoft_auth);
+        /// @param address Address to connect to
+        /// @param login Login of the account
+        /// @param force_microsoft_auth If true, use Microsoft auth flow even if login is not empty
+        /// @param decode_pool_ If not null, heavy packets (chunks, light) are decoded on this pool.
+        /// All packets are still dispatched to the handlers in arrival order
+        /// @param capture_path If not empty, all inbound packets are written to a capture file at this path
+        /// @param network_pool_ If not null, the connection runs on one of the pool threads and packets
+        /// are processed there instead of on a dedicated processing thread. Handlers then block all the
+        /// connections sharing this thread while they run, see NetworkPool
+        NetworkManager(const std::string& address, const std::string& login, const bool force_microsoft_auth, const std::shared_ptr<DecodePool>& decode_pool_ = nullptr, const std::string& capture_path = "", const std::shared_ptr<NetworkPool>& network_pool_ = nullptr);
         // Used to create a dummy network manager that does not fire any message
         // but is always in constant_connection_state
         NetworkManager(const ProtocolCraft::ConnectionState constant_connection_state);
+        /// @brief Create a network manager replaying a packet capture instead of connecting to a server.
+        /// Sent packets are dropped. Nothing is processed until StartReplay is called
+        /// @param capture_path Path of a capture written by a NetworkManager compiled with the same protocol version
+        /// @param login Name of the replaying player
+        /// @param decode_pool_ If not null, heavy packets (chunks, light) are decoded on this pool
+        /// @return The replaying network manager, throws std::runtime_error if the capture can't be opened
+        static std::shared_ptr<NetworkManager> FromCapture(const std::string& capture_path, const std::string& login, const std::shared_ptr<DecodePool>& decode_pool_ = nullptr);
         ~NetworkManager();
 
         void Close();
 
         void AddHandler(ProtocolCraft::Handler* h);
+        /// @brief Register a preparer called on the decode pool for heavy packets.
+        /// Must be called from the processing thread (e.g. in a handler) or before connection
+        void AddPreparer(PacketPreparer* p);
         void Send(const std::shared_ptr<ProtocolCraft::Message> msg);
         const ProtocolCraft::ConnectionState GetConnectionState() const;
         const std::string& GetMyName() const;
@@ -40,12 +67,49 @@ namespace Botcraft
         void SendChatMessage(const std::string& message);
         void SendChatCommand(const std::string& command);
 
-        std::thread::id GetProcessingThreadId() const;
+        /// @brief Get the loader id of this connection, returned by
+        /// GetCurrentLoaderId while its packets are processed
+        LoaderId GetLoaderId() const;
+
+        /// @brief Start processing the packets of the capture. Once all packets have been
+        /// processed, the connection state is set to None, as if the server closed the connection
+        /// @param real_time If true, packets are processed with the same timing as when they were captured, otherwise as fast as possible
+        void StartReplay(const bool real_time);
 
     private:
+        // Replay constructor, private as it would be ambiguous with the
+        // (address, login) one for readers, use FromCapture instead
+        NetworkManager(const std::string& capture_path, const std::string& login, const std::shared_ptr<DecodePool>& decode_pool_);
+
         void WaitForNewPackets();
+        /// @brief Processing thread loop when replaying a capture
+        void ReplayCapture(const bool real_time);
+        /// @brief Process a packet as received from the connection, possibly compressed
+        /// @param packet Packet data
+        /// @param decompressed_packet Buffer reused to decompress packets
+        void ProcessRawPacket(std::vector<unsigned char>&& packet, std::vector<unsigned char>& decompressed_packet);
         void ProcessPacket(const std::vector<unsigned char>& packet);
-        void OnNewRawData(const std::vector<unsigned char>& packet);
+        /// @brief Queue a packet received by the TCP connection
+        /// @param data Packet data, only valid during the call
+        /// @param length Packet size
+        void OnNewRawData(const unsigned char* data, const size_t length);
+        /// @brief Process a packet received by the TCP connection, on the processing strand
+        /// @param packet Packet data
+        void ProcessOnStrand(std::vector<unsigned char>& packet);
+
+        /// @brief Check if a packet should be parsed on the decode pool, without decompressing all of it
+        bool IsAsyncDecoded(const std::vector<unsigned char>& packet) const;
+        /// @brief Send a packet to the decode pool and add it to the pending packets
+        void DecodeAsync(std::vector<unsigned char>&& packet);
+        /// @brief Dispatch pending packets in order, waiting for their decoding if needed
+        /// @param max_pending Stop once there are at most max_pending packets left
+        void DispatchPendingPackets(const size_t max_pending);
+        /// @brief Wait for pending packets and drop them without dispatching
+        void DiscardPendingPackets();
+        /// @brief Create a message and read its content from uncompressed packet data
+        static std::shared_ptr<ProtocolCraft::Message> ParsePacket(const std::vector<unsigned char>& packet, const ProtocolCraft::ConnectionState connection_state);
+        /// @brief Read a message content, logging its name if it fails
+        static void ReadMessage(ProtocolCraft::Message& msg, ProtocolCraft::ReadIterator& iter, size_t& length);
 
 
         virtual void Handle(ProtocolCraft::Message& msg) override;
@@ -82,12 +146,30 @@ namespace Botcraft
 
     private:
         std::vector<ProtocolCraft::Handler*> subscribed;
+        std::vector<PacketPreparer*> preparers;
+
+        std::shared_ptr<DecodePool> decode_pool;
+        /// @brief Packets sent to the decode pool, not yet dispatched. Only used by the processing thread
+        std::deque<std::pair<PreparedPacketId, std::future<std::shared_ptr<ProtocolCraft::Message> > > > pending_packets;
+        /// @brief Messages reused for all the packets parsed and dispatched on the processing thread
+        ProtocolCraft::MessagePool message_pool;
 
         std::shared_ptr<TCP_Com> com;
+        /// @brief If not null, inbound packets are written to this capture
+        std::shared_ptr<PacketCaptureWriter> capture_writer;
+        /// @brief If not null, this network manager replays this capture instead of using com
+        std::shared_ptr<PacketCaptureReader> replay_reader;
         std::shared_ptr<Authentifier> authentifier;
         ProtocolCraft::ConnectionState state;
 
         std::thread m_thread_process;//Thread running to process incoming packets without blocking com
+        /// @brief Id of this connection as a chunk loader, set as current loader id while processing packets
+        LoaderId loader_id;
+
+        /// @brief If not null, packets are processed on this strand of a NetworkPool context instead of m_thread_process
+        std::shared_ptr<ProcessingStrand> processing_strand;
+        /// @brief Number of packets posted to processing_strand and not processed yet
+        std::atomic<size_t> queued_packets;
 
         std::queue<std::vector<unsigned char> > packets_to_process;
         std::mutex mutex_process;
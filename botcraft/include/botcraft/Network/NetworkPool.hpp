@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Botcraft
+{
+    struct IOContext;
+
+    /// @brief A pool of network threads shared by many connections.
+    /// Each thread runs its own io context, and new connections are
+    /// assigned to them round-robin. Connections using a pool don't
+    /// have any dedicated thread, their packets are processed on the
+    /// pool threads. The same pool can be shared by any number of
+    /// NetworkManager, it must outlive all of them.
+    /// As packets of all the connections of a thread are processed on
+    /// this thread, anything blocking during the processing of one
+    /// packet delays all these connections. This includes the handlers,
+    /// waiting for the decode pool when too many packets of a connection
+    /// are being decoded, and the synchronous session server request
+    /// made during online mode login. Handlers should post any long
+    /// work elsewhere, and logins on the same pool be spread in time
+    class NetworkPool
+    {
+    public:
+        /// @brief Start the network threads
+        /// @param num_threads Number of threads (and io contexts), if 0, use the number of hardware threads
+        NetworkPool(const size_t num_threads = 0);
+        ~NetworkPool();
+
+        NetworkPool(const NetworkPool&) = delete;
+        NetworkPool& operator=(const NetworkPool&) = delete;
+
+        size_t GetNumThreads() const;
+
+        /// @brief Get the context a new connection should use
+        /// @return The next context, round-robin
+        std::shared_ptr<IOContext> GetNextContext();
+
+    private:
+        std::vector<std::shared_ptr<IOContext> > contexts;
+        std::atomic<size_t> next_context;
+    };
+} // Botcraft
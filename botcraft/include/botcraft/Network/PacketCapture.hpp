@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "protocolCraft/enums.hpp"
+
+namespace Botcraft
+{
+    /// @brief One inbound packet of a capture
+    struct CapturedPacket
+    {
+        /// @brief Time since the start of the capture, in microseconds
+        long long int timestamp_us = 0;
+        /// @brief Connection state when the packet was processed
+        ProtocolCraft::ConnectionState state = ProtocolCraft::ConnectionState::None;
+        /// @brief Decrypted packet data, as framed on the connection (still compressed if compression was enabled)
+        std::vector<unsigned char> data;
+    };
+
+    /// @brief Write the inbound packets of a connection to a capture file.
+    /// Captures are only valid for the protocol version they were recorded with
+    class PacketCaptureWriter
+    {
+    public:
+        /// @brief Create a new capture file, overwriting any existing one
+        /// @param path Path of the file to write
+        PacketCaptureWriter(const std::string& path);
+
+        /// @brief Append a packet to the capture. Thread-safe
+        /// @param state Connection state the packet is processed in
+        /// @param data Packet data
+        void Write(const ProtocolCraft::ConnectionState state, const std::vector<unsigned char>& data);
+
+    private:
+        std::ofstream file;
+        std::mutex file_mutex;
+        std::chrono::steady_clock::time_point start;
+        long long int last_timestamp_us;
+        std::vector<unsigned char> record_buffer;
+    };
+
+    /// @brief Read the packets of a capture file written by PacketCaptureWriter
+    class PacketCaptureReader
+    {
+    public:
+        /// @brief Open a capture file, throw std::runtime_error if it's not a valid capture for this protocol version
+        /// @param path Path of the file to read
+        PacketCaptureReader(const std::string& path);
+
+        /// @brief Read the next packet of the capture
+        /// @param packet Output packet, its data buffer is reused
+        /// @return False if the end of the capture has been reached, true otherwise.
+        /// Throws std::runtime_error if the record is truncated or corrupted
+        bool Read(CapturedPacket& packet);
+
+    private:
+        std::ifstream file;
+        long long int last_timestamp_us;
+    };
+} // Botcraft
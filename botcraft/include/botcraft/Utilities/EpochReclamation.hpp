@@ -0,0 +1,33 @@
+#pragma once
+
+namespace Botcraft::Utilities
+{
+    /// @brief Process-wide epoch based reclamation, used to free data that
+    /// is read without lock once no reader can still be accessing it.
+    /// Each reading thread publishes the epoch it started reading in,
+    /// in its own cache line, so readers never write to shared memory.
+    ///
+    /// Usage:
+    /// - readers keep an EpochReadGuard alive while they access the shared data
+    /// - writers unlink old data, then call RetireEpoch and keep the old data
+    ///   until the returned epoch is lower than GetOldestReadEpoch
+    class EpochReadGuard
+    {
+    public:
+        /// @brief Mark the current thread as reading. Guards can be nested
+        EpochReadGuard();
+        ~EpochReadGuard();
+
+        EpochReadGuard(const EpochReadGuard&) = delete;
+        EpochReadGuard& operator=(const EpochReadGuard&) = delete;
+    };
+
+    /// @brief Advance the global epoch. Must be called after the retired data
+    /// has been unlinked, readers starting after this call can't access it
+    /// @return The epoch the retired data belongs to
+    unsigned long long int RetireEpoch();
+
+    /// @brief Get the epoch of the oldest reader still running
+    /// @return Any data retired in an epoch strictly lower than the returned value can be freed
+    unsigned long long int GetOldestReadEpoch();
+} // Botcraft::Utilities
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace Botcraft::Utilities
+{
+    /// @brief A function running on its own stack, that can suspend itself
+    /// and be resumed later without any OS thread. Switching in and out of a
+    /// fiber only saves and restores registers, it doesn't involve the scheduler.
+    /// A fiber should always be resumed from the same thread, as thread_local
+    /// data used before a suspension would otherwise change under its feet.
+    class Fiber
+    {
+    public:
+        /// @brief Default size of a fiber stack, in bytes. Same as the default
+        /// main thread stack on Linux. Pages are only committed when touched,
+        /// so a big stack costs address space, not memory
+        static constexpr size_t default_stack_size = 8 * 1024 * 1024;
+
+        /// @brief Create a fiber, nothing is run until the first call to Resume
+        /// @param function_ Function to run in the fiber. It must not throw,
+        /// exceptions escaping from it are logged and swallowed
+        /// @param stack_size Size of the fiber stack, in bytes. Unlike a thread
+        /// stack, it can't grow: a deeper recursion hits a guard page and
+        /// crashes the process with a segmentation fault instead of silently
+        /// corrupting memory. Throws a std::runtime_error if the stack can't be allocated
+        Fiber(std::function<void()>&& function_, const size_t stack_size = default_stack_size);
+        /// @brief Free the fiber stack. If the fiber is started and not finished,
+        /// the objects on its stack are **not** destroyed
+        ~Fiber();
+
+        Fiber(const Fiber&) = delete;
+        Fiber& operator=(const Fiber&) = delete;
+
+        /// @brief Run the fiber until it suspends itself or its function returns.
+        /// Does nothing if the fiber is finished
+        /// @return True if the fiber function has returned, false otherwise
+        bool Resume();
+
+        /// @brief Suspend the fiber currently running on this thread, returning
+        /// from the Resume call that started it. Throws a std::runtime_error if
+        /// not called from a fiber
+        static void Suspend();
+
+        /// @brief Get the fiber currently running on this thread
+        /// @return A pointer to the running fiber, nullptr if not called from a fiber
+        static Fiber* GetCurrent();
+
+        bool IsStarted() const;
+        bool IsFinished() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl;
+    };
+} // Botcraft::Utilities
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <type_traits>
+
+/// @brief Index in Entity::metadata of one of the current class metadata, computed at compile time from its name in metadata_names.
+/// Only usable in Entity subclasses member functions
+#define METADATA_INDEX(name) std::integral_constant<int, hierarchy_metadata_count + MetadataIndex(metadata_names, name)>::value
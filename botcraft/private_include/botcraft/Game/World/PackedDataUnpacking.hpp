@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Botcraft
+{
+    /// @brief Unpack entries from a packed long array, using the 1.16+ layout
+    /// (entries never span across two longs, first entry in the lowest bits).
+    /// Each bits per entry value uses a dedicated kernel with compile-time
+    /// shifts and masks, so the inner loop has no branch
+    /// @param data Packed long array
+    /// @param num_longs Number of longs in data
+    /// @param bits_per_entry Number of bits of each entry, in [1, 16]
+    /// @param out Output array, must have room for count entries
+    /// @param count Number of entries to unpack
+    /// @return False if bits_per_entry is not supported or data is too short, true otherwise
+    bool UnpackEntries(const unsigned long long int* data, const size_t num_longs, const unsigned char bits_per_entry, unsigned short* out, const size_t count);
+
+    /// @brief Clamp all entries to a max value, without branching
+    /// @param values Values to clamp
+    /// @param count Number of values
+    /// @param max_value Max allowed value
+    void ClampEntries(unsigned short* values, const size_t count, const unsigned short max_value);
+} // Botcraft
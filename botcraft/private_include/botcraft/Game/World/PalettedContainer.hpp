@@ -0,0 +1,102 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace Botcraft
+{
+    /// @brief Compact storage for a fixed number of small unsigned values.
+    /// Values are stored either as a single value (0 bit per entry),
+    /// as indices in a local palette (1, 2, 4 or 8 bits per entry)
+    /// or directly (direct_bits per entry). Bits per entry are always
+    /// a power of two so entries never span across two longs and
+    /// accesses are only shifts and masks. Storage automatically grows
+    /// when a new value doesn't fit in the current palette.
+    class PalettedContainer
+    {
+    public:
+        /// @brief Create a single value container
+        /// @param size_ Number of entries in the container
+        /// @param max_palette_bits_ Max bits per entry using a local palette. Above, values are stored directly
+        /// @param direct_bits_ Bits per entry when values are stored directly. Must be a power of two
+        /// @param default_value Initial value of all the entries
+        PalettedContainer(const size_t size_, const unsigned char max_palette_bits_, const unsigned char direct_bits_, const unsigned short default_value = 0);
+
+        /// @brief Get the value of an entry. Index is not checked
+        /// @param index Index of the entry
+        /// @return Value stored at index
+        unsigned short Get(const size_t index) const;
+
+        /// @brief Set the value of an entry, resizing the storage if required. Index is not checked
+        /// @param index Index of the entry
+        /// @param value Value to set
+        void Set(const size_t index, const unsigned short value);
+
+        /// @brief Set all entries to a single value, releasing the packed storage
+        /// @param value Value to set
+        void Fill(const unsigned short value);
+
+        /// @brief Clear the container and prepare it to receive values from a given palette
+        /// @param values Palette values. All entries are set to values[0]
+        void Reset(const std::vector<unsigned short>& values);
+
+        /// @brief Clear the container and switch to direct storage. All entries are set to 0
+        void ResetDirect();
+
+        /// @brief Store raw entries for a range of consecutive indices, packing full longs at once.
+        /// Raw entries are indices in the palette given to Reset (if it fits in max_palette_bits),
+        /// or values if storage is direct. Storage never grows and raw entries are not checked
+        /// @param start Index of the first entry to set
+        /// @param raw Raw entries to store
+        /// @param count Number of entries to store
+        void SetRawRange(const size_t start, const unsigned short* raw, const size_t count);
+
+        /// @brief Replace all the entries with direct values already packed as little-endian
+        /// bytes in the storage layout (e.g. a nibble array for 4 bits values)
+        /// @param bytes Packed values
+        /// @param num_bytes Number of bytes, must be size * direct_bits / 8
+        void LoadDirectPacked(const unsigned char* bytes, const size_t num_bytes);
+
+        /// @brief Check if the container may hold a value matching a predicate, looking only at the palette.
+        /// Overwritten values stay in the palette until the next Fill/Reset, so this can return
+        /// true for values not stored anymore. Always true if values are stored directly
+        /// @param predicate Function called once per palette value
+        /// @return False if no entry can match, true otherwise
+        bool MayContain(const std::function<bool(const unsigned short)>& predicate) const;
+
+        /// @brief Get the indices of all the entries matching a predicate
+        /// @param predicate Function called once per palette value, or once per entry if values are stored directly
+        /// @return Indices of the matching entries, in increasing order
+        std::vector<size_t> FindAll(const std::function<bool(const unsigned short)>& predicate) const;
+
+        /// @brief Get the number of entries in the container
+        size_t GetSize() const;
+
+        /// @brief Get the current number of bits per entry
+        /// @return 0 if single value, direct_bits if values are stored directly
+        unsigned char GetBitsPerEntry() const;
+
+        /// @brief Check if all entries share the same value
+        bool IsSingleValue() const;
+
+        /// @brief Get the number of bytes allocated by this container (excluding sizeof(PalettedContainer))
+        size_t GetMemoryFootprint() const;
+
+    private:
+        bool IsDirect() const;
+        unsigned short GetRaw(const size_t index) const;
+        void SetRaw(const size_t index, const unsigned short raw);
+        /// @brief Change bits per entry, repacking all the existing entries
+        /// @param new_bits New bits per entry, switch to direct storage if > max_palette_bits
+        void Resize(unsigned char new_bits);
+
+    private:
+        size_t size;
+        unsigned char max_palette_bits;
+        unsigned char direct_bits;
+        unsigned char bits_per_entry;
+        unsigned short value_mask;
+        std::vector<unsigned short> palette;
+        std::vector<unsigned long long int> data;
+    };
+} // Botcraft
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include "botcraft/Game/World/PalettedContainer.hpp"
 
 namespace Botcraft
 {
@@ -12,9 +12,12 @@ namespace Botcraft
 
         static size_t CoordsToBlockIndex(const int x, const int y, const int z);
         static size_t CoordsToLightIndex(const int x, const int y, const int z);
+        /// @brief Get the coordinates in the section of a block index
+        /// @return False if the index is not a block of this section (neighbour border), true otherwise
+        static bool BlockIndexToCoords(const size_t index, int& x, int& y, int& z);
 
-        std::vector<unsigned short> data_blocks;
-        std::vector<unsigned char> block_light;
-        std::vector<unsigned char> sky_light;
+        PalettedContainer data_blocks;
+        PalettedContainer block_light;
+        PalettedContainer sky_light;
     };
 } // Botcraft
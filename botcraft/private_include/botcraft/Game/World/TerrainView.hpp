@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "botcraft/Game/World/Blockstate.hpp"
+#include "botcraft/Game/World/ChunkIndex.hpp"
+
+namespace Botcraft
+{
+    struct Section;
+
+    /// @brief Read-only view of the blocks of one chunk. Sections are
+    /// shared with the Chunk, which copies them before any block
+    /// modification, so they are never modified once in a view
+    struct TerrainChunkView
+    {
+        int min_y;
+        int height;
+        std::vector<std::shared_ptr<const Section> > sections;
+
+        /// @brief Get the blockstate at a given position
+        /// @param pos Position of the block, in chunk coordinates (x and z in [0, CHUNK_WIDTH[)
+        /// @return A const pointer to the blockstate at position, nullptr if outside of the chunk or in an empty section
+        const Blockstate* GetBlock(const Position& pos) const;
+
+        /// @brief Get the walkability of the block at a given position, see AssetsManager::GetWalkability
+        /// @param pos Position of the block, in chunk coordinates (x and z in [0, CHUNK_WIDTH[)
+        /// @return Walkability of the block, empty if outside of the chunk or in an empty section
+        Walkability GetWalkability(const Position& pos) const;
+
+        /// @brief Get the blockstate corresponding to a value stored in a section
+        /// @param stored_id Value stored in the section data_blocks
+        /// @return A const pointer to the blockstate
+        static const Blockstate* GetBlockstate(const unsigned short stored_id);
+    };
+
+    /// @brief Read-only view of the blocks of the whole terrain, published by
+    /// World after each modification and read without lock. The set of chunks
+    /// is immutable, a chunk view can be atomically replaced by a new one
+    struct TerrainView
+    {
+        ChunkIndex<std::atomic<const TerrainChunkView*> > chunks;
+    };
+} // Botcraft
@@ -2,6 +2,7 @@
 
 #ifdef USE_ENCRYPTION
 
+#include <cstddef>
 #include <vector>
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include <string>
@@ -50,6 +51,10 @@ namespace Botcraft
 #endif
         std::vector<unsigned char> Encrypt(const std::vector<unsigned char>& in);
         std::vector<unsigned char> Decrypt(const std::vector<unsigned char>& in);
+        /// @brief Decrypt data without copying them. As AES/CFB8 is a stream cipher, output has the same size as input
+        /// @param data Data to decrypt, replaced by the decrypted data
+        /// @param size Number of bytes to decrypt
+        void DecryptInPlace(unsigned char* data, const size_t size);
 
     private:
         EVP_CIPHER_CTX* encryption_context;
@@ -1,11 +1,46 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 namespace Botcraft
 {
 #ifdef USE_COMPRESSION
-    std::vector<unsigned char> Compress(const std::vector<unsigned char>& raw);
-    std::vector<unsigned char> Decompress(const std::vector<unsigned char>& compressed, const int start = 0);
+    // All these functions reuse zlib streams kept for the calling thread
+    // instead of creating new ones for each packet. As each connection is
+    // processed on its own thread, this is one stream per connection, plus
+    // one per decode pool thread
+
+    /// @brief Compress data and append them to a buffer
+    /// @param raw Data to compress
+    /// @param out Buffer the compressed data are appended to
+    void Compress(const std::vector<unsigned char>& raw, std::vector<unsigned char>& out);
+    /// @brief Decompress data whose decompressed size is known, directly in the output buffer
+    /// @param compressed Compressed data
+    /// @param compressed_size Number of compressed bytes
+    /// @param out Output buffer, must be at least decompressed_size long
+    /// @param decompressed_size Expected decompressed size, an exception is thrown if the actual size is different
+    void Decompress(const unsigned char* compressed, const size_t compressed_size, unsigned char* out, const size_t decompressed_size);
+    /// @brief Decompress a received packet in a reused buffer. The decompressed size
+    /// sent by the server is checked before allocating anything, and the buffer
+    /// memory is released if a previous packet made it grow too much
+    /// @param compressed Compressed data
+    /// @param compressed_size Number of compressed bytes
+    /// @param decompressed_size Decompressed size sent with the packet, an exception is thrown if it's invalid
+    /// @param threshold Compression threshold of the connection, smaller packets are never compressed
+    /// @param buffer Buffer the packet is decompressed in, resized to decompressed_size
+    void DecompressPacket(const unsigned char* compressed, const size_t compressed_size, const int decompressed_size, const int threshold, std::vector<unsigned char>& buffer);
+    /// @brief Decompress data whose decompressed size is known
+    /// @param compressed Compressed data
+    /// @param start Index of the first compressed byte
+    /// @param decompressed_size Expected decompressed size, an exception is thrown if the actual size is different
+    /// @return Decompressed data
+    std::vector<unsigned char> Decompress(const std::vector<unsigned char>& compressed, const int start, const size_t decompressed_size);
+    /// @brief Decompress only the first bytes of compressed data
+    /// @param compressed Compressed data
+    /// @param start Index of the first compressed byte
+    /// @param max_size Maximum number of decompressed bytes to return
+    /// @return At most max_size first bytes of the decompressed data
+    std::vector<unsigned char> DecompressPrefix(const std::vector<unsigned char>& compressed, const int start, const size_t max_size);
 #endif
 } // Botcraft
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <asio/io_service.hpp>
+
+namespace Botcraft
+{
+    /// @brief An io_service and the thread running it. Shared by all the
+    /// connections of a NetworkPool, or owned by a single TCP_Com
+    struct IOContext
+    {
+        asio::io_service io_service;
+        /// @brief If not null, keep the thread running even without any connection
+        std::unique_ptr<asio::io_service::work> work;
+        std::thread thread;
+    };
+} // Botcraft
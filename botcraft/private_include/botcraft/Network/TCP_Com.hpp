@@ -1,6 +1,8 @@
 #pragma once
 
 #include <deque>
+#include <functional>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <asio/error_code.hpp>
@@ -12,12 +14,23 @@ namespace Botcraft
 #ifdef USE_ENCRYPTION
     class AESEncrypter;
 #endif
+    struct IOContext;
 
     class TCP_Com
     {
     public:
+        /// @brief Connect to a server
+        /// @param address Server address, with or without port
+        /// @param callback Function called on the network thread for each received packet, with
+        /// a pointer to the packet data (without the length prefix) and its size. Data point directly
+        /// in the receive buffer and are only valid during the call
+        /// @param context_ If not null, shared context running this connection. Otherwise a
+        /// context and its thread are created for this connection only
         TCP_Com(const std::string& address,
-            std::function<void(const std::vector<unsigned char>&)> callback);
+            std::function<void(const unsigned char*, const size_t)> callback,
+            const std::shared_ptr<IOContext>& context_ = nullptr);
+        /// @brief With a shared context, close the connection and wait for all its pending
+        /// handlers to complete. Must not be called from a handler running on this context
         ~TCP_Com();
 
         void close();
@@ -34,6 +47,9 @@ namespace Botcraft
 
         void handle_connect(const asio::error_code& error);
 
+        /// @brief Start an asynchronous read at the end of the receive buffer, making room if needed
+        void do_read();
+
         void handle_read(const asio::error_code& error, std::size_t bytes_transferred);
 
         void do_write(const std::vector<unsigned char>& msg);
@@ -46,17 +62,22 @@ namespace Botcraft
 
 
     private:
-        // io_service must be declared before socket
-        asio::io_service io_service;
+        // context must be declared before socket
+        std::shared_ptr<IOContext> context;
+        /// @brief True if context has been created for this connection only
+        bool owns_context;
         asio::ip::tcp::socket socket;
 
-        std::thread thread_com;
-
-        std::array<unsigned char, 512> read_msg;
-        std::vector<unsigned char> input_msg;
+        /// @brief Received bytes, reused for all reads. Bytes in [input_start, input_end[
+        /// are received but not part of a complete packet yet
+        std::vector<unsigned char> input_buffer;
+        size_t input_start;
+        size_t input_end;
+        /// @brief Total size of the incomplete packet at input_start if known, 0 otherwise
+        size_t pending_packet_size;
         std::deque<std::vector<unsigned char> > output_msg;
 
-        std::function<void(const std::vector<unsigned char>&)> NewPacketCallback;
+        std::function<void(const unsigned char*, const size_t)> NewPacketCallback;
         std::mutex mutex_output;
 
         std::string ip;
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Botcraft::Utilities
+{
+    /// @brief Counters shared by all the BlockPool, whatever their block size
+    struct BlockPoolCounters
+    {
+        /// @brief Number of blocks currently allocated
+        std::atomic<size_t> num_in_use = 0;
+        /// @brief Number of allocations that got a block freed by a previous deallocation
+        std::atomic<size_t> num_reused = 0;
+        /// @brief Number of blocks allocated from the system
+        std::atomic<size_t> num_blocks = 0;
+
+        static BlockPoolCounters& GetInstance()
+        {
+            static BlockPoolCounters counters;
+            return counters;
+        }
+    };
+
+    /// @brief Free list of fixed size blocks, allocated by slabs.
+    /// Memory is never given back, so the pool size is the peak
+    /// number of blocks used at the same time.
+    template<size_t BlockSize, size_t Alignment>
+    class BlockPool
+    {
+    public:
+        static constexpr size_t blocks_per_slab = 64;
+
+        /// @brief Get the pool for this block size. Intentionally leaked
+        /// as blocks can be freed by objects destroyed at exit
+        static BlockPool& GetInstance()
+        {
+            static BlockPool* instance = new BlockPool();
+            return *instance;
+        }
+
+        void* Allocate()
+        {
+            std::scoped_lock<std::mutex> lock(pool_mutex);
+            if (free_list == nullptr)
+            {
+                AddSlab();
+            }
+            else if (num_freed > 0)
+            {
+                // Freed blocks are always on top of the blocks never used
+                num_freed -= 1;
+                BlockPoolCounters::GetInstance().num_reused += 1;
+            }
+            BlockPoolCounters::GetInstance().num_in_use += 1;
+            FreeBlock* block = free_list;
+            free_list = block->next;
+            return block;
+        }
+
+        void Deallocate(void* p)
+        {
+            std::scoped_lock<std::mutex> lock(pool_mutex);
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = free_list;
+            free_list = block;
+            num_freed += 1;
+            BlockPoolCounters::GetInstance().num_in_use -= 1;
+        }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        static constexpr size_t alignment = Alignment < alignof(FreeBlock) ? alignof(FreeBlock) : Alignment;
+        static constexpr size_t block_size = ((BlockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : BlockSize) + alignment - 1) / alignment * alignment;
+
+        BlockPool() : free_list(nullptr), num_freed(0) {}
+
+        void AddSlab()
+        {
+            unsigned char* slab = static_cast<unsigned char*>(::operator new(block_size * blocks_per_slab, std::align_val_t(alignment)));
+            slabs.push_back(slab);
+            // Push in reverse order so blocks are given in address order
+            for (size_t i = blocks_per_slab; i-- > 0;)
+            {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * block_size);
+                block->next = free_list;
+                free_list = block;
+            }
+            BlockPoolCounters::GetInstance().num_blocks += blocks_per_slab;
+        }
+
+    private:
+        std::mutex pool_mutex;
+        FreeBlock* free_list;
+        /// @brief Number of blocks in free_list that have already been used
+        size_t num_freed;
+        std::vector<unsigned char*> slabs;
+    };
+
+    /// @brief Allocator using one BlockPool per allocated size. Meant to be used
+    /// with std::allocate_shared for objects created and destroyed very often,
+    /// the object and its control block then share one pooled block.
+    /// This block is only given back once the last weak_ptr is destroyed too.
+    /// Array allocations fall back to the default allocator.
+    template<typename T>
+    class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+        template<typename U>
+        PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+        T* allocate(const size_t n)
+        {
+            if (n == 1)
+            {
+                return static_cast<T*>(BlockPool<sizeof(T), alignof(T)>::GetInstance().Allocate());
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, const size_t n) noexcept
+        {
+            if (n == 1)
+            {
+                BlockPool<sizeof(T), alignof(T)>::GetInstance().Deallocate(p);
+                return;
+            }
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const PoolAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const PoolAllocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+} // Botcraft::Utilities
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <string>
+
+#include "botcraft/AI/BehaviourExecutor.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+#include "botcraft/Utilities/SleepUtilities.hpp"
+
+namespace Botcraft
+{
+    BehaviourExecutor::BehaviourExecutor(const size_t num_threads, const std::chrono::steady_clock::duration step_period_, const size_t fiber_stack_size_) :
+        step_period(step_period_), fiber_stack_size(fiber_stack_size_), next_thread(0)
+    {
+        next_id = 1;
+        running = true;
+
+        const size_t num_workers = num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : num_threads;
+        added_steps.resize(num_workers);
+        threads.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            threads.emplace_back(&BehaviourExecutor::Run, this, i);
+        }
+    }
+
+    BehaviourExecutor::~BehaviourExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(steps_mutex);
+            running = false;
+        }
+
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    size_t BehaviourExecutor::Add(std::function<bool()>&& step)
+    {
+        std::lock_guard<std::mutex> lock(steps_mutex);
+        const size_t id = next_id++;
+        active_ids.insert(id);
+        added_steps[next_thread.fetch_add(1, std::memory_order_relaxed) % threads.size()].emplace_back(id, std::move(step));
+        return id;
+    }
+
+    void BehaviourExecutor::WaitRemoved(const size_t id)
+    {
+        std::unique_lock<std::mutex> lock(steps_mutex);
+        removed_condition.wait(lock, [this, id]() { return active_ids.count(id) == 0; });
+    }
+
+    size_t BehaviourExecutor::GetNumThreads() const
+    {
+        return threads.size();
+    }
+
+    size_t BehaviourExecutor::GetFiberStackSize() const
+    {
+        return fiber_stack_size;
+    }
+
+    void BehaviourExecutor::Run(const size_t index)
+    {
+        Logger::GetInstance().RegisterThread("BehaviourExecutor - " + std::to_string(index));
+
+        // Only accessed by this thread
+        std::vector<std::pair<size_t, std::function<bool()> > > steps;
+        while (true)
+        {
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + step_period;
+            {
+                std::lock_guard<std::mutex> lock(steps_mutex);
+                if (!running)
+                {
+                    break;
+                }
+                for (auto& s : added_steps[index])
+                {
+                    steps.push_back(std::move(s));
+                }
+                added_steps[index].clear();
+            }
+
+            std::vector<size_t> removed_ids;
+            for (auto it = steps.begin(); it != steps.end();)
+            {
+                bool keep = false;
+                try
+                {
+                    keep = it->second();
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Exception in behaviour executor step: " << e.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("Unknown exception in behaviour executor step");
+                }
+
+                if (keep)
+                {
+                    ++it;
+                }
+                else
+                {
+                    removed_ids.push_back(it->first);
+                    it = steps.erase(it);
+                }
+            }
+
+            if (!removed_ids.empty())
+            {
+                {
+                    std::lock_guard<std::mutex> lock(steps_mutex);
+                    for (const size_t id : removed_ids)
+                    {
+                        active_ids.erase(id);
+                    }
+                }
+                removed_condition.notify_all();
+            }
+
+            Utilities::SleepUntil(end);
+        }
+
+        // Remaining steps are dropped, don't let anyone wait for them
+        {
+            std::lock_guard<std::mutex> lock(steps_mutex);
+            for (const auto& s : steps)
+            {
+                active_ids.erase(s.first);
+            }
+            for (const auto& s : added_steps[index])
+            {
+                active_ids.erase(s.first);
+            }
+            added_steps[index].clear();
+        }
+        removed_condition.notify_all();
+    }
+} // Botcraft
@@ -0,0 +1,675 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+#include "botcraft/AI/HierarchicalPathfinder.hpp"
+#include "botcraft/Game/World/Blockstate.hpp"
+#include "botcraft/Game/World/World.hpp"
+#include "botcraft/Game/World/WorldView.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+        constexpr int infinite_cost = std::numeric_limits<int>::max();
+
+        /// @brief Above this number of sections, the graph is cleared before the next search
+        constexpr size_t max_sections = 2048;
+        /// @brief The high-level search stops once closer than this to the end
+        constexpr int direct_distance = 32;
+        /// @brief Consecutive waypoints closer than this are merged in a single leg
+        constexpr int max_leg_distance = 32;
+        /// @brief Tolerance when refining a leg, the block-level search can
+        /// end one block above or below a waypoint (slabs, carpets...)
+        constexpr int leg_tolerance = 2;
+        /// @brief Max number of legs that can fail before giving up
+        constexpr int max_replans = 4;
+
+        // Blocks read to compute the portals of a section, relative to its origin.
+        // One block around horizontally, and enough vertically for all the moves
+        constexpr int grid_min_xz = -1;
+        constexpr int grid_size_xz = 18;
+        constexpr int grid_min_y = -4;
+        constexpr int grid_size_y = 22;
+
+        enum BlockFlags : uint8_t
+        {
+            Passable = 1 << 0,
+            Support = 1 << 1,
+            Climbable = 1 << 2
+        };
+
+        /// @brief Simplified version of the block-level classification, portals
+        /// only need to know where a player can walk, not the exact moves
+        uint8_t Classify(const Walkability block, const bool takes_damage)
+        {
+            if (takes_damage && block.IsHazardous())
+            {
+                return 0;
+            }
+            switch (block.GetKind())
+            {
+            case Walkability::Kind::Fluid:
+            case Walkability::Kind::Climbable:
+                return Passable | Climbable;
+            case Walkability::Kind::Solid:
+                // Fences and walls can't be walked on
+                return block.GetTopHeight() > 1.25f ? 0 : Support;
+            default:
+                return Passable;
+            }
+        }
+
+        int Distance(const Position& a, const Position& b)
+        {
+            return std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z);
+        }
+
+        uint64_t SectionKey(const int section_x, const int section_y, const int section_z)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(section_x) & 0x3FFFFF) << 42) |
+                (static_cast<uint64_t>(static_cast<uint32_t>(section_z) & 0x3FFFFF) << 20) |
+                (static_cast<uint64_t>(static_cast<uint32_t>(section_y) & 0xFFFFF));
+        }
+
+        uint64_t SectionKey(const Position& pos)
+        {
+            return SectionKey(pos.x >> 4, pos.y >> 4, pos.z >> 4);
+        }
+
+        /// @brief Index of a block in a section, same layout as the PathfindingEngine pages
+        uint16_t LocalIndex(const int x, const int y, const int z)
+        {
+            return static_cast<uint16_t>((x << 8) | (z << 4) | y);
+        }
+
+        bool IsInside(const int x, const int y, const int z)
+        {
+            return x >= 0 && x < 16 && y >= 0 && y < 16 && z >= 0 && z < 16;
+        }
+
+        /// @brief Walkable graph of the blocks read for a section
+        class Grid
+        {
+        public:
+            Grid(const uint8_t* flags_) : flags(flags_) {}
+
+            static size_t Index(const int x, const int y, const int z)
+            {
+                return ((x - grid_min_xz) * grid_size_xz + (z - grid_min_xz)) * grid_size_y + (y - grid_min_y);
+            }
+
+            bool Has(const int x, const int y, const int z, const uint8_t flag) const
+            {
+                return flags[Index(x, y, z)] & flag;
+            }
+
+            /// @brief Check if a player can stand with their feet in a block
+            bool IsStandable(const int x, const int y, const int z) const
+            {
+                return Has(x, y, z, Passable) && Has(x, y + 1, z, Passable) &&
+                    (Has(x, y - 1, z, Support) || Has(x, y, z, Climbable) || Has(x, y - 1, z, Climbable));
+            }
+
+            /// @brief Call f(x, y, z, cost, direction) for each block reachable from x, y, z.
+            /// x, y, z must be in the section, reached blocks may be outside
+            template<class F>
+            void ForEachMove(const int x, const int y, const int z, F&& f) const
+            {
+                static const std::array<std::pair<int, int>, 4> offsets = { std::make_pair(1, 0), std::make_pair(-1, 0), std::make_pair(0, 1), std::make_pair(0, -1) };
+
+                // Climbing up and down
+                if (Has(x, y, z, Climbable) && IsStandable(x, y + 1, z))
+                {
+                    f(x, y + 1, z, 1, 4);
+                }
+                if (Has(x, y - 1, z, Climbable) && IsStandable(x, y - 1, z))
+                {
+                    f(x, y - 1, z, 1, 5);
+                }
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    const int nx = x + offsets[i].first;
+                    const int nz = z + offsets[i].second;
+                    if (IsStandable(nx, y, nz))
+                    {
+                        f(nx, y, nz, 1, i);
+                        continue;
+                    }
+                    if (Has(x, y + 2, z, Passable) && IsStandable(nx, y + 1, nz))
+                    {
+                        f(nx, y + 1, nz, 2, i);
+                        continue;
+                    }
+                    if (!Has(nx, y, nz, Passable) || !Has(nx, y + 1, nz, Passable))
+                    {
+                        continue;
+                    }
+                    // Falls up to 3 blocks
+                    for (int k = 1; k <= 3; ++k)
+                    {
+                        if (IsStandable(nx, y - k, nz))
+                        {
+                            f(nx, y - k, nz, 1 + k, i);
+                            break;
+                        }
+                        if (!Has(nx, y - k, nz, Passable))
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+
+        private:
+            const uint8_t* flags;
+        };
+    }
+
+    struct HierarchicalPathfinder::Exit
+    {
+        /// @brief Block in the section
+        Position from;
+        /// @brief Block in the neighbouring section
+        Position to;
+        int cost;
+        /// @brief Set when the block-level search failed to follow this exit
+        bool blocked;
+    };
+
+    struct HierarchicalPathfinder::Section
+    {
+        /// @brief Position of the first block of the section
+        Position origin;
+        /// @brief Flags of all the blocks read to build this section, see Grid
+        std::vector<uint8_t> flags;
+        /// @brief One exit for each group of adjacent blocks leading to the same section
+        std::vector<Exit> exits;
+        /// @brief Cost to reach each exit, computed on demand for each start block
+        std::unordered_map<uint16_t, std::vector<std::pair<uint32_t, int> > > exit_costs;
+    };
+
+    struct HierarchicalPathfinder::RouteNode
+    {
+        Position pos;
+        int cost;
+        uint32_t parent;
+        /// @brief Exit that led to this node
+        uint64_t exit_section;
+        uint32_t exit;
+        bool closed;
+    };
+
+    HierarchicalPathfinder::HierarchicalPathfinder() :
+        // Legs are often requested again as the bot moves along them, so they are cached
+        engine(PathfindingEngine::default_budget, 16, true)
+    {
+        min_distance = default_min_distance;
+        budget = default_budget;
+        last_visit_count = 0;
+        graph_world_id = 0;
+        graph_takes_damage = false;
+        graph_revision = 0;
+        min_y = 0;
+        max_y = 0;
+        world_view = nullptr;
+    }
+
+    HierarchicalPathfinder::~HierarchicalPathfinder()
+    {
+
+    }
+
+    PathfindingEngine& HierarchicalPathfinder::GetEngine()
+    {
+        return engine;
+    }
+
+    int HierarchicalPathfinder::GetMinDistance() const
+    {
+        return min_distance;
+    }
+
+    void HierarchicalPathfinder::SetMinDistance(const int min_distance_)
+    {
+        min_distance = min_distance_;
+    }
+
+    size_t HierarchicalPathfinder::GetBudget() const
+    {
+        return budget;
+    }
+
+    void HierarchicalPathfinder::SetBudget(const size_t budget_)
+    {
+        budget = budget_;
+    }
+
+    void HierarchicalPathfinder::Clear()
+    {
+        sections.clear();
+        graph_world_id = 0;
+    }
+
+    size_t HierarchicalPathfinder::GetNumSections() const
+    {
+        return sections.size();
+    }
+
+    size_t HierarchicalPathfinder::GetLastVisitCount() const
+    {
+        return last_visit_count;
+    }
+
+    const std::vector<Position>& HierarchicalPathfinder::GetLastWaypoints() const
+    {
+        return last_waypoints;
+    }
+
+    std::vector<std::pair<Position, float>> HierarchicalPathfinder::FindPath(const World& world, const bool takes_damage, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump)
+    {
+        last_visit_count = 0;
+        last_waypoints.clear();
+        if (Distance(start, end) < min_distance)
+        {
+            return engine.FindPath(world, takes_damage, start, end, dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump);
+        }
+
+        Update(world, takes_damage);
+
+        std::vector<std::pair<Position, float>> output;
+        std::vector<uint32_t> route;
+        Position current = start;
+        for (int attempt = 0; attempt <= max_replans; ++attempt)
+        {
+            {
+                WorldView view(world);
+                world_view = &view;
+                SearchRoute(current, end, route);
+                world_view = nullptr;
+            }
+
+            // Merge the close waypoints, the block-level search can handle them in one go
+            std::vector<uint32_t> legs;
+            Position leg_start = current;
+            for (size_t i = 0; i < route.size(); ++i)
+            {
+                if (i + 1 < route.size() && Distance(leg_start, route_nodes[route[i + 1]].pos) <= max_leg_distance)
+                {
+                    continue;
+                }
+                legs.push_back(route[i]);
+                leg_start = route_nodes[route[i]].pos;
+            }
+
+            bool failed = false;
+            for (const uint32_t leg : legs)
+            {
+                const RouteNode& node = route_nodes[leg];
+                last_waypoints.push_back(node.pos);
+                const std::vector<std::pair<Position, float>> path = engine.FindPath(world, takes_damage, current, node.pos, leg_tolerance, 0, 0, allow_jump);
+                if (Distance(path.back().first, node.pos) > leg_tolerance)
+                {
+                    // Don't use this exit again until its section is modified
+                    auto it = sections.find(node.exit_section);
+                    if (it != sections.end())
+                    {
+                        it->second->exits[node.exit].blocked = true;
+                    }
+                    failed = true;
+                    break;
+                }
+                // The engine returns start if it's already close enough
+                if (path.back().first != current)
+                {
+                    output.insert(output.end(), path.begin(), path.end());
+                    current = path.back().first;
+                }
+            }
+
+            if (!failed)
+            {
+                break;
+            }
+        }
+
+        // Last leg, with the actual end criteria
+        const std::vector<std::pair<Position, float>> path = engine.FindPath(world, takes_damage, current, end, dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump);
+        if (output.empty() || path.back().first != current)
+        {
+            output.insert(output.end(), path.begin(), path.end());
+        }
+
+        return output;
+    }
+
+    void HierarchicalPathfinder::Update(const World& world, const bool takes_damage)
+    {
+        // Read before any block, so modifications during the build are seen as more recent
+        const unsigned long long int revision = world.GetBlockRevision();
+
+        if (graph_world_id != world.GetInstanceId() ||
+            graph_takes_damage != takes_damage ||
+            sections.size() > max_sections ||
+            !world.GetBlockChanges(graph_revision, changes))
+        {
+            sections.clear();
+            changes.clear();
+        }
+
+        graph_world_id = world.GetInstanceId();
+        graph_takes_damage = takes_damage;
+        graph_revision = revision;
+        min_y = world.GetMinY();
+        max_y = min_y + world.GetHeight() - 1;
+
+        // Remove all the sections that read a modified block
+        for (const auto& [min, max] : changes)
+        {
+            // Chunk changes cover the whole column
+            const int low_y = std::max(min.y, min_y - 1);
+            const int high_y = std::min(max.y, max_y + 1);
+            for (int section_x = (min.x - grid_size_xz - grid_min_xz + 1) >> 4; section_x <= (max.x - grid_min_xz) >> 4; ++section_x)
+            {
+                for (int section_z = (min.z - grid_size_xz - grid_min_xz + 1) >> 4; section_z <= (max.z - grid_min_xz) >> 4; ++section_z)
+                {
+                    for (int section_y = (low_y - grid_size_y - grid_min_y + 1) >> 4; section_y <= (high_y - grid_min_y) >> 4; ++section_y)
+                    {
+                        sections.erase(SectionKey(section_x, section_y, section_z));
+                    }
+                }
+            }
+        }
+    }
+
+    HierarchicalPathfinder::Section* HierarchicalPathfinder::GetSection(const Position& pos)
+    {
+        std::unique_ptr<Section>& section = sections[SectionKey(pos)];
+        if (section == nullptr)
+        {
+            section = std::make_unique<Section>();
+            section->origin = Position((pos.x >> 4) * 16, (pos.y >> 4) * 16, (pos.z >> 4) * 16);
+            BuildSection(*section);
+        }
+        return section.get();
+    }
+
+    void HierarchicalPathfinder::BuildSection(Section& section)
+    {
+        section.flags.resize(grid_size_xz * grid_size_xz * grid_size_y);
+        Position pos;
+        for (int x = 0; x < grid_size_xz; ++x)
+        {
+            pos.x = section.origin.x + grid_min_xz + x;
+            for (int z = 0; z < grid_size_xz; ++z)
+            {
+                pos.z = section.origin.z + grid_min_xz + z;
+                for (int y = 0; y < grid_size_y; ++y)
+                {
+                    pos.y = section.origin.y + grid_min_y + y;
+                    const Walkability block = (pos.y < min_y || pos.y > max_y) ? Walkability() : world_view->GetWalkability(pos);
+                    section.flags[(x * grid_size_xz + z) * grid_size_y + y] = Classify(block, graph_takes_damage);
+                }
+            }
+        }
+
+        // All the moves leaving the section, grouped by target section and direction
+        struct RawExit
+        {
+            uint16_t from;
+            Position to;
+            int cost;
+            uint32_t group;
+        };
+        std::vector<RawExit> raw_exits;
+        std::unordered_map<uint64_t, uint32_t> groups;
+        const Grid grid(section.flags.data());
+        for (int x = 0; x < 16; ++x)
+        {
+            for (int z = 0; z < 16; ++z)
+            {
+                for (int y = 0; y < 16; ++y)
+                {
+                    if (!grid.IsStandable(x, y, z))
+                    {
+                        continue;
+                    }
+                    grid.ForEachMove(x, y, z, [&](const int nx, const int ny, const int nz, const int cost, const int direction)
+                        {
+                            if (IsInside(nx, ny, nz))
+                            {
+                                return;
+                            }
+                            const Position to = section.origin + Position(nx, ny, nz);
+                            // Direction in the 4 lowest bits, target section key is at most 20 bits long in each direction
+                            const uint64_t group_key = (SectionKey(to) << 4) ^ direction;
+                            const uint32_t group = groups.try_emplace(group_key, static_cast<uint32_t>(groups.size())).first->second;
+                            raw_exits.push_back({ LocalIndex(x, y, z), to, cost, group });
+                        });
+                }
+            }
+        }
+
+        // Connected components of exits, using the 26 neighbours of their start block
+        std::unordered_map<uint64_t, uint32_t> exit_index;
+        for (uint32_t i = 0; i < raw_exits.size(); ++i)
+        {
+            exit_index.emplace((static_cast<uint64_t>(raw_exits[i].group) << 12) | raw_exits[i].from, i);
+        }
+        std::vector<uint32_t> parents(raw_exits.size());
+        for (uint32_t i = 0; i < parents.size(); ++i)
+        {
+            parents[i] = i;
+        }
+        const auto find_root = [&](uint32_t i)
+        {
+            while (parents[i] != i)
+            {
+                parents[i] = parents[parents[i]];
+                i = parents[i];
+            }
+            return i;
+        };
+        for (uint32_t i = 0; i < raw_exits.size(); ++i)
+        {
+            const int x = raw_exits[i].from >> 8;
+            const int z = (raw_exits[i].from >> 4) & 0xF;
+            const int y = raw_exits[i].from & 0xF;
+            for (int dx = -1; dx < 2; ++dx)
+            {
+                for (int dz = -1; dz < 2; ++dz)
+                {
+                    for (int dy = -1; dy < 2; ++dy)
+                    {
+                        if (!IsInside(x + dx, y + dy, z + dz))
+                        {
+                            continue;
+                        }
+                        auto it = exit_index.find((static_cast<uint64_t>(raw_exits[i].group) << 12) | LocalIndex(x + dx, y + dy, z + dz));
+                        if (it != exit_index.end())
+                        {
+                            parents[find_root(it->second)] = find_root(i);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Keep the exit the closest to the center of each component
+        // (relative to the section origin to avoid overflows)
+        std::unordered_map<uint32_t, std::pair<Position, int> > centers;
+        for (uint32_t i = 0; i < raw_exits.size(); ++i)
+        {
+            std::pair<Position, int>& center = centers[find_root(i)];
+            center.first += raw_exits[i].to - section.origin;
+            center.second += 1;
+        }
+        std::unordered_map<uint32_t, uint32_t> best;
+        for (uint32_t i = 0; i < raw_exits.size(); ++i)
+        {
+            const uint32_t root = find_root(i);
+            const std::pair<Position, int>& center = centers[root];
+            auto it = best.try_emplace(root, i).first;
+            const Position d_i = (raw_exits[i].to - section.origin) * center.second - center.first;
+            const Position d_best = (raw_exits[it->second].to - section.origin) * center.second - center.first;
+            if (d_i.SqrNorm() < d_best.SqrNorm() || (d_i.SqrNorm() == d_best.SqrNorm() && raw_exits[i].cost < raw_exits[it->second].cost))
+            {
+                it->second = i;
+            }
+        }
+
+        section.exits.clear();
+        section.exits.reserve(best.size());
+        for (const auto& [root, i] : best)
+        {
+            const RawExit& raw = raw_exits[i];
+            section.exits.push_back({ section.origin + Position(raw.from >> 8, raw.from & 0xF, (raw.from >> 4) & 0xF), raw.to, raw.cost, false });
+        }
+        // Don't depend on the hash map order
+        std::sort(section.exits.begin(), section.exits.end(), [](const Exit& a, const Exit& b)
+            {
+                return a.from < b.from || (a.from == b.from && a.to < b.to);
+            });
+    }
+
+    const std::vector<std::pair<uint32_t, int> >& HierarchicalPathfinder::GetExitCosts(Section& section, const Position& from)
+    {
+        const Position local = from - section.origin;
+        const uint16_t start_index = LocalIndex(local.x, local.y, local.z);
+        auto cached = section.exit_costs.find(start_index);
+        if (cached != section.exit_costs.end())
+        {
+            return cached->second;
+        }
+
+        // Dijkstra restricted to the section
+        const Grid grid(section.flags.data());
+        local_costs.assign(16 * 16 * 16, infinite_cost);
+        local_open.clear();
+        local_costs[start_index] = 0;
+        local_open.emplace_back(0, start_index);
+        while (!local_open.empty())
+        {
+            std::pop_heap(local_open.begin(), local_open.end(), std::greater<std::pair<int, uint16_t> >());
+            const auto [cost, index] = local_open.back();
+            local_open.pop_back();
+            if (cost > local_costs[index])
+            {
+                continue;
+            }
+            grid.ForEachMove(index >> 8, index & 0xF, (index >> 4) & 0xF, [&](const int nx, const int ny, const int nz, const int move_cost, const int)
+                {
+                    if (!IsInside(nx, ny, nz))
+                    {
+                        return;
+                    }
+                    const uint16_t next = LocalIndex(nx, ny, nz);
+                    if (cost + move_cost < local_costs[next])
+                    {
+                        local_costs[next] = cost + move_cost;
+                        local_open.emplace_back(cost + move_cost, next);
+                        std::push_heap(local_open.begin(), local_open.end(), std::greater<std::pair<int, uint16_t> >());
+                    }
+                });
+        }
+
+        std::vector<std::pair<uint32_t, int> >& output = section.exit_costs[start_index];
+        for (uint32_t i = 0; i < section.exits.size(); ++i)
+        {
+            const Position exit_local = section.exits[i].from - section.origin;
+            const int cost = local_costs[LocalIndex(exit_local.x, exit_local.y, exit_local.z)];
+            if (cost != infinite_cost)
+            {
+                output.emplace_back(i, cost);
+            }
+        }
+        return output;
+    }
+
+    bool HierarchicalPathfinder::SearchRoute(const Position& start, const Position& end, std::vector<uint32_t>& route)
+    {
+        route_nodes.clear();
+        route_index.clear();
+        route_open.clear();
+        route.clear();
+
+        route_nodes.push_back({ start, 0, invalid_index, 0, invalid_index, false });
+        route_index.emplace(start, 0);
+        route_open.emplace_back(Distance(start, end), 0);
+
+        uint32_t closest = 0;
+        int closest_dist = Distance(start, end);
+        bool found = closest_dist <= direct_distance;
+        size_t count_visit = 0;
+        while (!found && !route_open.empty() && count_visit < budget)
+        {
+            std::pop_heap(route_open.begin(), route_open.end(), std::greater<std::pair<int, uint32_t> >());
+            const uint32_t current = route_open.back().second;
+            route_open.pop_back();
+            if (route_nodes[current].closed)
+            {
+                continue;
+            }
+            route_nodes[current].closed = true;
+            count_visit += 1;
+
+            const Position pos = route_nodes[current].pos;
+            const int dist = Distance(pos, end);
+            if (dist < closest_dist)
+            {
+                closest = current;
+                closest_dist = dist;
+            }
+            if (dist <= direct_distance)
+            {
+                found = true;
+                break;
+            }
+
+            Section* section = GetSection(pos);
+            const uint64_t section_key = SectionKey(pos);
+            const int current_cost = route_nodes[current].cost;
+            for (const auto& [exit_index, cost] : GetExitCosts(*section, pos))
+            {
+                const Exit& exit = section->exits[exit_index];
+                if (exit.blocked)
+                {
+                    continue;
+                }
+                const int new_cost = current_cost + cost + exit.cost;
+                auto [it, inserted] = route_index.try_emplace(exit.to, static_cast<uint32_t>(route_nodes.size()));
+                if (inserted)
+                {
+                    route_nodes.push_back({ exit.to, new_cost, current, section_key, exit_index, false });
+                }
+                else
+                {
+                    RouteNode& node = route_nodes[it->second];
+                    if (node.closed || new_cost >= node.cost)
+                    {
+                        continue;
+                    }
+                    node.cost = new_cost;
+                    node.parent = current;
+                    node.exit_section = section_key;
+                    node.exit = exit_index;
+                }
+                route_open.emplace_back(new_cost + Distance(exit.to, end), it->second);
+                std::push_heap(route_open.begin(), route_open.end(), std::greater<std::pair<int, uint32_t> >());
+            }
+        }
+        last_visit_count += count_visit;
+
+        // If end can't be reached, get as close as possible
+        for (uint32_t index = closest; index != 0; index = route_nodes[index].parent)
+        {
+            route.push_back(index);
+        }
+        std::reverse(route.begin(), route.end());
+
+        return found;
+    }
+} // Botcraft
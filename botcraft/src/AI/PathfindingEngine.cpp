@@ -0,0 +1,1459 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <unordered_map>
+
+#include "botcraft/AI/PathfindingEngine.hpp"
+#include "botcraft/Game/World/Blockstate.hpp"
+#include "botcraft/Game/World/World.hpp"
+#include "botcraft/Game/World/WorldView.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+        /// @brief Max number of cache pages kept allocated between two searches
+        constexpr size_t max_kept_pages = 64;
+        /// @brief Same, but when the pages are kept for incremental replanning
+        constexpr size_t max_kept_pages_incremental = 512;
+
+        /// @brief Above this number of block changes, searching from
+        /// scratch is cheaper than repairing the previous tree
+        constexpr size_t max_repair_changes = 64;
+        /// @brief Above this number of block changes, the whole block cache is cleared
+        constexpr size_t max_invalidated_changes = 1024;
+
+        int Heuristic(const Position& a, const Position& b)
+        {
+            return std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z);
+        }
+
+        bool Intersects(const std::pair<Position, Position>& area, const Position& min, const Position& max)
+        {
+            return area.first.x <= max.x && area.second.x >= min.x &&
+                area.first.y <= max.y && area.second.y >= min.y &&
+                area.first.z <= max.z && area.second.z >= min.z;
+        }
+
+        /// @brief Check if any block read to compute a path has been modified
+        bool IsPathModified(const Position& start, const std::vector<std::pair<Position, float>>& path, const std::vector<std::pair<Position, Position>>& changes)
+        {
+            Position previous = start;
+            for (const auto& [pos, height] : path)
+            {
+                // All the blocks read by the move between previous and pos
+                const Position min(std::min(previous.x, pos.x) - 2, std::min(previous.y, pos.y) - 3, std::min(previous.z, pos.z) - 2);
+                const Position max(std::max(previous.x, pos.x) + 2, std::max(previous.y, pos.y) + 2, std::max(previous.z, pos.z) + 2);
+                for (const auto& area : changes)
+                {
+                    if (Intersects(area, min, max))
+                    {
+                        return true;
+                    }
+                }
+                previous = pos;
+            }
+            return false;
+        }
+
+        uint64_t ColumnKey(const int x, const int z)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+        }
+    }
+
+    class PathfindingEngine::PathfindingBlockstate
+    {
+    public:
+        enum Flags : uint8_t
+        {
+            Empty = 1 << 0,
+            Solid = 1 << 1,
+            Hazardous = 1 << 2,
+            Climbable = 1 << 3,
+            Fluid = 1 << 4,
+            StopsFall = 1 << 5,
+            FullHeight = 1 << 6
+        };
+
+        /// @brief Default state is an empty block
+        PathfindingBlockstate() = default;
+        PathfindingBlockstate(const uint8_t flags_, const float height_) : flags(flags_), height(height_) {}
+
+        /// @brief Classify a block for pathfinding
+        /// @param block Walkability of the block, empty if not loaded
+        /// @param pos Position of the block
+        /// @param take_damage If true, hazardous blocks are not considered solid/climbable
+        /// @param height Output, feet height when standing on this block
+        /// @return Flags of the block, never 0
+        static uint8_t Classify(const Walkability block, const Position& pos, const bool take_damage, float& height)
+        {
+            height = static_cast<float>(pos.y);
+
+            // Solid and not climbable stops a fall, whatever the hazard
+            const Walkability::Kind kind = block.GetKind();
+            const uint8_t stops_fall = kind == Walkability::Kind::Solid ? StopsFall : 0;
+
+            if (take_damage && block.IsHazardous())
+            {
+                return Hazardous | stops_fall;
+            }
+
+            switch (kind)
+            {
+            case Walkability::Kind::Fluid:
+                return Climbable | Fluid;
+            case Walkability::Kind::Climbable:
+                return Climbable;
+            case Walkability::Kind::Solid:
+                height += block.GetTopHeight();
+                return Solid | StopsFall | (height == pos.y + 1.0f ? FullHeight : 0);
+            default:
+                return Empty;
+            }
+        }
+
+        bool IsEmpty() const { return flags & Empty; }
+        bool IsSolid() const { return flags & Solid; }
+        bool IsHazardous() const { return flags & Hazardous; }
+        bool IsClimbable() const { return flags & Climbable; }
+        bool IsFluid() const { return flags & Fluid; }
+        bool StopsFalling() const { return flags & StopsFall; }
+        float GetHeight() const { return height; }
+
+    private:
+        uint8_t flags = Empty;
+        float height = 0.0f;
+    };
+
+    struct PathfindingEngine::Node
+    {
+        Position pos; // Block in which the feet are
+        float height; // Feet height
+        float cost; // Distance from start
+        float score; // Distance from start + heuristic to goal
+        uint32_t parent;
+        uint32_t next; // Next node in the same block
+        uint32_t heap_index;
+        int low_y; // Lowest block read when expanding this node
+    };
+
+    struct PathfindingEngine::Page
+    {
+        Page()
+        {
+            flags.fill(0);
+            nodes.fill(invalid_index);
+        }
+
+        /// @brief PathfindingBlockstate flags of each block, 0 if not classified yet
+        std::array<uint8_t, 16 * 16 * 16> flags;
+        /// @brief Height of the solid blocks that are not full blocks
+        std::array<float, 16 * 16 * 16> heights;
+        /// @brief First node with its feet in each block, other
+        /// nodes in the same block (different heights) are chained.
+        /// Not cleared between two searches, see GetFirstNode
+        std::array<uint32_t, 16 * 16 * 16> nodes;
+        /// @brief Position of the first block of the section
+        Position origin;
+
+        /// @brief Get the first node of a block
+        /// @return The node index, or invalid_index if this block has no node
+        uint32_t GetFirstNode(const size_t i, const Position& pos, const std::vector<Node>& all_nodes) const
+        {
+            // A node left by a previous search is either out of
+            // the arena, or replaced by a node of another block
+            return (nodes[i] < all_nodes.size() && all_nodes[nodes[i]].pos == pos) ? nodes[i] : invalid_index;
+        }
+
+        static size_t Index(const Position& pos)
+        {
+            // Y first, so a column of blocks is contiguous in memory
+            return ((pos.x & 0xF) << 8) | ((pos.z & 0xF) << 4) | (pos.y & 0xF);
+        }
+    };
+
+    struct PathfindingEngine::OpenEntry
+    {
+        // Copied from the node to avoid an indirection when comparing
+        float score;
+        float cost;
+        uint32_t node;
+    };
+
+    struct PathfindingEngine::CachedPath
+    {
+        /// @brief Instance id of the world, see World::GetInstanceId
+        unsigned long long int world_id;
+        unsigned long long int revision;
+        unsigned long long int last_use;
+        bool takes_damage;
+        bool allow_jump;
+        int dist_tolerance;
+        int min_end_dist;
+        int min_end_dist_xz;
+        Position start;
+        Position end;
+        /// @brief Path from start, start excluded
+        std::vector<std::pair<Position, float>> path;
+    };
+
+    PathfindingEngine::PathfindingEngine(const size_t budget_, const size_t cache_size_, const bool incremental_) :
+        budget(budget_), cache_size(cache_size_), incremental(incremental_)
+    {
+        last_visit_count = 0;
+        world_view = nullptr;
+        takes_damage = false;
+        min_y = 0;
+        search_dist_tolerance = 0;
+        search_min_end_dist = 0;
+        search_min_end_dist_xz = 0;
+        search_allow_jump = false;
+        tree_world_id = 0;
+        tree_revision = 0;
+        cache_clock = 0;
+        used_pages = 0;
+        page_cache.fill({ 0, nullptr });
+        best_suitable = invalid_index;
+        best_suitable_dist = 0;
+        best_suitable_dist_start = 0;
+        best_closest = invalid_index;
+        best_closest_dist = 0;
+        best_closest_dist_start = 0;
+    }
+
+    PathfindingEngine::~PathfindingEngine()
+    {
+
+    }
+
+    size_t PathfindingEngine::GetBudget() const
+    {
+        return budget;
+    }
+
+    void PathfindingEngine::SetBudget(const size_t budget_)
+    {
+        budget = budget_;
+    }
+
+    size_t PathfindingEngine::GetCacheSize() const
+    {
+        return cache_size;
+    }
+
+    void PathfindingEngine::SetCacheSize(const size_t cache_size_)
+    {
+        cache_size = cache_size_;
+        if (cache.size() > cache_size)
+        {
+            // Keep the most recently used paths
+            std::sort(cache.begin(), cache.end(), [](const CachedPath& a, const CachedPath& b) { return a.last_use > b.last_use; });
+            cache.erase(cache.begin() + cache_size, cache.end());
+        }
+    }
+
+    bool PathfindingEngine::IsIncremental() const
+    {
+        return incremental;
+    }
+
+    void PathfindingEngine::SetIncremental(const bool incremental_)
+    {
+        incremental = incremental_;
+    }
+
+    void PathfindingEngine::Clear()
+    {
+        cache.clear();
+        Reset();
+    }
+
+    size_t PathfindingEngine::GetLastVisitCount() const
+    {
+        return last_visit_count;
+    }
+
+    std::vector<std::pair<Position, float>> PathfindingEngine::FindPath(const World& world, const bool takes_damage_, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump)
+    {
+        // Read before any block, so modifications during the search are seen as more recent
+        const unsigned long long int revision = world.GetBlockRevision();
+
+        CachedPath query;
+        query.world_id = world.GetInstanceId();
+        query.revision = revision;
+        query.takes_damage = takes_damage_;
+        query.allow_jump = allow_jump;
+        query.dist_tolerance = dist_tolerance;
+        query.min_end_dist = min_end_dist;
+        query.min_end_dist_xz = min_end_dist_xz;
+        query.start = start;
+        query.end = end;
+
+        std::vector<std::pair<Position, float>> output;
+        if (cache_size > 0 && GetCachedPath(world, query, output))
+        {
+            last_visit_count = 0;
+            return output;
+        }
+
+        // Blocks classified during the previous search are still valid, except the modified ones
+        const bool same_blocks = incremental &&
+            tree_world_id == world.GetInstanceId() &&
+            takes_damage == takes_damage_ &&
+            world.GetBlockChanges(tree_revision, changes) &&
+            changes.size() <= max_invalidated_changes;
+        // The previous search tree can be repaired
+        const bool same_tree = same_blocks &&
+            changes.size() <= max_repair_changes &&
+            search_end == end &&
+            search_dist_tolerance == dist_tolerance &&
+            search_min_end_dist == min_end_dist &&
+            search_min_end_dist_xz == min_end_dist_xz &&
+            search_allow_jump == allow_jump;
+
+        // All blocks are read through the same view: no lock and no chunk lookup for each access
+        WorldView view(world);
+        world_view = &view;
+        takes_damage = takes_damage_;
+        min_y = world.GetMinY();
+        search_end = end;
+        search_dist_tolerance = dist_tolerance;
+        search_min_end_dist = min_end_dist;
+        search_min_end_dist_xz = min_end_dist_xz;
+        search_allow_jump = allow_jump;
+
+        if (same_blocks)
+        {
+            for (const auto& [min, max] : changes)
+            {
+                InvalidateBlocks(min, max);
+            }
+        }
+
+        if (!same_tree || !Repair(start))
+        {
+            if (same_blocks)
+            {
+                ResetNodes();
+            }
+            else
+            {
+                Reset();
+            }
+            search_start = start;
+            // Start is its own parent
+            AddNode(start, GetState(start).GetHeight(), 0.0f, 0);
+        }
+        tree_world_id = world.GetInstanceId();
+        tree_revision = revision;
+
+        const Blockstate* end_block = view.GetBlock(end);
+        Search(allow_jump, end_block != nullptr && end_block->IsSolid());
+        world_view = nullptr;
+
+        // We take the node respecting the criteria AND the closest
+        // to start as it should often lead to a shorter path.
+        // If there is none, this might mean we reached search limit,
+        // take the closest node to the goal in this case
+        const bool complete = best_suitable != invalid_index;
+        uint32_t index = complete ? best_suitable : best_closest;
+
+        output.emplace_back(nodes[index].pos, nodes[index].height);
+        while (index != 0 && nodes[index].parent != 0)
+        {
+            index = nodes[index].parent;
+            output.emplace_back(nodes[index].pos, nodes[index].height);
+        }
+        std::reverse(output.begin(), output.end());
+
+        // Don't keep all the memory of a very long search
+        const size_t max_pages = incremental ? max_kept_pages_incremental : max_kept_pages;
+        if (pages.size() > max_pages)
+        {
+            Reset();
+            pages.resize(max_pages);
+        }
+
+        // Only cache paths reaching the goal, the others
+        // may change as soon as more chunks are loaded
+        if (cache_size > 0 && complete)
+        {
+            query.path = output;
+            AddCachedPath(std::move(query));
+        }
+
+        return output;
+    }
+
+    void PathfindingEngine::Search(const bool allow_jump, const bool end_is_inside_solid)
+    {
+        size_t count_visit = 0;
+        // We found one location matching all the criterion, but
+        // continue the search to see if we can find a better one
+        bool suitable_location_found = false;
+        // We found a path to the desired goal
+        bool end_reached = false;
+
+        while (!open.empty())
+        {
+            count_visit++;
+            const uint32_t current = HeapPop();
+            closed[current >> 6] |= 1ULL << (current & 63);
+
+            const Position& pos = nodes[current].pos;
+            end_reached |= pos == search_end;
+            const int d_xz = std::abs(search_end.x - pos.x) + std::abs(search_end.z - pos.z);
+            const int d = d_xz + std::abs(search_end.y - pos.y);
+            suitable_location_found |= d <= search_dist_tolerance && d >= search_min_end_dist && d_xz >= search_min_end_dist_xz;
+
+            if (// If we exceeded the search budget
+                count_visit > budget ||
+                // Or if we found a suitable location in the process and already reached the goal/can't reach it anyway
+                (suitable_location_found && (end_reached || end_is_inside_solid)))
+            {
+                // Not expanded, so closed nodes are all expanded if the search is resumed
+                closed[current >> 6] &= ~(1ULL << (current & 63));
+                HeapPush(current);
+                break;
+            }
+
+            Expand(current, allow_jump);
+        }
+        last_visit_count = count_visit;
+    }
+
+    bool PathfindingEngine::GetCachedPath(const World& world, const CachedPath& query, std::vector<std::pair<Position, float>>& output)
+    {
+        for (auto it = cache.begin(); it != cache.end();)
+        {
+            if (it->world_id != query.world_id ||
+                it->takes_damage != query.takes_damage ||
+                it->allow_jump != query.allow_jump ||
+                it->end != query.end ||
+                it->dist_tolerance != query.dist_tolerance ||
+                it->min_end_dist != query.min_end_dist ||
+                it->min_end_dist_xz != query.min_end_dist_xz)
+            {
+                ++it;
+                continue;
+            }
+
+            // Start can be anywhere on the path
+            size_t first = 0;
+            if (it->start != query.start)
+            {
+                while (first < it->path.size() && it->path[first].first != query.start)
+                {
+                    first += 1;
+                }
+                first += 1;
+            }
+            if (first >= it->path.size())
+            {
+                ++it;
+                continue;
+            }
+
+            if (!world.GetBlockChanges(it->revision, changes) || IsPathModified(it->start, it->path, changes))
+            {
+                it = cache.erase(it);
+                continue;
+            }
+
+            it->revision = query.revision;
+            it->last_use = ++cache_clock;
+            output.assign(it->path.begin() + first, it->path.end());
+            return true;
+        }
+        return false;
+    }
+
+    void PathfindingEngine::AddCachedPath(CachedPath&& entry)
+    {
+        entry.last_use = ++cache_clock;
+        if (cache.size() < cache_size)
+        {
+            cache.push_back(std::move(entry));
+            return;
+        }
+        // Replace the least recently used one
+        auto oldest = std::min_element(cache.begin(), cache.end(), [](const CachedPath& a, const CachedPath& b) { return a.last_use < b.last_use; });
+        *oldest = std::move(entry);
+    }
+
+    bool PathfindingEngine::Repair(const Position& start)
+    {
+        // The tree can be reused only if start has been expanded in it
+        const uint32_t root = FindNode(start, GetState(start).GetHeight());
+        if (root == invalid_index || !(closed[root >> 6] & (1ULL << (root & 63))))
+        {
+            return false;
+        }
+
+        enum : uint8_t
+        {
+            Closed = 1 << 0,
+            Affected = 1 << 1, // Expanded reading a modified block
+            Live = 1 << 2, // Still valid in the new tree
+            Reopen = 1 << 3 // Closed node to expand again
+        };
+
+        const size_t num_nodes = nodes.size();
+        repair_states.assign(num_nodes, 0);
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if (!(closed[i >> 6] & (1ULL << (i & 63))))
+            {
+                continue;
+            }
+            repair_states[i] = Closed;
+            // All the blocks read by Expand
+            const Node& node = nodes[i];
+            const Position min(node.pos.x - 2, node.low_y, node.pos.z - 2);
+            const Position max(node.pos.x + 2, node.pos.y + 2, node.pos.z + 2);
+            for (const auto& area : changes)
+            {
+                if (Intersects(area, min, max))
+                {
+                    repair_states[i] |= Affected;
+                    break;
+                }
+            }
+        }
+
+        // Children of each node, children of i are in repair_children[repair_indices[i]..repair_indices[i + 1]]
+        repair_indices.assign(num_nodes + 1, 0);
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if (nodes[i].parent != i)
+            {
+                repair_indices[nodes[i].parent + 1] += 1;
+            }
+        }
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            repair_indices[i + 1] += repair_indices[i];
+        }
+        repair_children.resize(num_nodes);
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if (nodes[i].parent != i)
+            {
+                repair_children[repair_indices[nodes[i].parent]++] = static_cast<uint32_t>(i);
+            }
+        }
+        for (size_t i = num_nodes; i > 0; --i)
+        {
+            repair_indices[i] = repair_indices[i - 1];
+        }
+        repair_indices[0] = 0;
+
+        // Only the subtree of the new root is still reachable from start,
+        // minus the children of the nodes expanded with outdated blocks
+        size_t num_live = 0;
+        std::vector<uint32_t> stack = { root };
+        while (!stack.empty())
+        {
+            const uint32_t i = stack.back();
+            stack.pop_back();
+            repair_states[i] |= Live;
+            num_live += 1;
+            if (repair_states[i] & Affected)
+            {
+                continue;
+            }
+            stack.insert(stack.end(), repair_children.begin() + repair_indices[i], repair_children.begin() + repair_indices[i + 1]);
+        }
+
+        // Most of the search would be done again anyway
+        if (num_live * 4 < num_nodes)
+        {
+            return false;
+        }
+
+        // Lowest removed node in each column
+        std::unordered_map<uint64_t, int> removed_columns;
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if (!(repair_states[i] & Live))
+            {
+                auto it = removed_columns.try_emplace(ColumnKey(nodes[i].pos.x, nodes[i].pos.z), nodes[i].pos.y).first;
+                it->second = std::min(it->second, nodes[i].pos.y);
+            }
+        }
+
+        static const std::array<Position, 9> predecessor_offsets = {
+            Position(0, 0, 0),
+            Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1),
+            Position(2, 0, 0), Position(-2, 0, 0), Position(0, 0, 2), Position(0, 0, -2)
+        };
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if ((repair_states[i] & (Live | Closed)) != (Live | Closed))
+            {
+                continue;
+            }
+            if (repair_states[i] & Affected)
+            {
+                repair_states[i] |= Reopen;
+                continue;
+            }
+
+            const Position& pos = nodes[i].pos;
+            // Expand again nodes that may lead to a removed one, they
+            // can't be higher than one block above their predecessor
+            for (const Position& offset : predecessor_offsets)
+            {
+                auto it = removed_columns.find(ColumnKey(pos.x + offset.x, pos.z + offset.z));
+                if (it != removed_columns.end() && it->second <= pos.y + 1)
+                {
+                    repair_states[i] |= Reopen;
+                    break;
+                }
+            }
+
+            // Nodes matching the end criteria must be popped again for the search to stop
+            const int d_xz = std::abs(search_end.x - pos.x) + std::abs(search_end.z - pos.z);
+            const int d = d_xz + std::abs(search_end.y - pos.y);
+            if (pos == search_end || (d <= search_dist_tolerance && d >= search_min_end_dist && d_xz >= search_min_end_dist_xz))
+            {
+                repair_states[i] |= Reopen;
+            }
+        }
+
+        // Compact the live nodes, root first so it's its own parent
+        std::vector<uint32_t>& new_indices = repair_indices;
+        new_indices.assign(num_nodes, invalid_index);
+        std::vector<uint32_t>& old_indices = repair_children;
+        old_indices.clear();
+        old_indices.push_back(root);
+        for (size_t i = 0; i < num_nodes; ++i)
+        {
+            if ((repair_states[i] & Live) && i != root)
+            {
+                old_indices.push_back(static_cast<uint32_t>(i));
+            }
+        }
+        for (size_t i = 0; i < old_indices.size(); ++i)
+        {
+            new_indices[old_indices[i]] = static_cast<uint32_t>(i);
+        }
+
+        const float root_cost = nodes[root].cost;
+        repair_nodes.clear();
+        for (const uint32_t i : old_indices)
+        {
+            Node node = nodes[i];
+            node.parent = i == root ? 0 : new_indices[node.parent];
+            node.cost -= root_cost;
+            node.score = node.cost + Heuristic(node.pos, search_end);
+            node.next = invalid_index;
+            node.heap_index = invalid_index;
+            repair_nodes.push_back(node);
+        }
+        nodes.swap(repair_nodes);
+
+        // Old indices in the pages may point to nodes of the same block
+        for (const Node& node : nodes)
+        {
+            GetPage(node.pos)->nodes[Page::Index(node.pos)] = invalid_index;
+        }
+
+        open.clear();
+        closed.assign((nodes.size() + 63) / 64, 0);
+        search_start = start;
+        best_suitable = invalid_index;
+        best_closest = invalid_index;
+        for (uint32_t i = 0; i < nodes.size(); ++i)
+        {
+            LinkNode(i);
+            const uint8_t state = repair_states[old_indices[i]];
+            if ((state & Closed) && !(state & Reopen))
+            {
+                closed[i >> 6] |= 1ULL << (i & 63);
+            }
+            else
+            {
+                HeapPush(i);
+            }
+            UpdateBestCandidates(i);
+        }
+
+        return true;
+    }
+
+    void PathfindingEngine::InvalidateBlocks(const Position& min, const Position& max)
+    {
+        for (size_t i = 0; i < used_pages; ++i)
+        {
+            Page& page = *pages[i];
+            const Position low(std::max(min.x, page.origin.x), std::max(min.y, page.origin.y), std::max(min.z, page.origin.z));
+            const Position high(std::min(max.x, page.origin.x + 15), std::min(max.y, page.origin.y + 15), std::min(max.z, page.origin.z + 15));
+            if (low.x > high.x || low.y > high.y || low.z > high.z)
+            {
+                continue;
+            }
+            Position pos;
+            for (pos.x = low.x; pos.x <= high.x; ++pos.x)
+            {
+                for (pos.z = low.z; pos.z <= high.z; ++pos.z)
+                {
+                    for (pos.y = low.y; pos.y <= high.y; ++pos.y)
+                    {
+                        page.flags[Page::Index(pos)] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t PathfindingEngine::FindNode(const Position& pos, const float height)
+    {
+        const Page* page = GetPage(pos);
+        const size_t i = Page::Index(pos);
+        uint32_t index = page->GetFirstNode(i, pos, nodes);
+        while (index != invalid_index && nodes[index].height != height)
+        {
+            index = nodes[index].next;
+        }
+        return index;
+    }
+
+    void PathfindingEngine::LinkNode(const uint32_t index)
+    {
+        Node& node = nodes[index];
+        Page* page = GetPage(node.pos);
+        const size_t i = Page::Index(node.pos);
+        node.next = page->GetFirstNode(i, node.pos, nodes);
+        page->nodes[i] = index;
+    }
+
+    void PathfindingEngine::UpdateBestCandidates(const uint32_t index)
+    {
+        const Position diff = nodes[index].pos - search_end;
+        const int d_xz = std::abs(diff.x) + std::abs(diff.z);
+        const int d = d_xz + std::abs(diff.y);
+        const int d_start = Heuristic(nodes[index].pos, search_start);
+        if (d <= search_dist_tolerance && d >= search_min_end_dist && d_xz >= search_min_end_dist_xz &&
+            (best_suitable == invalid_index || d_start < best_suitable_dist_start || (d_start == best_suitable_dist_start && d < best_suitable_dist)))
+        {
+            best_suitable = index;
+            best_suitable_dist = d;
+            best_suitable_dist_start = d_start;
+        }
+        if (best_closest == invalid_index || d < best_closest_dist || (d == best_closest_dist && d_start < best_closest_dist_start))
+        {
+            best_closest = index;
+            best_closest_dist = d;
+            best_closest_dist_start = d_start;
+        }
+    }
+
+    void PathfindingEngine::Reset()
+    {
+        used_pages = 0;
+        page_index.clear();
+        page_cache.fill({ 0, nullptr });
+        ResetNodes();
+    }
+
+    void PathfindingEngine::ResetNodes()
+    {
+        nodes.clear();
+        open.clear();
+        closed.clear();
+        best_suitable = invalid_index;
+        best_closest = invalid_index;
+        tree_world_id = 0;
+    }
+
+    PathfindingEngine::Page* PathfindingEngine::GetPage(const Position& pos)
+    {
+        const int section_x = pos.x >> 4;
+        const int section_y = pos.y >> 4;
+        const int section_z = pos.z >> 4;
+        std::pair<uint64_t, Page*>& cached = page_cache[(section_x & 0x3) | ((section_z & 0x3) << 2) | ((section_y & 0x3) << 4)];
+
+        const uint64_t key =
+            (static_cast<uint64_t>(static_cast<uint32_t>(section_x) & 0x3FFFFF) << 42) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(section_z) & 0x3FFFFF) << 20) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(section_y) & 0xFFFFF));
+        if (cached.second != nullptr && cached.first == key)
+        {
+            return cached.second;
+        }
+
+        auto it = page_index.find(key);
+        if (it == page_index.end())
+        {
+            if (used_pages == pages.size())
+            {
+                pages.push_back(std::make_unique<Page>());
+            }
+            else
+            {
+                pages[used_pages]->flags.fill(0);
+            }
+            pages[used_pages]->origin = Position(section_x * 16, section_y * 16, section_z * 16);
+            it = page_index.emplace(key, pages[used_pages].get()).first;
+            used_pages += 1;
+        }
+        cached = { key, it->second };
+        return it->second;
+    }
+
+    PathfindingEngine::PathfindingBlockstate PathfindingEngine::GetState(const Position& pos)
+    {
+        return GetState(GetPage(pos), pos);
+    }
+
+    PathfindingEngine::PathfindingBlockstate PathfindingEngine::GetState(Page* page, const Position& pos)
+    {
+        const size_t i = Page::Index(pos);
+        uint8_t flags = page->flags[i];
+
+        float height = static_cast<float>(pos.y);
+        if (flags == 0)
+        {
+            flags = PathfindingBlockstate::Classify(world_view->GetWalkability(pos), pos, takes_damage, height);
+            page->flags[i] = flags;
+            if ((flags & PathfindingBlockstate::Solid) && !(flags & PathfindingBlockstate::FullHeight))
+            {
+                page->heights[i] = height;
+            }
+        }
+        else if (flags & PathfindingBlockstate::Solid)
+        {
+            height = (flags & PathfindingBlockstate::FullHeight) ? height + 1.0f : page->heights[i];
+        }
+        return PathfindingBlockstate(flags, height);
+    }
+
+    void PathfindingEngine::GetColumn(const Position& top, const int count, PathfindingBlockstate* output)
+    {
+        Position pos = top;
+        Page* page = GetPage(pos);
+        for (int i = 0; i < count; ++i)
+        {
+            output[i] = GetState(page, pos);
+            pos.y -= 1;
+            // Crossing a section boundary
+            if ((pos.y & 0xF) == 0xF)
+            {
+                page = GetPage(pos);
+            }
+        }
+    }
+
+    void PathfindingEngine::AddNode(const Position& pos, const float height, const float cost, const uint32_t parent)
+    {
+        Page* page = GetPage(pos);
+        const size_t i = Page::Index(pos);
+        const uint32_t first = page->GetFirstNode(i, pos, nodes);
+        uint32_t index = first;
+        while (index != invalid_index && nodes[index].height != height)
+        {
+            index = nodes[index].next;
+        }
+
+        // New node
+        if (index == invalid_index)
+        {
+            index = static_cast<uint32_t>(nodes.size());
+            Node node;
+            node.pos = pos;
+            node.height = height;
+            node.cost = cost;
+            node.score = cost + Heuristic(pos, search_end);
+            node.parent = parent;
+            node.next = first;
+            node.heap_index = invalid_index;
+            node.low_y = pos.y;
+            nodes.push_back(node);
+            page->nodes[i] = index;
+            if ((index >> 6) >= closed.size())
+            {
+                closed.push_back(0);
+            }
+            HeapPush(index);
+
+            // Keep track of the best end candidates
+            UpdateBestCandidates(index);
+            return;
+        }
+
+        // If we already know this node with a better path, nothing to do
+        Node& node = nodes[index];
+        if (cost >= node.cost)
+        {
+            return;
+        }
+        node.cost = cost;
+        node.score = cost + Heuristic(pos, search_end);
+        node.parent = parent;
+
+        // Already expanded, reopen it
+        if (closed[index >> 6] & (1ULL << (index & 63)))
+        {
+            closed[index >> 6] &= ~(1ULL << (index & 63));
+            HeapPush(index);
+        }
+        else
+        {
+            open[node.heap_index].score = node.score;
+            open[node.heap_index].cost = node.cost;
+            HeapSiftUp(node.heap_index);
+        }
+    }
+
+    bool PathfindingEngine::HeapLess(const OpenEntry& a, const OpenEntry& b)
+    {
+        // On equal scores, prefer the node the closest to the goal
+        return a.score < b.score || (a.score == b.score && a.cost > b.cost);
+    }
+
+    void PathfindingEngine::HeapPush(const uint32_t index)
+    {
+        open.push_back({ nodes[index].score, nodes[index].cost, index });
+        HeapSiftUp(open.size() - 1);
+    }
+
+    uint32_t PathfindingEngine::HeapPop()
+    {
+        const uint32_t top = open.front().node;
+        nodes[top].heap_index = invalid_index;
+        open.front() = open.back();
+        open.pop_back();
+        if (!open.empty())
+        {
+            HeapSiftDown(0);
+        }
+        return top;
+    }
+
+    void PathfindingEngine::HeapSiftUp(size_t i)
+    {
+        const OpenEntry entry = open[i];
+        while (i > 0)
+        {
+            const size_t parent = (i - 1) / 2;
+            if (!HeapLess(entry, open[parent]))
+            {
+                break;
+            }
+            open[i] = open[parent];
+            nodes[open[i].node].heap_index = static_cast<uint32_t>(i);
+            i = parent;
+        }
+        open[i] = entry;
+        nodes[entry.node].heap_index = static_cast<uint32_t>(i);
+    }
+
+    void PathfindingEngine::HeapSiftDown(size_t i)
+    {
+        const OpenEntry entry = open[i];
+        const size_t size = open.size();
+        while (true)
+        {
+            size_t child = 2 * i + 1;
+            if (child >= size)
+            {
+                break;
+            }
+            if (child + 1 < size && HeapLess(open[child + 1], open[child]))
+            {
+                child += 1;
+            }
+            if (!HeapLess(open[child], entry))
+            {
+                break;
+            }
+            open[i] = open[child];
+            nodes[open[i].node].heap_index = static_cast<uint32_t>(i);
+            i = child;
+        }
+        open[i] = entry;
+        nodes[entry.node].heap_index = static_cast<uint32_t>(i);
+    }
+
+    void PathfindingEngine::Expand(const uint32_t index, const bool allow_jump)
+    {
+        static const std::array<Position, 4> neighbour_offsets = { Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1) };
+
+        // Copy, as adding nodes may reallocate the arena
+        const Position current_pos = nodes[index].pos;
+        const float current_height = nodes[index].height;
+        const float current_cost = nodes[index].cost;
+        // Lowest block read, to know which blocks this expansion depends on
+        int lowest_y = current_pos.y - 3;
+
+        // Get the state around the player in the given location
+        std::array<PathfindingBlockstate, 6> vertical_surroundings;
+
+        // Assuming the player is standing on 3 (feeet on 2 and head on 1)
+        // 0
+        // 1
+        // 2
+        // 3
+        // 4
+        // 5
+        // 2 is the current feet block
+        GetColumn(current_pos + Position(0, 2, 0), 3, vertical_surroundings.data());
+
+        // if 2 is solid or hazardous, no down pathfinding is possible,
+        // so we can skip a few checks
+        if (!vertical_surroundings[2].IsSolid() && !vertical_surroundings[2].IsHazardous())
+        {
+            // if 3 is solid or hazardous, no down pathfinding is possible,
+            // so we can skip a few checks
+            vertical_surroundings[3] = GetState(current_pos + Position(0, -1, 0));
+
+            // If we can move down, we need 4 and 5
+            if (!vertical_surroundings[3].IsSolid() && !vertical_surroundings[3].IsHazardous())
+            {
+                GetColumn(current_pos + Position(0, -2, 0), 2, vertical_surroundings.data() + 4);
+            }
+        }
+
+
+        // Check all vertical cases that would allow the bot to pass
+        // -
+        // x
+        // ^
+        // ?
+        // ?
+        // ?
+        if (vertical_surroundings[2].IsClimbable()
+            && !vertical_surroundings[1].IsSolid()
+            && !vertical_surroundings[1].IsHazardous()
+            && !vertical_surroundings[0].IsSolid()
+            && !vertical_surroundings[0].IsHazardous()
+            )
+        {
+            AddNode(current_pos + Position(0, 1, 0), current_pos.y + 1.0f, current_cost + 1.0f, index);
+        }
+
+        // -
+        // ^
+        // x
+        // o
+        // ?
+        // ?
+        if (vertical_surroundings[1].IsClimbable()
+            && !vertical_surroundings[0].IsSolid()
+            && !vertical_surroundings[0].IsHazardous()
+            && (vertical_surroundings[2].IsSolid() || // we stand on top of 2
+                (!vertical_surroundings[2].IsClimbable() && vertical_surroundings[3].IsSolid()) // if not, it means we stand on 3. Height difference check is not necessary, as the feet are in 2, we know 3 is at least 1 tall
+               )
+            )
+        {
+            AddNode(current_pos + Position(0, 1, 0), current_pos.y + 1.0f, current_cost + 1.5f, index);
+        }
+
+        // ?
+        // x
+        //
+        // -
+        // ?
+        // ?
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            )
+        {
+            AddNode(current_pos + Position(0, -1, 0), current_pos.y - 1.0f, current_cost + 1.0f, index);
+        }
+
+        // ?
+        // x
+        //
+        // -
+        //
+        // o
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            && vertical_surroundings[4].IsEmpty()
+            && !vertical_surroundings[5].IsEmpty()
+            && !vertical_surroundings[5].IsHazardous()
+            )
+        {
+            const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_pos.y - 2;
+            AddNode(current_pos + Position(0, -3 + 1 * above_block, 0),
+                above_block ? std::max(current_pos.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight(),
+                current_cost + 3.0f - 1.0f * above_block, index);
+        }
+
+
+
+        // ?
+        // x
+        // ^
+        //
+        //
+        // o
+        if (vertical_surroundings[2].IsClimbable()
+            && vertical_surroundings[3].IsEmpty()
+            && vertical_surroundings[4].IsEmpty()
+            && !vertical_surroundings[5].IsEmpty()
+            && !vertical_surroundings[5].IsHazardous()
+            )
+        {
+            const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_pos.y - 2;
+            AddNode(current_pos + Position(0, -3 + 1 * above_block, 0),
+                above_block ? std::max(current_pos.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight(),
+                current_cost + 3.0f - 1.0f * above_block, index);
+        }
+
+
+        // ?
+        // x
+        //
+        // -
+        //
+        //
+        // Special case here, we can drop down
+        // if there is a climbable at the bottom
+        if (!vertical_surroundings[2].IsSolid() &&
+            vertical_surroundings[3].IsClimbable()
+            && vertical_surroundings[4].IsEmpty()
+            && vertical_surroundings[5].IsEmpty()
+            )
+        {
+            for (int y = -4; current_pos.y + y >= min_y; --y)
+            {
+                const PathfindingBlockstate landing_block = GetState(current_pos + Position(0, y, 0));
+                lowest_y = std::min(lowest_y, current_pos.y + y);
+
+                if (landing_block.StopsFalling())
+                {
+                    break;
+                }
+
+                if (landing_block.IsClimbable())
+                {
+                    AddNode(current_pos + Position(0, y + 1, 0), current_pos.y + y + 1.0f, current_cost + std::abs(y), index);
+                    break;
+                }
+            }
+        }
+
+
+        // For each neighbour, check if it's reachable
+        // and add it to the search list if it is
+        for (size_t i = 0; i < neighbour_offsets.size(); ++i)
+        {
+            const Position next_location = current_pos + neighbour_offsets[i];
+            const Position next_next_location = next_location + neighbour_offsets[i];
+
+            // Get the state around the player in the given direction
+            std::array<PathfindingBlockstate, 12> horizontal_surroundings;
+
+            // Assuming the player is standing on v3 (feeet on v2 and head on v1)
+            // v0   0   6 --> ?  ?  ?
+            // v1   1   7 --> x  ?  ?
+            // v2   2   8 --> x  ?  ?
+            // v3   3   9 --> ?  ?  ?
+            // v4   4  10 --> ?  ?  ?
+            // v5   5  11 --> ?  ?  ?
+
+            // if 1 is solid and tall, no horizontal pathfinding is possible,
+            // so we can skip a lot of checks
+            GetColumn(next_location + Position(0, 2, 0), 2, horizontal_surroundings.data());
+            const bool horizontal_movement =
+                (!horizontal_surroundings[1].IsSolid() || // 1 is not solid
+                    (horizontal_surroundings[1].GetHeight() - current_height < 1.25f && // or 1 is solid and small
+                        !horizontal_surroundings[0].IsSolid() && !horizontal_surroundings[0].IsHazardous())  // and 0 does not prevent standing
+                ) && !horizontal_surroundings[1].IsHazardous();
+
+            // If we can move horizontally, get the full column
+            if (horizontal_movement)
+            {
+                GetColumn(next_location, 4, horizontal_surroundings.data() + 2);
+            }
+
+            // Now that we know the surroundings, we can check all
+            // horizontal cases that would allow the bot to pass
+
+            /************ HORIZONTAL **************/
+
+            // ?  ?  ?
+            // x  -  ?
+            // x  -  ?
+            //--- o  ?
+            //    ?  ?
+            //    ?  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && !horizontal_surroundings[2].IsSolid()
+                && !horizontal_surroundings[2].IsHazardous()
+                && !horizontal_surroundings[3].IsEmpty()
+                && !horizontal_surroundings[3].IsHazardous()
+                && (!horizontal_surroundings[3].IsFluid()   // We can't go from above a fluid to above
+                    || !vertical_surroundings[3].IsFluid()  // another one to avoid "walking on water"
+                    || horizontal_surroundings[2].IsFluid() // except if one or both "leg level" blocks
+                    || vertical_surroundings[2].IsFluid())  // are also fluids
+                )
+            {
+                const bool above_block = horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[3].IsClimbable() || horizontal_surroundings[3].GetHeight() + 1e-3f > current_pos.y;
+                AddNode(next_location + Position(0, 1 - 1 * above_block, 0),
+                    above_block ? std::max(static_cast<float>(next_location.y), horizontal_surroundings[3].GetHeight()) : std::max(horizontal_surroundings[3].GetHeight(), horizontal_surroundings[4].GetHeight()),
+                    current_cost + 2.0f - 1.0f * above_block, index);
+            }
+
+
+            // -  -  ?
+            // x  o  ?
+            // x  ?  ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (!vertical_surroundings[0].IsSolid()
+                && !vertical_surroundings[0].IsHazardous()
+                && vertical_surroundings[1].IsEmpty()
+                && !vertical_surroundings[2].IsClimbable()
+                && (vertical_surroundings[2].IsSolid() || !vertical_surroundings[3].IsClimbable())
+                && !horizontal_surroundings[0].IsSolid()
+                && !horizontal_surroundings[0].IsHazardous()
+                && !horizontal_surroundings[1].IsEmpty()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[1].GetHeight() - current_height < 1.25f
+                )
+            {
+                AddNode(next_location + Position(0, 1, 0),
+                    std::max(horizontal_surroundings[1].GetHeight(), horizontal_surroundings[2].GetHeight()), // for the carpet on wall trick
+                    current_cost + 2.5f, index);
+            }
+
+            // -  -  ?
+            // x  -  ?
+            // x  o  ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (!vertical_surroundings[0].IsSolid()
+                && !vertical_surroundings[0].IsHazardous()
+                && vertical_surroundings[1].IsEmpty()
+                && (vertical_surroundings[2].IsSolid() || (vertical_surroundings[2].IsEmpty() && vertical_surroundings[3].IsSolid()))
+                && !horizontal_surroundings[0].IsSolid()
+                && !horizontal_surroundings[0].IsHazardous()
+                && !horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && !horizontal_surroundings[2].IsEmpty()
+                && !horizontal_surroundings[2].IsHazardous()
+                && horizontal_surroundings[2].GetHeight() - current_height < 1.25f
+                )
+            {
+                const bool above_block = horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[2].GetHeight() + 1e-3f > current_pos.y + 1;
+                AddNode(next_location + Position(0, 1 * above_block, 0),
+                    above_block ? std::max(current_pos.y + 1.0f, horizontal_surroundings[2].GetHeight()) : std::max(horizontal_surroundings[2].GetHeight(), horizontal_surroundings[3].GetHeight()),
+                    current_cost + 1.0f + 1.0f * above_block + 0.5f * (horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].GetHeight() - vertical_surroundings[2].GetHeight() > 0.5),
+                    index);
+            }
+
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //    o  ?
+            //    ?  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && !horizontal_surroundings[4].IsEmpty()
+                && !horizontal_surroundings[4].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[4].IsClimbable() || horizontal_surroundings[4].GetHeight() + 1e-3f > current_pos.y - 1;
+                AddNode(next_location + Position(0, -2 + 1 * above_block, 0),
+                    above_block ? std::max(current_pos.y - 1.0f, horizontal_surroundings[4].GetHeight()) : std::max(horizontal_surroundings[4].GetHeight(), horizontal_surroundings[5].GetHeight()),
+                    current_cost + 3.5f - 1.0f * above_block, index);
+            }
+
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //       ?
+            //    o  ?
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && horizontal_surroundings[4].IsEmpty()
+                && !horizontal_surroundings[5].IsEmpty()
+                && !horizontal_surroundings[5].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[5].IsClimbable() || horizontal_surroundings[5].GetHeight() + 1e-3f > current_pos.y - 2;
+                AddNode(next_location + Position(0, -3 + 1 * above_block, 0),
+                    above_block ? std::max(current_pos.y - 2.0f, horizontal_surroundings[5].GetHeight()) : horizontal_surroundings[5].GetHeight(), // no carpet on wall check here as we don't have the block below
+                    current_cost + 4.5f - 1.0f * above_block, index);
+            }
+
+            // ?  ?  ?
+            // x  -  ?
+            // x     ?
+            //---    ?
+            //       ?
+            //       ?
+            // Special case here, we can drop down
+            // if there is a climbable at the bottom
+            if (!horizontal_surroundings[1].IsSolid()
+                && !horizontal_surroundings[1].IsHazardous()
+                && horizontal_surroundings[2].IsEmpty()
+                && horizontal_surroundings[3].IsEmpty()
+                && horizontal_surroundings[4].IsEmpty()
+                && horizontal_surroundings[5].IsEmpty()
+                )
+            {
+                for (int y = -4; next_location.y + y >= min_y; --y)
+                {
+                    const PathfindingBlockstate landing_block = GetState(next_location + Position(0, y, 0));
+                    lowest_y = std::min(lowest_y, next_location.y + y);
+
+                    if (landing_block.StopsFalling())
+                    {
+                        break;
+                    }
+
+                    if (landing_block.IsClimbable())
+                    {
+                        AddNode(next_location + Position(0, y + 1, 0), next_location.y + y + 1.0f, current_cost + std::abs(y) + 1.5f, index);
+                        break;
+                    }
+                }
+            }
+
+            // If we can't make jumps, don't bother explore the rest
+            // of the cases
+            if (!allow_jump
+                || vertical_surroundings[0].IsSolid()       // Block above
+                || vertical_surroundings[0].IsHazardous()   // Block above
+                || !vertical_surroundings[1].IsEmpty()      // Block above
+                || vertical_surroundings[2].IsClimbable()   // Feet inside climbable
+                || vertical_surroundings[3].IsFluid()       // "Walking" on fluid
+                || vertical_surroundings[3].IsEmpty()       // Feet on nothing (inside climbable)
+                || horizontal_surroundings[0].IsSolid()     // Block above next column
+                || horizontal_surroundings[0].IsHazardous() // Hazard above next column
+                || !horizontal_surroundings[1].IsEmpty()    // Non empty block in next column, can't jump through it
+                || !horizontal_surroundings[2].IsEmpty()    // Non empty block in next column, can't jump through it
+                )
+            {
+                continue;
+            }
+
+            // We may jump, so we need the third column
+            horizontal_surroundings[6] = GetState(next_next_location + Position(0, 2, 0));
+            if (horizontal_surroundings[6].IsSolid()        // Block above nextnext column
+                || horizontal_surroundings[6].IsHazardous() // Hazard above nextnext column
+                )
+            {
+                continue;
+            }
+            GetColumn(next_next_location + Position(0, 1, 0), 5, horizontal_surroundings.data() + 7);
+
+            /************ BIG JUMP **************/
+            // -  -  -
+            // x     o
+            // x     ?
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (!horizontal_surroundings[7].IsEmpty()
+                && !horizontal_surroundings[7].IsHazardous()
+                && horizontal_surroundings[7].GetHeight() - current_height < 1.25f
+                )
+            {
+                // 5 > 4.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
+                // but if horizontal_surroundings[3] is hazardous we can jump over it
+                AddNode(next_next_location + Position(0, 1, 0),
+                    std::max(horizontal_surroundings[7].GetHeight(), horizontal_surroundings[8].GetHeight()), // for the carpet on wall trick
+                    current_cost + 5.0f, index);
+            }
+
+            // -  -  -
+            // x
+            // x     o
+            //--- ?  ?
+            //    ?  ?
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && !horizontal_surroundings[8].IsEmpty()
+                && !horizontal_surroundings[8].IsHazardous()
+                && horizontal_surroundings[8].GetHeight() - current_height < 1.25f
+                )
+            {
+                const bool above_block = horizontal_surroundings[8].IsClimbable() || horizontal_surroundings[8].GetHeight() + 1e-3f > current_pos.y + 1;
+                // 4 > 3.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
+                // but if horizontal_surroundings[3] is hazardous we can jump over it
+                AddNode(next_next_location + Position(0, above_block * 1, 0),
+                    above_block ? std::max(current_pos.y + 1.0f, horizontal_surroundings[8].GetHeight()) : std::max(horizontal_surroundings[8].GetHeight(), horizontal_surroundings[9].GetHeight()),
+                    current_cost + 3.0f + 1.0f * above_block, index);
+            }
+
+            // -  -  -
+            // x
+            // x
+            //--- ?  o
+            //    ?  ?
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && !horizontal_surroundings[9].IsEmpty()
+                && !horizontal_surroundings[9].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[9].IsClimbable() || horizontal_surroundings[9].GetHeight() + 1e-3f > current_pos.y;
+                AddNode(next_next_location + Position(0, -1 + 1 * above_block, 0),
+                    above_block ? std::max(static_cast<float>(current_pos.y), horizontal_surroundings[9].GetHeight()) : std::max(horizontal_surroundings[9].GetHeight(), horizontal_surroundings[10].GetHeight()),
+                    current_cost + 3.5f - 1.0f * above_block, index);
+            }
+
+            // -  -  -
+            // x
+            // x
+            //--- ?
+            //    ?  o
+            //    ?  ?
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && horizontal_surroundings[9].IsEmpty()
+                && !horizontal_surroundings[10].IsEmpty()
+                && !horizontal_surroundings[10].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[10].IsClimbable() || horizontal_surroundings[10].GetHeight() + 1e-3f > current_pos.y - 1;
+                AddNode(next_next_location + Position(0, -2 + 1 * above_block, 0),
+                    above_block ? std::max(current_pos.y - 1.0f, horizontal_surroundings[10].GetHeight()) : std::max(horizontal_surroundings[10].GetHeight(), horizontal_surroundings[11].GetHeight()),
+                    current_cost + 4.5f - 1.0f * above_block, index);
+            }
+
+            // -  -  -
+            // x
+            // x
+            //--- ?
+            //    ?
+            //    ?  o
+            if (horizontal_surroundings[7].IsEmpty()
+                && horizontal_surroundings[8].IsEmpty()
+                && horizontal_surroundings[9].IsEmpty()
+                && horizontal_surroundings[10].IsEmpty()
+                && !horizontal_surroundings[11].IsEmpty()
+                && !horizontal_surroundings[11].IsHazardous()
+                )
+            {
+                const bool above_block = horizontal_surroundings[11].IsClimbable() || horizontal_surroundings[11].GetHeight() + 1e-3f > current_pos.y - 2;
+                AddNode(next_next_location + Position(0, -3 + 1 * above_block, 0),
+                    above_block ? std::max(current_pos.y - 2.0f, horizontal_surroundings[11].GetHeight()) : horizontal_surroundings[11].GetHeight(),
+                    current_cost + 6.5f - 1.0f * above_block, index);
+            }
+        } // neighbour loop
+
+        nodes[index].low_y = lowest_y;
+    }
+} // Botcraft
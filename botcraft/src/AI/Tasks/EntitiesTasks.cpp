@@ -27,8 +27,9 @@ namespace Botcraft
         }
 
         std::shared_ptr<LocalPlayer> local_player = entity_manager->GetLocalPlayer();
+        const EntityPredictor& predictor = entity_manager->GetPredictor();
 
-        Vector3<double> entity_position = entity->GetPosition();
+        Vector3<double> entity_position = predictor.PredictPosition(entity_id, std::chrono::steady_clock::now()).value_or(entity->GetPosition());
         Vector3<double> position = local_player->GetPosition();
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
@@ -44,7 +45,7 @@ namespace Botcraft
                 return Status::Failure;
             }
 
-            entity_position = entity->GetPosition();
+            entity_position = predictor.PredictPosition(entity_id, std::chrono::steady_clock::now()).value_or(entity->GetPosition());
             position = local_player->GetPosition();
         }
 
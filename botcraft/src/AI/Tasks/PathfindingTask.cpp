@@ -1,5 +1,6 @@
 #include "botcraft/AI/BehaviourClient.hpp"
 #include "botcraft/AI/Blackboard.hpp"
+#include "botcraft/AI/HierarchicalPathfinder.hpp"
 #include "botcraft/AI/Tasks/PathfindingTask.hpp"
 #include "botcraft/Game/Entities/EntityManager.hpp"
 #include "botcraft/Game/Entities/LocalPlayer.hpp"
@@ -11,966 +12,15 @@
 
 namespace Botcraft
 {
-    class PathfindingBlockstate
-    {
-    public:
-        PathfindingBlockstate() = default;
-        PathfindingBlockstate(const Blockstate* block, const Position& pos, const bool take_damage) : block(block)
-        {
-            height = pos.y;
-            if (block == nullptr)
-            {
-                empty = true;
-                return;
-            }
-            empty = false;
-
-            if (take_damage && block->IsHazardous())
-            {
-                hazardous = true;
-                return;
-            }
-
-            if (block->IsFluidOrWaterlogged() && !block->IsSolid())
-            {
-                climbable = true;
-                fluid = true;
-                return;
-            }
-
-            if (block->IsClimbable())
-            {
-                climbable = true;
-                return;
-            }
-
-            if (block->IsSolid())
-            {
-                solid = true;
-                const auto& colliders = block->GetCollidersAtPos(pos);
-                for (const auto& c : colliders)
-                {
-                    height = std::max(static_cast<float>(c.GetMax().y), height);
-                }
-            }
-            else
-            {
-                empty = true;
-            }
-        }
-
-        const Blockstate* GetBlockstate() const { return block; }
-        bool IsEmpty() const { return empty; }
-        bool IsSolid() const { return solid; }
-        bool IsHazardous() const { return hazardous; }
-        bool IsClimbable() const { return climbable; }
-        bool IsFluid() const { return fluid; }
-        float GetHeight() const { return height; }
-
-    private:
-        const Blockstate* block = nullptr;
-        bool empty = true;
-        bool solid = false;
-        bool hazardous = false;
-        bool climbable = false;
-        bool fluid = false;
-        float height = 0.0f;
-    };
-
-    struct PosFloatPairHash
-    {
-    public:
-        size_t operator()(const std::pair<Position, float>& p) const
-        {
-            size_t value = std::hash<Position>()(p.first);
-            value ^= std::hash<float>()(p.second) + 0x9e3779b9 + (value << 6) + (value >> 2);
-            return value;
-        }
-    };
-
     std::vector<std::pair<Position, float>> FindPath(const BehaviourClient& client, const Position& start, const Position& end, const int dist_tolerance, const int min_end_dist, const int min_end_dist_xz, const bool allow_jump)
     {
-        struct PathNode
-        {
-            std::pair<Position, float> pos; // <Block in which the feet are, feet height>
-            float score; // distance from start + heuristic to goal
-
-            PathNode(const std::pair<Position, float>& p, const float s)
-            {
-                pos = p;
-                score = s;
-            }
-
-            bool operator>(const PathNode& rhs) const
-            {
-                return score > rhs.score;
-            }
-
-            static float Heuristic(const Position& a, const Position& b)
-            {
-                return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y) + std::abs(a.z - b.z));
-            }
-        };
-
-        constexpr int budget_visit = 15000;
-
-        const std::array<Position, 4> neighbour_offsets = { Position(1, 0, 0), Position(-1, 0, 0), Position(0, 0, 1), Position(0, 0, -1) };
-        std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode> > nodes_to_explore;
-        std::unordered_map<std::pair<Position, float>, std::pair<Position, float>, PosFloatPairHash> came_from;
-        std::unordered_map<std::pair<Position, float>, float, PosFloatPairHash> cost;
-
-        const bool takes_damage = !client.GetLocalPlayer()->GetInvulnerable();
-        std::shared_ptr<World> world = client.GetWorld();
-        const Blockstate* block = world->GetBlock(start);
-        nodes_to_explore.emplace(PathNode({ start, PathfindingBlockstate(block, start, takes_damage).GetHeight() }, 0.0f));
-        came_from[nodes_to_explore.top().pos] = nodes_to_explore.top().pos;
-        cost[nodes_to_explore.top().pos] = 0.0f;
-
-        int count_visit = 0;
-        // We found one location matching all the criterion, but
-        // continue the search to see if we can find a better one
-        bool suitable_location_found = false;
-        // We found a path to the desired goal
-        bool end_reached = false;
-
-        bool end_is_inside_solid = false;
-        block = world->GetBlock(end);
-        end_is_inside_solid = block != nullptr && block->IsSolid();
-
-        while (!nodes_to_explore.empty())
-        {
-            count_visit++;
-            PathNode current_node = nodes_to_explore.top();
-            nodes_to_explore.pop();
-
-            end_reached |= current_node.pos.first == end;
-            suitable_location_found |=
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) <= dist_tolerance &&
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.y - current_node.pos.first.y) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist &&
-                std::abs(end.x - current_node.pos.first.x) + std::abs(end.z - current_node.pos.first.z) >= min_end_dist_xz;
-
-            if (// If we exceeded the search budget
-                count_visit > budget_visit ||
-                // Or if we found a suitable location in the process and already reached the goal/can't reach it anyway
-                (suitable_location_found && (end_reached || end_is_inside_solid)))
-            {
-                break;
-            }
-
-            // Get the state around the player in the given location
-            std::array<PathfindingBlockstate, 6> vertical_surroundings;
-
-            // Assuming the player is standing on 3 (feeet on 2 and head on 1)
-            // 0
-            // 1
-            // 2
-            // 3
-            // 4
-            // 5
-            Position pos = current_node.pos.first + Position(0, 2, 0);
-            block = world->GetBlock(pos);
-            vertical_surroundings[0] = PathfindingBlockstate(block, pos, takes_damage);
-            pos = current_node.pos.first + Position(0, 1, 0);
-            block = world->GetBlock(pos);
-            vertical_surroundings[1] = PathfindingBlockstate(block, pos, takes_damage);
-            // Current feet block
-            pos = current_node.pos.first;
-            block = world->GetBlock(pos);
-            vertical_surroundings[2] = PathfindingBlockstate(block, pos, takes_damage);
-
-            // if 2 is solid or hazardous, no down pathfinding is possible,
-            // so we can skip a few checks
-            if (!vertical_surroundings[2].IsSolid() && !vertical_surroundings[2].IsHazardous())
-            {
-                // if 3 is solid or hazardous, no down pathfinding is possible,
-                // so we can skip a few checks
-                pos = current_node.pos.first + Position(0, -1, 0);
-                block = world->GetBlock(pos);
-                vertical_surroundings[3] = PathfindingBlockstate(block, pos, takes_damage);
-
-                // If we can move down, we need 4 and 5
-                if (!vertical_surroundings[3].IsSolid() && !vertical_surroundings[3].IsHazardous())
-                {
-                    pos = current_node.pos.first + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    vertical_surroundings[4] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = current_node.pos.first + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    vertical_surroundings[5] = PathfindingBlockstate(block, pos, takes_damage);
-                }
-            }
-
-
-            // Check all vertical cases that would allow the bot to pass
-            // -
-            // x
-            // ^
-            // ?
-            // ?
-            // ?
-            if (vertical_surroundings[2].IsClimbable()
-                && !vertical_surroundings[1].IsSolid()
-                && !vertical_surroundings[1].IsHazardous()
-                && !vertical_surroundings[0].IsSolid()
-                && !vertical_surroundings[0].IsHazardous()
-                )
-            {
-                const float new_cost = cost[current_node.pos] + 1.0f;
-                const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, 1, 0),
-                    current_node.pos.first.y + 1.0f
-                };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
-            }
-
-            // -
-            // ^
-            // x
-            // o
-            // ?
-            // ?
-            if (vertical_surroundings[1].IsClimbable()
-                && !vertical_surroundings[0].IsSolid()
-                && !vertical_surroundings[0].IsHazardous()
-                && (vertical_surroundings[2].IsSolid() || // we stand on top of 2
-                    (!vertical_surroundings[2].IsClimbable() && vertical_surroundings[3].IsSolid()) // if not, it means we stand on 3. Height difference check is not necessary, as the feet are in 2, we know 3 is at least 1 tall
-                   )
-                )
-            {
-                const float new_cost = cost[current_node.pos] + 1.5f;
-                const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, 1, 0),
-                    current_node.pos.first.y + 1.0f
-                };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
-            }
-
-            // ?
-            // x
-            //  
-            // -
-            // ?
-            // ?
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
-                )
-            {
-                const float new_cost = cost[current_node.pos] + 1.0f;
-                const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -1, 0),
-                    current_node.pos.first.y - 1.0f
-                };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(new_pos, new_cost + PathNode::Heuristic(new_pos.first, end)));
-                    came_from[new_pos] = current_node.pos;
-                }
-            }
-
-            // ?
-            // x
-            //  
-            // -
-            //  
-            // o
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
-                && vertical_surroundings[4].IsEmpty()
-                && !vertical_surroundings[5].IsEmpty()
-                && !vertical_surroundings[5].IsHazardous()
-                )
-            {
-                const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                const float new_cost = cost[current_node.pos] + 3.0f - 1.0f * above_block;
-                const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -3 + 1 * above_block, 0),
-                    above_block ? std::max(current_node.pos.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
-                };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
-            }
-
-
-
-            // ?
-            // x
-            // ^
-            //  
-            //  
-            // o
-            if (vertical_surroundings[2].IsClimbable()
-                && vertical_surroundings[3].IsEmpty()
-                && vertical_surroundings[4].IsEmpty()
-                && !vertical_surroundings[5].IsEmpty()
-                && !vertical_surroundings[5].IsHazardous()
-                )
-            {
-                const bool above_block = vertical_surroundings[5].IsClimbable() || vertical_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                const float new_cost = cost[current_node.pos] + 3.0f - 1.0f * above_block;
-                const std::pair<Position, float> new_pos = {
-                    current_node.pos.first + Position(0, -3 + 1 * above_block, 0),
-                    above_block ? std::max(current_node.pos.first.y - 2.0f, vertical_surroundings[5].GetHeight()) : vertical_surroundings[5].GetHeight()
-                };
-                auto it = cost.find(new_pos);
-                // If we don't already know this node with a better path, add it
-                if (it == cost.end() ||
-                    new_cost < it->second)
-                {
-                    cost[new_pos] = new_cost;
-                    nodes_to_explore.emplace(PathNode(
-                        new_pos,
-                        new_cost + PathNode::Heuristic(new_pos.first, end))
-                    );
-                    came_from[new_pos] = current_node.pos;
-                }
-            }
-
-
-            // ?
-            // x
-            //  
-            // -
-            //  
-            //  
-            // Special case here, we can drop down
-            // if there is a climbable at the bottom
-            if (!vertical_surroundings[2].IsSolid() &&
-                vertical_surroundings[3].IsClimbable()
-                && vertical_surroundings[4].IsEmpty()
-                && vertical_surroundings[5].IsEmpty()
-                )
-            {
-                for (int y = -4; current_node.pos.first.y + y >= world->GetMinY(); --y)
-                {
-                    pos = current_node.pos.first + Position(0, y, 0);
-                    block = world->GetBlock(pos);
-
-                    if (block != nullptr && block->IsSolid() && !block->IsClimbable())
-                    {
-                        break;
-                    }
-
-                    const PathfindingBlockstate landing_block(block, pos, takes_damage);
-                    if (landing_block.IsClimbable())
-                    {
-                        const float new_cost = cost[current_node.pos] + std::abs(y);
-                        const std::pair<Position, float> new_pos = {
-                            current_node.pos.first + Position(0, y + 1, 0),
-                            current_node.pos.first.y + y + 1.0f
-                        };
-                        auto it = cost.find(new_pos);
-                        // If we don't already know this node with a better path, add it
-                        if (it == cost.end() ||
-                            new_cost < it->second)
-                        {
-                            cost[new_pos] = new_cost;
-                            nodes_to_explore.emplace(PathNode(
-                                new_pos,
-                                new_cost + PathNode::Heuristic(new_pos.first, end))
-                            );
-                            came_from[new_pos] = current_node.pos;
-                        }
-
-                        break;
-                    }
-                }
-            }
-
-
-            // For each neighbour, check if it's reachable
-            // and add it to the search list if it is
-            for (int i = 0; i < neighbour_offsets.size(); ++i)
-            {
-                const Position next_location = current_node.pos.first + neighbour_offsets[i];
-                const Position next_next_location = next_location + neighbour_offsets[i];
-
-                // Get the state around the player in the given direction
-                std::array<PathfindingBlockstate, 12> horizontal_surroundings;
-
-                // Assuming the player is standing on v3 (feeet on v2 and head on v1)
-                // v0   0   6 --> ?  ?  ?
-                // v1   1   7 --> x  ?  ?
-                // v2   2   8 --> x  ?  ?
-                // v3   3   9 --> ?  ?  ?
-                // v4   4  10 --> ?  ?  ?
-                // v5   5  11 --> ?  ?  ?
-
-                // if 1 is solid and tall, no horizontal pathfinding is possible,
-                // so we can skip a lot of checks
-                pos = next_location + Position(0, 2, 0);
-                block = world->GetBlock(pos);
-                horizontal_surroundings[0] = PathfindingBlockstate(block, pos, takes_damage);
-                pos = next_location + Position(0, 1, 0);
-                block = world->GetBlock(pos);
-                horizontal_surroundings[1] = PathfindingBlockstate(block, pos, takes_damage);
-                const bool horizontal_movement =
-                    (!horizontal_surroundings[1].IsSolid() || // 1 is not solid
-                        (horizontal_surroundings[1].GetHeight() - current_node.pos.second < 1.25f && // or 1 is solid and small
-                            !horizontal_surroundings[0].IsSolid() && !horizontal_surroundings[0].IsHazardous())  // and 0 does not prevent standing
-                    ) && !horizontal_surroundings[1].IsHazardous();
-
-                // If we can move horizontally, get the full column
-                if (horizontal_movement)
-                {
-                    pos = next_location;
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[2] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[3] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[4] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_location + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[5] = PathfindingBlockstate(block, pos, takes_damage);
-                }
-
-                // You can't make large jumps if your feet are in a climbable block
-                // If we can jump, then we need the third column
-                if (allow_jump && !vertical_surroundings[2].IsClimbable())
-                {
-                    pos = next_next_location + Position(0, 2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[6] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, 1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[7] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location;
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[8] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -1, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[9] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -2, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[10] = PathfindingBlockstate(block, pos, takes_damage);
-                    pos = next_next_location + Position(0, -3, 0);
-                    block = world->GetBlock(pos);
-                    horizontal_surroundings[11] = PathfindingBlockstate(block, pos, takes_damage);
-                }
-
-                // Now that we know the surroundings, we can check all
-                // horizontal cases that would allow the bot to pass
-
-                /************ HORIZONTAL **************/
-
-                // ?  ?  ?
-                // x  -  ?
-                // x  -  ?
-                //--- o  ?
-                //    ?  ?
-                //    ?  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && !horizontal_surroundings[2].IsSolid()
-                    && !horizontal_surroundings[2].IsHazardous()
-                    && !horizontal_surroundings[3].IsEmpty()
-                    && !horizontal_surroundings[3].IsHazardous()
-                    && (!horizontal_surroundings[3].IsFluid()   // We can't go from above a fluid to above
-                        || !vertical_surroundings[3].IsFluid()  // another one to avoid "walking on water"
-                        || horizontal_surroundings[2].IsFluid() // except if one or both "leg level" blocks
-                        || vertical_surroundings[2].IsFluid())  // are also fluids
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[3].IsClimbable() || horizontal_surroundings[3].GetHeight() + 1e-3f > current_node.pos.first.y;
-                    const float new_cost = cost[current_node.pos] + 2.0f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1 - 1 * above_block, 0),
-                        above_block ? std::max(static_cast<float>(next_location.y), horizontal_surroundings[3].GetHeight()) : std::max(horizontal_surroundings[3].GetHeight(), horizontal_surroundings[4].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-
-                // -  -  ?
-                // x  o  ?
-                // x  ?  ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (!vertical_surroundings[0].IsSolid()
-                    && !vertical_surroundings[0].IsHazardous()
-                    && vertical_surroundings[1].IsEmpty()
-                    && !vertical_surroundings[2].IsClimbable()
-                    && (vertical_surroundings[2].IsSolid() || !vertical_surroundings[3].IsClimbable())
-                    && !horizontal_surroundings[0].IsSolid()
-                    && !horizontal_surroundings[0].IsHazardous()
-                    && !horizontal_surroundings[1].IsEmpty()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[1].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const float new_cost = cost[current_node.pos] + 2.5f;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1, 0),
-                        std::max(horizontal_surroundings[1].GetHeight(), horizontal_surroundings[2].GetHeight()) // for the carpet on wall trick
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // -  -  ?
-                // x  -  ?
-                // x  o  ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (!vertical_surroundings[0].IsSolid()
-                    && !vertical_surroundings[0].IsHazardous()
-                    && vertical_surroundings[1].IsEmpty()
-                    && (vertical_surroundings[2].IsSolid() || (vertical_surroundings[2].IsEmpty() && vertical_surroundings[3].IsSolid()))
-                    && !horizontal_surroundings[0].IsSolid()
-                    && !horizontal_surroundings[0].IsHazardous()
-                    && !horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && !horizontal_surroundings[2].IsEmpty()
-                    && !horizontal_surroundings[2].IsHazardous()
-                    && horizontal_surroundings[2].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].IsClimbable() || horizontal_surroundings[2].GetHeight() + 1e-3f > current_node.pos.first.y + 1;
-                    const float new_cost = cost[current_node.pos] + 1.0f + 1.0f * above_block + 0.5f * (horizontal_surroundings[1].IsClimbable() || horizontal_surroundings[2].GetHeight() - vertical_surroundings[2].GetHeight() > 0.5);
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y + 1.0f, horizontal_surroundings[2].GetHeight()) : std::max(horizontal_surroundings[2].GetHeight(), horizontal_surroundings[3].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //    o  ?
-                //    ?  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && !horizontal_surroundings[4].IsEmpty()
-                    && !horizontal_surroundings[4].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[4].IsClimbable() || horizontal_surroundings[4].GetHeight() + 1e-3f > current_node.pos.first.y - 1;
-                    const float new_cost = cost[current_node.pos] + 3.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, -2 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 1.0f, horizontal_surroundings[4].GetHeight()) : std::max(horizontal_surroundings[4].GetHeight(), horizontal_surroundings[5].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //       ?
-                //    o  ?
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && horizontal_surroundings[4].IsEmpty()
-                    && !horizontal_surroundings[5].IsEmpty()
-                    && !horizontal_surroundings[5].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[5].IsClimbable() || horizontal_surroundings[5].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                    const float new_cost = cost[current_node.pos] + 4.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_location + Position(0, -3 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 2.0f, horizontal_surroundings[5].GetHeight()) : horizontal_surroundings[5].GetHeight() // no carpet on wall check here as we don't have the block below
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // ?  ?  ?
-                // x  -  ?
-                // x     ?
-                //---    ?
-                //       ?
-                //       ?
-                // Special case here, we can drop down
-                // if there is a climbable at the bottom
-                if (!horizontal_surroundings[1].IsSolid()
-                    && !horizontal_surroundings[1].IsHazardous()
-                    && horizontal_surroundings[2].IsEmpty()
-                    && horizontal_surroundings[3].IsEmpty()
-                    && horizontal_surroundings[4].IsEmpty()
-                    && horizontal_surroundings[5].IsEmpty()
-                    )
-                {
-                    for (int y = -4; next_location.y + y >= world->GetMinY(); --y)
-                    {
-                        pos = next_location + Position(0, y, 0);
-                        block = world->GetBlock(pos);
-
-                        if (block != nullptr && block->IsSolid() && !block->IsClimbable())
-                        {
-                            break;
-                        }
-
-                        const PathfindingBlockstate landing_block(block, pos, takes_damage);
-                        if (landing_block.IsClimbable())
-                        {
-                            const float new_cost = cost[current_node.pos] + std::abs(y) + 1.5f;
-                            const std::pair<Position, float> new_pos = {
-                                next_location + Position(0, y + 1, 0),
-                                next_location.y + y + 1.0f
-                            };
-                            auto it = cost.find(new_pos);
-                            // If we don't already know this node with a better path, add it
-                            if (it == cost.end() ||
-                                new_cost < it->second)
-                            {
-                                cost[new_pos] = new_cost;
-                                nodes_to_explore.emplace(PathNode(
-                                    new_pos,
-                                    new_cost + PathNode::Heuristic(new_pos.first, end))
-                                );
-                                came_from[new_pos] = current_node.pos;
-                            }
-
-                            break;
-                        }
-                    }
-                }
-
-                // If we can't make jumps, don't bother explore the rest
-                // of the cases
-                if (!allow_jump
-                    || vertical_surroundings[0].IsSolid()       // Block above
-                    || vertical_surroundings[0].IsHazardous()   // Block above
-                    || !vertical_surroundings[1].IsEmpty()      // Block above
-                    || vertical_surroundings[2].IsClimbable()   // Feet inside climbable
-                    || vertical_surroundings[3].IsFluid()       // "Walking" on fluid
-                    || vertical_surroundings[3].IsEmpty()       // Feet on nothing (inside climbable)
-                    || horizontal_surroundings[0].IsSolid()     // Block above next column
-                    || horizontal_surroundings[0].IsHazardous() // Hazard above next column
-                    || !horizontal_surroundings[1].IsEmpty()    // Non empty block in next column, can't jump through it
-                    || !horizontal_surroundings[2].IsEmpty()    // Non empty block in next column, can't jump through it
-                    || horizontal_surroundings[6].IsSolid()     // Block above nextnext column
-                    || horizontal_surroundings[6].IsHazardous() // Hazard above nextnext column
-                    )
-                {
-                    continue;
-                }
-
-                /************ BIG JUMP **************/
-                // -  -  -
-                // x     o
-                // x     ?
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (!horizontal_surroundings[7].IsEmpty()
-                    && !horizontal_surroundings[7].IsHazardous()
-                    && horizontal_surroundings[7].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    // 5 > 4.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
-                    // but if horizontal_surroundings[3] is hazardous we can jump over it
-                    const float new_cost = cost[current_node.pos] + 5.0f;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, 1, 0),
-                        std::max(horizontal_surroundings[7].GetHeight(), horizontal_surroundings[8].GetHeight()), // for the carpet on wall trick
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // -  -  -
-                // x      
-                // x     o
-                //--- ?  ?
-                //    ?  ?
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && !horizontal_surroundings[8].IsEmpty()
-                    && !horizontal_surroundings[8].IsHazardous()
-                    && horizontal_surroundings[8].GetHeight() - current_node.pos.second < 1.25f
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[8].IsClimbable() || horizontal_surroundings[8].GetHeight() + 1e-3f > current_node.pos.first.y + 1;
-                    // 4 > 3.5 as if horizontal_surroundings[3] is solid we prefer to walk then jump instead of big jump
-                    // but if horizontal_surroundings[3] is hazardous we can jump over it
-                    const float new_cost = cost[current_node.pos] + 3.0f + 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, above_block * 1, 0),
-                        above_block ? std::max(current_node.pos.first.y + 1.0f, horizontal_surroundings[8].GetHeight()) : std::max(horizontal_surroundings[8].GetHeight(), horizontal_surroundings[9].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // -  -  -
-                // x      
-                // x      
-                //--- ?  o
-                //    ?  ?
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && !horizontal_surroundings[9].IsEmpty()
-                    && !horizontal_surroundings[9].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[9].IsClimbable() || horizontal_surroundings[9].GetHeight() + 1e-3f > current_node.pos.first.y;
-                    const float new_cost = cost[current_node.pos] + 3.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0,  -1 + 1 * above_block, 0),
-                        above_block ? std::max(static_cast<float>(current_node.pos.first.y), horizontal_surroundings[9].GetHeight()) : std::max(horizontal_surroundings[9].GetHeight(), horizontal_surroundings[10].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // -  -  -
-                // x      
-                // x      
-                //--- ?   
-                //    ?  o
-                //    ?  ?
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && horizontal_surroundings[9].IsEmpty()
-                    && !horizontal_surroundings[10].IsEmpty()
-                    && !horizontal_surroundings[10].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[10].IsClimbable() || horizontal_surroundings[10].GetHeight() + 1e-3f > current_node.pos.first.y - 1;
-                    const float new_cost = cost[current_node.pos] + 4.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, -2 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 1.0f, horizontal_surroundings[10].GetHeight()) : std::max(horizontal_surroundings[10].GetHeight(), horizontal_surroundings[11].GetHeight())
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-
-                // -  -  -
-                // x      
-                // x      
-                //--- ?   
-                //    ?   
-                //    ?  o
-                if (horizontal_surroundings[7].IsEmpty()
-                    && horizontal_surroundings[8].IsEmpty()
-                    && horizontal_surroundings[9].IsEmpty()
-                    && horizontal_surroundings[10].IsEmpty()
-                    && !horizontal_surroundings[11].IsEmpty()
-                    && !horizontal_surroundings[11].IsHazardous()
-                    )
-                {
-                    const bool above_block = horizontal_surroundings[11].IsClimbable() || horizontal_surroundings[11].GetHeight() + 1e-3f > current_node.pos.first.y - 2;
-                    const float new_cost = cost[current_node.pos] + 6.5f - 1.0f * above_block;
-                    const std::pair<Position, float> new_pos = {
-                        next_next_location + Position(0, -3 + 1 * above_block, 0),
-                        above_block ? std::max(current_node.pos.first.y - 2.0f, horizontal_surroundings[11].GetHeight()) : horizontal_surroundings[1].GetHeight()
-                    };
-                    auto it = cost.find(new_pos);
-                    // If we don't already know this node with a better path, add it
-                    if (it == cost.end() ||
-                        new_cost < it->second)
-                    {
-                        cost[new_pos] = new_cost;
-                        nodes_to_explore.emplace(PathNode(
-                            new_pos,
-                            new_cost + PathNode::Heuristic(new_pos.first, end))
-                        );
-                        came_from[new_pos] = current_node.pos;
-                    }
-                }
-            } // neighbour loop
-        }
-
-        auto it_end_path = came_from.begin();
-
-        // We search for the node respecting
-        // the criteria AND the closest to
-        // start as it should often lead
-        // to a shorter path. In case of a tie,
-        // take the one the closest to the end
-        int best_dist = std::numeric_limits<int>::max();
-        int best_dist_start = std::numeric_limits<int>::max();
-        for (auto it = came_from.begin(); it != came_from.end(); ++it)
-        {
-            const Position diff = it->first.first - end;
-            const int d_xz = std::abs(diff.x) + std::abs(diff.z);
-            const int d = d_xz + std::abs(diff.y);
-            const Position diff_start = it->first.first - start;
-            const int d_start = std::abs(diff_start.x) + std::abs(diff_start.y) + std::abs(diff_start.z);
-            if (d <= dist_tolerance && d >= min_end_dist && d_xz >= min_end_dist_xz &&
-                (d_start < best_dist_start || (d_start == best_dist_start && d < best_dist))
-                )
-            {
-                best_dist = d;
-                best_dist_start = d_start;
-                it_end_path = it;
-            }
-        }
-
-        // There were no node respecting the criteria in the search,
-        // this might mean we reached search limit
-        // Take closest node to the goal in this case
-        if (best_dist == std::numeric_limits<int>::max())
-        {
-            for (auto it = came_from.begin(); it != came_from.end(); ++it)
-            {
-                const Position diff = it->first.first - end;
-                const int d_xz = std::abs(diff.x) + std::abs(diff.z);
-                const int d = d_xz + std::abs(diff.y);
-                const Position diff_start = it->first.first - start;
-                const int d_start = std::abs(diff_start.x) + std::abs(diff_start.y) + std::abs(diff_start.z);
-                if (d < best_dist || (d == best_dist && d_start < best_dist_start))
-                {
-                    best_dist = d;
-                    best_dist_start = d_start;
-                    it_end_path = it;
-                }
-            }
-        }
-
-        std::deque<std::pair<Position, float>> output_deque;
-        output_deque.push_front(it_end_path->first);
-        while (it_end_path->second.first != start)
-        {
-            it_end_path = came_from.find(it_end_path->second);
-            output_deque.push_front(it_end_path->first);
-        }
-        
-        return std::vector<std::pair<Position, float>>(output_deque.begin(), output_deque.end());
+        // One pathfinder per thread, so its memory is reused between searches.
+        // Long trips go through the section graph, short ones directly use
+        // the block-level engine. Bots going back and forth between the same
+        // places reuse their paths, and replanning after a block change only
+        // searches again the parts of the previous search depending on it
+        thread_local HierarchicalPathfinder pathfinder;
+        return pathfinder.FindPath(*client.GetWorld(), !client.GetLocalPlayer()->GetInvulnerable(), start, end, dist_tolerance, min_end_dist, min_end_dist_xz, allow_jump);
     }
 
     // a75f87e0-0583-435b-847a-cf0c18ede2d1
@@ -1,6 +1,8 @@
+#include <array>
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <random>
 #include <set>
 
 #include "botcraft/Game/AssetsManager.hpp"
@@ -12,12 +14,84 @@
 #include "botcraft/Renderer/Atlas.hpp"
 #endif
 
+#include "protocolCraft/BinaryReadWrite.hpp"
 #include "protocolCraft/Utilities/Json.hpp"
 
 using namespace ProtocolCraft;
 
 namespace Botcraft
 {
+#if !USE_GUI
+    namespace
+    {
+        constexpr std::array<char, 4> bundle_magic = { 'B', 'C', 'A', 'S' };
+        /// @brief Must be incremented each time the data written by SaveBundle or
+        /// the way it's computed from the json files change, so existing bundles are rebuilt
+        constexpr int bundle_format_version = 3;
+
+        /// @brief FNV-1a hash of the size and modification time of a file
+        unsigned long long int HashFileStatus(const std::filesystem::path& file_path, unsigned long long int hash)
+        {
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(file_path, ec);
+            const long long int size_value = ec ? -1 : static_cast<long long int>(size);
+            const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(file_path, ec);
+            const long long int time_value = ec ? -1 : static_cast<long long int>(write_time.time_since_epoch().count());
+            for (const long long int value : { size_value, time_value })
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    hash ^= (static_cast<unsigned long long int>(value) >> (8 * i)) & 0xFF;
+                    hash *= 0x100000001b3ULL;
+                }
+            }
+            return hash;
+        }
+
+        /// @brief Header expected at the beginning of a valid bundle. As it
+        /// contains the size and modification time of the json files (including
+        /// all blockstates and models), any change in the assets invalidates the bundle
+        std::vector<unsigned char> GetBundleHeader()
+        {
+            std::vector<unsigned char> header(bundle_magic.begin(), bundle_magic.end());
+            WriteData<VarInt>(bundle_format_version, header);
+            WriteData<VarInt>(PROTOCOL_VERSION, header);
+            for (const char* file : { "Blocks_info.json", "Blocks.json", "Biomes.json", "Items.json" })
+            {
+                WriteData<VarLong>(static_cast<long long int>(HashFileStatus(ASSETS_PATH + std::string("/custom/") + file, 0xcbf29ce484222325ULL)), header);
+            }
+            // Blockstates and models are read from both folders
+            for (const char* folder : { "/custom/blockstates", "/custom/models", "/minecraft/blockstates", "/minecraft/models" })
+            {
+                // Directory iteration order is unspecified, so files are combined with a commutative sum
+                unsigned long long int folder_hash = 0;
+                long long int num_files = 0;
+                const std::filesystem::path folder_path = ASSETS_PATH + std::string(folder);
+                std::error_code ec;
+                for (std::filesystem::recursive_directory_iterator it(folder_path, ec), end; !ec && it != end; it.increment(ec))
+                {
+                    if (!it->is_regular_file(ec))
+                    {
+                        continue;
+                    }
+                    const std::string relative_path = std::filesystem::relative(it->path(), folder_path, ec).generic_string();
+                    unsigned long long int file_hash = 0xcbf29ce484222325ULL;
+                    for (const char c : relative_path)
+                    {
+                        file_hash ^= static_cast<unsigned char>(c);
+                        file_hash *= 0x100000001b3ULL;
+                    }
+                    folder_hash += HashFileStatus(it->path(), file_hash);
+                    num_files += 1;
+                }
+                WriteData<VarLong>(num_files, header);
+                WriteData<VarLong>(static_cast<long long int>(folder_hash), header);
+            }
+            return header;
+        }
+    }
+#endif
+
     AssetsManager& AssetsManager::getInstance()
     {
         static AssetsManager instance;
@@ -33,15 +107,26 @@ namespace Botcraft
             LOG_FATAL("Minecraft assets folder expected at " << std::filesystem::absolute(expected_mc_path) << " but not found");
             throw std::runtime_error("Minecraft assets not found");
         }
-        LOG_INFO("Loading blocks from file...");
-        LoadBlocksFile();
-        LOG_INFO("Done!");
-        LOG_INFO("Loading biomes from file...");
-        LoadBiomesFile();
-        LOG_INFO("Done!");
-        LOG_INFO("Loading items from file...");
-        LoadItemsFile();
-        LOG_INFO("Done!");
+#if !USE_GUI
+        // Models textures are not stored in the bundle, so it's only used without GUI
+        const std::string bundle_path = ASSETS_PATH + std::string("/custom/assets.bundle");
+        if (!LoadBundle(bundle_path))
+#endif
+        {
+            LOG_INFO("Loading blocks from file...");
+            LoadBlocksFile();
+            LoadWalkabilities();
+            LOG_INFO("Done!");
+            LOG_INFO("Loading biomes from file...");
+            LoadBiomesFile();
+            LOG_INFO("Done!");
+            LOG_INFO("Loading items from file...");
+            LoadItemsFile();
+            LOG_INFO("Done!");
+#if !USE_GUI
+            SaveBundle(bundle_path);
+#endif
+        }
 #if USE_GUI
         LOG_INFO("Loading textures...");
         atlas = std::make_unique<Renderer::Atlas>();
@@ -106,6 +191,16 @@ namespace Botcraft
 #endif
     }
 
+    Walkability AssetsManager::GetWalkability(const BlockstateId id) const
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        const unsigned int index = Blockstate::IdMetadataToId(id.first, id.second);
+#else
+        const unsigned int index = id;
+#endif
+        return index < walkabilities.size() ? walkabilities[index] : default_walkability;
+    }
+
     const Blockstate* AssetsManager::GetBlockstate(const std::string& name) const
     {
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
@@ -857,6 +952,46 @@ namespace Botcraft
     }
 #endif
 
+    void AssetsManager::LoadWalkabilities()
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        default_walkability = blockstates.at(-1).at(0)->GetWalkability();
+        // 12 bits for id, 4 for metadata
+        walkabilities = std::vector<Walkability>(1 << 16, default_walkability);
+        for (const auto& [id, blocks] : blockstates)
+        {
+            if (id < 0 || id >= (1 << 12))
+            {
+                continue;
+            }
+            // Unknown metadata are replaced by metadata 0, see GetBlockstate
+            auto it = blocks.find(0);
+            const Walkability base = it != blocks.end() ? it->second->GetWalkability() : default_walkability;
+            for (unsigned char metadata = 0; metadata < 16; ++metadata)
+            {
+                walkabilities[Blockstate::IdMetadataToId(id, metadata)] = base;
+            }
+            for (const auto& [metadata, block] : blocks)
+            {
+                if (metadata < 16)
+                {
+                    walkabilities[Blockstate::IdMetadataToId(id, metadata)] = block->GetWalkability();
+                }
+            }
+        }
+#else
+        default_walkability = blockstates.at(-1)->GetWalkability();
+        walkabilities = std::vector<Walkability>(flattened_blockstates_size, default_walkability);
+        for (size_t i = 0; i < flattened_blockstates_size; ++i)
+        {
+            if (flattened_blockstates[i] != nullptr)
+            {
+                walkabilities[i] = flattened_blockstates[i]->GetWalkability();
+            }
+        }
+#endif
+    }
+
     void AssetsManager::LoadBiomesFile()
     {
         std::string file_path = ASSETS_PATH + std::string("/custom/Biomes.json");
@@ -1090,6 +1225,178 @@ namespace Botcraft
         Model::ClearCache();
     }
 
+#if !USE_GUI
+    bool AssetsManager::LoadBundle(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        const std::vector<unsigned char> data = std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        file.close();
+
+        const std::vector<unsigned char> header = GetBundleHeader();
+        if (data.size() < header.size() || !std::equal(header.begin(), header.end(), data.begin()))
+        {
+            LOG_INFO("Assets bundle at " << path << " is outdated, it will be rebuilt from json files");
+            return false;
+        }
+
+        LOG_INFO("Loading assets from bundle...");
+        ReadIterator iter = data.begin() + header.size();
+        size_t length = data.size() - header.size();
+        try
+        {
+            const std::vector<size_t> models_mapping = Blockstate::ReadModelsBinary(iter, length);
+
+            const int num_blockstates = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_blockstates; ++i)
+            {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+                const int id = ReadData<VarInt>(iter, length);
+                const unsigned char metadata = ReadData<unsigned char>(iter, length);
+                blockstates[id][metadata] = std::make_unique<Blockstate>(iter, length, models_mapping);
+#else
+                const int id = ReadData<VarInt>(iter, length);
+                blockstates[id] = std::make_unique<Blockstate>(iter, length, models_mapping);
+#endif
+            }
+
+            const int num_biomes = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_biomes; ++i)
+            {
+                const int id = ReadData<VarInt>(iter, length);
+                const std::string name = ReadData<std::string>(iter, length);
+                const float temperature = ReadData<float>(iter, length);
+                const float rainfall = ReadData<float>(iter, length);
+                const BiomeType biome_type = static_cast<BiomeType>(ReadData<VarInt>(iter, length));
+                biomes[id] = std::make_unique<Biome>(name, temperature, rainfall, biome_type);
+            }
+
+            const int num_items = ReadData<VarInt>(iter, length);
+            for (int i = 0; i < num_items; ++i)
+            {
+                ItemProperties props;
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+                props.id.first = ReadData<VarInt>(iter, length);
+                props.id.second = ReadData<unsigned char>(iter, length);
+#else
+                props.id = ReadData<VarInt>(iter, length);
+#endif
+                props.name = ReadData<std::string>(iter, length);
+                props.stack_size = ReadData<unsigned char>(iter, length);
+                props.durability = ReadData<VarInt>(iter, length);
+                items[props.id] = std::make_unique<Item>(props);
+            }
+
+            if (length != 0)
+            {
+                throw std::runtime_error("Unexpected data at the end of the bundle");
+            }
+
+#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
+            FlattenBlocks();
+#endif
+            LoadWalkabilities();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Error reading assets bundle at " << path << ", it will be rebuilt from json files" << '\n' << e.what());
+            blockstates.clear();
+#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
+            flattened_blockstates.clear();
+            flattened_blockstates_size = 0;
+#endif
+            walkabilities.clear();
+            biomes.clear();
+            items.clear();
+            return false;
+        }
+        LOG_INFO("Done!");
+
+        return true;
+    }
+
+    void AssetsManager::SaveBundle(const std::string& path) const
+    {
+        std::vector<unsigned char> data = GetBundleHeader();
+
+        Blockstate::WriteModelsBinary(data);
+
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        int num_blockstates = 0;
+        for (const auto& [id, blocks] : blockstates)
+        {
+            num_blockstates += static_cast<int>(blocks.size());
+        }
+        WriteData<VarInt>(num_blockstates, data);
+        // [id][0] may be a copy of another metadata, so keys are written separately from the blockstates ids
+        for (const auto& [id, blocks] : blockstates)
+        {
+            for (const auto& [metadata, block] : blocks)
+            {
+                WriteData<VarInt>(id, data);
+                WriteData<unsigned char>(metadata, data);
+                block->WriteBinary(data);
+            }
+        }
+#else
+        WriteData<VarInt>(static_cast<int>(blockstates.size()), data);
+        for (const auto& [id, block] : blockstates)
+        {
+            WriteData<VarInt>(id, data);
+            block->WriteBinary(data);
+        }
+#endif
+
+        WriteData<VarInt>(static_cast<int>(biomes.size()), data);
+        for (const auto& [id, biome] : biomes)
+        {
+            WriteData<VarInt>(id, data);
+            WriteData<std::string>(biome->GetName(), data);
+            WriteData<float>(biome->GetTemperature(), data);
+            WriteData<float>(biome->GetRainfall(), data);
+            WriteData<VarInt>(static_cast<int>(biome->GetBiomeType()), data);
+        }
+
+        WriteData<VarInt>(static_cast<int>(items.size()), data);
+        for (const auto& [id, item] : items)
+        {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+            WriteData<VarInt>(id.first, data);
+            WriteData<unsigned char>(id.second, data);
+#else
+            WriteData<VarInt>(id, data);
+#endif
+            WriteData<std::string>(item->GetName(), data);
+            WriteData<unsigned char>(item->GetStackSize(), data);
+            WriteData<VarInt>(item->GetMaxDurability(), data);
+        }
+
+        // Write in a temporary file first so another process never reads a partial bundle
+        const std::string tmp_path = path + "." + std::to_string(std::random_device()()) + ".tmp";
+        std::ofstream file(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+        const bool written = file.is_open() && file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.close();
+
+        std::error_code ec;
+        if (!written)
+        {
+            LOG_WARNING("Can't write assets bundle at " << tmp_path << ", assets will be loaded from json files again next time");
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            LOG_WARNING("Can't write assets bundle at " << path << ", assets will be loaded from json files again next time" << '\n' << ec.message());
+            std::filesystem::remove(tmp_path, ec);
+        }
+    }
+#endif
+
 #if USE_GUI
     void AssetsManager::UpdateModelsWithAtlasData()
     {
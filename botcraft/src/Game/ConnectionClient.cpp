@@ -1,5 +1,7 @@
 #include "botcraft/Game/ConnectionClient.hpp"
 #include "botcraft/Network/NetworkManager.hpp"
+#include "botcraft/Network/DecodePool.hpp"
+#include "botcraft/Network/NetworkPool.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 
 using namespace ProtocolCraft;
@@ -19,10 +21,18 @@ namespace Botcraft
 
     void ConnectionClient::Connect(const std::string& address, const std::string& login, const bool force_microsoft_account)
     {
-        network_manager = std::make_shared<NetworkManager>(address, login, force_microsoft_account);
+        network_manager = std::make_shared<NetworkManager>(address, login, force_microsoft_account, decode_pool, capture_path, network_pool);
         network_manager->AddHandler(this);
     }
 
+    void ConnectionClient::Replay(const std::string& capture_path, const std::string& login, const bool real_time)
+    {
+        network_manager = NetworkManager::FromCapture(capture_path, login, decode_pool);
+        // Add the handler before starting so no packet is missed
+        network_manager->AddHandler(this);
+        network_manager->StartReplay(real_time);
+    }
+
     void ConnectionClient::Disconnect()
     {
         should_be_closed = true;
@@ -33,6 +43,21 @@ namespace Botcraft
         network_manager.reset();
     }
 
+    void ConnectionClient::SetDecodePool(const std::shared_ptr<DecodePool>& decode_pool_)
+    {
+        decode_pool = decode_pool_;
+    }
+
+    void ConnectionClient::SetNetworkPool(const std::shared_ptr<NetworkPool>& network_pool_)
+    {
+        network_pool = network_pool_;
+    }
+
+    void ConnectionClient::SetCapturePath(const std::string& capture_path_)
+    {
+        capture_path = capture_path_;
+    }
+
     bool ConnectionClient::GetShouldBeClosed() const
     {
         return should_be_closed;
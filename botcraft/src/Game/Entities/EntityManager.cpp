@@ -1,12 +1,39 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include "botcraft/Game/Entities/EntityManager.hpp"
 #include "botcraft/Game/Entities/entities/Entity.hpp"
 #include "botcraft/Game/Entities/entities/UnknownEntity.hpp"
 #include "botcraft/Game/Entities/LocalPlayer.hpp"
+#include "botcraft/Game/Physics/AABB.hpp"
 
 #include "botcraft/Utilities/Logger.hpp"
 
 namespace Botcraft
 {
+    namespace
+    {
+        /// @brief Cell coordinates are clamped so they fit in 21 bits
+        constexpr int max_cell_coord = (1 << 20) - 1;
+
+        int CellCoord(const double v, const int cell_size)
+        {
+            if (std::isnan(v))
+            {
+                return 0;
+            }
+            return static_cast<int>(std::clamp(std::floor(v / cell_size), static_cast<double>(-max_cell_coord), static_cast<double>(max_cell_coord)));
+        }
+
+        uint64_t CellKey(const int x, const int y, const int z)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(x) & 0x1FFFFF) << 42) |
+                (static_cast<uint64_t>(static_cast<uint32_t>(y) & 0x1FFFFF) << 21) |
+                static_cast<uint64_t>(static_cast<uint32_t>(z) & 0x1FFFFF);
+        }
+    }
+
     EntityManager::EntityManager()
     {
         local_player = nullptr;
@@ -31,8 +58,21 @@ namespace Botcraft
             return;
         }
 
+        const int id = entity->GetEntityID();
+        const Vector3<double> position = entity->GetPosition();
+
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
-        entities[entity->GetEntityID()] = entity;
+        entities[id] = entity;
+        if (entity == local_player)
+        {
+            UnindexEntity(id);
+            predictor.RemoveEntity(id);
+        }
+        else
+        {
+            IndexEntity(id, entity, position);
+            predictor.AddEntity(id, EntityPredictor::GetMotionModel(*entity), position, entity->GetSpeed(), std::chrono::steady_clock::now());
+        }
     }
 
     Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock> EntityManager::GetEntities() const
@@ -40,6 +80,251 @@ namespace Botcraft
         return Utilities::ScopeLockedWrapper<const std::unordered_map<int, std::shared_ptr<Entity>>, std::shared_mutex, std::shared_lock>(entities, entity_manager_mutex);
     }
 
+    template<class F>
+    void EntityManager::ForEachIndexedEntity(const Vector3<double>& min, const Vector3<double>& max, const std::optional<EntityType> type, F&& f) const
+    {
+        const auto visit = [&](const std::vector<std::pair<int, std::shared_ptr<Entity>>>& cell)
+        {
+            for (const auto& [id, entity] : cell)
+            {
+                if (type.has_value() && entity->GetType() != type.value())
+                {
+                    continue;
+                }
+                const Vector3<double> position = entity->GetPosition();
+                if (position.x >= min.x && position.x <= max.x &&
+                    position.y >= min.y && position.y <= max.y &&
+                    position.z >= min.z && position.z <= max.z)
+                {
+                    f(entity, position);
+                }
+            }
+        };
+
+        const int min_x = CellCoord(min.x, index_cell_size);
+        const int min_y = CellCoord(min.y, index_cell_size);
+        const int min_z = CellCoord(min.z, index_cell_size);
+        const int max_x = CellCoord(max.x, index_cell_size);
+        const int max_y = CellCoord(max.y, index_cell_size);
+        const int max_z = CellCoord(max.z, index_cell_size);
+
+        const size_t num_cells = static_cast<size_t>(max_x - min_x + 1) * static_cast<size_t>(max_y - min_y + 1) * static_cast<size_t>(max_z - min_z + 1);
+        // Large box, cheaper to go through all the non empty cells
+        if (num_cells >= index_cells.size())
+        {
+            for (const auto& [key, cell] : index_cells)
+            {
+                visit(cell);
+            }
+            return;
+        }
+
+        for (int x = min_x; x <= max_x; ++x)
+        {
+            for (int y = min_y; y <= max_y; ++y)
+            {
+                for (int z = min_z; z <= max_z; ++z)
+                {
+                    auto it = index_cells.find(CellKey(x, y, z));
+                    if (it != index_cells.end())
+                    {
+                        visit(it->second);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<Entity>> EntityManager::QueryRadius(const Vector3<double>& center, const double radius, const std::optional<EntityType> type) const
+    {
+        std::vector<std::shared_ptr<Entity>> output;
+        const double sqr_radius = radius * radius;
+
+        std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+        ForEachIndexedEntity(center - Vector3<double>(radius), center + Vector3<double>(radius), type,
+            [&](const std::shared_ptr<Entity>& entity, const Vector3<double>& position)
+            {
+                if ((position - center).SqrNorm() <= sqr_radius)
+                {
+                    output.push_back(entity);
+                }
+            });
+        return output;
+    }
+
+    std::vector<std::shared_ptr<Entity>> EntityManager::QueryAABB(const AABB& aabb, const std::optional<EntityType> type) const
+    {
+        std::vector<std::shared_ptr<Entity>> output;
+
+        std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+        ForEachIndexedEntity(aabb.GetMin(), aabb.GetMax(), type,
+            [&](const std::shared_ptr<Entity>& entity, const Vector3<double>&)
+            {
+                output.push_back(entity);
+            });
+        return output;
+    }
+
+    std::vector<std::shared_ptr<Entity>> EntityManager::Nearest(const Vector3<double>& pos, const size_t k, const std::optional<EntityType> type) const
+    {
+        std::vector<std::pair<double, std::shared_ptr<Entity>>> candidates;
+        const auto add_candidates = [&](const std::vector<std::pair<int, std::shared_ptr<Entity>>>& cell)
+        {
+            for (const auto& [id, entity] : cell)
+            {
+                if (!type.has_value() || entity->GetType() == type.value())
+                {
+                    candidates.emplace_back((entity->GetPosition() - pos).SqrNorm(), entity);
+                }
+            }
+        };
+        const auto closer = [](const std::pair<double, std::shared_ptr<Entity>>& a, const std::pair<double, std::shared_ptr<Entity>>& b)
+        {
+            return a.first < b.first;
+        };
+
+        {
+            std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+            if (k == 0 || index_cells.empty())
+            {
+                return {};
+            }
+
+            const int center_x = CellCoord(pos.x, index_cell_size);
+            const int center_y = CellCoord(pos.y, index_cell_size);
+            const int center_z = CellCoord(pos.z, index_cell_size);
+
+            // Visit rings of cells around pos until the k closest entities
+            // found so far are closer than any entity outside the rings
+            for (int r = 0; ; ++r)
+            {
+                // Cheaper to go through all the cells
+                const size_t side = 2 * static_cast<size_t>(r) + 1;
+                if (side * side * side >= index_cells.size())
+                {
+                    candidates.clear();
+                    for (const auto& [key, cell] : index_cells)
+                    {
+                        add_candidates(cell);
+                    }
+                    break;
+                }
+
+                for (int x = -r; x <= r; ++x)
+                {
+                    for (int y = -r; y <= r; ++y)
+                    {
+                        // Only the border of the cube, inner cells have already been visited
+                        const bool inner = std::abs(x) != r && std::abs(y) != r;
+                        for (int z = -r; z <= r; z += (inner && r > 0) ? 2 * r : 1)
+                        {
+                            auto it = index_cells.find(CellKey(center_x + x, center_y + y, center_z + z));
+                            if (it != index_cells.end())
+                            {
+                                add_candidates(it->second);
+                            }
+                        }
+                    }
+                }
+
+                if (candidates.size() >= k)
+                {
+                    std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), closer);
+                    const double ring_dist = static_cast<double>(r * index_cell_size);
+                    if (candidates[k - 1].first <= ring_dist * ring_dist)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+
+        const size_t num_output = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + num_output, candidates.end(), closer);
+
+        std::vector<std::shared_ptr<Entity>> output;
+        output.reserve(num_output);
+        for (size_t i = 0; i < num_output; ++i)
+        {
+            output.push_back(std::move(candidates[i].second));
+        }
+        return output;
+    }
+
+    const EntityPredictor& EntityManager::GetPredictor() const
+    {
+        return predictor;
+    }
+
+    void EntityManager::IndexEntity(const int id, const std::shared_ptr<Entity>& entity, const Vector3<double>& position)
+    {
+        const uint64_t key = CellKey(CellCoord(position.x, index_cell_size), CellCoord(position.y, index_cell_size), CellCoord(position.z, index_cell_size));
+
+        auto it = indexed_entities.find(id);
+        if (it != indexed_entities.end())
+        {
+            if (it->second.first == key)
+            {
+                index_cells[key][it->second.second].second = entity;
+                return;
+            }
+            UnindexEntity(id);
+        }
+
+        std::vector<std::pair<int, std::shared_ptr<Entity>>>& cell = index_cells[key];
+        indexed_entities[id] = { key, cell.size() };
+        cell.emplace_back(id, entity);
+    }
+
+    void EntityManager::UnindexEntity(const int id)
+    {
+        auto it = indexed_entities.find(id);
+        if (it == indexed_entities.end())
+        {
+            return;
+        }
+
+        auto cell_it = index_cells.find(it->second.first);
+        std::vector<std::pair<int, std::shared_ptr<Entity>>>& cell = cell_it->second;
+        const size_t index = it->second.second;
+        // Swap with the last one to remove in constant time
+        if (index != cell.size() - 1)
+        {
+            cell[index] = std::move(cell.back());
+            indexed_entities[cell[index].first].second = index;
+        }
+        cell.pop_back();
+        if (cell.empty())
+        {
+            index_cells.erase(cell_it);
+        }
+        indexed_entities.erase(it);
+    }
+
+    void EntityManager::UpdateEntityIndex(const int id, const Vector3<double>& position)
+    {
+        const uint64_t key = CellKey(CellCoord(position.x, index_cell_size), CellCoord(position.y, index_cell_size), CellCoord(position.z, index_cell_size));
+
+        // Most moves don't change cell, don't block readers for them
+        {
+            std::shared_lock<std::shared_mutex> lock(entity_manager_mutex);
+            auto it = indexed_entities.find(id);
+            if (it == indexed_entities.end() || it->second.first == key)
+            {
+                return;
+            }
+        }
+
+        std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
+        auto it = indexed_entities.find(id);
+        if (it == indexed_entities.end())
+        {
+            return;
+        }
+        const std::shared_ptr<Entity> entity = index_cells[it->second.first][it->second.second].second;
+        IndexEntity(id, entity, position);
+    }
+
 
     void EntityManager::Handle(ProtocolCraft::ClientboundLoginPacket& msg)
     {
@@ -52,6 +337,8 @@ namespace Botcraft
 #endif
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities[msg.GetPlayerId()] = local_player;
+        UnindexEntity(msg.GetPlayerId());
+        predictor.RemoveEntity(msg.GetPlayerId());
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
@@ -64,6 +351,7 @@ namespace Botcraft
             std::shared_ptr<Entity> entity = std::make_shared<UnknownEntity>();
             entity->SetEntityID(msg.GetEntityId());
             entities[msg.GetEntityId()] = entity;
+            IndexEntity(msg.GetEntityId(), entity, entity->GetPosition());
         }
     }
 #endif
@@ -84,11 +372,14 @@ namespace Botcraft
         if (entity != nullptr)
         {
             const Vector3<double> entity_position = entity->GetPosition();
-            entity->SetPosition(Vector3<double>(
+            const Vector3<double> new_position(
                 (msg.GetXA() / 128.0f + entity_position.x * 32.0f) / 32.0f,
                 (msg.GetYA() / 128.0f + entity_position.y * 32.0f) / 32.0f,
                 (msg.GetZA() / 128.0f + entity_position.z * 32.0f) / 32.0f
-            ));
+            );
+            entity->SetPosition(new_position);
+            UpdateEntityIndex(msg.GetEntityId(), new_position);
+            predictor.UpdatePosition(msg.GetEntityId(), new_position, msg.GetOnGround(), std::chrono::steady_clock::now());
             entity->SetOnGround(msg.GetOnGround());
         }
     }
@@ -109,11 +400,14 @@ namespace Botcraft
         if (entity != nullptr)
         {
             const Vector3<double> entity_position = entity->GetPosition();
-            entity->SetPosition(Vector3<double>(
+            const Vector3<double> new_position(
                 (msg.GetXA() / 128.0f + entity_position.x * 32.0f) / 32.0f,
                 (msg.GetYA() / 128.0f + entity_position.y * 32.0f) / 32.0f,
                 (msg.GetZA() / 128.0f + entity_position.z * 32.0f) / 32.0f
-            ));
+            );
+            entity->SetPosition(new_position);
+            UpdateEntityIndex(msg.GetEntityId(), new_position);
+            predictor.UpdatePosition(msg.GetEntityId(), new_position, msg.GetOnGround(), std::chrono::steady_clock::now());
             entity->SetYaw(360.0f * msg.GetYRot() / 256.0f);
             entity->SetPitch(360.0f * msg.GetXRot() / 256.0f);
             entity->SetOnGround(msg.GetOnGround());
@@ -189,9 +483,13 @@ namespace Botcraft
         entity->SetYaw(360.0f * msg.GetYRot() / 256.0f);
         entity->SetPitch(360.0f * msg.GetXRot() / 256.0f);
         entity->SetUUID(msg.GetUuid());
+        // Packet data is in 1/8000 of block per tick, so convert it back to block/tick
+        entity->SetSpeed(Vector3<double>(msg.GetXa(), msg.GetYa(), msg.GetZa()) / 8000.0);
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities[msg.GetId_()] = entity;
+        IndexEntity(msg.GetId_(), entity, Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()));
+        predictor.AddEntity(msg.GetId_(), EntityPredictor::GetMotionModel(*entity), Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()), entity->GetSpeed(), std::chrono::steady_clock::now());
     }
 
 #if PROTOCOL_VERSION < 759 /* < 1.19 */
@@ -206,9 +504,13 @@ namespace Botcraft
         entity->SetYaw(360.0f * msg.GetYRot() / 256.0f);
         entity->SetPitch(360.0f * msg.GetXRot() / 256.0f);
         entity->SetUUID(msg.GetUuid());
+        // Packet data is in 1/8000 of block per tick, so convert it back to block/tick
+        entity->SetSpeed(Vector3<double>(msg.GetXd(), msg.GetYd(), msg.GetZd()) / 8000.0);
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities[msg.GetId_()] = entity;
+        IndexEntity(msg.GetId_(), entity, Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()));
+        predictor.AddEntity(msg.GetId_(), EntityPredictor::GetMotionModel(*entity), Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()), entity->GetSpeed(), std::chrono::steady_clock::now());
     }
 #endif
 
@@ -223,6 +525,8 @@ namespace Botcraft
         // What do we do with the xp value?
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities[msg.GetId_()] = entity;
+        IndexEntity(msg.GetId_(), entity, Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()));
+        predictor.AddEntity(msg.GetId_(), EntityPredictor::GetMotionModel(*entity), Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()), Vector3<double>(0.0), std::chrono::steady_clock::now());
     }
 
 #if PROTOCOL_VERSION < 721 /* < 1.16 */
@@ -237,6 +541,7 @@ namespace Botcraft
 
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities[msg.GetId_()] = entity;
+        IndexEntity(msg.GetId_(), entity, Vector3<double>(msg.GetX(), msg.GetY(), msg.GetZ()));
     }
 #endif
 
@@ -244,6 +549,11 @@ namespace Botcraft
     void EntityManager::Handle(ProtocolCraft::ClientboundAddPlayerPacket& msg)
     {
         std::shared_ptr<Entity> entity = nullptr;
+        const Vector3<double> position(
+            msg.GetX(),
+            msg.GetY(),
+            msg.GetZ()
+        );
 
         {
             std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
@@ -257,14 +567,12 @@ namespace Botcraft
             {
                 entity = it->second;
             }
+            IndexEntity(msg.GetEntityId(), entity, position);
+            predictor.AddEntity(msg.GetEntityId(), EntityPredictor::GetMotionModel(*entity), position, Vector3<double>(0.0), std::chrono::steady_clock::now());
         }
 
         entity->SetEntityID(msg.GetEntityId());
-        entity->SetPosition(Vector3<double>(
-            msg.GetX(),
-            msg.GetY(),
-            msg.GetZ()
-        ));
+        entity->SetPosition(position);
         entity->SetYaw(360.0f * msg.GetYRot() / 256.0f);
         entity->SetPitch(360.0f * msg.GetXRot() / 256.0f);
         entity->SetUUID(msg.GetPlayerId());
@@ -293,11 +601,14 @@ namespace Botcraft
 
         if (entity != nullptr)
         {
-            entity->SetPosition(Vector3<double>(
+            const Vector3<double> position(
                 msg.GetX(),
                 msg.GetY(),
                 msg.GetZ()
-            ));
+            );
+            entity->SetPosition(position);
+            UpdateEntityIndex(msg.GetId_(), position);
+            predictor.SetPosition(msg.GetId_(), position, msg.GetOnGround(), std::chrono::steady_clock::now());
             entity->SetYaw(360.0f * msg.GetYRot() / 256.0f);
             entity->SetPitch(360.0f * msg.GetXRot() / 256.0f);
             entity->SetOnGround(msg.GetOnGround());
@@ -316,6 +627,8 @@ namespace Botcraft
     {
         std::scoped_lock<std::shared_mutex> lock(entity_manager_mutex);
         entities.erase(msg.GetEntityId());
+        UnindexEntity(msg.GetEntityId());
+        predictor.RemoveEntity(msg.GetEntityId());
     }
 #else
     void EntityManager::Handle(ProtocolCraft::ClientboundRemoveEntitiesPacket& msg)
@@ -324,6 +637,8 @@ namespace Botcraft
         for (int i = 0; i < msg.GetEntityIds().size(); ++i)
         {
             entities.erase(msg.GetEntityIds()[i]);
+            UnindexEntity(msg.GetEntityIds()[i]);
+            predictor.RemoveEntity(msg.GetEntityIds()[i]);
         }
     }
 #endif
@@ -392,7 +707,9 @@ namespace Botcraft
         else
         {
             // Packet data is in 1/8000 of block per tick, so convert it back to block/tick
-            entity->SetSpeed(Vector3<double>(msg.GetXA(), msg.GetYA(), msg.GetZA()) / 8000.0);
+            const Vector3<double> speed = Vector3<double>(msg.GetXA(), msg.GetYA(), msg.GetZA()) / 8000.0;
+            entity->SetSpeed(speed);
+            predictor.SetVelocity(msg.GetId_(), speed, std::chrono::steady_clock::now());
         }
     }
 
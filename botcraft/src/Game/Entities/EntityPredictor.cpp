@@ -0,0 +1,384 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "botcraft/Game/Entities/EntityPredictor.hpp"
+#include "botcraft/Game/Entities/entities/Entity.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Distance travelled along one axis after ticks ticks, starting at velocity v, with
+        /// a constant acceleration -g applied before each move and a velocity multiplier k after it
+        double Displacement(const double v, const double g, const double k, const double ticks)
+        {
+            if (k > 1.0 - 1e-9)
+            {
+                return ticks * v - g * ticks * (ticks + 1.0) * 0.5;
+            }
+            // Terminal velocity
+            const double v_inf = -k * g / (1.0 - k);
+            return ticks * (v_inf - g) + (v - v_inf) * (1.0 - std::pow(k, ticks)) / (1.0 - k);
+        }
+
+        /// @brief Velocity after ticks ticks, see Displacement
+        double Velocity(const double v, const double g, const double k, const double ticks)
+        {
+            if (k > 1.0 - 1e-9)
+            {
+                return v - g * ticks;
+            }
+            const double v_inf = -k * g / (1.0 - k);
+            return v_inf + (v - v_inf) * std::pow(k, ticks);
+        }
+    }
+
+    EntityPredictor::MotionModel EntityPredictor::GetMotionModel(const Entity& entity)
+    {
+        // Values from vanilla entities tick functions
+        switch (entity.GetType())
+        {
+        case EntityType::ItemEntity:
+        case EntityType::FallingBlockEntity:
+        case EntityType::PrimedTnt:
+            return MotionModel{ 0.04, 0.98, 0.98, 0.98 * 0.6 };
+        case EntityType::ExperienceOrb:
+            return MotionModel{ 0.03, 0.98, 0.98, 0.98 * 0.6 };
+        case EntityType::ThrownPotion:
+            return MotionModel{ 0.05, 0.99, 0.99, 0.0 };
+        case EntityType::ThrownExperienceBottle:
+            return MotionModel{ 0.07, 0.99, 0.99, 0.0 };
+        // Flying mobs
+#if PROTOCOL_VERSION > 758 /* > 1.18.2 */
+        case EntityType::Allay:
+#endif
+#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
+        case EntityType::Bee:
+#endif
+        case EntityType::Blaze:
+        case EntityType::Parrot:
+        case EntityType::Vex:
+            return MotionModel{};
+        default:
+            break;
+        }
+
+        if (entity.IsAbstractArrow())
+        {
+            return MotionModel{ 0.05, 0.99, 0.99, 0.0 };
+        }
+        if (entity.IsThrowableItemProjectile() || entity.IsThrowableProjectile())
+        {
+            return MotionModel{ 0.03, 0.99, 0.99, 0.0 };
+        }
+        if (entity.IsLivingEntity())
+        {
+            if (entity.IsFlyingMob() || entity.IsAmbientCreature() || entity.IsWaterAnimal())
+            {
+                return MotionModel{};
+            }
+            // Horizontal movement is driven by the mob AI, keep the estimated velocity
+            return MotionModel{ 0.08, 1.0, 0.98, 1.0 };
+        }
+        // Fireballs, vehicles, decorations...
+        return MotionModel{};
+    }
+
+    void EntityPredictor::AddEntity(const int id, const MotionModel& model, const Vector3<double>& position, const Vector3<double>& velocity, const std::chrono::steady_clock::time_point& time)
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        size_t index = 0;
+        if (it == indices.end())
+        {
+            index = ids.size();
+            indices[id] = index;
+            ids.push_back(id);
+            position_x.emplace_back();
+            position_y.emplace_back();
+            position_z.emplace_back();
+            velocity_x.emplace_back();
+            velocity_y.emplace_back();
+            velocity_z.emplace_back();
+            update_times.emplace_back();
+            on_ground.emplace_back();
+            server_velocity.emplace_back();
+            models.emplace_back();
+        }
+        else
+        {
+            index = it->second;
+        }
+
+        position_x[index] = position.x;
+        position_y[index] = position.y;
+        position_z[index] = position.z;
+        velocity_x[index] = velocity.x;
+        velocity_y[index] = velocity.y;
+        velocity_z[index] = velocity.z;
+        update_times[index] = time;
+        // Spawn packets don't tell if the entity is on ground, assume
+        // it is if it doesn't move, so entities at rest don't fall
+        on_ground[index] = velocity.SqrNorm() == 0.0;
+        server_velocity[index] = true;
+        models[index] = model;
+    }
+
+    void EntityPredictor::RemoveEntity(const int id)
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return;
+        }
+
+        const size_t index = it->second;
+        const size_t last = ids.size() - 1;
+        // Swap with the last one to remove in constant time
+        if (index != last)
+        {
+            ids[index] = ids[last];
+            position_x[index] = position_x[last];
+            position_y[index] = position_y[last];
+            position_z[index] = position_z[last];
+            velocity_x[index] = velocity_x[last];
+            velocity_y[index] = velocity_y[last];
+            velocity_z[index] = velocity_z[last];
+            update_times[index] = update_times[last];
+            on_ground[index] = on_ground[last];
+            server_velocity[index] = server_velocity[last];
+            models[index] = models[last];
+            indices[ids[index]] = index;
+        }
+        ids.pop_back();
+        position_x.pop_back();
+        position_y.pop_back();
+        position_z.pop_back();
+        velocity_x.pop_back();
+        velocity_y.pop_back();
+        velocity_z.pop_back();
+        update_times.pop_back();
+        on_ground.pop_back();
+        server_velocity.pop_back();
+        models.pop_back();
+        indices.erase(it);
+    }
+
+    void EntityPredictor::Clear()
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        indices.clear();
+        ids.clear();
+        position_x.clear();
+        position_y.clear();
+        position_z.clear();
+        velocity_x.clear();
+        velocity_y.clear();
+        velocity_z.clear();
+        update_times.clear();
+        on_ground.clear();
+        server_velocity.clear();
+        models.clear();
+    }
+
+    void EntityPredictor::UpdatePosition(const int id, const Vector3<double>& position, const bool on_ground_, const std::chrono::steady_clock::time_point& time)
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return;
+        }
+
+        const size_t index = it->second;
+        const double elapsed = ElapsedTicks(index, time);
+
+        Vector3<double> velocity(velocity_x[index], velocity_y[index], velocity_z[index]);
+        if (server_velocity[index])
+        {
+            // Velocity sent by the server is more reliable than the one
+            // we could estimate, just advance it to the current time
+            Vector3<double> predicted_position;
+            Extrapolate(index, elapsed, predicted_position, velocity);
+        }
+        // Several updates in the same tick, can't estimate anything
+        else if (elapsed >= 0.5)
+        {
+            const Vector3<double> measured = (position - Vector3<double>(position_x[index], position_y[index], position_z[index])) / std::max(1.0, elapsed);
+            // Smooth the estimate, unless the previous one is too old to be relevant
+            velocity = elapsed > max_prediction_ticks ? measured : (measured + velocity) * 0.5;
+        }
+
+        if (on_ground_)
+        {
+            velocity.y = 0.0;
+        }
+
+        position_x[index] = position.x;
+        position_y[index] = position.y;
+        position_z[index] = position.z;
+        velocity_x[index] = velocity.x;
+        velocity_y[index] = velocity.y;
+        velocity_z[index] = velocity.z;
+        update_times[index] = time;
+        on_ground[index] = on_ground_;
+        server_velocity[index] = false;
+    }
+
+    void EntityPredictor::SetPosition(const int id, const Vector3<double>& position, const bool on_ground_, const std::chrono::steady_clock::time_point& time)
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return;
+        }
+
+        const size_t index = it->second;
+        position_x[index] = position.x;
+        position_y[index] = position.y;
+        position_z[index] = position.z;
+        update_times[index] = time;
+        on_ground[index] = on_ground_;
+    }
+
+    void EntityPredictor::SetVelocity(const int id, const Vector3<double>& velocity, const std::chrono::steady_clock::time_point& time)
+    {
+        std::scoped_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return;
+        }
+
+        const size_t index = it->second;
+
+        // Move the entity up to now with its previous velocity
+        Vector3<double> position;
+        Vector3<double> previous_velocity;
+        Extrapolate(index, ElapsedTicks(index, time), position, previous_velocity);
+
+        position_x[index] = position.x;
+        position_y[index] = position.y;
+        position_z[index] = position.z;
+        velocity_x[index] = velocity.x;
+        velocity_y[index] = velocity.y;
+        velocity_z[index] = velocity.z;
+        update_times[index] = time;
+        // Jump or knockback
+        if (velocity.y > 0.0)
+        {
+            on_ground[index] = false;
+        }
+        server_velocity[index] = true;
+    }
+
+    std::optional<Vector3<double>> EntityPredictor::PredictPosition(const int id, const std::chrono::steady_clock::time_point& time) const
+    {
+        std::shared_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return std::nullopt;
+        }
+
+        Vector3<double> position;
+        Vector3<double> velocity;
+        Extrapolate(it->second, ElapsedTicks(it->second, time), position, velocity);
+        return position;
+    }
+
+    std::optional<Vector3<double>> EntityPredictor::PredictVelocity(const int id, const std::chrono::steady_clock::time_point& time) const
+    {
+        std::shared_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return std::nullopt;
+        }
+
+        Vector3<double> position;
+        Vector3<double> velocity;
+        Extrapolate(it->second, ElapsedTicks(it->second, time), position, velocity);
+        return velocity;
+    }
+
+    std::vector<std::pair<int, Vector3<double>>> EntityPredictor::PredictPositions(const std::chrono::steady_clock::time_point& time) const
+    {
+        std::shared_lock<std::shared_mutex> lock(predictor_mutex);
+
+        std::vector<std::pair<int, Vector3<double>>> output(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            const double ticks = std::clamp(ElapsedTicks(i, time), 0.0, max_prediction_ticks);
+            const MotionModel& model = models[i];
+            const double g = on_ground[i] ? 0.0 : model.gravity;
+            const double k_h = on_ground[i] ? model.ground_inertia : model.horizontal_inertia;
+            const double k_v = on_ground[i] ? 1.0 : model.vertical_inertia;
+            output[i].first = ids[i];
+            output[i].second.x = position_x[i] + Displacement(velocity_x[i], 0.0, k_h, ticks);
+            output[i].second.y = position_y[i] + Displacement(velocity_y[i], g, k_v, ticks);
+            output[i].second.z = position_z[i] + Displacement(velocity_z[i], 0.0, k_h, ticks);
+        }
+        return output;
+    }
+
+    std::optional<Vector3<double>> EntityPredictor::PredictInterception(const int id, const Vector3<double>& origin, const double speed, const std::chrono::steady_clock::time_point& time) const
+    {
+        std::shared_lock<std::shared_mutex> lock(predictor_mutex);
+        auto it = indices.find(id);
+        if (it == indices.end())
+        {
+            return std::nullopt;
+        }
+
+        const double now = ElapsedTicks(it->second, time);
+        Vector3<double> position;
+        Vector3<double> velocity;
+        Extrapolate(it->second, now, position, velocity);
+        if (speed <= 0.0)
+        {
+            return position;
+        }
+
+        // Fixed point iteration on the flight time, converges
+        // quickly as long as the target is slower than the projectile
+        for (int i = 0; i < 4; ++i)
+        {
+            const double flight_ticks = std::sqrt(position.SqrDist(origin)) / speed;
+            Extrapolate(it->second, now + flight_ticks, position, velocity);
+        }
+        return position;
+    }
+
+    size_t EntityPredictor::GetNumEntities() const
+    {
+        std::shared_lock<std::shared_mutex> lock(predictor_mutex);
+        return ids.size();
+    }
+
+    double EntityPredictor::ElapsedTicks(const size_t index, const std::chrono::steady_clock::time_point& time) const
+    {
+        // Ratio of integer counts, so a whole number of ticks is exact and max_prediction_ticks is reached
+        constexpr std::chrono::steady_clock::duration::rep tick_count = std::chrono::duration_cast<std::chrono::steady_clock::duration>(tick_duration).count();
+        return static_cast<double>((time - update_times[index]).count()) / static_cast<double>(tick_count);
+    }
+
+    void EntityPredictor::Extrapolate(const size_t index, const double ticks, Vector3<double>& position, Vector3<double>& velocity) const
+    {
+        const double n = std::clamp(ticks, 0.0, max_prediction_ticks);
+        const MotionModel& model = models[index];
+        const double g = on_ground[index] ? 0.0 : model.gravity;
+        const double k_h = on_ground[index] ? model.ground_inertia : model.horizontal_inertia;
+        const double k_v = on_ground[index] ? 1.0 : model.vertical_inertia;
+
+        position.x = position_x[index] + Displacement(velocity_x[index], 0.0, k_h, n);
+        position.y = position_y[index] + Displacement(velocity_y[index], g, k_v, n);
+        position.z = position_z[index] + Displacement(velocity_z[index], 0.0, k_h, n);
+        velocity.x = Velocity(velocity_x[index], 0.0, k_h, n);
+        velocity.y = Velocity(velocity_y[index], g, k_v, n);
+        velocity.z = Velocity(velocity_z[index], 0.0, k_h, n);
+    }
+} // Botcraft
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/AgeableMobEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AgeableMobEntity::metadata_count> AgeableMobEntity::metadata_names{ {
-        "data_baby_id",
-    } };
-
     AgeableMobEntity::AgeableMobEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataBabyId(false);
     }
@@ -44,21 +43,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AgeableMobEntity::GetDataBabyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_baby_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_baby_id")]);
     }
 
 
     void AgeableMobEntity::SetDataBabyId(const bool data_baby_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_baby_id"] = data_baby_id;
+        metadata[METADATA_INDEX("data_baby_id")] = data_baby_id;
     }
 
 }
@@ -1,4 +1,5 @@
 #include "botcraft/Game/Entities/entities/AreaEffectCloudEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "protocolCraft/Types/Particles/ColorParticleOptions.hpp"
@@ -8,21 +9,10 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, AreaEffectCloudEntity::metadata_count> AreaEffectCloudEntity::metadata_names{ {
-        "data_radius",
-        "data_color",
-        "data_waiting",
-#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
-        "data_particle",
-#endif
-#if PROTOCOL_VERSION < 341 /* < 1.13 */
-        "data_particle_argument1",
-        "data_particle_argument2",
-#endif
-    } };
-
     AreaEffectCloudEntity::AreaEffectCloudEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 761 /* < 1.19.3 */
         SetDataRadius(0.5f);
@@ -102,10 +92,9 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            const std::string& metadata_name = metadata_names[index - hierarchy_metadata_count];
-            metadata[metadata_name] = value;
+            metadata[index] = value;
 #if USE_GUI
-            if (metadata_name == "data_radius")
+            if (index == METADATA_INDEX("data_radius"))
             {
                 OnSizeUpdated();
             }
@@ -123,39 +112,39 @@ namespace Botcraft
     int AreaEffectCloudEntity::GetDataColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_color"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_color")]);
     }
 #endif
 
     bool AreaEffectCloudEntity::GetDataWaiting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_waiting"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_waiting")]);
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     std::shared_ptr<ProtocolCraft::Particle> AreaEffectCloudEntity::GetDataParticle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::shared_ptr<ProtocolCraft::Particle>>(metadata.at("data_particle"));
+        return std::any_cast<std::shared_ptr<ProtocolCraft::Particle>>(metadata[METADATA_INDEX("data_particle")]);
     }
 #else
     std::optional<int> AreaEffectCloudEntity::GetDataParticle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_particle"));
+        return std::any_cast<std::optional<int>>(metadata[METADATA_INDEX("data_particle")]);
     }
 
     int AreaEffectCloudEntity::GetDataParticleArgument1() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_particle_argument1"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_particle_argument1")]);
     }
 
     int AreaEffectCloudEntity::GetDataParticleArgument2() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_particle_argument2"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_particle_argument2")]);
     }
 #endif
 
@@ -163,7 +152,7 @@ namespace Botcraft
     void AreaEffectCloudEntity::SetDataRadius(const float data_radius)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_radius"] = data_radius;
+        metadata[METADATA_INDEX("data_radius")] = data_radius;
 #if USE_GUI
         OnSizeUpdated();
 #endif
@@ -173,51 +162,51 @@ namespace Botcraft
     void AreaEffectCloudEntity::SetDataColor(const int data_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_color"] = data_color;
+        metadata[METADATA_INDEX("data_color")] = data_color;
     }
 #endif
 
     void AreaEffectCloudEntity::SetDataWaiting(const bool data_waiting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_waiting"] = data_waiting;
+        metadata[METADATA_INDEX("data_waiting")] = data_waiting;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void AreaEffectCloudEntity::SetDataParticle(const ProtocolCraft::Particle& data_particle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle"] = data_particle;
+        metadata[METADATA_INDEX("data_particle")] = data_particle;
     }
 #else
     void AreaEffectCloudEntity::SetDataParticle(const std::optional<int>& data_particle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle"] = data_particle;
+        metadata[METADATA_INDEX("data_particle")] = data_particle;
     }
 
     void AreaEffectCloudEntity::SetDataParticleArgument1(const int data_particle_argument1)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle_argument1"] = data_particle_argument1;
+        metadata[METADATA_INDEX("data_particle_argument1")] = data_particle_argument1;
     }
 
     void AreaEffectCloudEntity::SetDataParticleArgument2(const int data_particle_argument2)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_particle_argument2"] = data_particle_argument2;
+        metadata[METADATA_INDEX("data_particle_argument2")] = data_particle_argument2;
     }
 #endif
 
 
     float AreaEffectCloudEntity::GetDataRadiusImpl() const
     {
-        return std::any_cast<float>(metadata.at("data_radius"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_radius")]);
     }
 
     double AreaEffectCloudEntity::GetWidthImpl() const
     {
-        return std::any_cast<float>(metadata.at("data_radius")) * 2.0;
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_radius")]) * 2.0;
     }
 
     double AreaEffectCloudEntity::GetHeightImpl() const
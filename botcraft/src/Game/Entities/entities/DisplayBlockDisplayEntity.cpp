@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
 #include "botcraft/Game/Entities/entities/DisplayBlockDisplayEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayBlockDisplayEntity::metadata_count> DisplayBlockDisplayEntity::metadata_names{ {
-        "data_block_state_id",
-    } };
-
     DisplayBlockDisplayEntity::DisplayBlockDisplayEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataBlockStateId(0);
     }
@@ -63,7 +62,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -71,14 +70,14 @@ namespace Botcraft
     int DisplayBlockDisplayEntity::GetDataBlockStateId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_block_state_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_block_state_id")]);
     }
     
     
     void DisplayBlockDisplayEntity::SetDataBlockStateId(const int data_block_state_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_block_state_id"] = data_block_state_id;
+        metadata[METADATA_INDEX("data_block_state_id")] = data_block_state_id;
     }
 
     double DisplayBlockDisplayEntity::GetWidthImpl() const
@@ -1,17 +1,15 @@
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
 #include "botcraft/Game/Entities/entities/DisplayItemDisplayEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayItemDisplayEntity::metadata_count> DisplayItemDisplayEntity::metadata_names{ {
-        "data_item_stack_id",
-        "data_item_display_id",
-    } };
-
     DisplayItemDisplayEntity::DisplayItemDisplayEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataItemStackId(ProtocolCraft::Slot());
         SetDataItemDisplayId(0);
@@ -66,7 +64,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -74,26 +72,26 @@ namespace Botcraft
     ProtocolCraft::Slot DisplayItemDisplayEntity::GetDataItemStackId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item_stack_id"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_item_stack_id")]);
     }
     
     char DisplayItemDisplayEntity::GetDataItemDisplayId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_item_display_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_item_display_id")]);
     }
     
     
     void DisplayItemDisplayEntity::SetDataItemStackId(const ProtocolCraft::Slot& data_item_stack_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack_id"] = data_item_stack_id;
+        metadata[METADATA_INDEX("data_item_stack_id")] = data_item_stack_id;
     }
     
     void DisplayItemDisplayEntity::SetDataItemDisplayId(const char data_item_display_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_display_id"] = data_item_display_id;
+        metadata[METADATA_INDEX("data_item_display_id")] = data_item_display_id;
     }
 
 
@@ -1,20 +1,15 @@
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
 #include "botcraft/Game/Entities/entities/DisplayTextDisplayEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, DisplayTextDisplayEntity::metadata_count> DisplayTextDisplayEntity::metadata_names{ {
-        "data_text_id",
-        "data_line_width_id",
-        "data_background_color_id",
-        "data_text_opacity_id",
-        "data_style_flags_id",
-    } };
-
     DisplayTextDisplayEntity::DisplayTextDisplayEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataTextId(ProtocolCraft::Chat());
         SetDataLineWidthId(200);
@@ -75,7 +70,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -83,62 +78,62 @@ namespace Botcraft
     ProtocolCraft::Chat DisplayTextDisplayEntity::GetDataTextId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Chat>(metadata.at("data_text_id"));
+        return std::any_cast<ProtocolCraft::Chat>(metadata[METADATA_INDEX("data_text_id")]);
     }
     
     int DisplayTextDisplayEntity::GetDataLineWidthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_line_width_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_line_width_id")]);
     }
     
     int DisplayTextDisplayEntity::GetDataBackgroundColorId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_background_color_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_background_color_id")]);
     }
     
     char DisplayTextDisplayEntity::GetDataTextOpacityId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_text_opacity_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_text_opacity_id")]);
     }
     
     char DisplayTextDisplayEntity::GetDataStyleFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_style_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_style_flags_id")]);
     }
     
     
     void DisplayTextDisplayEntity::SetDataTextId(const ProtocolCraft::Chat& data_text_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_text_id"] = data_text_id;
+        metadata[METADATA_INDEX("data_text_id")] = data_text_id;
     }
     
     void DisplayTextDisplayEntity::SetDataLineWidthId(const int data_line_width_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_line_width_id"] = data_line_width_id;
+        metadata[METADATA_INDEX("data_line_width_id")] = data_line_width_id;
     }
     
     void DisplayTextDisplayEntity::SetDataBackgroundColorId(const int data_background_color_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_background_color_id"] = data_background_color_id;
+        metadata[METADATA_INDEX("data_background_color_id")] = data_background_color_id;
     }
     
     void DisplayTextDisplayEntity::SetDataTextOpacityId(const char data_text_opacity_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_text_opacity_id"] = data_text_opacity_id;
+        metadata[METADATA_INDEX("data_text_opacity_id")] = data_text_opacity_id;
     }
     
     void DisplayTextDisplayEntity::SetDataStyleFlagsId(const char data_style_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_style_flags_id"] = data_style_flags_id;
+        metadata[METADATA_INDEX("data_style_flags_id")] = data_style_flags_id;
     }
 
 
@@ -1,4 +1,5 @@
 #include "botcraft/Game/Entities/entities/Entity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include "protocolCraft/Types/Item/Slot.hpp"
 #include "protocolCraft/Types/Chat/Chat.hpp"
@@ -16,6 +17,7 @@
 #include "botcraft/Renderer/Atlas.hpp"
 #endif
 #include "botcraft/Utilities/Logger.hpp"
+#include "botcraft/Utilities/PoolAllocator.hpp"
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include "botcraft/Game/Entities/entities/animal/allay/AllayEntity.hpp"
@@ -238,21 +240,6 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, Entity::metadata_count> Entity::metadata_names{ {
-        "data_shared_flags_id",
-        "data_air_supply_id",
-        "data_custom_name",
-        "data_custom_name_visible",
-        "data_silent",
-        "data_no_gravity",
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "data_pose",
-#endif
-#if PROTOCOL_VERSION > 754 /* > 1.16.5 */
-        "data_ticks_frozen",
-#endif
-    } };
-
     Entity::Entity()
     {
         {
@@ -264,16 +251,10 @@ namespace Botcraft
             pitch = 0.0f;
             speed = Vector3<double>(0.0, 0.0, 0.0);
             on_ground = false;
-            equipments = {
-                { EquipmentSlot::MainHand, ProtocolCraft::Slot() },
-                { EquipmentSlot::OffHand, ProtocolCraft::Slot() },
-                { EquipmentSlot::Boots, ProtocolCraft::Slot() },
-                { EquipmentSlot::Leggings, ProtocolCraft::Slot() },
-                { EquipmentSlot::ChestPlate, ProtocolCraft::Slot() },
-                { EquipmentSlot::Helmet, ProtocolCraft::Slot() }
-            };
         }
 
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataSharedFlagsId(0);
         SetDataAirSupplyId(300);
@@ -606,10 +587,9 @@ namespace Botcraft
     {
         assert(index >= 0 && index < metadata_count);
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        const std::string& metadata_name = metadata_names[index];
-        metadata[metadata_name] = value;
+        metadata[index] = value;
 #if USE_GUI && PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        if (metadata_name == "data_pose")
+        if (index == METADATA_INDEX("data_pose"))
         {
             OnSizeUpdated();
         }
@@ -632,39 +612,39 @@ namespace Botcraft
     int Entity::GetDataAirSupplyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_air_supply_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_air_supply_id")]);
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     std::optional<ProtocolCraft::Chat> Entity::GetDataCustomName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::Chat>>(metadata.at("data_custom_name"));
+        return std::any_cast<std::optional<ProtocolCraft::Chat>>(metadata[METADATA_INDEX("data_custom_name")]);
     }
 #else
     std::string Entity::GetDataCustomName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_custom_name"));
+        return std::any_cast<std::string>(metadata[METADATA_INDEX("data_custom_name")]);
     }
 #endif
 
     bool Entity::GetDataCustomNameVisible() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_custom_name_visible"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_custom_name_visible")]);
     }
 
     bool Entity::GetDataSilent() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_silent"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_silent")]);
     }
 
     bool Entity::GetDataNoGravity() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_no_gravity"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_no_gravity")]);
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -679,7 +659,7 @@ namespace Botcraft
     int Entity::GetDataTicksFrozen() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_ticks_frozen"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_ticks_frozen")]);
     }
 #endif
 
@@ -699,39 +679,39 @@ namespace Botcraft
     void Entity::SetDataAirSupplyId(const int data_air_supply_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_air_supply_id"] = data_air_supply_id;
+        metadata[METADATA_INDEX("data_air_supply_id")] = data_air_supply_id;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void Entity::SetDataCustomName(const std::optional<ProtocolCraft::Chat>& data_custom_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name"] = data_custom_name;
+        metadata[METADATA_INDEX("data_custom_name")] = data_custom_name;
     }
 #else
     void Entity::SetDataCustomName(const std::string& data_custom_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name"] = data_custom_name;
+        metadata[METADATA_INDEX("data_custom_name")] = data_custom_name;
     }
 #endif
 
     void Entity::SetDataCustomNameVisible(const bool data_custom_name_visible)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_custom_name_visible"] = data_custom_name_visible;
+        metadata[METADATA_INDEX("data_custom_name_visible")] = data_custom_name_visible;
     }
 
     void Entity::SetDataSilent(const bool data_silent)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_silent"] = data_silent;
+        metadata[METADATA_INDEX("data_silent")] = data_silent;
     }
 
     void Entity::SetDataNoGravity(const bool data_no_gravity)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_no_gravity"] = data_no_gravity;
+        metadata[METADATA_INDEX("data_no_gravity")] = data_no_gravity;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -746,7 +726,7 @@ namespace Botcraft
     void Entity::SetDataTicksFrozen(const int data_ticks_frozen)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_ticks_frozen"] = data_ticks_frozen;
+        metadata[METADATA_INDEX("data_ticks_frozen")] = data_ticks_frozen;
     }
 #endif
 
@@ -832,13 +812,22 @@ namespace Botcraft
     std::map<EquipmentSlot, ProtocolCraft::Slot> Entity::GetEquipments() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return equipments;
+        std::map<EquipmentSlot, ProtocolCraft::Slot> output;
+        for (size_t i = 0; i < num_equipment_slots; ++i)
+        {
+            output[static_cast<EquipmentSlot>(i)] = equipments == nullptr ? ProtocolCraft::Slot() : (*equipments)[i];
+        }
+        return output;
     }
 
     ProtocolCraft::Slot Entity::GetEquipment(const EquipmentSlot slot) const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return equipments.at(slot);
+        if (equipments == nullptr)
+        {
+            return ProtocolCraft::Slot();
+        }
+        return equipments->at(static_cast<size_t>(slot));
     }
 
     std::vector<EntityEffect> Entity::GetEffects() const
@@ -1021,7 +1010,15 @@ namespace Botcraft
     void Entity::SetEquipment(const EquipmentSlot slot, const ProtocolCraft::Slot& item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        equipments.at(slot) = item;
+        if (equipments == nullptr)
+        {
+            if (item.IsEmptySlot())
+            {
+                return;
+            }
+            equipments = std::make_unique<std::array<ProtocolCraft::Slot, num_equipment_slots>>();
+        }
+        equipments->at(static_cast<size_t>(slot)) = item;
     }
 
     void Entity::SetEffects(const std::vector<EntityEffect>& effects_)
@@ -1088,9 +1085,9 @@ namespace Botcraft
             output["speed"] = speed.Serialize();
             output["on_ground"] = on_ground;
             output["equipment"] = ProtocolCraft::Json::Value();
-            for (auto& p : equipments)
+            for (size_t i = 0; i < num_equipment_slots; ++i)
             {
-                output["equipment"][std::to_string(static_cast<int>(p.first))] = p.second.Serialize();
+                output["equipment"][std::to_string(i)] = equipments == nullptr ? ProtocolCraft::Slot().Serialize() : (*equipments)[i].Serialize();
             }
         }
 
@@ -1337,7 +1334,7 @@ namespace Botcraft
         case EntityType::ArmorStand:
             return std::make_shared<ArmorStandEntity>();
         case EntityType::Arrow:
-            return std::make_shared<ArrowEntity>();
+            return std::allocate_shared<ArrowEntity>(Utilities::PoolAllocator<ArrowEntity>());
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
         case EntityType::Axolotl:
             return std::make_shared<AxolotlEntity>();
@@ -1423,13 +1420,13 @@ namespace Botcraft
         case EntityType::EvokerFangs:
             return std::make_shared<EvokerFangsEntity>();
         case EntityType::ExperienceOrb:
-            return std::make_shared<ExperienceOrbEntity>();
+            return std::allocate_shared<ExperienceOrbEntity>(Utilities::PoolAllocator<ExperienceOrbEntity>());
         case EntityType::EyeOfEnder:
             return std::make_shared<EyeOfEnderEntity>();
         case EntityType::FallingBlockEntity:
-            return std::make_shared<FallingBlockEntity>();
+            return std::allocate_shared<FallingBlockEntity>(Utilities::PoolAllocator<FallingBlockEntity>());
         case EntityType::FireworkRocketEntity:
-            return std::make_shared<FireworkRocketEntity>();
+            return std::allocate_shared<FireworkRocketEntity>(Utilities::PoolAllocator<FireworkRocketEntity>());
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         case EntityType::Fox:
             return std::make_shared<FoxEntity>();
@@ -1465,7 +1462,7 @@ namespace Botcraft
         case EntityType::IronGolem:
             return std::make_shared<IronGolemEntity>();
         case EntityType::ItemEntity:
-            return std::make_shared<ItemEntity>();
+            return std::allocate_shared<ItemEntity>(Utilities::PoolAllocator<ItemEntity>());
         case EntityType::ItemFrame:
             return std::make_shared<ItemFrameEntity>();
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
@@ -1573,9 +1570,9 @@ namespace Botcraft
         case EntityType::SnowGolem:
             return std::make_shared<SnowGolemEntity>();
         case EntityType::Snowball:
-            return std::make_shared<SnowballEntity>();
+            return std::allocate_shared<SnowballEntity>(Utilities::PoolAllocator<SnowballEntity>());
         case EntityType::SpectralArrow:
-            return std::make_shared<SpectralArrowEntity>();
+            return std::allocate_shared<SpectralArrowEntity>(Utilities::PoolAllocator<SpectralArrowEntity>());
         case EntityType::Spider:
             return std::make_shared<SpiderEntity>();
         case EntityType::Squid:
@@ -1591,16 +1588,16 @@ namespace Botcraft
             return std::make_shared<TadpoleEntity>();
 #endif
         case EntityType::ThrownEgg:
-            return std::make_shared<ThrownEggEntity>();
+            return std::allocate_shared<ThrownEggEntity>(Utilities::PoolAllocator<ThrownEggEntity>());
         case EntityType::ThrownEnderpearl:
-            return std::make_shared<ThrownEnderpearlEntity>();
+            return std::allocate_shared<ThrownEnderpearlEntity>(Utilities::PoolAllocator<ThrownEnderpearlEntity>());
         case EntityType::ThrownExperienceBottle:
-            return std::make_shared<ThrownExperienceBottleEntity>();
+            return std::allocate_shared<ThrownExperienceBottleEntity>(Utilities::PoolAllocator<ThrownExperienceBottleEntity>());
         case EntityType::ThrownPotion:
-            return std::make_shared<ThrownPotionEntity>();
+            return std::allocate_shared<ThrownPotionEntity>(Utilities::PoolAllocator<ThrownPotionEntity>());
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
         case EntityType::ThrownTrident:
-            return std::make_shared<ThrownTridentEntity>();
+            return std::allocate_shared<ThrownTridentEntity>(Utilities::PoolAllocator<ThrownTridentEntity>());
 #endif
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         case EntityType::TraderLlama:
@@ -1680,7 +1677,7 @@ namespace Botcraft
         case ObjectEntityType::Boat:
             return std::make_shared<BoatEntity>();
         case ObjectEntityType::ItemEntity:
-            return std::make_shared<ItemEntity>();
+            return std::allocate_shared<ItemEntity>(Utilities::PoolAllocator<ItemEntity>());
         case ObjectEntityType::AreaEffectCloud:
             return std::make_shared<AreaEffectCloudEntity>();
         case ObjectEntityType::PrimedTnt:
@@ -1688,17 +1685,17 @@ namespace Botcraft
         case ObjectEntityType::EndCrystal:
             return std::make_shared<EndCrystalEntity>();
         case ObjectEntityType::Arrow:
-            return std::make_shared<ArrowEntity>();
+            return std::allocate_shared<ArrowEntity>(Utilities::PoolAllocator<ArrowEntity>());
         case ObjectEntityType::Snowball:
-            return std::make_shared<SnowballEntity>();
+            return std::allocate_shared<SnowballEntity>(Utilities::PoolAllocator<SnowballEntity>());
         case ObjectEntityType::ThrownEgg:
-            return std::make_shared<ThrownEggEntity>();
+            return std::allocate_shared<ThrownEggEntity>(Utilities::PoolAllocator<ThrownEggEntity>());
         case ObjectEntityType::LargeFireball:
             return std::make_shared<LargeFireballEntity>();
         case ObjectEntityType::SmallFireball:
             return std::make_shared<SmallFireballEntity>();
         case ObjectEntityType::ThrownEnderpearl:
-            return std::make_shared<ThrownEnderpearlEntity>();
+            return std::allocate_shared<ThrownEnderpearlEntity>(Utilities::PoolAllocator<ThrownEnderpearlEntity>());
         case ObjectEntityType::WitherSkull:
             return std::make_shared<WitherSkullEntity>();
         case ObjectEntityType::ShulkerBullet:
@@ -1706,17 +1703,17 @@ namespace Botcraft
         case ObjectEntityType::LlamaSpit:
             return std::make_shared<LlamaSpitEntity>();
         case ObjectEntityType::FallingBlockEntity:
-            return std::make_shared<FallingBlockEntity>();
+            return std::allocate_shared<FallingBlockEntity>(Utilities::PoolAllocator<FallingBlockEntity>());
         case ObjectEntityType::ItemFrame:
             return std::make_shared<ItemFrameEntity>();
         case ObjectEntityType::EyeOfEnder:
             return std::make_shared<EyeOfEnderEntity>();
         case ObjectEntityType::ThrownPotion:
-            return std::make_shared<ThrownPotionEntity>();
+            return std::allocate_shared<ThrownPotionEntity>(Utilities::PoolAllocator<ThrownPotionEntity>());
         case ObjectEntityType::ThrownExperienceBottle:
-            return std::make_shared<ThrownExperienceBottleEntity>();
+            return std::allocate_shared<ThrownExperienceBottleEntity>(Utilities::PoolAllocator<ThrownExperienceBottleEntity>());
         case ObjectEntityType::FireworkRocketEntity:
-            return std::make_shared<FireworkRocketEntity>();
+            return std::allocate_shared<FireworkRocketEntity>(Utilities::PoolAllocator<FireworkRocketEntity>());
         case ObjectEntityType::LeashFenceKnotEntity:
             return std::make_shared<LeashFenceKnotEntity>();
         case ObjectEntityType::ArmorStand:
@@ -1726,12 +1723,12 @@ namespace Botcraft
         case ObjectEntityType::FishingHook:
             return std::make_shared<FishingHookEntity>();
         case ObjectEntityType::SpectralArrow:
-            return std::make_shared<SpectralArrowEntity>();
+            return std::allocate_shared<SpectralArrowEntity>(Utilities::PoolAllocator<SpectralArrowEntity>());
         case ObjectEntityType::DragonFireball:
             return std::make_shared<DragonFireballEntity>();
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
         case ObjectEntityType::ThrownTrident:
-            return std::make_shared<ThrownTridentEntity>();
+            return std::allocate_shared<ThrownTridentEntity>(Utilities::PoolAllocator<ThrownTridentEntity>());
 #endif
         default:
             return nullptr;
@@ -1739,6 +1736,12 @@ namespace Botcraft
     }
 #endif
 
+    Entity::PoolStats Entity::GetPoolStats()
+    {
+        const Utilities::BlockPoolCounters& counters = Utilities::BlockPoolCounters::GetInstance();
+        return PoolStats{ counters.num_in_use.load(), counters.num_reused.load(), counters.num_blocks.load() };
+    }
+
 #if USE_GUI
     void Entity::InitializeFaces()
     {
@@ -1839,7 +1842,7 @@ namespace Botcraft
 
     char Entity::GetDataSharedFlagsIdImpl() const
     {
-        return std::any_cast<char>(metadata.at("data_shared_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_shared_flags_id")]);
     }
 
     bool Entity::GetDataSharedFlagsIdImpl(const EntitySharedFlagsId id) const
@@ -1849,7 +1852,7 @@ namespace Botcraft
 
     void Entity::SetDataSharedFlagsIdImpl(const char data_shared_flags_id)
     {
-        metadata["data_shared_flags_id"] = data_shared_flags_id;
+        metadata[METADATA_INDEX("data_shared_flags_id")] = data_shared_flags_id;
     }
 
     void Entity::SetDataSharedFlagsIdImpl(const EntitySharedFlagsId id, const bool b)
@@ -1866,12 +1869,12 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     Pose Entity::GetDataPoseImpl() const
     {
-        return std::any_cast<Pose>(metadata.at("data_pose"));
+        return std::any_cast<Pose>(metadata[METADATA_INDEX("data_pose")]);
     }
 
     void Entity::SetDataPoseImpl(const Pose data_pose)
     {
-        metadata["data_pose"] = data_pose;
+        metadata[METADATA_INDEX("data_pose")] = data_pose;
 #if USE_GUI
         OnSizeUpdated();
 #endif
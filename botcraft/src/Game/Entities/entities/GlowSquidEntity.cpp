@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
 #include "botcraft/Game/Entities/entities/GlowSquidEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, GlowSquidEntity::metadata_count> GlowSquidEntity::metadata_names{ {
-        "data_dark_ticks_remaining",
-    } };
-
     GlowSquidEntity::GlowSquidEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataDarkTicksRemaining(0);
     }
@@ -62,21 +61,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int GlowSquidEntity::GetDataDarkTicksRemaining() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_dark_ticks_remaining"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_dark_ticks_remaining")]);
     }
 
 
     void GlowSquidEntity::SetDataDarkTicksRemaining(const int data_dark_ticks_remaining)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dark_ticks_remaining"] = data_dark_ticks_remaining;
+        metadata[METADATA_INDEX("data_dark_ticks_remaining")] = data_dark_ticks_remaining;
     }
 
 
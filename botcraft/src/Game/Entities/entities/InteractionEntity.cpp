@@ -1,18 +1,15 @@
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
 #include "botcraft/Game/Entities/entities/InteractionEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, InteractionEntity::metadata_count> InteractionEntity::metadata_names{ {
-        "data_width_id",
-        "data_height_id",
-        "data_response_id",
-    } };
-
     InteractionEntity::InteractionEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataWidthId(1.0f);
         SetDataHeightId(1.0f);
@@ -69,7 +66,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -77,38 +74,38 @@ namespace Botcraft
     float InteractionEntity::GetDataWidthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_width_id"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_width_id")]);
     }
     
     float InteractionEntity::GetDataHeightId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_height_id"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_height_id")]);
     }
     
     bool InteractionEntity::GetDataResponseId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_response_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_response_id")]);
     }
     
     
     void InteractionEntity::SetDataWidthId(const float data_width_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_width_id"] = data_width_id;
+        metadata[METADATA_INDEX("data_width_id")] = data_width_id;
     }
     
     void InteractionEntity::SetDataHeightId(const float data_height_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_height_id"] = data_height_id;
+        metadata[METADATA_INDEX("data_height_id")] = data_height_id;
     }
     
     void InteractionEntity::SetDataResponseId(const bool data_response_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_response_id"] = data_response_id;
+        metadata[METADATA_INDEX("data_response_id")] = data_response_id;
     }
 
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/MobEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, MobEntity::metadata_count> MobEntity::metadata_names{ {
-        "data_mob_flags_id",
-    } };
-
     MobEntity::MobEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataMobFlagsId(0);
 
@@ -55,21 +54,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char MobEntity::GetDataMobFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_mob_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_mob_flags_id")]);
     }
 
 
     void MobEntity::SetDataMobFlagsId(const char data_mob_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_mob_flags_id"] = data_mob_flags_id;
+        metadata[METADATA_INDEX("data_mob_flags_id")] = data_mob_flags_id;
     }
 
 
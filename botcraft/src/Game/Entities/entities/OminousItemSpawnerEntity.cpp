@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/Entities/entities/OminousItemSpawnerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, OminousItemSpawnerEntity::metadata_count> OminousItemSpawnerEntity::metadata_names{ {
-        "data_item",
-    } };
-
     OminousItemSpawnerEntity::OminousItemSpawnerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataItem(ProtocolCraft::Slot());
     }
@@ -62,21 +61,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot OminousItemSpawnerEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<const ProtocolCraft::Slot&>(metadata.at("data_item"));
+        return std::any_cast<const ProtocolCraft::Slot&>(metadata[METADATA_INDEX("data_item")]);
     }
 
 
     void OminousItemSpawnerEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        metadata[METADATA_INDEX("data_item")] = data_item;
     }
 
 
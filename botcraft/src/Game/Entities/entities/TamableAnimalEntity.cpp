@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/TamableAnimalEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, TamableAnimalEntity::metadata_count> TamableAnimalEntity::metadata_names{ {
-        "data_flags_id",
-        "data_owneruuid_id",
-    } };
-
     TamableAnimalEntity::TamableAnimalEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataFlagsId(0);
         SetDataOwneruuidId(std::optional<ProtocolCraft::UUID>());
@@ -47,33 +45,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char TamableAnimalEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_flags_id")]);
     }
 
     std::optional<ProtocolCraft::UUID> TamableAnimalEntity::GetDataOwneruuidId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_owneruuid_id"));
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata[METADATA_INDEX("data_owneruuid_id")]);
     }
 
 
     void TamableAnimalEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        metadata[METADATA_INDEX("data_flags_id")] = data_flags_id;
     }
 
     void TamableAnimalEntity::SetDataOwneruuidId(const std::optional<ProtocolCraft::UUID>& data_owneruuid_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_owneruuid_id"] = data_owneruuid_id;
+        metadata[METADATA_INDEX("data_owneruuid_id")] = data_owneruuid_id;
     }
 
 }
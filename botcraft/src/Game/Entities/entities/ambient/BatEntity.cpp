@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/ambient/BatEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, BatEntity::metadata_count> BatEntity::metadata_names{ {
-        "data_id_flags",
-    } };
-
     BatEntity::BatEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdFlags(0);
 
@@ -64,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char BatEntity::GetDataIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_id_flags"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_id_flags")]);
     }
 
 
     void BatEntity::SetDataIdFlags(const char data_id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_flags"] = data_id_flags;
+        metadata[METADATA_INDEX("data_id_flags")] = data_id_flags;
     }
 
 
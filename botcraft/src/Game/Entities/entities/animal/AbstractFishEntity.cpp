@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/AbstractFishEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractFishEntity::metadata_count> AbstractFishEntity::metadata_names{ {
-        "from_bucket",
-    } };
-
     AbstractFishEntity::AbstractFishEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetFromBucket(false);
 
@@ -47,21 +46,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractFishEntity::GetFromBucket() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("from_bucket"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("from_bucket")]);
     }
 
 
     void AbstractFishEntity::SetFromBucket(const bool from_bucket)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["from_bucket"] = from_bucket;
+        metadata[METADATA_INDEX("from_bucket")] = from_bucket;
     }
 
 }
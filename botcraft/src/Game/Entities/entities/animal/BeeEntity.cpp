@@ -1,17 +1,15 @@
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
 #include "botcraft/Game/Entities/entities/animal/BeeEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, BeeEntity::metadata_count> BeeEntity::metadata_names{ {
-        "data_flags_id",
-        "data_remaining_anger_time",
-    } };
-
     BeeEntity::BeeEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataFlagsId(0);
         SetDataRemainingAngerTime(0);
@@ -76,33 +74,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char BeeEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_flags_id")]);
     }
 
     int BeeEntity::GetDataRemainingAngerTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_remaining_anger_time"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_remaining_anger_time")]);
     }
 
 
     void BeeEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        metadata[METADATA_INDEX("data_flags_id")] = data_flags_id;
     }
 
     void BeeEntity::SetDataRemainingAngerTime(const int data_remaining_anger_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_remaining_anger_time"] = data_remaining_anger_time;
+        metadata[METADATA_INDEX("data_remaining_anger_time")] = data_remaining_anger_time;
     }
 
 
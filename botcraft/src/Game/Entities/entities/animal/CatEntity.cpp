@@ -1,19 +1,15 @@
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
 #include "botcraft/Game/Entities/entities/animal/CatEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, CatEntity::metadata_count> CatEntity::metadata_names{ {
-        "data_type_id",
-        "is_lying",
-        "relax_state_one",
-        "data_collar_color",
-    } };
-
     CatEntity::CatEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataTypeId(1);
         SetIsLying(false);
@@ -79,57 +75,57 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int CatEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_type_id")]);
     }
 
     bool CatEntity::GetIsLying() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_lying"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("is_lying")]);
     }
 
     bool CatEntity::GetRelaxStateOne() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("relax_state_one"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("relax_state_one")]);
     }
 
     int CatEntity::GetDataCollarColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_collar_color"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_collar_color")]);
     }
 
 
     void CatEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        metadata[METADATA_INDEX("data_type_id")] = data_type_id;
     }
 
     void CatEntity::SetIsLying(const bool is_lying)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_lying"] = is_lying;
+        metadata[METADATA_INDEX("is_lying")] = is_lying;
     }
 
     void CatEntity::SetRelaxStateOne(const bool relax_state_one)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["relax_state_one"] = relax_state_one;
+        metadata[METADATA_INDEX("relax_state_one")] = relax_state_one;
     }
 
     void CatEntity::SetDataCollarColor(const int data_collar_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_collar_color"] = data_collar_color;
+        metadata[METADATA_INDEX("data_collar_color")] = data_collar_color;
     }
 
 
@@ -1,18 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/animal/DolphinEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, DolphinEntity::metadata_count> DolphinEntity::metadata_names{ {
-        "treasure_pos",
-        "got_fish",
-        "moistness_level",
-    } };
-
     DolphinEntity::DolphinEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetTreasurePos(Position(0, 0, 0));
         SetGotFish(false);
@@ -76,45 +73,45 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Position DolphinEntity::GetTreasurePos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("treasure_pos"));
+        return std::any_cast<Position>(metadata[METADATA_INDEX("treasure_pos")]);
     }
 
     bool DolphinEntity::GetGotFish() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("got_fish"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("got_fish")]);
     }
 
     int DolphinEntity::GetMoistnessLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("moistness_level"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("moistness_level")]);
     }
 
 
     void DolphinEntity::SetTreasurePos(const Position& treasure_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["treasure_pos"] = treasure_pos;
+        metadata[METADATA_INDEX("treasure_pos")] = treasure_pos;
     }
 
     void DolphinEntity::SetGotFish(const bool got_fish)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["got_fish"] = got_fish;
+        metadata[METADATA_INDEX("got_fish")] = got_fish;
     }
 
     void DolphinEntity::SetMoistnessLevel(const int moistness_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["moistness_level"] = moistness_level;
+        metadata[METADATA_INDEX("moistness_level")] = moistness_level;
     }
 
 
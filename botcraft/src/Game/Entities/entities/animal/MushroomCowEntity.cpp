@@ -1,18 +1,15 @@
 #include "botcraft/Game/Entities/entities/animal/MushroomCowEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-    const std::array<std::string, MushroomCowEntity::metadata_count> MushroomCowEntity::metadata_names{ {
-        "data_type",
-    } };
-#endif
-
     MushroomCowEntity::MushroomCowEntity()
     {
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataType("red");
 #endif
@@ -66,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     std::string MushroomCowEntity::GetDataType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_type"));
+        return std::any_cast<std::string>(metadata[METADATA_INDEX("data_type")]);
     }
 
 
     void MushroomCowEntity::SetDataType(const std::string& data_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type"] = data_type;
+        metadata[METADATA_INDEX("data_type")] = data_type;
     }
 #endif
 
@@ -1,19 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/OcelotEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, OcelotEntity::metadata_count> OcelotEntity::metadata_names{ {
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "data_trusting",
-#else
-        "data_type_id",
-#endif
-    } };
-
     OcelotEntity::OcelotEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         SetDataTrusting(false);
@@ -80,7 +75,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -88,27 +83,27 @@ namespace Botcraft
     bool OcelotEntity::GetDataTrusting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_trusting"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_trusting")]);
     }
 
 
     void OcelotEntity::SetDataTrusting(const bool data_trusting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_trusting"] = data_trusting;
+        metadata[METADATA_INDEX("data_trusting")] = data_trusting;
     }
 #else
     int OcelotEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_type_id")]);
     }
 
 
     void OcelotEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        metadata[METADATA_INDEX("data_type_id")] = data_type_id;
     }
 #endif
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/ParrotEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ParrotEntity::metadata_count> ParrotEntity::metadata_names{ {
-        "data_variant_id",
-    } };
-
     ParrotEntity::ParrotEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataVariantId(0);
 
@@ -68,21 +67,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ParrotEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_variant_id")]);
     }
 
 
     void ParrotEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        metadata[METADATA_INDEX("data_variant_id")] = data_variant_id;
     }
 
 
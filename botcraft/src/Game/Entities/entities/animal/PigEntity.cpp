@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/PigEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PigEntity::metadata_count> PigEntity::metadata_names{ {
-        "data_saddle_id",
-        "data_boost_time",
-    } };
-
     PigEntity::PigEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataSaddleId(false);
         SetDataBoostTime(0);
@@ -68,33 +66,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool PigEntity::GetDataSaddleId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_saddle_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_saddle_id")]);
     }
 
     int PigEntity::GetDataBoostTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_boost_time"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_boost_time")]);
     }
 
 
     void PigEntity::SetDataSaddleId(const bool data_saddle_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_saddle_id"] = data_saddle_id;
+        metadata[METADATA_INDEX("data_saddle_id")] = data_saddle_id;
     }
 
     void PigEntity::SetDataBoostTime(const int data_boost_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_boost_time"] = data_boost_time;
+        metadata[METADATA_INDEX("data_boost_time")] = data_boost_time;
     }
 
 
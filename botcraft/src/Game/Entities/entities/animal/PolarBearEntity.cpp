@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/PolarBearEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PolarBearEntity::metadata_count> PolarBearEntity::metadata_names{ {
-        "data_standing_id",
-    } };
-
     PolarBearEntity::PolarBearEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataStandingId(false);
 
@@ -69,21 +68,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool PolarBearEntity::GetDataStandingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_standing_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_standing_id")]);
     }
 
 
     void PolarBearEntity::SetDataStandingId(const bool data_standing_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_standing_id"] = data_standing_id;
+        metadata[METADATA_INDEX("data_standing_id")] = data_standing_id;
     }
 
 
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/animal/PufferfishEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PufferfishEntity::metadata_count> PufferfishEntity::metadata_names{ {
-        "puff_state",
-    } };
-
     PufferfishEntity::PufferfishEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetPuffState(0);
     }
@@ -62,21 +61,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PufferfishEntity::GetPuffState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("puff_state"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("puff_state")]);
     }
 
 
     void PufferfishEntity::SetPuffState(const int puff_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["puff_state"] = puff_state;
+        metadata[METADATA_INDEX("puff_state")] = puff_state;
     }
 
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/RabbitEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, RabbitEntity::metadata_count> RabbitEntity::metadata_names{ {
-        "data_type_id",
-    } };
-
     RabbitEntity::RabbitEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataTypeId(0);
 
@@ -65,21 +64,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int RabbitEntity::GetDataTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_type_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_type_id")]);
     }
 
 
     void RabbitEntity::SetDataTypeId(const int data_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_type_id"] = data_type_id;
+        metadata[METADATA_INDEX("data_type_id")] = data_type_id;
     }
 
 
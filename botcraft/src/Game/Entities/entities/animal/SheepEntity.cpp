@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/SheepEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, SheepEntity::metadata_count> SheepEntity::metadata_names{ {
-        "data_wool_id",
-    } };
-
     SheepEntity::SheepEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataWoolId(0);
 
@@ -65,21 +64,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SheepEntity::GetDataWoolId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_wool_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_wool_id")]);
     }
 
 
     void SheepEntity::SetDataWoolId(const char data_wool_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_wool_id"] = data_wool_id;
+        metadata[METADATA_INDEX("data_wool_id")] = data_wool_id;
     }
 
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/SnowGolemEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, SnowGolemEntity::metadata_count> SnowGolemEntity::metadata_names{ {
-        "data_pumpkin_id",
-    } };
-
     SnowGolemEntity::SnowGolemEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataPumpkinId(16);
 
@@ -65,21 +64,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SnowGolemEntity::GetDataPumpkinId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_pumpkin_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_pumpkin_id")]);
     }
 
 
     void SnowGolemEntity::SetDataPumpkinId(const char data_pumpkin_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_pumpkin_id"] = data_pumpkin_id;
+        metadata[METADATA_INDEX("data_pumpkin_id")] = data_pumpkin_id;
     }
 
 
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/animal/TropicalFishEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, TropicalFishEntity::metadata_count> TropicalFishEntity::metadata_names{ {
-        "data_id_type_variant",
-    } };
-
     TropicalFishEntity::TropicalFishEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdTypeVariant(0);
     }
@@ -62,21 +61,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int TropicalFishEntity::GetDataIdTypeVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type_variant"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_type_variant")]);
     }
 
 
     void TropicalFishEntity::SetDataIdTypeVariant(const int data_id_type_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type_variant"] = data_id_type_variant;
+        metadata[METADATA_INDEX("data_id_type_variant")] = data_id_type_variant;
     }
 
 
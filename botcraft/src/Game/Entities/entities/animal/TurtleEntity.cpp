@@ -1,21 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/animal/TurtleEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, TurtleEntity::metadata_count> TurtleEntity::metadata_names{ {
-        "home_pos",
-        "has_egg",
-        "laying_egg",
-        "travel_pos",
-        "going_home",
-        "travelling",
-    } };
-
     TurtleEntity::TurtleEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetHomePos(Position(0, 0, 0));
         SetHasEgg(false);
@@ -84,81 +78,81 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Position TurtleEntity::GetHomePos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("home_pos"));
+        return std::any_cast<Position>(metadata[METADATA_INDEX("home_pos")]);
     }
 
     bool TurtleEntity::GetHasEgg() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("has_egg"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("has_egg")]);
     }
 
     bool TurtleEntity::GetLayingEgg() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("laying_egg"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("laying_egg")]);
     }
 
     Position TurtleEntity::GetTravelPos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("travel_pos"));
+        return std::any_cast<Position>(metadata[METADATA_INDEX("travel_pos")]);
     }
 
     bool TurtleEntity::GetGoingHome() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("going_home"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("going_home")]);
     }
 
     bool TurtleEntity::GetTravelling() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("travelling"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("travelling")]);
     }
 
 
     void TurtleEntity::SetHomePos(const Position& home_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["home_pos"] = home_pos;
+        metadata[METADATA_INDEX("home_pos")] = home_pos;
     }
 
     void TurtleEntity::SetHasEgg(const bool has_egg)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["has_egg"] = has_egg;
+        metadata[METADATA_INDEX("has_egg")] = has_egg;
     }
 
     void TurtleEntity::SetLayingEgg(const bool laying_egg)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["laying_egg"] = laying_egg;
+        metadata[METADATA_INDEX("laying_egg")] = laying_egg;
     }
 
     void TurtleEntity::SetTravelPos(const Position& travel_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["travel_pos"] = travel_pos;
+        metadata[METADATA_INDEX("travel_pos")] = travel_pos;
     }
 
     void TurtleEntity::SetGoingHome(const bool going_home)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["going_home"] = going_home;
+        metadata[METADATA_INDEX("going_home")] = going_home;
     }
 
     void TurtleEntity::SetTravelling(const bool travelling)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["travelling"] = travelling;
+        metadata[METADATA_INDEX("travelling")] = travelling;
     }
 
 
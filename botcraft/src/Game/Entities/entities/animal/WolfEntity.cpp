@@ -1,25 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/WolfEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, WolfEntity::metadata_count> WolfEntity::metadata_names{ {
-#if PROTOCOL_VERSION < 499 /* < 1.15 */
-        "data_health_id",
-#endif
-        "data_interested_id",
-        "data_collar_color",
-#if PROTOCOL_VERSION > 578 /* > 1.15.2 */
-        "data_remaining_anger_time",
-#endif
-#if PROTOCOL_VERSION > 765 /* > 1.20.4 */
-        "data_variant_id",
-#endif
-    } };
-
     WolfEntity::WolfEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 499 /* < 1.15 */
         SetDataHealthId(1.0f);
@@ -102,7 +91,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -110,27 +99,27 @@ namespace Botcraft
     float WolfEntity::GetDataHealthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_health_id"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_health_id")]);
     }
 #endif
 
     bool WolfEntity::GetDataInterestedId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_interested_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_interested_id")]);
     }
 
     int WolfEntity::GetDataCollarColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_collar_color"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_collar_color")]);
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     int WolfEntity::GetDataRemainingAngerTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_remaining_anger_time"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_remaining_anger_time")]);
     }
 #endif
 
@@ -138,7 +127,7 @@ namespace Botcraft
     int WolfEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_variant_id")]);
     }
 #endif
 
@@ -147,27 +136,27 @@ namespace Botcraft
     void WolfEntity::SetDataHealthId(const float data_health_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_health_id"] = data_health_id;
+        metadata[METADATA_INDEX("data_health_id")] = data_health_id;
     }
 #endif
 
     void WolfEntity::SetDataInterestedId(const bool data_interested_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_interested_id"] = data_interested_id;
+        metadata[METADATA_INDEX("data_interested_id")] = data_interested_id;
     }
 
     void WolfEntity::SetDataCollarColor(const int data_collar_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_collar_color"] = data_collar_color;
+        metadata[METADATA_INDEX("data_collar_color")] = data_collar_color;
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     void WolfEntity::SetDataRemainingAngerTime(const int data_remaining_anger_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_remaining_anger_time"] = data_remaining_anger_time;
+        metadata[METADATA_INDEX("data_remaining_anger_time")] = data_remaining_anger_time;
     }
 #endif
 
@@ -175,7 +164,7 @@ namespace Botcraft
     void WolfEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        metadata[METADATA_INDEX("data_variant_id")] = data_variant_id;
     }
 #endif
 
@@ -1,19 +1,16 @@
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include "botcraft/Game/Entities/entities/animal/allay/AllayEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 759 /* > 1.19 */
-    const std::array<std::string, AllayEntity::metadata_count> AllayEntity::metadata_names{ {
-        "data_dancing",
-        "data_can_duplicate",
-    } };
-#endif
     AllayEntity::AllayEntity()
     {
 #if PROTOCOL_VERSION > 759 /* > 1.19 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataDancing(true);
         SetDataCanDuplicate(true);
@@ -79,33 +76,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AllayEntity::GetDataDancing() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_dancing"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_dancing")]);
     }
 
     bool AllayEntity::GetDataCanDuplicate() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_can_duplicate"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_can_duplicate")]);
     }
 
 
     void AllayEntity::SetDataDancing(const bool data_dancing)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dancing"] = data_dancing;
+        metadata[METADATA_INDEX("data_dancing")] = data_dancing;
     }
 
     void AllayEntity::SetDataCanDuplicate(const bool data_can_duplicate)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_can_duplicate"] = data_can_duplicate;
+        metadata[METADATA_INDEX("data_can_duplicate")] = data_can_duplicate;
     }
 #endif
 
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/Entities/entities/animal/armadillo/ArmadilloEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ArmadilloEntity::metadata_count> ArmadilloEntity::metadata_names{ {
-        "armadillo_state",
-    } };
-
     ArmadilloEntity::ArmadilloEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetArmadilloState(0);
 
@@ -66,21 +65,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ArmadilloEntity::GetArmadilloState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("armadillo_state"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("armadillo_state")]);
     }
 
 
     void ArmadilloEntity::SetArmadilloState(const int armadillo_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["armadillo_state"] = armadillo_state;
+        metadata[METADATA_INDEX("armadillo_state")] = armadillo_state;
     }
 
 
@@ -1,18 +1,15 @@
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
 #include "botcraft/Game/Entities/entities/animal/axolotl/AxolotlEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AxolotlEntity::metadata_count> AxolotlEntity::metadata_names{ {
-        "data_variant",
-        "data_playing_dead",
-        "from_bucket",
-    } };
-
     AxolotlEntity::AxolotlEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataVariant(0);
         SetDataPlayingDead(false);
@@ -80,45 +77,45 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int AxolotlEntity::GetDataVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_variant")]);
     }
 
     bool AxolotlEntity::GetDataPlayingDead() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_playing_dead"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_playing_dead")]);
     }
 
     bool AxolotlEntity::GetFromBucket() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("from_bucket"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("from_bucket")]);
     }
 
 
     void AxolotlEntity::SetDataVariant(const int data_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant"] = data_variant;
+        metadata[METADATA_INDEX("data_variant")] = data_variant;
     }
 
     void AxolotlEntity::SetDataPlayingDead(const bool data_playing_dead)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_playing_dead"] = data_playing_dead;
+        metadata[METADATA_INDEX("data_playing_dead")] = data_playing_dead;
     }
 
     void AxolotlEntity::SetFromBucket(const bool from_bucket)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["from_bucket"] = from_bucket;
+        metadata[METADATA_INDEX("from_bucket")] = from_bucket;
     }
 
 
@@ -1,17 +1,15 @@
 #if PROTOCOL_VERSION > 760 /* > 1.19.2 */
 #include "botcraft/Game/Entities/entities/animal/camel/CamelEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, CamelEntity::metadata_count> CamelEntity::metadata_names{ {
-        "dash",
-        "last_pose_change_tick",
-    } };
-
     CamelEntity::CamelEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDash(true);
 #if PROTOCOL_VERSION < 762 /* < 1.19.4 */
@@ -79,33 +77,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool CamelEntity::GetDash() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("dash"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("dash")]);
     }
 
     long long int CamelEntity::GetLastPoseChangeTick() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<long long int>(metadata.at("last_pose_change_tick"));
+        return std::any_cast<long long int>(metadata[METADATA_INDEX("last_pose_change_tick")]);
     }
 
 
     void CamelEntity::SetDash(const bool dash)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["dash"] = dash;
+        metadata[METADATA_INDEX("dash")] = dash;
     }
 
     void CamelEntity::SetLastPoseChangeTick(const long long int last_pose_change_tick)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["last_pose_change_tick"] = last_pose_change_tick;
+        metadata[METADATA_INDEX("last_pose_change_tick")] = last_pose_change_tick;
     }
 
 
@@ -1,17 +1,15 @@
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include "botcraft/Game/Entities/entities/animal/frog/FrogEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, FrogEntity::metadata_count> FrogEntity::metadata_names{ {
-        "data_variant_id",
-        "data_tongue_target_id",
-    } };
-
     FrogEntity::FrogEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataVariantId(0);
         SetDataTongueTargetId(std::optional<int>());
@@ -76,33 +74,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int FrogEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_variant_id")]);
     }
 
     std::optional<int> FrogEntity::GetDataTongueTargetId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_tongue_target_id"));
+        return std::any_cast<std::optional<int>>(metadata[METADATA_INDEX("data_tongue_target_id")]);
     }
 
 
     void FrogEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        metadata[METADATA_INDEX("data_variant_id")] = data_variant_id;
     }
 
     void FrogEntity::SetDataTongueTargetId(const std::optional<int>& data_tongue_target_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_tongue_target_id"] = data_tongue_target_id;
+        metadata[METADATA_INDEX("data_tongue_target_id")] = data_tongue_target_id;
     }
 
 
@@ -1,20 +1,15 @@
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
 #include "botcraft/Game/Entities/entities/animal/goat/GoatEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, GoatEntity::metadata_count> GoatEntity::metadata_names{ {
-        "data_is_screaming_goat",
-#if PROTOCOL_VERSION > 758 /* > 1.18.2 */
-        "data_has_left_horn",
-        "data_has_right_horn",
-#endif
-    } };
-
     GoatEntity::GoatEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIsScreamingGoat(false);
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
@@ -82,27 +77,27 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GoatEntity::GetDataIsScreamingGoat() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_screaming_goat"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_is_screaming_goat")]);
     }
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
     bool GoatEntity::GetDataHasLeftHorn() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_has_left_horn"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_has_left_horn")]);
     }
 
     bool GoatEntity::GetDataHasRightHorn() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_has_right_horn"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_has_right_horn")]);
     }
 #endif
 
@@ -110,20 +105,20 @@ namespace Botcraft
     void GoatEntity::SetDataIsScreamingGoat(const bool data_is_screaming_goat)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_screaming_goat"] = data_is_screaming_goat;
+        metadata[METADATA_INDEX("data_is_screaming_goat")] = data_is_screaming_goat;
     }
 
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
     void GoatEntity::SetDataHasLeftHorn(const bool data_has_left_horn)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_has_left_horn"] = data_has_left_horn;
+        metadata[METADATA_INDEX("data_has_left_horn")] = data_has_left_horn;
     }
 
     void GoatEntity::SetDataHasRightHorn(const bool data_has_right_horn)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_has_right_horn"] = data_has_right_horn;
+        metadata[METADATA_INDEX("data_has_right_horn")] = data_has_right_horn;
     }
 #endif
 
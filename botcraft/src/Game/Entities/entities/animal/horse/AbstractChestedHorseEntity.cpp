@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/horse/AbstractChestedHorseEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractChestedHorseEntity::metadata_count> AbstractChestedHorseEntity::metadata_names{ {
-        "data_id_chest",
-    } };
-
     AbstractChestedHorseEntity::AbstractChestedHorseEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdChest(false);
 
@@ -52,21 +51,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractChestedHorseEntity::GetDataIdChest() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_chest"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_chest")]);
     }
 
 
     void AbstractChestedHorseEntity::SetDataIdChest(const bool data_id_chest)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_chest"] = data_id_chest;
+        metadata[METADATA_INDEX("data_id_chest")] = data_id_chest;
     }
 
 }
@@ -1,18 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/horse/HorseEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, HorseEntity::metadata_count> HorseEntity::metadata_names{ {
-        "data_id_type_variant",
-#if PROTOCOL_VERSION < 405 /* < 1.14 */
-        "armor_type",
-#endif
-    } };
-
     HorseEntity::HorseEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdTypeVariant(0);
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
@@ -70,21 +66,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int HorseEntity::GetDataIdTypeVariant() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type_variant"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_type_variant")]);
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     std::optional<int> HorseEntity::GetArmorType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("armor_type"));
+        return std::any_cast<std::optional<int>>(metadata[METADATA_INDEX("armor_type")]);
     }
 #endif
 
@@ -92,14 +88,14 @@ namespace Botcraft
     void HorseEntity::SetDataIdTypeVariant(const int data_id_type_variant)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type_variant"] = data_id_type_variant;
+        metadata[METADATA_INDEX("data_id_type_variant")] = data_id_type_variant;
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     void HorseEntity::SetArmorType(const std::optional<int>& armor_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["armor_type"] = armor_type;
+        metadata[METADATA_INDEX("armor_type")] = armor_type;
     }
 #endif
 
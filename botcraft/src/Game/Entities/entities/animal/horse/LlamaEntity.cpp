@@ -1,19 +1,14 @@
 #include "botcraft/Game/Entities/entities/animal/horse/LlamaEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, LlamaEntity::metadata_count> LlamaEntity::metadata_names{ {
-        "data_strength_id",
-#if PROTOCOL_VERSION < 766 /* < 1.20.5 */
-        "data_swag_id",
-#endif
-        "data_variant_id",
-    } };
-
     LlamaEntity::LlamaEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataStrengthId(0);
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
@@ -76,49 +71,49 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int LlamaEntity::GetDataStrengthId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_strength_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_strength_id")]);
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     int LlamaEntity::GetDataSwagId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_swag_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_swag_id")]);
     }
 #endif
 
     int LlamaEntity::GetDataVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_variant_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_variant_id")]);
     }
 
 
     void LlamaEntity::SetDataStrengthId(const int data_strength_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_strength_id"] = data_strength_id;
+        metadata[METADATA_INDEX("data_strength_id")] = data_strength_id;
     }
 
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
     void LlamaEntity::SetDataSwagId(const int data_swag_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_swag_id"] = data_swag_id;
+        metadata[METADATA_INDEX("data_swag_id")] = data_swag_id;
     }
 #endif
 
     void LlamaEntity::SetDataVariantId(const int data_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_variant_id"] = data_variant_id;
+        metadata[METADATA_INDEX("data_variant_id")] = data_variant_id;
     }
 
 
@@ -1,17 +1,15 @@
 #if PROTOCOL_VERSION > 761 /* > 1.19.3 */
 #include "botcraft/Game/Entities/entities/animal/sniffer/SnifferEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, SnifferEntity::metadata_count> SnifferEntity::metadata_names{ {
-        "data_state",
-        "data_drop_seed_at_tick",
-    } };
-
     SnifferEntity::SnifferEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataState(0);
         SetDataDropSeedAtTick(0);
@@ -70,7 +68,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -78,26 +76,26 @@ namespace Botcraft
     int SnifferEntity::GetDataState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_state"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_state")]);
     }
     
     int SnifferEntity::GetDataDropSeedAtTick() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_drop_seed_at_tick"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_drop_seed_at_tick")]);
     }
     
     
     void SnifferEntity::SetDataState(const int data_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_state"] = data_state;
+        metadata[METADATA_INDEX("data_state")] = data_state;
     }
     
     void SnifferEntity::SetDataDropSeedAtTick(const int data_drop_seed_at_tick)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_drop_seed_at_tick"] = data_drop_seed_at_tick;
+        metadata[METADATA_INDEX("data_drop_seed_at_tick")] = data_drop_seed_at_tick;
     }
 
 
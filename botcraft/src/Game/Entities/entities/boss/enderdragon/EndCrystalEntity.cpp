@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/boss/enderdragon/EndCrystalEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, EndCrystalEntity::metadata_count> EndCrystalEntity::metadata_names{ {
-        "data_beam_target",
-        "data_show_bottom",
-    } };
-
     EndCrystalEntity::EndCrystalEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataBeamTarget(std::optional<Position>());
         SetDataShowBottom(true);
@@ -64,33 +62,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     std::optional<Position> EndCrystalEntity::GetDataBeamTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<Position>>(metadata.at("data_beam_target"));
+        return std::any_cast<std::optional<Position>>(metadata[METADATA_INDEX("data_beam_target")]);
     }
 
     bool EndCrystalEntity::GetDataShowBottom() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_show_bottom"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_show_bottom")]);
     }
 
 
     void EndCrystalEntity::SetDataBeamTarget(const std::optional<Position>& data_beam_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_beam_target"] = data_beam_target;
+        metadata[METADATA_INDEX("data_beam_target")] = data_beam_target;
     }
 
     void EndCrystalEntity::SetDataShowBottom(const bool data_show_bottom)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_show_bottom"] = data_show_bottom;
+        metadata[METADATA_INDEX("data_show_bottom")] = data_show_bottom;
     }
 
 
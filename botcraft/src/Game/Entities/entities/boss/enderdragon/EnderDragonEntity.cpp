@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/boss/enderdragon/EnderDragonEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, EnderDragonEntity::metadata_count> EnderDragonEntity::metadata_names{ {
-        "data_phase",
-    } };
-
     EnderDragonEntity::EnderDragonEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataPhase(10);
 
@@ -64,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int EnderDragonEntity::GetDataPhase() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_phase"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_phase")]);
     }
 
 
     void EnderDragonEntity::SetDataPhase(const int data_phase)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_phase"] = data_phase;
+        metadata[METADATA_INDEX("data_phase")] = data_phase;
     }
 
 
@@ -1,18 +1,14 @@
 #include "botcraft/Game/Entities/entities/boss/wither/WitherBossEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, WitherBossEntity::metadata_count> WitherBossEntity::metadata_names{ {
-        "data_target_a",
-        "data_target_b",
-        "data_target_c",
-        "data_id_inv",
-    } };
-
     WitherBossEntity::WitherBossEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataTargetA(0);
         SetDataTargetB(0);
@@ -79,57 +75,57 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int WitherBossEntity::GetDataTargetA() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_a"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_target_a")]);
     }
 
     int WitherBossEntity::GetDataTargetB() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_b"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_target_b")]);
     }
 
     int WitherBossEntity::GetDataTargetC() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_target_c"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_target_c")]);
     }
 
     int WitherBossEntity::GetDataIdInv() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_inv"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_inv")]);
     }
 
 
     void WitherBossEntity::SetDataTargetA(const int data_target_a)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_a"] = data_target_a;
+        metadata[METADATA_INDEX("data_target_a")] = data_target_a;
     }
 
     void WitherBossEntity::SetDataTargetB(const int data_target_b)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_b"] = data_target_b;
+        metadata[METADATA_INDEX("data_target_b")] = data_target_b;
     }
 
     void WitherBossEntity::SetDataTargetC(const int data_target_c)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_target_c"] = data_target_c;
+        metadata[METADATA_INDEX("data_target_c")] = data_target_c;
     }
 
     void WitherBossEntity::SetDataIdInv(const int data_id_inv)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_inv"] = data_id_inv;
+        metadata[METADATA_INDEX("data_id_inv")] = data_id_inv;
     }
 
 
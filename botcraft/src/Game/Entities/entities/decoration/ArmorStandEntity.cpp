@@ -1,21 +1,14 @@
 #include "botcraft/Game/Entities/entities/decoration/ArmorStandEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ArmorStandEntity::metadata_count> ArmorStandEntity::metadata_names{ {
-        "data_client_flags",
-        "data_head_pose",
-        "data_body_pose",
-        "data_left_arm_pose",
-        "data_right_arm_pose",
-        "data_left_leg_pose",
-        "data_right_leg_pose",
-    } };
-
     ArmorStandEntity::ArmorStandEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataClientFlags(0);
         SetDataHeadPose(Vector3<float>(0.0f, 0.0f, 0.0f));
@@ -84,93 +77,93 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char ArmorStandEntity::GetDataClientFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_client_flags"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_client_flags")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataHeadPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_head_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_head_pose")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataBodyPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_body_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_body_pose")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataLeftArmPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_left_arm_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_left_arm_pose")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataRightArmPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_right_arm_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_right_arm_pose")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataLeftLegPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_left_leg_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_left_leg_pose")]);
     }
 
     Vector3<float> ArmorStandEntity::GetDataRightLegPose() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Vector3<float>>(metadata.at("data_right_leg_pose"));
+        return std::any_cast<Vector3<float>>(metadata[METADATA_INDEX("data_right_leg_pose")]);
     }
 
 
     void ArmorStandEntity::SetDataClientFlags(const char data_client_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_client_flags"] = data_client_flags;
+        metadata[METADATA_INDEX("data_client_flags")] = data_client_flags;
     }
 
     void ArmorStandEntity::SetDataHeadPose(const Vector3<float>& data_head_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_head_pose"] = data_head_pose;
+        metadata[METADATA_INDEX("data_head_pose")] = data_head_pose;
     }
 
     void ArmorStandEntity::SetDataBodyPose(const Vector3<float>& data_body_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_body_pose"] = data_body_pose;
+        metadata[METADATA_INDEX("data_body_pose")] = data_body_pose;
     }
 
     void ArmorStandEntity::SetDataLeftArmPose(const Vector3<float>& data_left_arm_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_left_arm_pose"] = data_left_arm_pose;
+        metadata[METADATA_INDEX("data_left_arm_pose")] = data_left_arm_pose;
     }
 
     void ArmorStandEntity::SetDataRightArmPose(const Vector3<float>& data_right_arm_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_right_arm_pose"] = data_right_arm_pose;
+        metadata[METADATA_INDEX("data_right_arm_pose")] = data_right_arm_pose;
     }
 
     void ArmorStandEntity::SetDataLeftLegPose(const Vector3<float>& data_left_leg_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_left_leg_pose"] = data_left_leg_pose;
+        metadata[METADATA_INDEX("data_left_leg_pose")] = data_left_leg_pose;
     }
 
     void ArmorStandEntity::SetDataRightLegPose(const Vector3<float>& data_right_leg_pose)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_right_leg_pose"] = data_right_leg_pose;
+        metadata[METADATA_INDEX("data_right_leg_pose")] = data_right_leg_pose;
     }
 
 
@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/decoration/ItemFrameEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ItemFrameEntity::metadata_count> ItemFrameEntity::metadata_names{ {
-        "data_item",
-        "data_rotation",
-    } };
-
     ItemFrameEntity::ItemFrameEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataItem(ProtocolCraft::Slot());
         SetDataRotation(0);
@@ -64,33 +62,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ItemFrameEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_item")]);
     }
 
     int ItemFrameEntity::GetDataRotation() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_rotation"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_rotation")]);
     }
 
 
     void ItemFrameEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        metadata[METADATA_INDEX("data_item")] = data_item;
     }
 
     void ItemFrameEntity::SetDataRotation(const int data_rotation)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_rotation"] = data_rotation;
+        metadata[METADATA_INDEX("data_rotation")] = data_rotation;
     }
 
 
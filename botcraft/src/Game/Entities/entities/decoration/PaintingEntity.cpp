@@ -1,18 +1,15 @@
 #include "botcraft/Game/Entities/entities/decoration/PaintingEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 758 /* > 1.18.2 */
-    const std::array<std::string, PaintingEntity::metadata_count> PaintingEntity::metadata_names{ {
-        "data_painting_variant_id",
-    } };
-#endif
-
     PaintingEntity::PaintingEntity()
     {
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataPaintingVariantId(0);
 #endif
@@ -66,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PaintingEntity::GetDataPaintingVariantId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_painting_variant_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_painting_variant_id")]);
     }
 
 
     void PaintingEntity::SetDataPaintingVariantId(const int data_painting_variant_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_painting_variant_id"] = data_painting_variant_id;
+        metadata[METADATA_INDEX("data_painting_variant_id")] = data_painting_variant_id;
     }
 #endif
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/item/FallingBlockEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, FallingBlockEntity::metadata_count> FallingBlockEntity::metadata_names{ {
-        "data_start_pos",
-    } };
-
     FallingBlockEntity::FallingBlockEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataStartPos(Position(0, 0, 0));
     }
@@ -61,21 +60,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Position FallingBlockEntity::GetDataStartPos() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Position>(metadata.at("data_start_pos"));
+        return std::any_cast<Position>(metadata[METADATA_INDEX("data_start_pos")]);
     }
 
 
     void FallingBlockEntity::SetDataStartPos(const Position& data_start_pos)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_start_pos"] = data_start_pos;
+        metadata[METADATA_INDEX("data_start_pos")] = data_start_pos;
     }
 
 
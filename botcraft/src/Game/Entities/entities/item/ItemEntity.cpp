@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/item/ItemEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ItemEntity::metadata_count> ItemEntity::metadata_names{ {
-        "data_item",
-    } };
-
     ItemEntity::ItemEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataItem(ProtocolCraft::Slot());
     }
@@ -61,21 +60,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ItemEntity::GetDataItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_item")]);
     }
 
 
     void ItemEntity::SetDataItem(const ProtocolCraft::Slot& data_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item"] = data_item;
+        metadata[METADATA_INDEX("data_item")] = data_item;
     }
 
 
@@ -1,19 +1,15 @@
 #include "botcraft/Game/Entities/entities/item/PrimedTntEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 #include "botcraft/Game/AssetsManager.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PrimedTntEntity::metadata_count> PrimedTntEntity::metadata_names{ {
-        "data_fuse_id",
-#if PROTOCOL_VERSION > 764 /* > 1.20.2 */
-        "data_block_state_id",
-#endif
-    } };
-
     PrimedTntEntity::PrimedTntEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataFuseId(80);
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
@@ -71,21 +67,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PrimedTntEntity::GetDataFuseId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_fuse_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_fuse_id")]);
     }
 
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
     int PrimedTntEntity::GetDataBlockStateId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_block_state_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_block_state_id")]);
     }
 #endif
 
@@ -93,14 +89,14 @@ namespace Botcraft
     void PrimedTntEntity::SetDataFuseId(const int data_fuse_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_fuse_id"] = data_fuse_id;
+        metadata[METADATA_INDEX("data_fuse_id")] = data_fuse_id;
     }
 
 #if PROTOCOL_VERSION > 764 /* > 1.20.2 */
     void PrimedTntEntity::SetDataBlockStateId(const int data_block_state_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_block_state_id"] = data_block_state_id;
+        metadata[METADATA_INDEX("data_block_state_id")] = data_block_state_id;
     }
 #endif
 
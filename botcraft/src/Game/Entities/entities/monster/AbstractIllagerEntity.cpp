@@ -1,17 +1,15 @@
 #include "botcraft/Game/Entities/entities/monster/AbstractIllagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION < 405 /* < 1.14 */
-    const std::array<std::string, AbstractIllagerEntity::metadata_count> AbstractIllagerEntity::metadata_names{ {
-        "has_target",
-    } };
-#endif
     AbstractIllagerEntity::AbstractIllagerEntity()
     {
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetHasTarget(0);
 #endif
@@ -48,20 +46,20 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char AbstractIllagerEntity::GetHasTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("has_target"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("has_target")]);
     }
 
     void AbstractIllagerEntity::SetHasTarget(const char has_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["has_target"] = has_target;
+        metadata[METADATA_INDEX("has_target")] = has_target;
     }
 #endif
 
@@ -1,18 +1,15 @@
 #include "botcraft/Game/Entities/entities/monster/AbstractSkeletonEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION < 405 /* < 1.14 */
-    const std::array<std::string, AbstractSkeletonEntity::metadata_count> AbstractSkeletonEntity::metadata_names{ {
-        "is_swinging_arms",
-    } };
-#endif
-
     AbstractSkeletonEntity::AbstractSkeletonEntity()
     {
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIsSwingingArms(false);
 #endif
@@ -52,21 +49,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractSkeletonEntity::GetIsSwingingArms() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_swinging_arms"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("is_swinging_arms")]);
     }
 
 
     void AbstractSkeletonEntity::SetIsSwingingArms(const bool is_swinging_arms)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_swinging_arms"] = is_swinging_arms;
+        metadata[METADATA_INDEX("is_swinging_arms")] = is_swinging_arms;
     }
 #endif
 
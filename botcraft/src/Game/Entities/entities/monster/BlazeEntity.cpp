@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/BlazeEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, BlazeEntity::metadata_count> BlazeEntity::metadata_names{ {
-        "data_flags_id",
-    } };
-
     BlazeEntity::BlazeEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataFlagsId(0);
 
@@ -66,21 +65,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char BlazeEntity::GetDataFlagsId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_flags_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_flags_id")]);
     }
 
 
     void BlazeEntity::SetDataFlagsId(const char data_flags_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_flags_id"] = data_flags_id;
+        metadata[METADATA_INDEX("data_flags_id")] = data_flags_id;
     }
 
 
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/Entities/entities/monster/BoggedEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, BoggedEntity::metadata_count> BoggedEntity::metadata_names{ {
-        "data_sheared",
-    } };
-
     BoggedEntity::BoggedEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataSheared(false);
 
@@ -65,21 +64,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool BoggedEntity::GetDataSheared() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_sheared"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_sheared")]);
     }
 
 
     void BoggedEntity::SetDataSheared(const bool data_sheared)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_sheared"] = data_sheared;
+        metadata[METADATA_INDEX("data_sheared")] = data_sheared;
     }
 
 
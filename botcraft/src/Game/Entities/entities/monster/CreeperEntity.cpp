@@ -1,17 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/CreeperEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, CreeperEntity::metadata_count> CreeperEntity::metadata_names{ {
-        "data_swell_dir",
-        "data_is_powered",
-        "data_is_ignited",
-    } };
-
     CreeperEntity::CreeperEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataSwellDir(-1);
         SetDataIsPowered(false);
@@ -70,45 +67,45 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int CreeperEntity::GetDataSwellDir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_swell_dir"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_swell_dir")]);
     }
 
     bool CreeperEntity::GetDataIsPowered() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_powered"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_is_powered")]);
     }
 
     bool CreeperEntity::GetDataIsIgnited() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_ignited"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_is_ignited")]);
     }
 
 
     void CreeperEntity::SetDataSwellDir(const int data_swell_dir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_swell_dir"] = data_swell_dir;
+        metadata[METADATA_INDEX("data_swell_dir")] = data_swell_dir;
     }
 
     void CreeperEntity::SetDataIsPowered(const bool data_is_powered)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_powered"] = data_is_powered;
+        metadata[METADATA_INDEX("data_is_powered")] = data_is_powered;
     }
 
     void CreeperEntity::SetDataIsIgnited(const bool data_is_ignited)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_ignited"] = data_is_ignited;
+        metadata[METADATA_INDEX("data_is_ignited")] = data_is_ignited;
     }
 
 
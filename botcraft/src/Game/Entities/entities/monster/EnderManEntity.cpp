@@ -1,19 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/EnderManEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, EnderManEntity::metadata_count> EnderManEntity::metadata_names{ {
-        "data_carry_state",
-        "data_creepy",
-#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
-        "data_stared_at",
-#endif
-    } };
-
     EnderManEntity::EnderManEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataCarryState(0);
         SetDataCreepy(false);
@@ -82,27 +77,27 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int EnderManEntity::GetDataCarryState() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_carry_state"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_carry_state")]);
     }
 
     bool EnderManEntity::GetDataCreepy() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_creepy"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_creepy")]);
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     bool EnderManEntity::GetDataStaredAt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_stared_at"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_stared_at")]);
     }
 #endif
 
@@ -110,20 +105,20 @@ namespace Botcraft
     void EnderManEntity::SetDataCarryState(const int data_carry_state)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_carry_state"] = data_carry_state;
+        metadata[METADATA_INDEX("data_carry_state")] = data_carry_state;
     }
 
     void EnderManEntity::SetDataCreepy(const bool data_creepy)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_creepy"] = data_creepy;
+        metadata[METADATA_INDEX("data_creepy")] = data_creepy;
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     void EnderManEntity::SetDataStaredAt(const bool data_stared_at)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_stared_at"] = data_stared_at;
+        metadata[METADATA_INDEX("data_stared_at")] = data_stared_at;
     }
 #endif
 
@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/GhastEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, GhastEntity::metadata_count> GhastEntity::metadata_names{ {
-        "data_is_charging",
-    } };
-
     GhastEntity::GhastEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIsCharging(false);
 
@@ -65,21 +64,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GhastEntity::GetDataIsCharging() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_is_charging"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_is_charging")]);
     }
 
 
     void GhastEntity::SetDataIsCharging(const bool data_is_charging)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_is_charging"] = data_is_charging;
+        metadata[METADATA_INDEX("data_is_charging")] = data_is_charging;
     }
 
 
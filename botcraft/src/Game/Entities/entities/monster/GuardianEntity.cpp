@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/GuardianEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, GuardianEntity::metadata_count> GuardianEntity::metadata_names{ {
-        "data_id_moving",
-        "data_id_attack_target",
-    } };
-
     GuardianEntity::GuardianEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdMoving(false);
         SetDataIdAttackTarget(0);
@@ -70,33 +68,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool GuardianEntity::GetDataIdMoving() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_moving"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_moving")]);
     }
 
     int GuardianEntity::GetDataIdAttackTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_attack_target"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_attack_target")]);
     }
 
 
     void GuardianEntity::SetDataIdMoving(const bool data_id_moving)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_moving"] = data_id_moving;
+        metadata[METADATA_INDEX("data_id_moving")] = data_id_moving;
     }
 
     void GuardianEntity::SetDataIdAttackTarget(const int data_id_attack_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_attack_target"] = data_id_attack_target;
+        metadata[METADATA_INDEX("data_id_attack_target")] = data_id_attack_target;
     }
 
 
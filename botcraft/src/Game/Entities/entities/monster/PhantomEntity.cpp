@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/monster/PhantomEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PhantomEntity::metadata_count> PhantomEntity::metadata_names{ {
-        "id_size",
-    } };
-
     PhantomEntity::PhantomEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIdSize(0);
     }
@@ -62,21 +61,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int PhantomEntity::GetIdSize() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("id_size"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("id_size")]);
     }
 
 
     void PhantomEntity::SetIdSize(const int id_size)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_size"] = id_size;
+        metadata[METADATA_INDEX("id_size")] = id_size;
     }
 
 
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
 #include "botcraft/Game/Entities/entities/monster/PillagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PillagerEntity::metadata_count> PillagerEntity::metadata_names{ {
-        "is_charging_crossbow",
-    } };
-
     PillagerEntity::PillagerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIsChargingCrossbow(false);
 
@@ -68,21 +67,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool PillagerEntity::GetIsChargingCrossbow() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_charging_crossbow"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("is_charging_crossbow")]);
     }
 
 
     void PillagerEntity::SetIsChargingCrossbow(const bool is_charging_crossbow)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_charging_crossbow"] = is_charging_crossbow;
+        metadata[METADATA_INDEX("is_charging_crossbow")] = is_charging_crossbow;
     }
 
 
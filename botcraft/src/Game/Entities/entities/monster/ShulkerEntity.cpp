@@ -1,20 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/ShulkerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ShulkerEntity::metadata_count> ShulkerEntity::metadata_names{ {
-        "data_attach_face_id",
-#if PROTOCOL_VERSION < 755 /* < 1.17 */
-        "data_attach_pos_id",
-#endif
-        "data_peek_id",
-        "data_color_id",
-    } };
-
     ShulkerEntity::ShulkerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataAttachFaceId(Direction::Down);
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
@@ -79,61 +73,61 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     Direction ShulkerEntity::GetDataAttachFaceId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<Direction>(metadata.at("data_attach_face_id"));
+        return std::any_cast<Direction>(metadata[METADATA_INDEX("data_attach_face_id")]);
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
     std::optional<Position> ShulkerEntity::GetDataAttachPosId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<Position>>(metadata.at("data_attach_pos_id"));
+        return std::any_cast<std::optional<Position>>(metadata[METADATA_INDEX("data_attach_pos_id")]);
     }
 #endif
 
     char ShulkerEntity::GetDataPeekId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_peek_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_peek_id")]);
     }
 
     char ShulkerEntity::GetDataColorId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_color_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_color_id")]);
     }
 
 
     void ShulkerEntity::SetDataAttachFaceId(const Direction data_attach_face_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attach_face_id"] = data_attach_face_id;
+        metadata[METADATA_INDEX("data_attach_face_id")] = data_attach_face_id;
     }
 
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
     void ShulkerEntity::SetDataAttachPosId(const std::optional<Position>& data_attach_pos_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attach_pos_id"] = data_attach_pos_id;
+        metadata[METADATA_INDEX("data_attach_pos_id")] = data_attach_pos_id;
     }
 #endif
 
     void ShulkerEntity::SetDataPeekId(const char data_peek_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_peek_id"] = data_peek_id;
+        metadata[METADATA_INDEX("data_peek_id")] = data_peek_id;
     }
 
     void ShulkerEntity::SetDataColorId(const char data_color_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_color_id"] = data_color_id;
+        metadata[METADATA_INDEX("data_color_id")] = data_color_id;
     }
 
 
@@ -1,18 +1,15 @@
 #include "botcraft/Game/Entities/entities/monster/SkeletonEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 754 /* > 1.16.5 */
-    const std::array<std::string, SkeletonEntity::metadata_count> SkeletonEntity::metadata_names{ {
-        "data_stray_conversion_id",
-    } };
-#endif
-
     SkeletonEntity::SkeletonEntity()
     {
 #if PROTOCOL_VERSION > 754 /* > 1.16.5 */
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataStrayConversionId(false);
 #endif
@@ -66,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool SkeletonEntity::GetDataStrayConversionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_stray_conversion_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_stray_conversion_id")]);
     }
 
 
     void SkeletonEntity::SetDataStrayConversionId(const bool data_stray_conversion_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_stray_conversion_id"] = data_stray_conversion_id;
+        metadata[METADATA_INDEX("data_stray_conversion_id")] = data_stray_conversion_id;
     }
 #endif
 
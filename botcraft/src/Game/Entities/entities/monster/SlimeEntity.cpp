@@ -1,20 +1,19 @@
 #include "botcraft/Game/Entities/entities/monster/SlimeEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, SlimeEntity::metadata_count> SlimeEntity::metadata_names{ {
-        "id_size",
-    } };
-
     SlimeEntity::SlimeEntity()
     {
         // As Slime don't inherit from MonsterEntity, AttackDamage is not initialized in parent constructor
         // It is overwritten when size is set, but it needs to be initialized before
         attributes.insert({ EntityAttribute::Type::AttackDamage, EntityAttribute(EntityAttribute::Type::AttackDamage, 1.0) });
 
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIdSize(1);
     }
@@ -66,9 +65,8 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            const std::string& metadata_name = metadata_names[index - hierarchy_metadata_count];
-            metadata[metadata_name] = value;
-            if (metadata_name == "id_size")
+            metadata[index] = value;
+            if (index == METADATA_INDEX("id_size"))
             {
                 SizeChanged(std::any_cast<int>(value));
 #if USE_GUI
@@ -88,7 +86,7 @@ namespace Botcraft
     void SlimeEntity::SetIdSize(const int id_size)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_size"] = id_size;
+        metadata[METADATA_INDEX("id_size")] = id_size;
         SizeChanged(id_size);
 #if USE_GUI
         OnSizeUpdated();
@@ -97,7 +95,7 @@ namespace Botcraft
 
     int SlimeEntity::GetIdSizeImpl() const
     {
-        return std::any_cast<int>(metadata.at("id_size"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("id_size")]);
     }
 
     void SlimeEntity::SizeChanged(const int new_size)
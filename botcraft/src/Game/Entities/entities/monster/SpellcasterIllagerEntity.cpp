@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/SpellcasterIllagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, SpellcasterIllagerEntity::metadata_count> SpellcasterIllagerEntity::metadata_names{ {
-        "data_spell_casting_id",
-    } };
-
     SpellcasterIllagerEntity::SpellcasterIllagerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataSpellCastingId(0);
     }
@@ -44,21 +43,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char SpellcasterIllagerEntity::GetDataSpellCastingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_spell_casting_id"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_spell_casting_id")]);
     }
 
 
     void SpellcasterIllagerEntity::SetDataSpellCastingId(const char data_spell_casting_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_spell_casting_id"] = data_spell_casting_id;
+        metadata[METADATA_INDEX("data_spell_casting_id")] = data_spell_casting_id;
     }
 
 }
@@ -1,18 +1,15 @@
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
 #include "botcraft/Game/Entities/entities/monster/StriderEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, StriderEntity::metadata_count> StriderEntity::metadata_names{ {
-        "data_boost_time",
-        "data_suffocating",
-        "data_saddle_id",
-    } };
-
     StriderEntity::StriderEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataBoostTime(0);
         SetDataSuffocating(false);
@@ -72,45 +69,45 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int StriderEntity::GetDataBoostTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_boost_time"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_boost_time")]);
     }
 
     bool StriderEntity::GetDataSuffocating() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_suffocating"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_suffocating")]);
     }
 
     bool StriderEntity::GetDataSaddleId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_saddle_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_saddle_id")]);
     }
 
 
     void StriderEntity::SetDataBoostTime(const int data_boost_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_boost_time"] = data_boost_time;
+        metadata[METADATA_INDEX("data_boost_time")] = data_boost_time;
     }
 
     void StriderEntity::SetDataSuffocating(const bool data_suffocating)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_suffocating"] = data_suffocating;
+        metadata[METADATA_INDEX("data_suffocating")] = data_suffocating;
     }
 
     void StriderEntity::SetDataSaddleId(const bool data_saddle_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_saddle_id"] = data_saddle_id;
+        metadata[METADATA_INDEX("data_saddle_id")] = data_saddle_id;
     }
 
 
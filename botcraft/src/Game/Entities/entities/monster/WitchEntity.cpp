@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/WitchEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, WitchEntity::metadata_count> WitchEntity::metadata_names{ {
-        "data_using_item",
-    } };
-
     WitchEntity::WitchEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataUsingItem(false);
 
@@ -73,21 +72,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool WitchEntity::GetDataUsingItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_using_item"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_using_item")]);
     }
 
 
     void WitchEntity::SetDataUsingItem(const bool data_using_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_using_item"] = data_using_item;
+        metadata[METADATA_INDEX("data_using_item")] = data_using_item;
     }
 
 
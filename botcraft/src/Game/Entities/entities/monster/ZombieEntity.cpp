@@ -1,22 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/ZombieEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ZombieEntity::metadata_count> ZombieEntity::metadata_names{ {
-        "data_baby_id",
-        "data_special_type_id",
-#if PROTOCOL_VERSION < 405 /* < 1.14 */
-        "data_are_hands_up",
-#endif
-#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
-        "data_drowned_conversion_id",
-#endif
-    } };
-
     ZombieEntity::ZombieEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataBabyId(false);
         SetDataSpecialTypeId(0);
@@ -91,27 +83,27 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool ZombieEntity::GetDataBabyId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_baby_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_baby_id")]);
     }
 
     int ZombieEntity::GetDataSpecialTypeId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_special_type_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_special_type_id")]);
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     bool ZombieEntity::GetDataAreHandsUp() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_are_hands_up"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_are_hands_up")]);
     }
 #endif
 
@@ -119,7 +111,7 @@ namespace Botcraft
     bool ZombieEntity::GetDataDrownedConversionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_drowned_conversion_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_drowned_conversion_id")]);
     }
 #endif
 
@@ -127,20 +119,20 @@ namespace Botcraft
     void ZombieEntity::SetDataBabyId(const bool data_baby_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_baby_id"] = data_baby_id;
+        metadata[METADATA_INDEX("data_baby_id")] = data_baby_id;
     }
 
     void ZombieEntity::SetDataSpecialTypeId(const int data_special_type_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_special_type_id"] = data_special_type_id;
+        metadata[METADATA_INDEX("data_special_type_id")] = data_special_type_id;
     }
 
 #if PROTOCOL_VERSION < 405 /* < 1.14 */
     void ZombieEntity::SetDataAreHandsUp(const bool data_are_hands_up)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_are_hands_up"] = data_are_hands_up;
+        metadata[METADATA_INDEX("data_are_hands_up")] = data_are_hands_up;
     }
 #endif
 
@@ -148,7 +140,7 @@ namespace Botcraft
     void ZombieEntity::SetDataDrownedConversionId(const bool data_drowned_conversion_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_drowned_conversion_id"] = data_drowned_conversion_id;
+        metadata[METADATA_INDEX("data_drowned_conversion_id")] = data_drowned_conversion_id;
     }
 #endif
 
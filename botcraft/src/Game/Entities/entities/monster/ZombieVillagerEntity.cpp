@@ -1,20 +1,14 @@
 #include "botcraft/Game/Entities/entities/monster/ZombieVillagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ZombieVillagerEntity::metadata_count> ZombieVillagerEntity::metadata_names{ {
-        "data_converting_id",
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "data_villager_data",
-#else
-        "data_villager_profession_id"
-#endif
-    } };
-
     ZombieVillagerEntity::ZombieVillagerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataConvertingId(false);
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
@@ -76,27 +70,27 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool ZombieVillagerEntity::GetDataConvertingId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_converting_id"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_converting_id")]);
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     VillagerData ZombieVillagerEntity::GetDataVillagerData() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<VillagerData>(metadata.at("data_villager_data"));
+        return std::any_cast<VillagerData>(metadata[METADATA_INDEX("data_villager_data")]);
     }
 #else
     int ZombieVillagerEntity::GetDataVillagerProfessionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_villager_profession_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_villager_profession_id")]);
     }
 #endif
 
@@ -104,20 +98,20 @@ namespace Botcraft
     void ZombieVillagerEntity::SetDataConvertingId(const bool data_converting_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_converting_id"] = data_converting_id;
+        metadata[METADATA_INDEX("data_converting_id")] = data_converting_id;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     void ZombieVillagerEntity::SetDataVillagerData(const VillagerData& data_villager_data)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_data"] = data_villager_data;
+        metadata[METADATA_INDEX("data_villager_data")] = data_villager_data;
     }
 #else
     void ZombieVillagerEntity::SetDataVillagerProfessionId(const int data_villager_profession_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_profession_id"] = data_villager_profession_id;
+        metadata[METADATA_INDEX("data_villager_profession_id")] = data_villager_profession_id;
     }
 #endif
 
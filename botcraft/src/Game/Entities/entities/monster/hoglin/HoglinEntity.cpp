@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
 #include "botcraft/Game/Entities/entities/monster/hoglin/HoglinEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, HoglinEntity::metadata_count> HoglinEntity::metadata_names{ {
-        "data_immune_to_zombification",
-    } };
-
     HoglinEntity::HoglinEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataImmuneToZombification(false);
 
@@ -71,21 +70,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool HoglinEntity::GetDataImmuneToZombification() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_immune_to_zombification"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_immune_to_zombification")]);
     }
 
 
     void HoglinEntity::SetDataImmuneToZombification(const bool data_immune_to_zombification)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_immune_to_zombification"] = data_immune_to_zombification;
+        metadata[METADATA_INDEX("data_immune_to_zombification")] = data_immune_to_zombification;
     }
 
 
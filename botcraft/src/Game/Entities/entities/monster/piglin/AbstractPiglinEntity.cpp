@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 736 /* > 1.16.1 */
 #include "botcraft/Game/Entities/entities/monster/piglin/AbstractPiglinEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractPiglinEntity::metadata_count> AbstractPiglinEntity::metadata_names{ {
-        "data_immune_to_zombification",
-    } };
-
     AbstractPiglinEntity::AbstractPiglinEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataImmuneToZombification(false);
     }
@@ -45,21 +44,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool AbstractPiglinEntity::GetDataImmuneToZombification() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_immune_to_zombification"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_immune_to_zombification")]);
     }
 
 
     void AbstractPiglinEntity::SetDataImmuneToZombification(const bool data_immune_to_zombification)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_immune_to_zombification"] = data_immune_to_zombification;
+        metadata[METADATA_INDEX("data_immune_to_zombification")] = data_immune_to_zombification;
     }
 
 }
@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
 #include "botcraft/Game/Entities/entities/monster/warden/WardenEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, WardenEntity::metadata_count> WardenEntity::metadata_names{ {
-        "client_anger_level",
-    } };
-
     WardenEntity::WardenEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetClientAngerLevel(0);
 
@@ -69,21 +68,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int WardenEntity::GetClientAngerLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("client_anger_level"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("client_anger_level")]);
     }
 
 
     void WardenEntity::SetClientAngerLevel(const int client_anger_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["client_anger_level"] = client_anger_level;
+        metadata[METADATA_INDEX("client_anger_level")] = client_anger_level;
     }
 
 
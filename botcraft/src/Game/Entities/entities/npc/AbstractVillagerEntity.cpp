@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 477 /* > 1.14 */
 #include "botcraft/Game/Entities/entities/npc/AbstractVillagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractVillagerEntity::metadata_count> AbstractVillagerEntity::metadata_names{ {
-        "data_unhappy_counter",
-    } };
-
     AbstractVillagerEntity::AbstractVillagerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataUnhappyCounter(0);
     }
@@ -45,21 +44,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int AbstractVillagerEntity::GetDataUnhappyCounter() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_unhappy_counter"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_unhappy_counter")]);
     }
 
 
     void AbstractVillagerEntity::SetDataUnhappyCounter(const int data_unhappy_counter)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_unhappy_counter"] = data_unhappy_counter;
+        metadata[METADATA_INDEX("data_unhappy_counter")] = data_unhappy_counter;
     }
 
 }
@@ -1,19 +1,14 @@
 #include "botcraft/Game/Entities/entities/npc/VillagerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, VillagerEntity::metadata_count> VillagerEntity::metadata_names{ {
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "data_villager_data",
-#else
-        "data_villager_profession_id",
-#endif
-    } };
-
     VillagerEntity::VillagerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         SetDataVillagerData(VillagerData{ 2, 0, 1 });
@@ -85,7 +80,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -93,27 +88,27 @@ namespace Botcraft
     VillagerData VillagerEntity::GetDataVillagerData() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<VillagerData>(metadata.at("data_villager_data"));
+        return std::any_cast<VillagerData>(metadata[METADATA_INDEX("data_villager_data")]);
     }
 
 
     void VillagerEntity::SetDataVillagerData(const VillagerData& data_villager_data)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_data"] = data_villager_data;
+        metadata[METADATA_INDEX("data_villager_data")] = data_villager_data;
     }
 #else
     int VillagerEntity::GetDataVillagerProfessionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_villager_profession_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_villager_profession_id")]);
     }
 
 
     void VillagerEntity::SetDataVillagerProfessionId(const int data_villager_profession_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_villager_profession_id"] = data_villager_profession_id;
+        metadata[METADATA_INDEX("data_villager_profession_id")] = data_villager_profession_id;
     }
 #endif
 
@@ -1,20 +1,14 @@
 #include "botcraft/Game/Entities/entities/player/PlayerEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, PlayerEntity::metadata_count> PlayerEntity::metadata_names{ {
-        "data_player_absorption_id",
-        "data_score_id",
-        "data_player_mode_customisation",
-        "data_player_main_hand",
-        "data_shoulder_left",
-        "data_shoulder_right",
-    } };
-
     PlayerEntity::PlayerEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataPlayerAbsorptionId(0.0f);
         SetDataScoreId(0);
@@ -140,81 +134,81 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     float PlayerEntity::GetDataPlayerAbsorptionId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_player_absorption_id"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_player_absorption_id")]);
     }
 
     int PlayerEntity::GetDataScoreId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_score_id"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_score_id")]);
     }
 
     char PlayerEntity::GetDataPlayerModeCustomisation() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_player_mode_customisation"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_player_mode_customisation")]);
     }
 
     char PlayerEntity::GetDataPlayerMainHand() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("data_player_main_hand"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("data_player_main_hand")]);
     }
 
     ProtocolCraft::NBT::Value PlayerEntity::GetDataShoulderLeft() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::NBT::Value>(metadata.at("data_shoulder_left"));
+        return std::any_cast<ProtocolCraft::NBT::Value>(metadata[METADATA_INDEX("data_shoulder_left")]);
     }
 
     ProtocolCraft::NBT::Value PlayerEntity::GetDataShoulderRight() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::NBT::Value>(metadata.at("data_shoulder_right"));
+        return std::any_cast<ProtocolCraft::NBT::Value>(metadata[METADATA_INDEX("data_shoulder_right")]);
     }
 
 
     void PlayerEntity::SetDataPlayerAbsorptionId(const float data_player_absorption_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_player_absorption_id"] = data_player_absorption_id;
+        metadata[METADATA_INDEX("data_player_absorption_id")] = data_player_absorption_id;
     }
 
     void PlayerEntity::SetDataScoreId(const int data_score_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_score_id"] = data_score_id;
+        metadata[METADATA_INDEX("data_score_id")] = data_score_id;
     }
 
     void PlayerEntity::SetDataPlayerModeCustomisation(const char data_player_mode_customisation)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_player_mode_customisation"] = data_player_mode_customisation;
+        metadata[METADATA_INDEX("data_player_mode_customisation")] = data_player_mode_customisation;
     }
 
     void PlayerEntity::SetDataPlayerMainHand(const char data_player_main_hand)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_player_main_hand"] = data_player_main_hand;
+        metadata[METADATA_INDEX("data_player_main_hand")] = data_player_main_hand;
     }
 
     void PlayerEntity::SetDataShoulderLeft(const ProtocolCraft::NBT::Value& data_shoulder_left)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shoulder_left"] = data_shoulder_left;
+        metadata[METADATA_INDEX("data_shoulder_left")] = data_shoulder_left;
     }
 
     void PlayerEntity::SetDataShoulderRight(const ProtocolCraft::NBT::Value& data_shoulder_right)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shoulder_right"] = data_shoulder_right;
+        metadata[METADATA_INDEX("data_shoulder_right")] = data_shoulder_right;
     }
 
     bool PlayerEntity::IsRemotePlayer() const
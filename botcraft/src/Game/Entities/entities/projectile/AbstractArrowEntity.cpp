@@ -1,21 +1,14 @@
 #include "botcraft/Game/Entities/entities/projectile/AbstractArrowEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractArrowEntity::metadata_count> AbstractArrowEntity::metadata_names{ {
-        "id_flags",
-#if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
-        "data_owneruuid_id",
-#endif
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "pierce_level",
-#endif
-    } };
-
     AbstractArrowEntity::AbstractArrowEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIdFlags(0);
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
@@ -70,21 +63,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char AbstractArrowEntity::GetIdFlags() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("id_flags"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("id_flags")]);
     }
 
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
     std::optional<ProtocolCraft::UUID> AbstractArrowEntity::GetDataOwneruuidId() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata.at("data_owneruuid_id"));
+        return std::any_cast<std::optional<ProtocolCraft::UUID>>(metadata[METADATA_INDEX("data_owneruuid_id")]);
     }
 #endif
 
@@ -92,7 +85,7 @@ namespace Botcraft
     char AbstractArrowEntity::GetPierceLevel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("pierce_level"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("pierce_level")]);
     }
 #endif
 
@@ -100,14 +93,14 @@ namespace Botcraft
     void AbstractArrowEntity::SetIdFlags(const char id_flags)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_flags"] = id_flags;
+        metadata[METADATA_INDEX("id_flags")] = id_flags;
     }
 
 #if PROTOCOL_VERSION < 579 /* < 1.16 */ && PROTOCOL_VERSION > 393 /* > 1.13 */
     void AbstractArrowEntity::SetDataOwneruuidId(const std::optional<ProtocolCraft::UUID>& data_owneruuid_id)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_owneruuid_id"] = data_owneruuid_id;
+        metadata[METADATA_INDEX("data_owneruuid_id")] = data_owneruuid_id;
     }
 #endif
 
@@ -115,7 +108,7 @@ namespace Botcraft
     void AbstractArrowEntity::SetPierceLevel(const char pierce_level)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["pierce_level"] = pierce_level;
+        metadata[METADATA_INDEX("pierce_level")] = pierce_level;
     }
 #endif
 
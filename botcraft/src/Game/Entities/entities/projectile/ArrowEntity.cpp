@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/projectile/ArrowEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ArrowEntity::metadata_count> ArrowEntity::metadata_names{ {
-        "id_effect_color",
-    } };
-
     ArrowEntity::ArrowEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIdEffectColor(-1);
     }
@@ -61,21 +60,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int ArrowEntity::GetIdEffectColor() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("id_effect_color"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("id_effect_color")]);
     }
 
 
     void ArrowEntity::SetIdEffectColor(const int id_effect_color)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_effect_color"] = id_effect_color;
+        metadata[METADATA_INDEX("id_effect_color")] = id_effect_color;
     }
 
 
@@ -1,4 +1,5 @@
 #include "botcraft/Game/Entities/entities/projectile/FireballEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/AssetsManager.hpp"
@@ -8,14 +9,10 @@
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-    const std::array<std::string, FireballEntity::metadata_count> FireballEntity::metadata_names{ {
-        "data_item_stack",
-    } };
-#endif
-
     FireballEntity::FireballEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
@@ -61,21 +58,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot FireballEntity::GetDataItemStack() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<const ProtocolCraft::Slot&>(metadata.at("data_item_stack"));
+        return std::any_cast<const ProtocolCraft::Slot&>(metadata[METADATA_INDEX("data_item_stack")]);
     }
 
 
     void FireballEntity::SetDataItemStack(const ProtocolCraft::Slot& data_item_stack)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack"] = data_item_stack;
+        metadata[METADATA_INDEX("data_item_stack")] = data_item_stack;
     }
 #endif
 
@@ -1,4 +1,5 @@
 #include "botcraft/Game/Entities/entities/projectile/FireworkRocketEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/AssetsManager.hpp"
@@ -8,16 +9,10 @@
 
 namespace Botcraft
 {
-    const std::array<std::string, FireworkRocketEntity::metadata_count> FireworkRocketEntity::metadata_names{ {
-        "data_id_fireworks_item",
-        "data_attached_to_target",
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-        "data_shot_at_angle",
-#endif
-    } };
-
     FireworkRocketEntity::FireworkRocketEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 766 /* < 1.20.5 */
         SetDataIdFireworksItem(ProtocolCraft::Slot());
@@ -98,33 +93,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot FireworkRocketEntity::GetDataIdFireworksItem() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_id_fireworks_item"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_id_fireworks_item")]);
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     std::optional<int> FireworkRocketEntity::GetDataAttachedToTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::optional<int>>(metadata.at("data_attached_to_target"));
+        return std::any_cast<std::optional<int>>(metadata[METADATA_INDEX("data_attached_to_target")]);
     }
 
     bool FireworkRocketEntity::GetDataShotAtAngle() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_shot_at_angle"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_shot_at_angle")]);
     }
 #else
     int FireworkRocketEntity::GetDataAttachedToTarget() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_attached_to_target"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_attached_to_target")]);
     }
 #endif
 
@@ -132,26 +127,26 @@ namespace Botcraft
     void FireworkRocketEntity::SetDataIdFireworksItem(const ProtocolCraft::Slot& data_id_fireworks_item)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_fireworks_item"] = data_id_fireworks_item;
+        metadata[METADATA_INDEX("data_id_fireworks_item")] = data_id_fireworks_item;
     }
 
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
     void FireworkRocketEntity::SetDataAttachedToTarget(const std::optional<int>& data_attached_to_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attached_to_target"] = data_attached_to_target;
+        metadata[METADATA_INDEX("data_attached_to_target")] = data_attached_to_target;
     }
 
     void FireworkRocketEntity::SetDataShotAtAngle(const bool data_shot_at_angle)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_shot_at_angle"] = data_shot_at_angle;
+        metadata[METADATA_INDEX("data_shot_at_angle")] = data_shot_at_angle;
     }
 #else
     void FireworkRocketEntity::SetDataAttachedToTarget(const int data_attached_to_target)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_attached_to_target"] = data_attached_to_target;
+        metadata[METADATA_INDEX("data_attached_to_target")] = data_attached_to_target;
     }
 #endif
 
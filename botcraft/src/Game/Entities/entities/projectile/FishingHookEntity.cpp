@@ -1,18 +1,14 @@
 #include "botcraft/Game/Entities/entities/projectile/FishingHookEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, FishingHookEntity::metadata_count> FishingHookEntity::metadata_names{ {
-        "data_hooked_entity",
-#if PROTOCOL_VERSION > 578 /* > 1.15.2 */
-        "data_biting",
-#endif
-    } };
-
     FishingHookEntity::FishingHookEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataHookedEntity(0);
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
@@ -77,21 +73,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     int FishingHookEntity::GetDataHookedEntity() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_hooked_entity"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_hooked_entity")]);
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     bool FishingHookEntity::GetDataBiting() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_biting"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_biting")]);
     }
 #endif
 
@@ -99,14 +95,14 @@ namespace Botcraft
     void FishingHookEntity::SetDataHookedEntity(const int data_hooked_entity)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_hooked_entity"] = data_hooked_entity;
+        metadata[METADATA_INDEX("data_hooked_entity")] = data_hooked_entity;
     }
 
 #if PROTOCOL_VERSION > 578 /* > 1.15.2 */
     void FishingHookEntity::SetDataBiting(const bool data_biting)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_biting"] = data_biting;
+        metadata[METADATA_INDEX("data_biting")] = data_biting;
     }
 #endif
 
@@ -1,17 +1,14 @@
 #include "botcraft/Game/Entities/entities/projectile/ThrowableItemProjectileEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
-    const std::array<std::string, ThrowableItemProjectileEntity::metadata_count> ThrowableItemProjectileEntity::metadata_names{ {
-        "data_item_stack",
-    } };
-#endif
-
     ThrowableItemProjectileEntity::ThrowableItemProjectileEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
         SetDataItemStack(ProtocolCraft::Slot());
@@ -49,21 +46,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ThrowableItemProjectileEntity::GetDataItemStack() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item_stack"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_item_stack")]);
     }
 
 
     void ThrowableItemProjectileEntity::SetDataItemStack(const ProtocolCraft::Slot& data_item_stack)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack"] = data_item_stack;
+        metadata[METADATA_INDEX("data_item_stack")] = data_item_stack;
     }
 #endif
 
@@ -1,4 +1,5 @@
 #include "botcraft/Game/Entities/entities/projectile/ThrownPotionEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #if PROTOCOL_VERSION > 765 /* > 1.20.4 */
 #include "botcraft/Game/AssetsManager.hpp"
@@ -10,14 +11,10 @@
 
 namespace Botcraft
 {
-#if PROTOCOL_VERSION < 579 /* < 1.16 */
-    const std::array<std::string, ThrownPotionEntity::metadata_count> ThrownPotionEntity::metadata_names{ {
-        "data_item_stack",
-    } };
-#endif
-
     ThrownPotionEntity::ThrownPotionEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 579 /* < 1.16 */
         SetDataItemStack(ProtocolCraft::Slot());
@@ -79,21 +76,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     ProtocolCraft::Slot ThrownPotionEntity::GetDataItemStack() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Slot>(metadata.at("data_item_stack"));
+        return std::any_cast<ProtocolCraft::Slot>(metadata[METADATA_INDEX("data_item_stack")]);
     }
 
 
     void ThrownPotionEntity::SetDataItemStack(const ProtocolCraft::Slot& data_item_stack)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_item_stack"] = data_item_stack;
+        metadata[METADATA_INDEX("data_item_stack")] = data_item_stack;
     }
 #endif
 
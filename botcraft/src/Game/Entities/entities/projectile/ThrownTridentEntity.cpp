@@ -1,19 +1,15 @@
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
 #include "botcraft/Game/Entities/entities/projectile/ThrownTridentEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, ThrownTridentEntity::metadata_count> ThrownTridentEntity::metadata_names{ {
-        "id_loyalty",
-#if PROTOCOL_VERSION > 498 /* > 1.14.4 */
-        "id_foil",
-#endif
-    } };
-
     ThrownTridentEntity::ThrownTridentEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIdLoyalty(0);
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
@@ -71,21 +67,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     char ThrownTridentEntity::GetIdLoyalty() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<char>(metadata.at("id_loyalty"));
+        return std::any_cast<char>(metadata[METADATA_INDEX("id_loyalty")]);
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     bool ThrownTridentEntity::GetIdFoil() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("id_foil"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("id_foil")]);
     }
 #endif
 
@@ -93,14 +89,14 @@ namespace Botcraft
     void ThrownTridentEntity::SetIdLoyalty(const char id_loyalty)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_loyalty"] = id_loyalty;
+        metadata[METADATA_INDEX("id_loyalty")] = id_loyalty;
     }
 
 #if PROTOCOL_VERSION > 498 /* > 1.14.4 */
     void ThrownTridentEntity::SetIdFoil(const bool id_foil)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["id_foil"] = id_foil;
+        metadata[METADATA_INDEX("id_foil")] = id_foil;
     }
 #endif
 
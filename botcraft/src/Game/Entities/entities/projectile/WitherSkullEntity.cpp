@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/projectile/WitherSkullEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, WitherSkullEntity::metadata_count> WitherSkullEntity::metadata_names{ {
-        "data_dangerous",
-    } };
-
     WitherSkullEntity::WitherSkullEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataDangerous(false);
     }
@@ -61,21 +60,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool WitherSkullEntity::GetDataDangerous() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_dangerous"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_dangerous")]);
     }
 
 
     void WitherSkullEntity::SetDataDangerous(const bool data_dangerous)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_dangerous"] = data_dangerous;
+        metadata[METADATA_INDEX("data_dangerous")] = data_dangerous;
     }
 
 
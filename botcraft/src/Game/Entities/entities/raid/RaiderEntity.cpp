@@ -1,16 +1,15 @@
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
 #include "botcraft/Game/Entities/entities/raid/RaiderEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, RaiderEntity::metadata_count> RaiderEntity::metadata_names{ {
-        "is_celebrating",
-    } };
-
     RaiderEntity::RaiderEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetIsCelebrating(false);
     }
@@ -45,21 +44,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool RaiderEntity::GetIsCelebrating() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("is_celebrating"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("is_celebrating")]);
     }
 
 
     void RaiderEntity::SetIsCelebrating(const bool is_celebrating)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["is_celebrating"] = is_celebrating;
+        metadata[METADATA_INDEX("is_celebrating")] = is_celebrating;
     }
 
 }
@@ -1,22 +1,14 @@
 #include "botcraft/Game/Entities/entities/vehicle/AbstractMinecartEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, AbstractMinecartEntity::metadata_count> AbstractMinecartEntity::metadata_names{ {
-#if PROTOCOL_VERSION < 765 /* < 1.20.3 */
-        "data_id_hurt",
-        "data_id_hurtdir",
-        "data_id_damage",
-#endif
-        "data_id_display_block",
-        "data_id_display_offset",
-        "data_id_custom_display",
-    } };
-
     AbstractMinecartEntity::AbstractMinecartEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         SetDataIdHurt(0);
@@ -73,7 +65,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -81,38 +73,38 @@ namespace Botcraft
     int AbstractMinecartEntity::GetDataIdHurt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurt"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_hurt")]);
     }
 
     int AbstractMinecartEntity::GetDataIdHurtdir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurtdir"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_hurtdir")]);
     }
 
     float AbstractMinecartEntity::GetDataIdDamage() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_id_damage"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_id_damage")]);
     }
 #endif
 
     int AbstractMinecartEntity::GetDataIdDisplayBlock() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_display_block"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_display_block")]);
     }
 
     int AbstractMinecartEntity::GetDataIdDisplayOffset() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_display_offset"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_display_offset")]);
     }
 
     bool AbstractMinecartEntity::GetDataIdCustomDisplay() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_custom_display"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_custom_display")]);
     }
 
 
@@ -120,38 +112,38 @@ namespace Botcraft
     void AbstractMinecartEntity::SetDataIdHurt(const int data_id_hurt)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurt"] = data_id_hurt;
+        metadata[METADATA_INDEX("data_id_hurt")] = data_id_hurt;
     }
 
     void AbstractMinecartEntity::SetDataIdHurtdir(const int data_id_hurtdir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurtdir"] = data_id_hurtdir;
+        metadata[METADATA_INDEX("data_id_hurtdir")] = data_id_hurtdir;
     }
 
     void AbstractMinecartEntity::SetDataIdDamage(const float data_id_damage)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_damage"] = data_id_damage;
+        metadata[METADATA_INDEX("data_id_damage")] = data_id_damage;
     }
 #endif
 
     void AbstractMinecartEntity::SetDataIdDisplayBlock(const int data_id_display_block)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_display_block"] = data_id_display_block;
+        metadata[METADATA_INDEX("data_id_display_block")] = data_id_display_block;
     }
 
     void AbstractMinecartEntity::SetDataIdDisplayOffset(const int data_id_display_offset)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_display_offset"] = data_id_display_offset;
+        metadata[METADATA_INDEX("data_id_display_offset")] = data_id_display_offset;
     }
 
     void AbstractMinecartEntity::SetDataIdCustomDisplay(const bool data_id_custom_display)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_custom_display"] = data_id_custom_display;
+        metadata[METADATA_INDEX("data_id_custom_display")] = data_id_custom_display;
     }
 
 }
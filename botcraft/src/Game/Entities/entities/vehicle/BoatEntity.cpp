@@ -1,25 +1,14 @@
 #include "botcraft/Game/Entities/entities/vehicle/BoatEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, BoatEntity::metadata_count> BoatEntity::metadata_names{ {
-#if PROTOCOL_VERSION < 765 /* < 1.20.3 */
-        "data_id_hurt",
-        "data_id_hurtdir",
-        "data_id_damage",
-#endif
-        "data_id_type",
-        "data_id_paddle_left",
-        "data_id_paddle_right",
-#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
-        "data_id_bubble_time",
-#endif
-    } };
-
     BoatEntity::BoatEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
 #if PROTOCOL_VERSION < 765 /* < 1.20.3 */
         SetDataIdHurt(0);
@@ -99,7 +88,7 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
@@ -107,45 +96,45 @@ namespace Botcraft
     int BoatEntity::GetDataIdHurt() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurt"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_hurt")]);
     }
 
     int BoatEntity::GetDataIdHurtdir() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_hurtdir"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_hurtdir")]);
     }
 
     float BoatEntity::GetDataIdDamage() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<float>(metadata.at("data_id_damage"));
+        return std::any_cast<float>(metadata[METADATA_INDEX("data_id_damage")]);
     }
 #endif
 
     int BoatEntity::GetDataIdType() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_type"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_type")]);
     }
 
     bool BoatEntity::GetDataIdPaddleLeft() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_left"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_paddle_left")]);
     }
 
     bool BoatEntity::GetDataIdPaddleRight() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_paddle_right"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_paddle_right")]);
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     int BoatEntity::GetDataIdBubbleTime() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<int>(metadata.at("data_id_bubble_time"));
+        return std::any_cast<int>(metadata[METADATA_INDEX("data_id_bubble_time")]);
     }
 #endif
 
@@ -154,45 +143,45 @@ namespace Botcraft
     void BoatEntity::SetDataIdHurt(const int data_id_hurt)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurt"] = data_id_hurt;
+        metadata[METADATA_INDEX("data_id_hurt")] = data_id_hurt;
     }
 
     void BoatEntity::SetDataIdHurtdir(const int data_id_hurtdir)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_hurtdir"] = data_id_hurtdir;
+        metadata[METADATA_INDEX("data_id_hurtdir")] = data_id_hurtdir;
     }
 
     void BoatEntity::SetDataIdDamage(const float data_id_damage)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_damage"] = data_id_damage;
+        metadata[METADATA_INDEX("data_id_damage")] = data_id_damage;
     }
 #endif
 
     void BoatEntity::SetDataIdType(const int data_id_type)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_type"] = data_id_type;
+        metadata[METADATA_INDEX("data_id_type")] = data_id_type;
     }
 
     void BoatEntity::SetDataIdPaddleLeft(const bool data_id_paddle_left)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_left"] = data_id_paddle_left;
+        metadata[METADATA_INDEX("data_id_paddle_left")] = data_id_paddle_left;
     }
 
     void BoatEntity::SetDataIdPaddleRight(const bool data_id_paddle_right)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_paddle_right"] = data_id_paddle_right;
+        metadata[METADATA_INDEX("data_id_paddle_right")] = data_id_paddle_right;
     }
 
 #if PROTOCOL_VERSION > 340 /* > 1.12.2 */
     void BoatEntity::SetDataIdBubbleTime(const int data_id_bubble_time)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_bubble_time"] = data_id_bubble_time;
+        metadata[METADATA_INDEX("data_id_bubble_time")] = data_id_bubble_time;
     }
 #endif
 
@@ -1,16 +1,14 @@
 #include "botcraft/Game/Entities/entities/vehicle/MinecartCommandBlockEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, MinecartCommandBlockEntity::metadata_count> MinecartCommandBlockEntity::metadata_names{ {
-        "data_id_command_name",
-        "data_id_last_output",
-    } };
-
     MinecartCommandBlockEntity::MinecartCommandBlockEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdCommandName("");
         SetDataIdLastOutput(ProtocolCraft::Chat());
@@ -64,33 +62,33 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     std::string MinecartCommandBlockEntity::GetDataIdCommandName() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<std::string>(metadata.at("data_id_command_name"));
+        return std::any_cast<std::string>(metadata[METADATA_INDEX("data_id_command_name")]);
     }
 
     ProtocolCraft::Chat MinecartCommandBlockEntity::GetDataIdLastOutput() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<ProtocolCraft::Chat>(metadata.at("data_id_last_output"));
+        return std::any_cast<ProtocolCraft::Chat>(metadata[METADATA_INDEX("data_id_last_output")]);
     }
 
 
     void MinecartCommandBlockEntity::SetDataIdCommandName(const std::string& data_id_command_name)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_command_name"] = data_id_command_name;
+        metadata[METADATA_INDEX("data_id_command_name")] = data_id_command_name;
     }
 
     void MinecartCommandBlockEntity::SetDataIdLastOutput(const ProtocolCraft::Chat& data_id_last_output)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_last_output"] = data_id_last_output;
+        metadata[METADATA_INDEX("data_id_last_output")] = data_id_last_output;
     }
 
 
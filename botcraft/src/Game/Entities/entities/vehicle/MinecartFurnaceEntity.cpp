@@ -1,15 +1,14 @@
 #include "botcraft/Game/Entities/entities/vehicle/MinecartFurnaceEntity.hpp"
+#include "botcraft/Game/Entities/MetadataIndex.hpp"
 
 #include <mutex>
 
 namespace Botcraft
 {
-    const std::array<std::string, MinecartFurnaceEntity::metadata_count> MinecartFurnaceEntity::metadata_names{ {
-        "data_id_fuel",
-    } };
-
     MinecartFurnaceEntity::MinecartFurnaceEntity()
     {
+        metadata.resize(hierarchy_metadata_count + metadata_count);
+
         // Initialize all metadata with default values
         SetDataIdFuel(false);
     }
@@ -61,21 +60,21 @@ namespace Botcraft
         else if (index - hierarchy_metadata_count < metadata_count)
         {
             std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-            metadata[metadata_names[index - hierarchy_metadata_count]] = value;
+            metadata[index] = value;
         }
     }
 
     bool MinecartFurnaceEntity::GetDataIdFuel() const
     {
         std::shared_lock<std::shared_mutex> lock(entity_mutex);
-        return std::any_cast<bool>(metadata.at("data_id_fuel"));
+        return std::any_cast<bool>(metadata[METADATA_INDEX("data_id_fuel")]);
     }
 
 
     void MinecartFurnaceEntity::SetDataIdFuel(const bool data_id_fuel)
     {
         std::scoped_lock<std::shared_mutex> lock(entity_mutex);
-        metadata["data_id_fuel"] = data_id_fuel;
+        metadata[METADATA_INDEX("data_id_fuel")] = data_id_fuel;
     }
 
 
@@ -8,6 +8,7 @@
 #include "botcraft/Game/Inventory/Window.hpp"
 #include "botcraft/Game/ManagersClient.hpp"
 #include "botcraft/Game/Physics/PhysicsManager.hpp"
+#include "botcraft/Game/Physics/TickScheduler.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 #include "botcraft/Utilities/SleepUtilities.hpp"
 
@@ -32,6 +33,7 @@ namespace Botcraft
         inventory_manager = nullptr;
         entity_manager = nullptr;
         physics_manager = nullptr;
+        tick_scheduler = nullptr;
 
 #if USE_GUI
         use_renderer = use_renderer_;
@@ -55,10 +57,11 @@ namespace Botcraft
 
     void ManagersClient::Disconnect()
     {
-        std::thread::id network_process_thread_id;
+        // 0 is never given to any loader
+        LoaderId network_loader_id = 0;
         if (network_manager)
         {
-            network_process_thread_id = network_manager->GetProcessingThreadId();
+            network_loader_id = network_manager->GetLoaderId();
         }
 
         ConnectionClient::Disconnect();
@@ -82,7 +85,7 @@ namespace Botcraft
 
         if (world)
         {
-            world->UnloadAllChunks(network_process_thread_id);
+            world->UnloadAllChunks(network_loader_id);
             world.reset();
         }
 
@@ -117,6 +120,11 @@ namespace Botcraft
         world = world_;
     }
 
+    void ManagersClient::SetTickScheduler(const std::shared_ptr<TickScheduler>& tick_scheduler_)
+    {
+        tick_scheduler = tick_scheduler_;
+    }
+
     bool ManagersClient::GetAutoRespawn() const
     {
         return auto_respawn;
@@ -184,6 +192,7 @@ namespace Botcraft
         entity_manager = std::make_shared<EntityManager>();
         // Subscribe them to the network manager
         network_manager->AddHandler(world.get());
+        network_manager->AddPreparer(world.get());
         network_manager->AddHandler(inventory_manager.get());
         network_manager->AddHandler(entity_manager.get());
 #if USE_GUI
@@ -198,7 +207,7 @@ namespace Botcraft
 #endif
         network_manager->AddHandler(physics_manager.get());
         // Start physics
-        physics_manager->StartPhysics();
+        physics_manager->StartPhysics(tick_scheduler);
     }
 
     void ManagersClient::Handle(ClientboundChangeDifficultyPacket& msg)
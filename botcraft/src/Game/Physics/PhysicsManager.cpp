@@ -1,5 +1,6 @@
 #include "botcraft/Game/AssetsManager.hpp"
 #include "botcraft/Game/Physics/PhysicsManager.hpp"
+#include "botcraft/Game/Physics/TickScheduler.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 #include "botcraft/Utilities/SleepUtilities.hpp"
 #include "botcraft/Utilities/ItemUtilities.hpp"
@@ -11,6 +12,7 @@
 #include "botcraft/Game/Inventory/Window.hpp"
 #include "botcraft/Network/NetworkManager.hpp"
 #include "botcraft/Game/World/World.hpp"
+#include "botcraft/Game/World/WorldView.hpp"
 #if USE_GUI
 #include "botcraft/Renderer/RenderingManager.hpp"
 #endif
@@ -39,6 +41,8 @@ namespace Botcraft
 
         should_run = false;
         ticks_since_last_position_sent = 0;
+        tick_scheduler = nullptr;
+        tick_scheduler_id = 0;
 
         const AssetsManager& assets_manager = AssetsManager::getInstance();
 
@@ -54,10 +58,17 @@ namespace Botcraft
         StopPhysics();
     }
 
-    void PhysicsManager::StartPhysics()
+    void PhysicsManager::StartPhysics(const std::shared_ptr<TickScheduler>& tick_scheduler_)
     {
         should_run = true;
 
+        if (tick_scheduler_)
+        {
+            tick_scheduler = tick_scheduler_;
+            tick_scheduler_id = tick_scheduler->Register(std::bind(&PhysicsManager::Step, this));
+            return;
+        }
+
         // Launch the physics thread (continuously sending the position to the server)
         thread_physics = std::thread(&PhysicsManager::Physics, this);
     }
@@ -69,6 +80,11 @@ namespace Botcraft
         {
             thread_physics.join();
         }
+        if (tick_scheduler)
+        {
+            tick_scheduler->Unregister(tick_scheduler_id);
+            tick_scheduler.reset();
+        }
     }
 
     void PhysicsManager::Handle(ProtocolCraft::Message& msg)
@@ -92,27 +108,35 @@ namespace Botcraft
             // End of the current tick
             auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
 
-            if (network_manager->GetConnectionState() == ConnectionState::Play)
-            {
-                if (player == nullptr)
-                {
-                    player = entity_manager->GetLocalPlayer();
-                }
+            Step();
 
-                if (player != nullptr && !std::isnan(player->GetY()))
-                {
-                    // As PhysicsManager is a friend of LocalPlayer, we can lock the whole entity
-                    // while physics is processed. This also means we can't use public interface
-                    // as it's thread-safe by design and would deadlock because of this global lock
-                    std::scoped_lock<std::shared_mutex> lock(player->entity_mutex);
-                    PhysicsTick();
-                }
-            }
             // Wait for end of tick
             Utilities::SleepUntil(end);
         }
     }
 
+    void PhysicsManager::Step()
+    {
+        if (network_manager->GetConnectionState() != ConnectionState::Play)
+        {
+            return;
+        }
+
+        if (player == nullptr)
+        {
+            player = entity_manager->GetLocalPlayer();
+        }
+
+        if (player != nullptr && !std::isnan(player->GetY()))
+        {
+            // As PhysicsManager is a friend of LocalPlayer, we can lock the whole entity
+            // while physics is processed. This also means we can't use public interface
+            // as it's thread-safe by design and would deadlock because of this global lock
+            std::scoped_lock<std::shared_mutex> lock(player->entity_mutex);
+            PhysicsTick();
+        }
+    }
+
     void PhysicsManager::PhysicsTick()
     {
         // Check for rocket boosting if currently in elytra flying mode
@@ -365,6 +389,8 @@ namespace Botcraft
         double fluid_relative_height = 0.0;
         int num_push = 0;
 
+        WorldView world_view(*world);
+
         for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
         {
             block_pos.x = x;
@@ -374,7 +400,7 @@ namespace Botcraft
                 for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
                 {
                     block_pos.z = z;
-                    const Blockstate* block = world->GetBlock(block_pos);
+                    const Blockstate* block = world_view.GetBlock(block_pos);
                     if (block == nullptr || !block->IsFluid() ||
                         (block->IsLava() && water) || (block->IsWater() && !water))
                     {
@@ -382,7 +408,7 @@ namespace Botcraft
                     }
 
                     double fluid_height = 0.0;
-                    if (const Blockstate* block_above = world->GetBlock(block_pos + Position(0, 1, 0)); block_above != nullptr &&
+                    if (const Blockstate* block_above = world_view.GetBlock(block_pos + Position(0, 1, 0)); block_above != nullptr &&
                         ((block_above->IsLava() && block->IsLava()) || (block_above->IsWater() && block->IsWater())))
                     {
                         fluid_height = 1.0;
@@ -417,7 +443,7 @@ namespace Botcraft
                         continue;
                     }
 
-                    Vector3<double> current_push = world->GetFlow(block_pos);
+                    Vector3<double> current_push = world_view.GetFlow(block_pos);
                     if (fluid_relative_height < 0.4)
                     {
                         current_push *= fluid_relative_height;
@@ -798,7 +824,8 @@ namespace Botcraft
 
     Vector3<double> PhysicsManager::CollideBoundingBox(const AABB& aabb, const Vector3<double>& movement) const
     {
-        const std::vector<AABB> colliders = world->GetColliders(aabb, movement);
+        world->GetColliders(aabb, movement, colliders_buffer);
+        const std::vector<AABB>& colliders = colliders_buffer;
         // TODO: add world borders to colliders?
         if (colliders.size() == 0)
         {
@@ -1113,18 +1140,19 @@ namespace Botcraft
         )
         { // Player::maybeBackOffFromEdge
             const double step = 0.05;
+            WorldView world_view(*world);
 
-            while (movement.x != 0.0 && world->IsFree((player_aabb + Vector3<double>(movement.x, -max_up_step, 0.0)).Inflate(-1e-7), false))
+            while (movement.x != 0.0 && world_view.IsFree((player_aabb + Vector3<double>(movement.x, -max_up_step, 0.0)).Inflate(-1e-7), false))
             {
                 movement.x = (movement.x < step && movement.x >= -step) ? 0.0 : (movement.x > 0.0 ? (movement.x - step) : (movement.x + step));
             }
 
-            while (movement.z != 0.0 && world->IsFree((player_aabb + Vector3<double>(0.0, -max_up_step, movement.z)).Inflate(-1e-7), false))
+            while (movement.z != 0.0 && world_view.IsFree((player_aabb + Vector3<double>(0.0, -max_up_step, movement.z)).Inflate(-1e-7), false))
             {
                 movement.z = (movement.z < step && movement.z >= -step) ? 0.0 : (movement.z > 0.0 ? (movement.z - step) : (movement.z + step));
             }
 
-            while (movement.x != 0.0 && movement.z != 0.0 && world->IsFree((player_aabb + Vector3<double>(movement.x, -max_up_step, movement.z)).Inflate(-1e-7), false))
+            while (movement.x != 0.0 && movement.z != 0.0 && world_view.IsFree((player_aabb + Vector3<double>(movement.x, -max_up_step, movement.z)).Inflate(-1e-7), false))
             {
                 movement.x = (movement.x < step && movement.x >= -step) ? 0.0 : (movement.x > 0.0 ? (movement.x - step) : (movement.x + step));
                 movement.z = (movement.z < step && movement.z >= -step) ? 0.0 : (movement.z > 0.0 ? (movement.z - step) : (movement.z + step));
@@ -1290,6 +1318,7 @@ namespace Botcraft
         const Vector3<double> min_aabb = aabb.GetMin();
         const Vector3<double> max_aabb = aabb.GetMax();
         Position block_pos;
+        WorldView world_view(*world);
         for (int y = static_cast<int>(std::floor(min_aabb.y)); y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
         {
             block_pos.y = y;
@@ -1299,7 +1328,7 @@ namespace Botcraft
                 for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
                 {
                     block_pos.x = x;
-                    const Blockstate* block = world->GetBlock(block_pos);
+                    const Blockstate* block = world_view.GetBlock(block_pos);
                     if (block == nullptr)
                     {
                         continue;
@@ -1310,7 +1339,7 @@ namespace Botcraft
                     }
                     else if (block->IsBubbleColumn())
                     {
-                        const Blockstate* above_block = world->GetBlock(block_pos + Position(0, 1, 0));
+                        const Blockstate* above_block = world_view.GetBlock(block_pos + Position(0, 1, 0));
                         if (above_block == nullptr || above_block->IsAir())
                         { // Entity::onAboveBubbleCol
                             player->speed.y = block->IsDownBubbleColumn() ? std::max(-0.9, player->speed.y - 0.03) : std::min(1.8, player->speed.y + 0.1);
@@ -1349,7 +1378,7 @@ namespace Botcraft
                     }
                     else if (block->IsPowderSnow())
                     { // PowderSnowBlock::entityInside
-                        const Blockstate* feet_block = world->GetBlock(Position(
+                        const Blockstate* feet_block = world_view.GetBlock(Position(
                             static_cast<int>(std::floor(player->position.x)),
                             static_cast<int>(std::floor(player->position.y)),
                             static_cast<int>(std::floor(player->position.z))
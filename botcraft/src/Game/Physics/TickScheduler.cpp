@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <string>
+
+#include "botcraft/Game/Physics/TickScheduler.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+#if _WIN32 && BETTER_SLEEP
+#include <Windows.h>
+#undef Yield // Because there is a Yield macro in Windows API somewhere :]
+#include <timeapi.h>
+#endif
+
+namespace Botcraft
+{
+    namespace
+    {
+        /// @brief Id of the task currently run by this thread, 0 if none
+        thread_local size_t current_task = 0;
+    }
+
+    TickScheduler::TickScheduler(const size_t num_threads, const std::chrono::steady_clock::duration tick_period_) : tick_period(tick_period_)
+    {
+        next_id = 1;
+        running = true;
+
+        const size_t num_workers = num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : num_threads;
+        threads.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            threads.emplace_back(&TickScheduler::Run, this, i);
+        }
+    }
+
+    TickScheduler::~TickScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            running = false;
+        }
+        tasks_condition.notify_all();
+
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    size_t TickScheduler::Register(std::function<void()>&& tick)
+    {
+        size_t id;
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            id = next_id++;
+            tasks[id].tick = std::move(tick);
+            schedule.push(ScheduledTick{ std::chrono::steady_clock::now(), id });
+        }
+        tasks_condition.notify_one();
+        return id;
+    }
+
+    void TickScheduler::Unregister(const size_t id)
+    {
+        std::unique_lock<std::mutex> lock(tasks_mutex);
+        auto it = tasks.find(id);
+        if (it == tasks.end())
+        {
+            return;
+        }
+
+        if (!it->second.running)
+        {
+            // Its scheduled tick will be skipped when popped
+            tasks.erase(it);
+            return;
+        }
+
+        // The worker running it will erase it at the end of the tick
+        it->second.removed = true;
+        if (current_task != id)
+        {
+            removed_condition.wait(lock, [this, id]() { return tasks.count(id) == 0; });
+        }
+    }
+
+    size_t TickScheduler::GetNumThreads() const
+    {
+        return threads.size();
+    }
+
+    std::chrono::steady_clock::duration TickScheduler::GetTickPeriod() const
+    {
+        return tick_period;
+    }
+
+    TickStats TickScheduler::GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        return stats;
+    }
+
+    void TickScheduler::ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        stats = TickStats();
+    }
+
+    void TickScheduler::Run(const size_t index)
+    {
+        Logger::GetInstance().RegisterThread("TickScheduler - " + std::to_string(index));
+#if _WIN32 && BETTER_SLEEP
+        timeBeginPeriod(1);
+#endif
+
+        std::unique_lock<std::mutex> lock(tasks_mutex);
+        while (true)
+        {
+            tasks_condition.wait(lock, [this]() { return !running || !schedule.empty(); });
+            if (!running)
+            {
+                break;
+            }
+
+            const ScheduledTick scheduled = schedule.top();
+            auto it = tasks.find(scheduled.id);
+            if (it == tasks.end())
+            {
+                // Unregistered task
+                schedule.pop();
+                continue;
+            }
+
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            if (scheduled.deadline > start)
+            {
+                // Go back to the top of the loop after waiting, as an earlier tick may have been scheduled meanwhile
+                tasks_condition.wait_until(lock, scheduled.deadline);
+                continue;
+            }
+            schedule.pop();
+
+            Task& task = it->second;
+            task.running = true;
+            lock.unlock();
+
+            current_task = scheduled.id;
+            try
+            {
+                task.tick();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception in scheduled tick: " << e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR("Unknown exception in scheduled tick");
+            }
+            current_task = 0;
+            const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            lock.lock();
+            // task is still valid as a running task is never erased by Unregister
+            task.running = false;
+
+            const std::chrono::microseconds jitter = std::chrono::duration_cast<std::chrono::microseconds>(start - scheduled.deadline);
+            const std::chrono::microseconds duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            stats.ticks += 1;
+            stats.total_jitter += jitter;
+            stats.max_jitter = std::max(stats.max_jitter, jitter);
+            stats.max_duration = std::max(stats.max_duration, duration);
+            if (end - start > tick_period)
+            {
+                stats.overruns += 1;
+            }
+
+            if (task.removed)
+            {
+                tasks.erase(scheduled.id);
+                removed_condition.notify_all();
+                continue;
+            }
+
+            // Keep the task on its own deadlines, skipping the ticks that are already more than one period late
+            std::chrono::steady_clock::time_point next_deadline = scheduled.deadline + tick_period;
+            if (end > next_deadline + tick_period)
+            {
+                const auto missed = (end - next_deadline) / tick_period;
+                stats.missed_ticks += missed;
+                next_deadline += missed * tick_period;
+            }
+            schedule.push(ScheduledTick{ next_deadline, scheduled.id });
+        }
+        lock.unlock();
+
+#if _WIN32 && BETTER_SLEEP
+        timeEndPeriod(1);
+#endif
+    }
+} // Botcraft
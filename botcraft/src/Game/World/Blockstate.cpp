@@ -1,5 +1,6 @@
 #include <deque>
 #include <fstream>
+#include <iterator>
 #include <set>
 
 #include "botcraft/Game/World/Blockstate.hpp"
@@ -574,6 +575,54 @@ namespace Botcraft
         LoadWeightedModels({ {model_, 1} });
     }
 
+#if !USE_GUI
+    Blockstate::Blockstate(ReadIterator& iter, size_t& length, const std::vector<size_t>& models_mapping)
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        blockstate_id.first = ReadData<VarInt>(iter, length);
+        blockstate_id.second = ReadData<unsigned char>(iter, length);
+#else
+        blockstate_id = ReadData<VarInt>(iter, length);
+#endif
+        flags = decltype(flags)(ReadData<unsigned long long int>(iter, length));
+        hardness = ReadData<float>(iter, length);
+        friction = ReadData<float>(iter, length);
+        tint_type = static_cast<TintType>(ReadData<VarInt>(iter, length));
+        m_name = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+
+        const int num_models = ReadData<VarInt>(iter, length);
+        models_indices.reserve(num_models);
+        models_weights.reserve(num_models);
+        weights_sum = 0;
+        for (int i = 0; i < num_models; ++i)
+        {
+            models_indices.push_back(models_mapping.at(ReadData<VarInt>(iter, length)));
+            models_weights.push_back(ReadData<VarInt>(iter, length));
+            weights_sum += models_weights.back();
+        }
+
+        const int num_tools = ReadData<VarInt>(iter, length);
+        best_tools.reserve(num_tools);
+        for (int i = 0; i < num_tools; ++i)
+        {
+            BestTool tool;
+            tool.tool_type = static_cast<ToolType>(ReadData<VarInt>(iter, length));
+            tool.min_material = static_cast<ToolMaterial>(ReadData<VarInt>(iter, length));
+            tool.multiplier = ReadData<float>(iter, length);
+            best_tools.push_back(tool);
+        }
+
+        const int num_variables = ReadData<VarInt>(iter, length);
+        for (int i = 0; i < num_variables; ++i)
+        {
+            const std::string* variable = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+            variables[variable] = GetUniqueStringPtr(ReadData<std::string>(iter, length));
+        }
+
+        FlattenModels();
+    }
+#endif
+
     BlockstateId Blockstate::GetId() const
     {
         return blockstate_id;
@@ -641,15 +690,7 @@ namespace Botcraft
     std::set<AABB> Blockstate::GetCollidersAtPos(const Position& pos) const
     {
         std::set<AABB> output;
-
-        const Model& model = GetModel(GetModelId(pos));
-
-        const std::set<AABB>& colliders = model.GetColliders();
-        const Vector3<double> offset = GetHorizontalOffsetAtPos(pos);
-        for (const auto& c : colliders)
-        {
-            output.insert(c + offset);
-        }
+        CopyCollidersAtPos(pos, std::inserter(output, output.end()));
         return output;
     }
 
@@ -837,6 +878,11 @@ namespace Botcraft
         return 1.0f - static_cast<float>(level + 1) / 9.0f;
     }
 
+    Walkability Blockstate::GetWalkability() const
+    {
+        return walkability;
+    }
+
     float Blockstate::GetMiningTimeSeconds(const ToolType tool_type, const ToolMaterial tool_material,
         const unsigned char tool_efficiency, const unsigned char haste, const unsigned char fatigue,
         const bool on_ground, const bool head_in_fluid_wo_aqua_affinity, const float speed_factor) const
@@ -927,6 +973,94 @@ namespace Botcraft
         unique_models.shrink_to_fit();
     }
 
+#if !USE_GUI
+    void Blockstate::WriteBinary(WriteContainer& container) const
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        WriteData<VarInt>(blockstate_id.first, container);
+        WriteData<unsigned char>(blockstate_id.second, container);
+#else
+        WriteData<VarInt>(blockstate_id, container);
+#endif
+        WriteData<unsigned long long int>(flags.to_ullong(), container);
+        WriteData<float>(hardness, container);
+        WriteData<float>(friction, container);
+        WriteData<VarInt>(static_cast<int>(tint_type), container);
+        WriteData<std::string>(*m_name, container);
+
+        WriteData<VarInt>(static_cast<int>(models_indices.size()), container);
+        for (size_t i = 0; i < models_indices.size(); ++i)
+        {
+            WriteData<VarInt>(static_cast<int>(models_indices[i]), container);
+            WriteData<VarInt>(models_weights[i], container);
+        }
+
+        WriteData<VarInt>(static_cast<int>(best_tools.size()), container);
+        for (const BestTool& tool : best_tools)
+        {
+            WriteData<VarInt>(static_cast<int>(tool.tool_type), container);
+            WriteData<VarInt>(static_cast<int>(tool.min_material), container);
+            WriteData<float>(tool.multiplier, container);
+        }
+
+        WriteData<VarInt>(static_cast<int>(variables.size()), container);
+        for (const auto& [variable, value] : variables)
+        {
+            WriteData<std::string>(*variable, container);
+            WriteData<std::string>(*value, container);
+        }
+    }
+
+    void Blockstate::WriteModelsBinary(WriteContainer& container)
+    {
+        WriteData<VarInt>(static_cast<int>(unique_models.size()), container);
+        for (const Model& model : unique_models)
+        {
+            const std::set<AABB>& model_colliders = model.GetColliders();
+            WriteData<VarInt>(static_cast<int>(model_colliders.size()), container);
+            for (const AABB& collider : model_colliders)
+            {
+                const Vector3<double>& center = collider.GetCenter();
+                const Vector3<double>& half_size = collider.GetHalfSize();
+                WriteData<double>(center.x, container);
+                WriteData<double>(center.y, container);
+                WriteData<double>(center.z, container);
+                WriteData<double>(half_size.x, container);
+                WriteData<double>(half_size.y, container);
+                WriteData<double>(half_size.z, container);
+            }
+        }
+    }
+
+    std::vector<size_t> Blockstate::ReadModelsBinary(ReadIterator& iter, size_t& length)
+    {
+        const int num_models = ReadData<VarInt>(iter, length);
+        std::vector<size_t> models_mapping;
+        models_mapping.reserve(num_models);
+        for (int i = 0; i < num_models; ++i)
+        {
+            std::set<AABB> model_colliders;
+            const int num_colliders = ReadData<VarInt>(iter, length);
+            for (int j = 0; j < num_colliders; ++j)
+            {
+                Vector3<double> center;
+                center.x = ReadData<double>(iter, length);
+                center.y = ReadData<double>(iter, length);
+                center.z = ReadData<double>(iter, length);
+                Vector3<double> half_size;
+                half_size.x = ReadData<double>(iter, length);
+                half_size.y = ReadData<double>(iter, length);
+                half_size.z = ReadData<double>(iter, length);
+                model_colliders.insert(AABB(center, half_size));
+            }
+            Model model;
+            model.SetColliders(model_colliders);
+            models_mapping.push_back(GetUniqueModelIndex(model));
+        }
+        return models_mapping;
+    }
+#endif
+
 #if USE_GUI
     void Blockstate::UpdateModelsWithAtlasData(const Renderer::Atlas* atlas)
     {
@@ -1067,6 +1201,52 @@ namespace Botcraft
 
         models_indices.shrink_to_fit();
         models_weights.shrink_to_fit();
+
+        FlattenModels();
+    }
+
+    void Blockstate::FlattenModels()
+    {
+        // Flatten all models colliders so they can be read without going through std::set nodes
+        colliders.clear();
+        colliders_offsets.clear();
+        colliders_offsets.reserve(models_indices.size() + 1);
+        colliders_offsets.push_back(0);
+        for (const size_t index : models_indices)
+        {
+            const std::set<AABB>& model_colliders = unique_models[index].GetColliders();
+            colliders.insert(colliders.end(), model_colliders.begin(), model_colliders.end());
+            colliders_offsets.push_back(static_cast<unsigned short>(colliders.size()));
+        }
+        colliders.shrink_to_fit();
+
+        ComputeWalkability();
+    }
+
+    void Blockstate::ComputeWalkability()
+    {
+        Walkability::Kind kind = Walkability::Kind::Empty;
+        if (IsFluidOrWaterlogged() && !IsSolid())
+        {
+            kind = Walkability::Kind::Fluid;
+        }
+        else if (IsClimbable())
+        {
+            kind = Walkability::Kind::Climbable;
+        }
+        else if (IsSolid())
+        {
+            kind = Walkability::Kind::Solid;
+        }
+
+        // Colliders are relative to the block, and only offset horizontally
+        float top_height = 0.0f;
+        for (const AABB& collider : colliders)
+        {
+            top_height = std::max(top_height, static_cast<float>(collider.GetMax().y));
+        }
+
+        walkability = Walkability(kind, IsHazardous(), top_height);
     }
 
     bool Blockstate::GetBoolFromCondition(const Json::Value& condition) const
@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <array>
+
 #include "botcraft/Game/AssetsManager.hpp"
 #include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/PackedDataUnpacking.hpp"
 #include "botcraft/Game/World/Section.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 
@@ -183,6 +187,17 @@ namespace Botcraft
                 data_array[i] = ReadData<unsigned long long int>(iter, length);
             }
 
+            if (palette_type == Palette::SectionPalette)
+            {
+                // Use the server palette as section storage palette
+                if (!sections[sectionY])
+                {
+                    AddSection(sectionY);
+                }
+                DetachSection(sectionY);
+                sections[sectionY]->data_blocks.Reset(std::vector<unsigned short>(palette.begin(), palette.end()));
+            }
+
             //Blocks data
 #if PROTOCOL_VERSION > 712 /* > 1.15.2 */
             int bit_offset = 0;
@@ -359,9 +374,6 @@ namespace Botcraft
                 break;
             }
 
-            //A mask 0...01..1 with bits_per_block ones
-            unsigned int individual_value_mask = static_cast<unsigned int>((1 << bits_per_block) - 1);
-
             //Data array length
             int data_array_size = ReadData<VarInt>(iter, length);
 
@@ -373,56 +385,61 @@ namespace Botcraft
             }
 
             //Blocks data
-            int bit_offset = 0;
-            Position pos;
-            if (block_count != 0)
+            if (block_count != 0 && palette_type == Palette::SingleValue)
+            {
+                if (!sections[sectionY])
+                {
+                    AddSection(sectionY);
+                }
+                DetachSection(sectionY);
+                sections[sectionY]->data_blocks.Fill(static_cast<unsigned short>(palette_value));
+            }
+            else if (block_count != 0)
             {
+                // Unpack the whole section at once. Section palette indices
+                // are stored as is, with the server palette as storage palette
+                std::array<unsigned short, CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT> raw_ids;
+                if (!UnpackEntries(data_array.data(), data_array.size(), bits_per_block, raw_ids.data(), raw_ids.size()))
+                {
+                    LOG_WARNING("Invalid block data for section " << sectionY << " (" << static_cast<int>(bits_per_block) << " bits per block, " << data_array.size() << " longs)");
+                    sections[sectionY] = nullptr;
+                    LoadSectionBiomeData(sectionY, iter, length);
+                    continue;
+                }
+
+                if (!sections[sectionY])
+                {
+                    AddSection(sectionY);
+                }
+                DetachSection(sectionY);
+                PalettedContainer& blocks = sections[sectionY]->data_blocks;
+                if (palette_type == Palette::SectionPalette)
+                {
+                    if (palette.empty())
+                    {
+                        palette.push_back(0);
+                    }
+                    // Malformed data could point outside of the palette
+                    ClampEntries(raw_ids.data(), raw_ids.size(), static_cast<unsigned short>(palette.size() - 1));
+                    blocks.Reset(std::vector<unsigned short>(palette.begin(), palette.end()));
+                }
+                else
+                {
+                    blocks.ResetDirect();
+                }
+
+#if USE_GUI
+                // Storage has borders for the neighbour blocks, store one row at a time
                 for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
                 {
-                    pos.y = block_y + sectionY * SECTION_HEIGHT + min_y;
                     for (int block_z = 0; block_z < CHUNK_WIDTH; ++block_z)
                     {
-                        pos.z = block_z;
-                        for (int block_x = 0; block_x < CHUNK_WIDTH; ++block_x)
-                        {
-                            pos.x = block_x;
-                            if (palette_type == Palette::SingleValue)
-                            {
-                                SetBlock(pos, palette_value);
-                                continue;
-                            }
-
-                            // Entries don't span across multiple longs
-                            if (64 - (bit_offset % 64) < bits_per_block)
-                            {
-                                bit_offset += 64 - (bit_offset % 64);
-                            }
-                            int start_long_index = bit_offset / 64;
-                            int end_long_index = start_long_index;
-                            int start_offset = bit_offset % 64;
-                            bit_offset += bits_per_block;
-
-                            unsigned int raw_id;
-                            if (start_long_index == end_long_index)
-                            {
-                                raw_id = static_cast<unsigned int>(data_array[start_long_index] >> start_offset);
-                            }
-                            else
-                            {
-                                int end_offset = 64 - start_offset;
-                                raw_id = static_cast<unsigned int>(data_array[start_long_index] >> start_offset | data_array[end_long_index] << end_offset);
-                            }
-                            raw_id &= individual_value_mask;
-
-                            if (palette_type == Palette::SectionPalette)
-                            {
-                                raw_id = palette[raw_id];
-                            }
-
-                            SetBlock(pos, raw_id);
-                        }
+                        blocks.SetRawRange(Section::CoordsToBlockIndex(0, block_y, block_z), raw_ids.data() + (block_y * CHUNK_WIDTH + block_z) * CHUNK_WIDTH, CHUNK_WIDTH);
                     }
                 }
+#else
+                blocks.SetRawRange(0, raw_ids.data(), raw_ids.size());
+#endif
             }
             else
             {
@@ -519,10 +536,10 @@ namespace Botcraft
 
 #if PROTOCOL_VERSION < 347 /* < 1.13 */
         BlockstateId block_id;
-        const unsigned short stored_id = *(sections[section_y]->data_blocks.data() + Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z));
+        const unsigned short stored_id = sections[section_y]->data_blocks.Get(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z));
         Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
 #else
-        const BlockstateId block_id = static_cast<BlockstateId>(*(sections[section_y]->data_blocks.data() + Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
+        const BlockstateId block_id = static_cast<BlockstateId>(sections[section_y]->data_blocks.Get(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
 #endif
         return AssetsManager::getInstance().GetBlockstate(block_id);
     }
@@ -572,7 +589,8 @@ namespace Botcraft
 #else
         const unsigned short block_id = static_cast<unsigned short>(id);
 #endif
-        sections[section_y]->data_blocks[Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] = block_id;
+        DetachSection(section_y);
+        sections[section_y]->data_blocks.Set(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z), block_id);
 
 #if USE_GUI
         modified_since_last_rendered = true;
@@ -592,7 +610,7 @@ namespace Botcraft
             return 0;
         }
 
-        return (sections[section_y]->block_light[Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] >> (4 * (pos.x % 2))) & 0x0F;
+        return static_cast<unsigned char>(sections[section_y]->block_light.Get(Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
     }
 
     void Chunk::SetBlockLight(const Position& pos, const unsigned char v)
@@ -608,17 +626,7 @@ namespace Botcraft
             AddSection(section_y);
         }
 
-        unsigned char* packed_value = sections[section_y]->block_light.data() + Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
-        if (pos.x % 2 == 1)
-        {
-            const unsigned char first_value = *packed_value & 0x0F;
-            *packed_value = first_value | ((v & 0x0F) << 4);
-        }
-        else
-        {
-            const unsigned char second_value = *packed_value & 0xF0;
-            *packed_value = second_value | (v & 0x0F);
-        }
+        sections[section_y]->block_light.Set(Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z), v & 0x0F);
         // Not necessary as we don't render lights
 //#if USE_GUI
 //        modified_since_last_rendered = true;
@@ -638,7 +646,7 @@ namespace Botcraft
             return 0;
         }
 
-        return (sections[section_y]->sky_light[Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)] >> (4 * (pos.x % 2))) & 0x0F;
+        return static_cast<unsigned char>(sections[section_y]->sky_light.Get(Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
     }
 
     void Chunk::SetSkyLight(const Position& pos, const unsigned char v)
@@ -654,17 +662,7 @@ namespace Botcraft
             AddSection(section_y);
         }
 
-        unsigned char* packed_value = sections[section_y]->sky_light.data() + Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z);
-        if (pos.x % 2 == 1)
-        {
-            const unsigned char first_value = *packed_value & 0x0F;
-            *packed_value = first_value | ((v & 0x0F) << 4);
-        }
-        else
-        {
-            const unsigned char second_value = *packed_value & 0xF0;
-            *packed_value = second_value | (v & 0x0F);
-        }
+        sections[section_y]->sky_light.Set(Section::CoordsToLightIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z), v & 0x0F);
 
         // Not necessary as we don't render lights
 //#if USE_GUI
@@ -672,6 +670,41 @@ namespace Botcraft
 //#endif
     }
 
+    void Chunk::LoadSectionLight(const int section_y, const std::vector<char>& data, const bool sky)
+    {
+        if (section_y < 0 || section_y >= sections.size() || (sky && !has_sky_light))
+        {
+            return;
+        }
+
+        constexpr size_t section_light_bytes = CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2;
+        if (!data.empty() && data.size() != section_light_bytes)
+        {
+            LOG_WARNING("Invalid light data size for section " << section_y << " (" << data.size() << " bytes)");
+            return;
+        }
+
+        if (!sections[section_y])
+        {
+            AddSection(section_y);
+        }
+
+        PalettedContainer& light = sky ? sections[section_y]->sky_light : sections[section_y]->block_light;
+
+        // Sections with a uniform light value (very common, full sky light
+        // or no block light) are kept as single value
+        const unsigned char first_byte = data.empty() ? 0 : static_cast<unsigned char>(data[0]);
+        if ((first_byte >> 4) == (first_byte & 0x0F) &&
+            std::all_of(data.begin(), data.end(), [first_byte](const char c) { return static_cast<unsigned char>(c) == first_byte; }))
+        {
+            light.Fill(first_byte & 0x0F);
+            return;
+        }
+
+        // Nibble arrays already have the direct storage layout (x fastest, first entry in the low bits)
+        light.LoadDirectPacked(reinterpret_cast<const unsigned char*>(data.data()), data.size());
+    }
+
     size_t Chunk::GetDimensionIndex() const
     {
         return dimension_index;
@@ -692,6 +725,11 @@ namespace Botcraft
         sections[y] = std::make_unique<Section>(has_sky_light);
     }
 
+    std::vector<std::shared_ptr<const Section> > Chunk::ShareSections() const
+    {
+        return std::vector<std::shared_ptr<const Section> >(sections.begin(), sections.end());
+    }
+
 #if PROTOCOL_VERSION < 552 /* < 1.15 */
     const Biome* Chunk::GetBiome(const int x, const int z) const
     {
@@ -941,17 +979,22 @@ namespace Botcraft
 #endif
     }
 
-    void Chunk::AddLoader(const std::thread::id& thread_id)
+    void Chunk::AddLoader(const LoaderId loader_id)
     {
-        loaded_from.insert(thread_id);
+        loaded_from.insert(loader_id);
     }
 
-    size_t Chunk::RemoveLoader(const std::thread::id& thread_id)
+    size_t Chunk::RemoveLoader(const LoaderId loader_id)
     {
-        loaded_from.erase(thread_id);
+        loaded_from.erase(loader_id);
         return loaded_from.size();
     }
 
+    const std::unordered_set<LoaderId>& Chunk::GetLoaders() const
+    {
+        return loaded_from;
+    }
+
     bool Chunk::IsInsideChunk(const Position& pos, const bool ignore_gui_borders) const
     {
         if (ignore_gui_borders)
@@ -971,6 +1014,16 @@ namespace Botcraft
 #endif
     }
 
+    void Chunk::DetachSection(const int y)
+    {
+        // All owners other than this chunk are read-only views that
+        // may be read without lock, they must never see a modification
+        if (sections[y] != nullptr && sections[y].use_count() > 1)
+        {
+            sections[y] = std::make_shared<Section>(*sections[y]);
+        }
+    }
+
 #if PROTOCOL_VERSION > 756 /* > 1.17.1 */
     void Botcraft::Chunk::LoadSectionBiomeData(const int section_y, ProtocolCraft::ReadIterator& iter, size_t& length)
     {
@@ -1001,9 +1054,6 @@ namespace Botcraft
             break;
         }
 
-        //A mask 0...01..1 with bits_per_biome ones
-        unsigned int individual_value_mask = static_cast<unsigned int>((1 << bits_per_biome) - 1);
-
         //Data array length
         int data_array_size = ReadData<VarInt>(iter, length);
 
@@ -1015,51 +1065,50 @@ namespace Botcraft
         }
 
         //Biomes data
-        int bit_offset = 0;
-        for (int block_y = 0; block_y < SECTION_HEIGHT / 4; ++block_y)
+        constexpr size_t biomes_per_section = (SECTION_HEIGHT / 4) * (CHUNK_WIDTH / 4) * (CHUNK_WIDTH / 4);
+        const size_t first_biome = section_y * biomes_per_section;
+        if (first_biome + biomes_per_section > biomes.size())
         {
-            for (int block_z = 0; block_z < CHUNK_WIDTH / 4; ++block_z)
-            {
-                for (int block_x = 0; block_x < CHUNK_WIDTH / 4; ++block_x)
-                {
-                    const int biome_index = section_y * 64 + block_y * 16 + block_z * 4 + block_x;
-                    if (palette_type == Palette::SingleValue)
-                    {
-                        SetBiome(biome_index, palette_value);
-                        continue;
-                    }
-
-                    // Entries don't span across multiple longs
-                    if (64 - (bit_offset % 64) < bits_per_biome)
-                    {
-                        bit_offset += 64 - (bit_offset % 64);
-                    }
-                    int start_long_index = bit_offset / 64;
-                    int end_long_index = start_long_index;
-                    int start_offset = bit_offset % 64;
-                    bit_offset += bits_per_biome;
-
-                    unsigned int raw_id;
-                    if (start_long_index == end_long_index)
-                    {
-                        raw_id = static_cast<unsigned int>(data_array[start_long_index] >> start_offset);
-                    }
-                    else
-                    {
-                        int end_offset = 64 - start_offset;
-                        raw_id = static_cast<unsigned int>(data_array[start_long_index] >> start_offset | data_array[end_long_index] << end_offset);
-                    }
-                    raw_id &= individual_value_mask;
+            return;
+        }
 
-                    if (palette_type == Palette::SectionPalette)
-                    {
-                        raw_id = palette[raw_id];
-                    }
+        if (palette_type == Palette::SingleValue)
+        {
+            std::fill(biomes.begin() + first_biome, biomes.begin() + first_biome + biomes_per_section, static_cast<unsigned char>(palette_value));
+        }
+        else
+        {
+            std::array<unsigned short, biomes_per_section> raw_ids;
+            if (!UnpackEntries(data_array.data(), data_array.size(), bits_per_biome, raw_ids.data(), raw_ids.size()))
+            {
+                LOG_WARNING("Invalid biome data for section " << section_y << " (" << static_cast<int>(bits_per_biome) << " bits per biome, " << data_array.size() << " longs)");
+                return;
+            }
 
-                    SetBiome(biome_index, raw_id);
+            if (palette_type == Palette::SectionPalette)
+            {
+                if (palette.empty())
+                {
+                    palette.push_back(0);
+                }
+                ClampEntries(raw_ids.data(), raw_ids.size(), static_cast<unsigned short>(palette.size() - 1));
+                for (size_t i = 0; i < biomes_per_section; ++i)
+                {
+                    biomes[first_biome + i] = static_cast<unsigned char>(palette[raw_ids[i]]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < biomes_per_section; ++i)
+                {
+                    biomes[first_biome + i] = static_cast<unsigned char>(raw_ids[i]);
                 }
             }
         }
+
+#if USE_GUI
+        modified_since_last_rendered = true;
+#endif
     }
 #endif
 } //Botcraft
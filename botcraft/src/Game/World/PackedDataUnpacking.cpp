@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "botcraft/Game/World/PackedDataUnpacking.hpp"
+
+namespace Botcraft
+{
+    using UnpackFunction = void(*)(const unsigned long long int*, unsigned short*, const size_t);
+
+    template<unsigned char Bits>
+    void UnpackEntriesImpl(const unsigned long long int* data, unsigned short* out, const size_t count)
+    {
+        constexpr size_t entries_per_long = 64 / Bits;
+        constexpr unsigned long long int mask = (1ULL << Bits) - 1;
+
+        const size_t full_longs = count / entries_per_long;
+        for (size_t i = 0; i < full_longs; ++i)
+        {
+            const unsigned long long int packed = data[i];
+            unsigned short* const dst = out + i * entries_per_long;
+            // Constant trip count, fully unrolled by the compiler
+            for (size_t j = 0; j < entries_per_long; ++j)
+            {
+                dst[j] = static_cast<unsigned short>((packed >> (j * Bits)) & mask);
+            }
+        }
+
+        const size_t remaining = count - full_longs * entries_per_long;
+        if (remaining > 0)
+        {
+            const unsigned long long int packed = data[full_longs];
+            unsigned short* const dst = out + full_longs * entries_per_long;
+            for (size_t j = 0; j < remaining; ++j)
+            {
+                dst[j] = static_cast<unsigned short>((packed >> (j * Bits)) & mask);
+            }
+        }
+    }
+
+    template<size_t... Is>
+    constexpr std::array<UnpackFunction, sizeof...(Is)> MakeUnpackFunctions(std::index_sequence<Is...>)
+    {
+        return { &UnpackEntriesImpl<static_cast<unsigned char>(Is + 1)>... };
+    }
+
+    // unpack_functions[i] unpacks entries of i + 1 bits
+    static constexpr std::array<UnpackFunction, 16> unpack_functions = MakeUnpackFunctions(std::make_index_sequence<16>());
+
+    bool UnpackEntries(const unsigned long long int* data, const size_t num_longs, const unsigned char bits_per_entry, unsigned short* out, const size_t count)
+    {
+        if (bits_per_entry == 0 || bits_per_entry > unpack_functions.size())
+        {
+            return false;
+        }
+
+        const size_t entries_per_long = 64 / bits_per_entry;
+        if (num_longs < (count + entries_per_long - 1) / entries_per_long)
+        {
+            return false;
+        }
+
+        unpack_functions[bits_per_entry - 1](data, out, count);
+        return true;
+    }
+
+    void ClampEntries(unsigned short* values, const size_t count, const unsigned short max_value)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = std::min(values[i], max_value);
+        }
+    }
+} // Botcraft
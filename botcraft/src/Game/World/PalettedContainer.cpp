@@ -0,0 +1,302 @@
+#include <algorithm>
+
+#include "botcraft/Game/World/PalettedContainer.hpp"
+
+namespace Botcraft
+{
+    PalettedContainer::PalettedContainer(const size_t size_, const unsigned char max_palette_bits_, const unsigned char direct_bits_, const unsigned short default_value)
+    {
+        size = size_;
+        max_palette_bits = max_palette_bits_;
+        direct_bits = direct_bits_;
+        Fill(default_value);
+    }
+
+    unsigned short PalettedContainer::Get(const size_t index) const
+    {
+        if (bits_per_entry == 0)
+        {
+            return palette[0];
+        }
+
+        const unsigned short raw = GetRaw(index);
+        return IsDirect() ? raw : palette[raw];
+    }
+
+    void PalettedContainer::Set(const size_t index, const unsigned short value)
+    {
+        if (IsDirect())
+        {
+            SetRaw(index, value);
+            return;
+        }
+
+        size_t palette_index = std::find(palette.begin(), palette.end(), value) - palette.begin();
+        if (palette_index == palette.size())
+        {
+            // Current palette is full, we need more bits
+            if (palette.size() == (1ULL << bits_per_entry))
+            {
+                Resize(bits_per_entry == 0 ? 1 : 2 * bits_per_entry);
+                if (IsDirect())
+                {
+                    SetRaw(index, value);
+                    return;
+                }
+            }
+            palette.push_back(value);
+        }
+
+        if (bits_per_entry != 0)
+        {
+            SetRaw(index, static_cast<unsigned short>(palette_index));
+        }
+    }
+
+    void PalettedContainer::Fill(const unsigned short value)
+    {
+        bits_per_entry = 0;
+        value_mask = 0;
+        palette = { value };
+        data = std::vector<unsigned long long int>();
+    }
+
+    void PalettedContainer::Reset(const std::vector<unsigned short>& values)
+    {
+        if (values.size() < 2)
+        {
+            Fill(values.empty() ? 0 : values[0]);
+            return;
+        }
+
+        unsigned char new_bits = 1;
+        while ((1ULL << new_bits) < values.size())
+        {
+            new_bits *= 2;
+        }
+
+        if (new_bits > max_palette_bits)
+        {
+            // Fill with values[0] and let Resize switch to direct storage
+            Fill(values[0]);
+            Resize(direct_bits);
+            return;
+        }
+
+        bits_per_entry = new_bits;
+        value_mask = static_cast<unsigned short>((1ULL << bits_per_entry) - 1);
+        palette = values;
+        // All raw indices are 0, which is values[0]
+        data = std::vector<unsigned long long int>((size * bits_per_entry + 63) / 64, 0);
+    }
+
+    void PalettedContainer::ResetDirect()
+    {
+        bits_per_entry = direct_bits;
+        value_mask = static_cast<unsigned short>((1ULL << bits_per_entry) - 1);
+        palette = std::vector<unsigned short>();
+        data = std::vector<unsigned long long int>((size * bits_per_entry + 63) / 64, 0);
+    }
+
+    void PalettedContainer::SetRawRange(const size_t start, const unsigned short* raw, const size_t count)
+    {
+        if (bits_per_entry == 0)
+        {
+            return;
+        }
+
+        const size_t entries_per_long = 64 / bits_per_entry;
+        size_t i = 0;
+        // Entries before the first long boundary
+        for (; i < count && (start + i) % entries_per_long != 0; ++i)
+        {
+            SetRaw(start + i, raw[i]);
+        }
+        // Whole longs, written without reading them
+        for (; i + entries_per_long <= count; i += entries_per_long)
+        {
+            unsigned long long int packed = 0;
+            for (size_t j = 0; j < entries_per_long; ++j)
+            {
+                packed |= static_cast<unsigned long long int>(raw[i + j] & value_mask) << (j * bits_per_entry);
+            }
+            data[(start + i) / entries_per_long] = packed;
+        }
+        // Remaining entries after the last long boundary
+        for (; i < count; ++i)
+        {
+            SetRaw(start + i, raw[i]);
+        }
+    }
+
+    void PalettedContainer::LoadDirectPacked(const unsigned char* bytes, const size_t num_bytes)
+    {
+        if (bits_per_entry != direct_bits)
+        {
+            ResetDirect();
+        }
+
+        const size_t num_longs = std::min(data.size(), num_bytes / 8);
+        for (size_t i = 0; i < num_longs; ++i)
+        {
+            // Explicit little-endian assembly, compiled to a single load on little-endian targets
+            unsigned long long int packed = 0;
+            for (size_t j = 0; j < 8; ++j)
+            {
+                packed |= static_cast<unsigned long long int>(bytes[8 * i + j]) << (8 * j);
+            }
+            data[i] = packed;
+        }
+    }
+
+    bool PalettedContainer::MayContain(const std::function<bool(const unsigned short)>& predicate) const
+    {
+        if (IsDirect())
+        {
+            return true;
+        }
+        return std::any_of(palette.begin(), palette.end(), predicate);
+    }
+
+    std::vector<size_t> PalettedContainer::FindAll(const std::function<bool(const unsigned short)>& predicate) const
+    {
+        std::vector<size_t> output;
+
+        if (bits_per_entry == 0)
+        {
+            if (predicate(palette[0]))
+            {
+                output.resize(size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    output[i] = i;
+                }
+            }
+            return output;
+        }
+
+        if (IsDirect())
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (predicate(GetRaw(i)))
+                {
+                    output.push_back(i);
+                }
+            }
+            return output;
+        }
+
+        // Evaluate the predicate once per palette index, then only compare raw entries
+        std::vector<unsigned char> raw_matches(palette.size());
+        bool any_match = false;
+        for (size_t i = 0; i < palette.size(); ++i)
+        {
+            raw_matches[i] = predicate(palette[i]);
+            any_match |= raw_matches[i] != 0;
+        }
+        if (!any_match)
+        {
+            return output;
+        }
+
+        const size_t entries_per_long = 64 / bits_per_entry;
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            unsigned long long int packed = data[i];
+            const size_t first = i * entries_per_long;
+            for (size_t j = 0; j < entries_per_long && first + j < size; ++j, packed >>= bits_per_entry)
+            {
+                const unsigned short raw = static_cast<unsigned short>(packed) & value_mask;
+                // Raw indices can be above the palette size when loaded from network data
+                if (raw < raw_matches.size() && raw_matches[raw])
+                {
+                    output.push_back(first + j);
+                }
+            }
+        }
+
+        return output;
+    }
+
+    size_t PalettedContainer::GetSize() const
+    {
+        return size;
+    }
+
+    unsigned char PalettedContainer::GetBitsPerEntry() const
+    {
+        return bits_per_entry;
+    }
+
+    bool PalettedContainer::IsSingleValue() const
+    {
+        return bits_per_entry == 0;
+    }
+
+    size_t PalettedContainer::GetMemoryFootprint() const
+    {
+        return palette.capacity() * sizeof(unsigned short) + data.capacity() * sizeof(unsigned long long int);
+    }
+
+    bool PalettedContainer::IsDirect() const
+    {
+        return bits_per_entry > max_palette_bits;
+    }
+
+    unsigned short PalettedContainer::GetRaw(const size_t index) const
+    {
+        // bits_per_entry is a power of two, so an entry never spans across two longs
+        const size_t bit_index = index * bits_per_entry;
+        return static_cast<unsigned short>(data[bit_index >> 6] >> (bit_index & 63)) & value_mask;
+    }
+
+    void PalettedContainer::SetRaw(const size_t index, const unsigned short raw)
+    {
+        const size_t bit_index = index * bits_per_entry;
+        unsigned long long int& packed = data[bit_index >> 6];
+        const size_t offset = bit_index & 63;
+        packed = (packed & ~(static_cast<unsigned long long int>(value_mask) << offset)) | (static_cast<unsigned long long int>(raw & value_mask) << offset);
+    }
+
+    void PalettedContainer::Resize(unsigned char new_bits)
+    {
+        const bool to_direct = new_bits > max_palette_bits;
+        if (to_direct)
+        {
+            new_bits = direct_bits;
+        }
+
+        // Get what needs to be stored in the new layout: palette
+        // indices are kept as is, except if we switch to direct values
+        std::vector<unsigned short> values(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (bits_per_entry == 0)
+            {
+                values[i] = to_direct ? palette[0] : 0;
+            }
+            else if (IsDirect() || !to_direct)
+            {
+                values[i] = GetRaw(i);
+            }
+            else
+            {
+                values[i] = palette[GetRaw(i)];
+            }
+        }
+
+        bits_per_entry = new_bits;
+        value_mask = static_cast<unsigned short>((1ULL << bits_per_entry) - 1);
+        data = std::vector<unsigned long long int>((size * bits_per_entry + 63) / 64, 0);
+        for (size_t i = 0; i < size; ++i)
+        {
+            SetRaw(i, values[i]);
+        }
+
+        if (to_direct)
+        {
+            palette = std::vector<unsigned short>();
+        }
+    }
+} // Botcraft
@@ -4,20 +4,25 @@
 
 namespace Botcraft
 {
-    Section::Section(const bool has_sky_light)
-    {
+    // Up to 256 different blockstates in the section palette, 16 bits ids otherwise
+    static constexpr unsigned char BLOCKS_MAX_PALETTE_BITS = 8;
+    static constexpr unsigned char BLOCKS_DIRECT_BITS = 16;
+    // Light values are 4 bits
+    static constexpr unsigned char LIGHT_MAX_PALETTE_BITS = 2;
+    static constexpr unsigned char LIGHT_DIRECT_BITS = 4;
+
+    Section::Section(const bool has_sky_light) :
 #if USE_GUI
         // +2 because we also store the neighbour section blocks
-        data_blocks = std::vector<unsigned short>((CHUNK_WIDTH + 2) * (CHUNK_WIDTH + 2) * SECTION_HEIGHT);
+        data_blocks((CHUNK_WIDTH + 2) * (CHUNK_WIDTH + 2) * SECTION_HEIGHT, BLOCKS_MAX_PALETTE_BITS, BLOCKS_DIRECT_BITS),
 #else
-        data_blocks = std::vector<unsigned short>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT);
+        data_blocks(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT, BLOCKS_MAX_PALETTE_BITS, BLOCKS_DIRECT_BITS),
 #endif
+        block_light(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT, LIGHT_MAX_PALETTE_BITS, LIGHT_DIRECT_BITS),
+        // No sky light means 0 everywhere, which costs nothing in a single value container
+        sky_light(has_sky_light ? CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT : 0, LIGHT_MAX_PALETTE_BITS, LIGHT_DIRECT_BITS)
+    {
 
-        block_light = std::vector<unsigned char>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2);
-        if (has_sky_light)
-        {
-            sky_light = std::vector<unsigned char>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2);
-        }
     }
 
     size_t Section::CoordsToBlockIndex(const int x, const int y, const int z)
@@ -29,8 +34,23 @@ namespace Botcraft
 #endif
     }
 
+    bool Section::BlockIndexToCoords(const size_t index, int& x, int& y, int& z)
+    {
+#if USE_GUI
+        x = static_cast<int>(index % (CHUNK_WIDTH + 2)) - 1;
+        z = static_cast<int>((index / (CHUNK_WIDTH + 2)) % (CHUNK_WIDTH + 2)) - 1;
+        y = static_cast<int>(index / ((CHUNK_WIDTH + 2) * (CHUNK_WIDTH + 2)));
+        return x >= 0 && x < CHUNK_WIDTH && z >= 0 && z < CHUNK_WIDTH;
+#else
+        x = static_cast<int>(index % CHUNK_WIDTH);
+        z = static_cast<int>((index / CHUNK_WIDTH) % CHUNK_WIDTH);
+        y = static_cast<int>(index / (CHUNK_WIDTH * CHUNK_WIDTH));
+        return true;
+#endif
+    }
+
     size_t Section::CoordsToLightIndex(const int x, const int y, const int z)
     {
-        return ((y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x) / 2;
+        return (y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x;
     }
 } // Botcraft
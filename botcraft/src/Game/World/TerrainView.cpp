@@ -0,0 +1,57 @@
+#include "botcraft/Game/AssetsManager.hpp"
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/Section.hpp"
+#include "botcraft/Game/World/TerrainView.hpp"
+
+namespace Botcraft
+{
+    const Blockstate* TerrainChunkView::GetBlock(const Position& pos) const
+    {
+        if (pos.y < min_y || pos.y >= min_y + height)
+        {
+            return nullptr;
+        }
+
+        const Section* section = sections[(pos.y - min_y) / SECTION_HEIGHT].get();
+        if (section == nullptr)
+        {
+            return nullptr;
+        }
+
+        return GetBlockstate(section->data_blocks.Get(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z)));
+    }
+
+    Walkability TerrainChunkView::GetWalkability(const Position& pos) const
+    {
+        if (pos.y < min_y || pos.y >= min_y + height)
+        {
+            return Walkability();
+        }
+
+        const Section* section = sections[(pos.y - min_y) / SECTION_HEIGHT].get();
+        if (section == nullptr)
+        {
+            return Walkability();
+        }
+
+        const unsigned short stored_id = section->data_blocks.Get(Section::CoordsToBlockIndex(pos.x, (pos.y - min_y) % SECTION_HEIGHT, pos.z));
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        BlockstateId block_id;
+        Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
+#else
+        const BlockstateId block_id = static_cast<BlockstateId>(stored_id);
+#endif
+        return AssetsManager::getInstance().GetWalkability(block_id);
+    }
+
+    const Blockstate* TerrainChunkView::GetBlockstate(const unsigned short stored_id)
+    {
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+        BlockstateId block_id;
+        Blockstate::IdToIdMetadata(static_cast<unsigned int>(stored_id), block_id.first, block_id.second);
+#else
+        const BlockstateId block_id = static_cast<BlockstateId>(stored_id);
+#endif
+        return AssetsManager::getInstance().GetBlockstate(block_id);
+    }
+} // Botcraft
@@ -1,11 +1,27 @@
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
 #include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/TerrainView.hpp"
 #include "botcraft/Game/World/World.hpp"
+#include "botcraft/Game/World/WorldView.hpp"
 
+#include "botcraft/Utilities/EpochReclamation.hpp"
 #include "botcraft/Utilities/Logger.hpp"
 
 namespace Botcraft
 {
-    World::World(const bool is_shared_) : is_shared(is_shared_)
+    namespace
+    {
+        /// @brief Max number of modified areas kept for GetBlockChanges
+        constexpr size_t max_block_changes = 8192;
+
+        /// @brief Id of the next World created
+        std::atomic<unsigned long long int> next_world_instance_id = 1;
+    }
+
+    World::World(const bool is_shared_) : is_shared(is_shared_), instance_id(next_world_instance_id.fetch_add(1))
     {
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
         current_dimension = Dimension::None;
@@ -16,6 +32,12 @@ namespace Botcraft
 #if PROTOCOL_VERSION > 758 /* > 1.18.2 */
         world_interaction_sequence_id = 0;
 #endif
+
+        published_terrain_view = std::make_unique<TerrainView>();
+        terrain_view = published_terrain_view.get();
+
+        block_changes_start = 0;
+        block_revision = 0;
     }
 
     World::~World()
@@ -25,12 +47,7 @@ namespace Botcraft
 
     bool World::IsLoaded(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-
-        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
-        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
-
-        return terrain.find({ chunk_x, chunk_z }) != terrain.end();
+        return WorldView(*this).IsLoaded(pos);
     }
 
     bool World::IsShared() const
@@ -100,22 +117,24 @@ namespace Botcraft
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-    void World::LoadChunk(const int x, const int z, const Dimension dim, const std::thread::id& loader_id)
+    void World::LoadChunk(const int x, const int z, const Dimension dim, const LoaderId loader_id)
 #else
-    void World::LoadChunk(const int x, const int z, const std::string& dim, const std::thread::id& loader_id)
+    void World::LoadChunk(const int x, const int z, const std::string& dim, const LoaderId loader_id)
 #endif
     {
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
         LoadChunkImpl(x, z, dim, loader_id);
+        PublishTerrainView();
     }
 
-    void World::UnloadChunk(const int x, const int z, const std::thread::id& loader_id)
+    void World::UnloadChunk(const int x, const int z, const LoaderId loader_id)
     {
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
         UnloadChunkImpl(x, z, loader_id);
+        PublishTerrainView();
     }
 
-    void World::UnloadAllChunks(const std::thread::id& loader_id)
+    void World::UnloadAllChunks(const LoaderId loader_id)
     {
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
         for (auto it = terrain.begin(); it != terrain.end();)
@@ -123,6 +142,8 @@ namespace Botcraft
             const int load_count = it->second.RemoveLoader(loader_id);
             if (load_count == 0)
             {
+                MarkChunkModified(it->first.first, it->first.second);
+                RecordChunkChange(it->first.first, it->first.second);
                 terrain.erase(it++);
             }
             else
@@ -130,27 +151,28 @@ namespace Botcraft
                 ++it;
             }
         }
+        PublishTerrainView();
     }
 
     void World::SetBlock(const Position& pos, const BlockstateId id)
     {
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
         SetBlockImpl(pos, id);
+        PublishTerrainView();
     }
 
     const Blockstate* World::GetBlock(const Position& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        return GetBlockImpl(pos);
+        return WorldView(*this).GetBlock(pos);
     }
 
     std::vector<const Blockstate*> World::GetBlocks(const std::vector<Position>& pos) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
+        WorldView view(*this);
         std::vector<const Blockstate*> output(pos.size());
         for (size_t i = 0; i < pos.size(); ++i)
         {
-            output[i] = GetBlockImpl(pos[i]);
+            output[i] = view.GetBlock(pos[i]);
         }
 
         return output;
@@ -158,113 +180,42 @@ namespace Botcraft
 
     std::vector<AABB> World::GetColliders(const AABB& aabb, const Vector3<double>& movement) const
     {
-        const AABB movement_extended_aabb(aabb.GetCenter() + movement * 0.5, aabb.GetHalfSize() + movement.Abs() * 0.5);
-        const Vector3<double> min_aabb = movement_extended_aabb.GetMin();
-        const Vector3<double> max_aabb = movement_extended_aabb.GetMax();
-        std::vector<AABB> output;
-        output.reserve(32);
-        Position current_pos;
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
-        {
-            current_pos.y = y;
-            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
-            {
-                current_pos.z = z;
-                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
-                {
-                    current_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(current_pos);
-                    if (block == nullptr || !block->IsSolid())
-                    {
-                        continue;
-                    }
+        return WorldView(*this).GetColliders(aabb, movement);
+    }
 
-                    const std::set<AABB> colliders = block->GetCollidersAtPos(current_pos);
-                    output.insert(output.end(), colliders.begin(), colliders.end());
-                }
-            }
-        }
-        return output;
+    void World::GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output) const
+    {
+        WorldView(*this).GetColliders(aabb, movement, output);
     }
 
     Vector3<double> World::GetFlow(const Position& pos)
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-        Vector3<double> flow(0.0);
-        std::vector<Position> horizontal_neighbours = {
-            Position(0, 0, -1), Position(1, 0, 0),
-            Position(0, 0, 1), Position(-1, 0, 0)
-        };
-        const Blockstate* block = GetBlockImpl(pos);
-        if (block == nullptr || !block->IsFluidOrWaterlogged())
-        {
-            return flow;
-        }
+        return WorldView(*this).GetFlow(pos);
+    }
 
-        const float current_fluid_height = block->GetFluidHeight();
-        for (const Position& neighbour_pos : horizontal_neighbours)
-        {
-            const Blockstate* neighbour = GetBlockImpl(pos + neighbour_pos);
-            if (neighbour == nullptr || (neighbour->IsFluidOrWaterlogged() && neighbour->IsWaterOrWaterlogged() != block->IsWaterOrWaterlogged()))
-            {
-                continue;
-            }
-            const float neighbour_fluid_height = neighbour->GetFluidHeight();
-            if (neighbour_fluid_height == 0.0f)
-            {
-                if (!neighbour->IsSolid())
-                {
-                    const Blockstate* block_below_neighbour = GetBlockImpl(pos + neighbour_pos + Position(0, -1, 0));
-                    if (block_below_neighbour != nullptr &&
-                        (!block_below_neighbour->IsFluidOrWaterlogged() || block_below_neighbour->IsWaterOrWaterlogged() == block->IsWaterOrWaterlogged()))
-                    {
-                        const float block_below_neighbour_fluid_height = block_below_neighbour->GetFluidHeight();
-                        if (block_below_neighbour_fluid_height > 0.0f)
-                        {
-                            flow.x += (current_fluid_height - block_below_neighbour_fluid_height + 0.8888889f) * neighbour_pos.x;
-                            flow.z += (current_fluid_height - block_below_neighbour_fluid_height + 0.8888889f) * neighbour_pos.z;
-                        }
-                    }
-                }
-            }
-            else
-            {
-                flow.x += (current_fluid_height - neighbour_fluid_height) * neighbour_pos.x;
-                flow.z += (current_fluid_height - neighbour_fluid_height) * neighbour_pos.z;
-            }
-        }
+    std::vector<Position> World::FindBlocks(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius, const size_t max_count) const
+    {
+        return WorldView(*this).FindBlocks(predicate, center, radius, max_count);
+    }
 
-        if (block->IsFluidFalling())
-        {
-            for (const Position& neighbour_pos : horizontal_neighbours)
-            {
-                const Blockstate* neighbour = GetBlockImpl(pos + neighbour_pos);
-                if (neighbour == nullptr)
-                {
-                    continue;
-                }
-                const Blockstate* above_neighbour = GetBlockImpl(pos + neighbour_pos + Position(0, 1, 0));
-                if (above_neighbour == nullptr)
-                {
-                    continue;
-                }
-                if (neighbour->IsSolid() && above_neighbour->IsSolid())
-                {
-                    flow.Normalize();
-                    flow.y -= 6.0;
-                    break;
-                }
-            }
-        }
+    std::vector<Position> World::FindBlocks(const std::unordered_set<std::string>& names, const Position& center, const int radius, const size_t max_count) const
+    {
+        return WorldView(*this).FindBlocks(names, center, radius, max_count);
+    }
 
-        flow.Normalize();
-        return flow;
+    std::optional<Position> World::FindNearest(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius) const
+    {
+        return WorldView(*this).FindNearest(predicate, center, radius);
     }
 
-    Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock> World::GetChunks() const
+    std::optional<Position> World::FindNearest(const std::unordered_set<std::string>& names, const Position& center, const int radius) const
     {
-        return Utilities::ScopeLockedWrapper<const std::unordered_map<std::pair<int, int>, Chunk>, std::shared_mutex, std::shared_lock>(terrain, world_mutex);
+        return WorldView(*this).FindNearest(names, center, radius);
+    }
+
+    Utilities::ScopeLockedWrapper<const ChunkIndex<Chunk>, std::shared_mutex, std::shared_lock> World::GetChunks() const
+    {
+        return Utilities::ScopeLockedWrapper<const ChunkIndex<Chunk>, std::shared_mutex, std::shared_lock>(terrain, world_mutex);
     }
 
 #if PROTOCOL_VERSION < 358 /* < 1.13 */
@@ -550,12 +501,15 @@ namespace Botcraft
 
             if (block != nullptr && !block->IsAir())
             {
-                for (const auto& collider : block->GetCollidersAtPos(out_pos))
-                {
-                    if (collider.Intersect(origin, direction))
+                bool hit = false;
+                block->ForEachColliderAtPos(out_pos, [&](const AABB& collider)
                     {
-                        return block;
-                    }
+                        hit = collider.Intersect(origin, direction);
+                        return !hit;
+                    });
+                if (hit)
+                {
+                    return block;
                 }
             }
 
@@ -611,97 +565,73 @@ namespace Botcraft
 
     bool World::IsFree(const AABB& aabb, const bool fluid_collide) const
     {
-        std::shared_lock<std::shared_mutex> lock(world_mutex);
-
-        const Vector3<double> min_aabb = aabb.GetMin();
-        const Vector3<double> max_aabb = aabb.GetMax();
+        return WorldView(*this).IsFree(aabb, fluid_collide);
+    }
 
-        Position cube_pos;
-        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
-        {
-            cube_pos.y = y;
-            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
-            {
-                cube_pos.z = z;
-                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
-                {
-                    cube_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(cube_pos);
+    std::optional<Position> World::GetSupportingBlockPos(const AABB& aabb) const
+    {
+        return WorldView(*this).GetSupportingBlockPos(aabb);
+    }
 
-                    if (block == nullptr)
-                    {
-                        continue;
-                    }
+    ChunkLoadStats World::GetChunkLoadStats() const
+    {
+        std::scoped_lock<std::mutex> lock(chunk_load_stats_mutex);
+        return chunk_load_stats;
+    }
 
-                    if (block->IsFluid())
-                    {
-                        if (!fluid_collide)
-                        {
-                            continue;
-                        }
-                    }
-                    else if (!block->IsSolid())
-                    {
-                        continue;
-                    }
+    void World::ResetChunkLoadStats()
+    {
+        std::scoped_lock<std::mutex> lock(chunk_load_stats_mutex);
+        chunk_load_stats = ChunkLoadStats();
+    }
 
-                    for (const auto& collider : block->GetCollidersAtPos(cube_pos))
-                    {
-                        if (aabb.Collide(collider))
-                        {
-                            return false;
-                        }
-                    }
-                }
-            }
-        }
+    unsigned long long int World::GetInstanceId() const
+    {
+        return instance_id;
+    }
 
-        return true;
+    unsigned long long int World::GetBlockRevision() const
+    {
+        return block_revision.load(std::memory_order_acquire);
     }
 
-    std::optional<Position> World::GetSupportingBlockPos(const AABB& aabb) const
+    bool World::GetBlockChanges(const unsigned long long int revision, std::vector<std::pair<Position, Position> >& output) const
     {
+        output.clear();
         std::shared_lock<std::shared_mutex> lock(world_mutex);
+        // Too old, or a revision from something else
+        if (revision < block_changes_start || revision > block_changes_start + block_changes.size())
+        {
+            return false;
+        }
+        output.insert(output.end(), block_changes.begin() + (revision - block_changes_start), block_changes.end());
+        return true;
+    }
 
-        const Vector3<double> min_aabb = aabb.GetMin();
-        const Vector3<double> max_aabb = aabb.GetMax();
-
-        Position cube_pos;
-        std::optional<Position> output = std::optional<Position>();
-        double min_distance = std::numeric_limits<double>::max();
-        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
+    void World::Prepare(ProtocolCraft::Message& msg, const PreparedPacketId id)
+    {
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        const ProtocolCraft::ClientboundLevelChunkWithLightPacket* chunk_msg = dynamic_cast<const ProtocolCraft::ClientboundLevelChunkWithLightPacket*>(&msg);
+        if (chunk_msg == nullptr)
         {
-            cube_pos.y = y;
-            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
-            {
-                cube_pos.z = z;
-                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
-                {
-                    cube_pos.x = x;
-                    const Blockstate* block = GetBlockImpl(cube_pos);
+            return;
+        }
 
-                    if (block == nullptr || !block->IsSolid())
-                    {
-                        continue;
-                    }
+        const std::chrono::steady_clock::time_point decode_start = std::chrono::steady_clock::now();
+        Chunk chunk = DecodeChunk(*chunk_msg);
+        const long long int decode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decode_start).count();
 
-                    for (const auto& collider : block->GetCollidersAtPos(cube_pos))
-                    {
-                        if (aabb.Collide(collider))
-                        {
-                            const double distance = aabb.GetCenter().SqrDist(collider.GetCenter());
-                            if (distance < min_distance)
-                            {
-                                min_distance = distance;
-                                output = cube_pos;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        std::scoped_lock<std::mutex> lock(prepared_chunks_mutex);
+        prepared_chunks.insert_or_assign(id, PreparedChunk{ std::move(chunk), decode_ns });
+#endif
+    }
 
-        return output;
+    void World::DiscardPrepared(const PreparedPacketId id)
+    {
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        std::scoped_lock<std::mutex> lock(prepared_chunks_mutex);
+        prepared_chunks.erase(id);
+#endif
     }
 
     void World::Handle(ProtocolCraft::ClientboundLoginPacket& msg)
@@ -736,7 +666,7 @@ namespace Botcraft
 
     void World::Handle(ProtocolCraft::ClientboundRespawnPacket& msg)
     {
-        UnloadAllChunks(std::this_thread::get_id());
+        UnloadAllChunks(GetCurrentLoaderId());
 
         std::scoped_lock<std::shared_mutex> lock(world_mutex);
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -767,6 +697,7 @@ namespace Botcraft
 #else
         SetBlockImpl(msg.GetPos(), msg.GetBlockstate());
 #endif
+        PublishTerrainView();
     }
 
     void World::Handle(ProtocolCraft::ClientboundSectionBlocksUpdatePacket& msg)
@@ -811,14 +742,15 @@ namespace Botcraft
 #endif
             }
         }
+        PublishTerrainView();
     }
 
     void World::Handle(ProtocolCraft::ClientboundForgetLevelChunkPacket& msg)
     {
 #if PROTOCOL_VERSION < 764 /* < 1.20.2 */
-        UnloadChunk(msg.GetX(), msg.GetZ(), std::this_thread::get_id());
+        UnloadChunk(msg.GetX(), msg.GetZ(), GetCurrentLoaderId());
 #else
-        UnloadChunk(msg.GetPos().GetX(), msg.GetPos().GetZ(), std::this_thread::get_id());
+        UnloadChunk(msg.GetPos().GetX(), msg.GetPos().GetZ(), GetCurrentLoaderId());
 #endif
     }
 
@@ -830,13 +762,17 @@ namespace Botcraft
         if (msg.GetFullChunk())
         {
 #endif
-            LoadChunk(msg.GetX(), msg.GetZ(), current_dimension, std::this_thread::get_id());
+            LoadChunk(msg.GetX(), msg.GetZ(), current_dimension, GetCurrentLoaderId());
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
         }
 #endif
 
+        const std::chrono::steady_clock::time_point lock_requested = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point lock_acquired;
+        std::chrono::steady_clock::time_point lock_released;
         { // lock scope
             std::scoped_lock<std::shared_mutex> lock(world_mutex);
+            lock_acquired = std::chrono::steady_clock::now();
 #if PROTOCOL_VERSION > 404 /* > 1.13.2 */
             if (auto it = delayed_light_updates.find({ msg.GetX(), msg.GetZ() }); it != delayed_light_updates.end())
             {
@@ -861,19 +797,61 @@ namespace Botcraft
 #endif
 #endif
             LoadBlockEntityDataInChunk(msg.GetX(), msg.GetZ(), msg.GetBlockEntitiesTags());
+            PublishTerrainView();
+            lock_released = std::chrono::steady_clock::now();
         }
+
+        // Data are decoded while holding the lock in this version
+        RecordChunkLoad(0,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lock_acquired - lock_requested).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lock_released - lock_acquired).count()
+        );
     }
 #else
     void World::Handle(ProtocolCraft::ClientboundLevelChunkWithLightPacket& msg)
     {
+        // Phase one: get the data decoded in a detached chunk, either
+        // already done on the decode pool or done now without holding the lock
+        std::optional<Chunk> chunk;
+        long long int decode_ns = 0;
+        const PreparedPacketId prepared_id = GetCurrentPreparedPacketId();
+        if (prepared_id != 0)
+        {
+            std::scoped_lock<std::mutex> lock(prepared_chunks_mutex);
+            auto it = prepared_chunks.find(prepared_id);
+            if (it != prepared_chunks.end())
+            {
+                chunk.emplace(std::move(it->second.chunk));
+                decode_ns = it->second.decode_ns;
+                prepared_chunks.erase(it);
+            }
+        }
+        if (!chunk.has_value())
+        {
+            const std::chrono::steady_clock::time_point decode_start = std::chrono::steady_clock::now();
+            chunk.emplace(DecodeChunk(msg));
+            decode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - decode_start).count();
+        }
+        const std::chrono::steady_clock::time_point decode_end = std::chrono::steady_clock::now();
+
+        // Phase two: swap it into the terrain
+        std::chrono::steady_clock::time_point lock_acquired;
+        std::chrono::steady_clock::time_point lock_released;
+        {
             std::scoped_lock<std::shared_mutex> lock(world_mutex);
-            LoadChunkImpl(msg.GetX(), msg.GetZ(), current_dimension, std::this_thread::get_id());
-            LoadDataInChunk(msg.GetX(), msg.GetZ(), msg.GetChunkData().GetBuffer());
-            LoadBlockEntityDataInChunk(msg.GetX(), msg.GetZ(), msg.GetChunkData().GetBlockEntitiesData());
-            UpdateChunkLight(msg.GetX(), msg.GetZ(), current_dimension,
-                msg.GetLightData().GetSkyYMask(), msg.GetLightData().GetEmptySkyYMask(), msg.GetLightData().GetSkyUpdates(), true);
-            UpdateChunkLight(msg.GetX(), msg.GetZ(), current_dimension,
-                msg.GetLightData().GetBlockYMask(), msg.GetLightData().GetEmptyBlockYMask(), msg.GetLightData().GetBlockUpdates(), false);
+            lock_acquired = std::chrono::steady_clock::now();
+            InsertChunkImpl(msg.GetX(), msg.GetZ(), std::move(chunk.value()), GetCurrentLoaderId());
+#if USE_GUI
+            UpdateChunk(msg.GetX(), msg.GetZ());
+#endif
+            PublishTerrainView();
+            lock_released = std::chrono::steady_clock::now();
+        }
+
+        RecordChunkLoad(decode_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lock_acquired - decode_end).count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(lock_released - lock_acquired).count()
+        );
     }
 #endif
 
@@ -964,9 +942,9 @@ namespace Botcraft
 #endif
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
-    void World::LoadChunkImpl(const int x, const int z, const Dimension dim, const std::thread::id& loader_id)
+    void World::LoadChunkImpl(const int x, const int z, const Dimension dim, const LoaderId loader_id)
 #else
-    void World::LoadChunkImpl(const int x, const int z, const std::string& dim, const std::thread::id& loader_id)
+    void World::LoadChunkImpl(const int x, const int z, const std::string& dim, const LoaderId loader_id)
 #endif
     {
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -979,9 +957,9 @@ namespace Botcraft
         if (it == terrain.end())
         {
 #if PROTOCOL_VERSION < 757 /* < 1.18 */
-            auto inserted = terrain.insert({ {x, z}, Chunk(dim_index, has_sky_light) });
+            auto inserted = terrain.try_emplace({ x, z }, dim_index, has_sky_light);
 #else
-            auto inserted = terrain.insert({ { x, z }, Chunk(dimension_min_y.at(dim), dimension_height.at(dim), dim_index, has_sky_light)});
+            auto inserted = terrain.try_emplace({ x, z }, dimension_min_y.at(dim), dimension_height.at(dim), dim_index, has_sky_light);
 #endif
             inserted.first->second.AddLoader(loader_id);
         }
@@ -1005,11 +983,14 @@ namespace Botcraft
             it->second.AddLoader(loader_id);
         }
 
+        MarkChunkModified(x, z);
+        RecordChunkChange(x, z);
+
         //Not necessary, from void to air, there is no difference
         //UpdateChunk(x, z);
     }
 
-    void World::UnloadChunkImpl(const int x, const int z, const std::thread::id& loader_id)
+    void World::UnloadChunkImpl(const int x, const int z, const LoaderId loader_id)
     {
         auto it = terrain.find({ x, z });
         if (it != terrain.end())
@@ -1018,6 +999,8 @@ namespace Botcraft
             if (load_counter == 0)
             {
                 terrain.erase(it);
+                MarkChunkModified(x, z);
+                RecordChunkChange(x, z);
 #if USE_GUI
                 UpdateChunk(x, z);
 #endif
@@ -1025,15 +1008,86 @@ namespace Botcraft
         }
     }
 
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    Chunk World::DecodeChunk(const ProtocolCraft::ClientboundLevelChunkWithLightPacket& msg)
+    {
+        std::string dim;
+        int min_y;
+        unsigned int height;
+        std::optional<size_t> dim_index;
+        {
+            std::shared_lock<std::shared_mutex> lock(world_mutex);
+            dim = current_dimension;
+            min_y = dimension_min_y.at(dim);
+            height = dimension_height.at(dim);
+            if (auto it = dimension_index_map.find(dim); it != dimension_index_map.end())
+            {
+                dim_index = it->second;
+            }
+        }
+        if (!dim_index.has_value())
+        {
+            std::scoped_lock<std::shared_mutex> lock(world_mutex);
+            dim_index = GetDimIndex(dim);
+        }
+
+        Chunk chunk(min_y, height, dim_index.value(), dim == "minecraft:overworld");
+        chunk.LoadChunkData(msg.GetChunkData().GetBuffer());
+        chunk.LoadChunkBlockEntitiesData(msg.GetChunkData().GetBlockEntitiesData());
+        LoadLightInChunk(chunk, msg.GetLightData().GetSkyYMask(), msg.GetLightData().GetEmptySkyYMask(), msg.GetLightData().GetSkyUpdates(), true);
+        LoadLightInChunk(chunk, msg.GetLightData().GetBlockYMask(), msg.GetLightData().GetEmptyBlockYMask(), msg.GetLightData().GetBlockUpdates(), false);
+        return chunk;
+    }
+
+    void World::InsertChunkImpl(const int x, const int z, Chunk&& chunk, const LoaderId loader_id)
+    {
+        MarkChunkModified(x, z);
+        RecordChunkChange(x, z);
+        auto it = terrain.find({ x, z });
+        chunk.AddLoader(loader_id);
+        if (it == terrain.end())
+        {
+            terrain.try_emplace({ x, z }, std::move(chunk));
+            return;
+        }
+
+        // This may already exists in this dimension if this is a shared world
+        if (it->second.GetDimensionIndex() == chunk.GetDimensionIndex())
+        {
+            for (const LoaderId id : it->second.GetLoaders())
+            {
+                chunk.AddLoader(id);
+            }
+        }
+        else if (is_shared)
+        {
+            LOG_WARNING("Changing dimension with a shared world is not supported and can lead to wrong world data");
+        }
+        it->second = std::move(chunk);
+    }
+#endif
+
+    void World::RecordChunkLoad(const long long int decode_ns, const long long int lock_wait_ns, const long long int lock_hold_ns)
+    {
+        std::scoped_lock<std::mutex> lock(chunk_load_stats_mutex);
+        chunk_load_stats.num_chunks += 1;
+        chunk_load_stats.decode_total_ns += decode_ns;
+        chunk_load_stats.decode_max_ns = std::max(chunk_load_stats.decode_max_ns, decode_ns);
+        chunk_load_stats.lock_wait_total_ns += lock_wait_ns;
+        chunk_load_stats.lock_wait_max_ns = std::max(chunk_load_stats.lock_wait_max_ns, lock_wait_ns);
+        chunk_load_stats.lock_hold_total_ns += lock_hold_ns;
+        chunk_load_stats.lock_hold_max_ns = std::max(chunk_load_stats.lock_hold_max_ns, lock_hold_ns);
+    }
+
     void World::SetBlockImpl(const Position& pos, const BlockstateId id)
     {
         const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
         const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
 
-        auto it = terrain.find({ chunk_x, chunk_z });
+        Chunk* chunk = terrain.Get(chunk_x, chunk_z);
 
         // Can't set block in unloaded chunk
-        if (it == terrain.end())
+        if (chunk == nullptr)
         {
             return;
         }
@@ -1044,7 +1098,9 @@ namespace Botcraft
             (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH
         );
 
-        it->second.SetBlock(set_pos, id);
+        chunk->SetBlock(set_pos, id);
+        MarkChunkModified(chunk_x, chunk_z);
+        RecordBlockChange(pos, pos);
 
 #if USE_GUI
         // If this block is on the edge, update neighbours chunks
@@ -1052,26 +1108,107 @@ namespace Botcraft
 #endif
     }
 
-    const Blockstate* World::GetBlockImpl(const Position& pos) const
+    void World::MarkChunkModified(const int x, const int z)
     {
-        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
-        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
-
-        auto it = terrain.find({ chunk_x, chunk_z });
+        modified_chunks.push_back({ x, z });
+    }
 
-        // Can't get block in unloaded chunk
-        if (it == terrain.end())
+    void World::RecordBlockChange(const Position& min, const Position& max)
+    {
+        if (block_changes.size() == max_block_changes)
         {
-            return nullptr;
+            block_changes.pop_front();
+            block_changes_start += 1;
         }
+        block_changes.emplace_back(min, max);
+        block_revision.store(block_changes_start + block_changes.size(), std::memory_order_release);
+    }
 
-        const Position chunk_pos(
-            (pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH,
-            pos.y,
-            (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH
+    void World::RecordChunkChange(const int x, const int z)
+    {
+        RecordBlockChange(
+            Position(x * CHUNK_WIDTH, std::numeric_limits<int>::min(), z * CHUNK_WIDTH),
+            Position(x * CHUNK_WIDTH + CHUNK_WIDTH - 1, std::numeric_limits<int>::max(), z * CHUNK_WIDTH + CHUNK_WIDTH - 1)
         );
+    }
+
+    void World::PublishTerrainView()
+    {
+        if (modified_chunks.empty())
+        {
+            return;
+        }
+
+        std::sort(modified_chunks.begin(), modified_chunks.end());
+        modified_chunks.erase(std::unique(modified_chunks.begin(), modified_chunks.end()), modified_chunks.end());
 
-        return it->second.GetBlock(chunk_pos);
+        RetiredTerrainViews retired;
+        bool chunk_set_changed = false;
+        for (const auto& [x, z] : modified_chunks)
+        {
+            const Chunk* chunk = terrain.Get(x, z);
+            std::unique_ptr<const TerrainChunkView> chunk_view;
+            if (chunk != nullptr)
+            {
+                chunk_view = std::make_unique<const TerrainChunkView>(TerrainChunkView{ chunk->GetMinY(), chunk->GetHeight(), chunk->ShareSections() });
+            }
+
+            auto it = published_chunk_views.find({ x, z });
+            if (it == published_chunk_views.end())
+            {
+                if (chunk_view != nullptr)
+                {
+                    published_chunk_views.try_emplace({ x, z }, std::move(chunk_view));
+                    chunk_set_changed = true;
+                }
+                continue;
+            }
+
+            retired.chunks.push_back(std::move(it->second));
+            if (chunk_view == nullptr)
+            {
+                published_chunk_views.erase(it);
+                chunk_set_changed = true;
+            }
+            else
+            {
+                it->second = std::move(chunk_view);
+            }
+        }
+
+        if (chunk_set_changed)
+        {
+            // Chunks added or removed, publish a whole new index
+            std::unique_ptr<TerrainView> new_view = std::make_unique<TerrainView>();
+            for (const auto& [coords, chunk_view] : published_chunk_views)
+            {
+                new_view->chunks.try_emplace(coords, chunk_view.get());
+            }
+            terrain_view.store(new_view.get(), std::memory_order_seq_cst);
+            retired.terrain = std::move(published_terrain_view);
+            published_terrain_view = std::move(new_view);
+        }
+        else
+        {
+            // Only blocks changed, swap the modified chunks in the current index
+            for (const auto& [x, z] : modified_chunks)
+            {
+                published_terrain_view->chunks.Get(x, z)->store(published_chunk_views.at({ x, z }).get(), std::memory_order_seq_cst);
+            }
+        }
+        modified_chunks.clear();
+
+        if (retired.terrain != nullptr || !retired.chunks.empty())
+        {
+            // Old views are now unreachable for any new reader
+            retired.epoch = Utilities::RetireEpoch();
+            retired_terrain_views.push_back(std::move(retired));
+        }
+
+        const unsigned long long int oldest_read_epoch = Utilities::GetOldestReadEpoch();
+        auto first_in_use = std::find_if(retired_terrain_views.begin(), retired_terrain_views.end(),
+            [oldest_read_epoch](const RetiredTerrainViews& r) { return r.epoch >= oldest_read_epoch; });
+        retired_terrain_views.erase(retired_terrain_views.begin(), first_in_use);
     }
 
 #if PROTOCOL_VERSION < 719 /* < 1.16 */
@@ -1266,6 +1403,8 @@ namespace Botcraft
 #else
             it->second.LoadChunkData(data);
 #endif
+            MarkChunkModified(x, z);
+            RecordChunkChange(x, z);
 #if USE_GUI
             UpdateChunk(x, z);
 #endif
@@ -1317,51 +1456,37 @@ namespace Botcraft
             return;
         }
 
+        LoadLightInChunk(it->second, light_mask, empty_light_mask, data, sky);
+    }
+
+#if PROTOCOL_VERSION < 755 /* < 1.17 */
+    void World::LoadLightInChunk(Chunk& chunk, const int light_mask, const int empty_light_mask,
+        const std::vector<std::vector<char>>& data, const bool sky)
+#else
+    void World::LoadLightInChunk(Chunk& chunk,
+        const std::vector<unsigned long long int>& light_mask, const std::vector<unsigned long long int>& empty_light_mask,
+        const std::vector<std::vector<char>>& data, const bool sky)
+#endif
+    {
         int counter_arrays = 0;
-        Position pos1, pos2;
 
-        const int num_sections = GetHeightImpl() / 16 + 2;
+        const int num_sections = chunk.GetHeight() / 16 + 2;
 
         for (int i = 0; i < num_sections; ++i)
         {
+            // First and last sections are outside of the world
             const int section_Y = i - 1;
+            const bool inside = i > 0 && i < num_sections - 1;
 
-            // Sky light
 #if PROTOCOL_VERSION < 755 /* < 1.17 */
             if ((light_mask >> i) & 1)
 #else
             if ((light_mask.size() > i / 64) && (light_mask[i / 64] >> (i % 64)) & 1)
 #endif
             {
-                if (i > 0 && i < num_sections - 1)
+                if (inside && counter_arrays < data.size())
                 {
-                    for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
-                    {
-                        pos1.y = block_y + section_Y * SECTION_HEIGHT + GetMinYImpl();
-                        pos2.y = pos1.y;
-                        for (int block_z = 0; block_z < CHUNK_WIDTH; ++block_z)
-                        {
-                            pos1.z = block_z;
-                            pos2.z = block_z;
-                            for (int block_x = 0; block_x < CHUNK_WIDTH; block_x += 2)
-                            {
-                                pos1.x = block_x;
-                                pos2.x = block_x + 1;
-                                const char two_light_values = data[counter_arrays][(block_y * CHUNK_WIDTH * CHUNK_WIDTH + block_z * CHUNK_WIDTH + block_x) / 2];
-
-                                if (sky)
-                                {
-                                    it->second.SetSkyLight(pos1, two_light_values & 0x0F);
-                                    it->second.SetSkyLight(pos2, (two_light_values >> 4) & 0x0F);
-                                }
-                                else
-                                {
-                                    it->second.SetBlockLight(pos1, two_light_values & 0x0F);
-                                    it->second.SetBlockLight(pos2, (two_light_values >> 4) & 0x0F);
-                                }
-                            }
-                        }
-                    }
+                    chunk.LoadSectionLight(section_Y, data[counter_arrays], sky);
                 }
                 counter_arrays++;
             }
@@ -1371,33 +1496,9 @@ namespace Botcraft
             else if ((empty_light_mask.size() > i / 64) && (empty_light_mask[i / 64] >> (i % 64)) & 1)
 #endif
             {
-                if (i > 0 && i < num_sections - 1)
+                if (inside)
                 {
-                    for (int block_y = 0; block_y < SECTION_HEIGHT; ++block_y)
-                    {
-                        pos1.y = block_y + section_Y * SECTION_HEIGHT + GetMinYImpl();
-                        pos2.y = pos1.y;
-                        for (int block_z = 0; block_z < CHUNK_WIDTH; ++block_z)
-                        {
-                            pos1.z = block_z;
-                            pos2.z = block_z;
-                            for (int block_x = 0; block_x < CHUNK_WIDTH; block_x += 2)
-                            {
-                                pos1.x = block_x;
-                                pos2.x = block_x + 1;
-                                if (sky)
-                                {
-                                    it->second.SetSkyLight(pos1, 0);
-                                    it->second.SetSkyLight(pos2, 0);
-                                }
-                                else
-                                {
-                                    it->second.SetBlockLight(pos1, 0);
-                                    it->second.SetBlockLight(pos2, 0);
-                                }
-                            }
-                        }
-                    }
+                    chunk.LoadSectionLight(section_Y, {}, sky);
                 }
             }
         }
@@ -0,0 +1,431 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "botcraft/Game/World/Chunk.hpp"
+#include "botcraft/Game/World/Section.hpp"
+#include "botcraft/Game/World/TerrainView.hpp"
+#include "botcraft/Game/World/World.hpp"
+#include "botcraft/Game/World/WorldView.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        long long int SqrDistance(const Position& a, const Position& b)
+        {
+            const long long int dx = static_cast<long long int>(a.x) - b.x;
+            const long long int dy = static_cast<long long int>(a.y) - b.y;
+            const long long int dz = static_cast<long long int>(a.z) - b.z;
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        /// @brief Squared distance between a position and the closest block of a box
+        long long int SqrDistanceToBox(const Position& pos, const Position& min, const Position& max)
+        {
+            return SqrDistance(pos, Position(
+                std::clamp(pos.x, min.x, max.x),
+                std::clamp(pos.y, min.y, max.y),
+                std::clamp(pos.z, min.z, max.z)
+            ));
+        }
+    }
+
+    WorldView::WorldView(const World& world) :
+        terrain(world.terrain_view.load(std::memory_order_seq_cst)),
+        has_cached_chunk(false), cached_chunk_x(0), cached_chunk_z(0), cached_chunk(nullptr)
+    {
+
+    }
+
+    bool WorldView::IsLoaded(const Position& pos)
+    {
+        const int chunk_x = static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH)));
+        const int chunk_z = static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)));
+
+        return GetChunkView(chunk_x, chunk_z) != nullptr;
+    }
+
+    const Blockstate* WorldView::GetBlock(const Position& pos)
+    {
+        // Same as std::floor(pos.x / double(CHUNK_WIDTH)), without going through floating points
+        const int chunk_x = (pos.x < 0 ? pos.x - (CHUNK_WIDTH - 1) : pos.x) / CHUNK_WIDTH;
+        const int chunk_z = (pos.z < 0 ? pos.z - (CHUNK_WIDTH - 1) : pos.z) / CHUNK_WIDTH;
+
+        const TerrainChunkView* chunk = GetChunkView(chunk_x, chunk_z);
+
+        // Can't get block in unloaded chunk
+        if (chunk == nullptr)
+        {
+            return nullptr;
+        }
+
+        return chunk->GetBlock(Position(pos.x - chunk_x * CHUNK_WIDTH, pos.y, pos.z - chunk_z * CHUNK_WIDTH));
+    }
+
+    Walkability WorldView::GetWalkability(const Position& pos)
+    {
+        const int chunk_x = (pos.x < 0 ? pos.x - (CHUNK_WIDTH - 1) : pos.x) / CHUNK_WIDTH;
+        const int chunk_z = (pos.z < 0 ? pos.z - (CHUNK_WIDTH - 1) : pos.z) / CHUNK_WIDTH;
+
+        const TerrainChunkView* chunk = GetChunkView(chunk_x, chunk_z);
+        if (chunk == nullptr)
+        {
+            return Walkability();
+        }
+
+        return chunk->GetWalkability(Position(pos.x - chunk_x * CHUNK_WIDTH, pos.y, pos.z - chunk_z * CHUNK_WIDTH));
+    }
+
+    bool WorldView::IsFree(const AABB& aabb, const bool fluid_collide)
+    {
+        const Vector3<double> min_aabb = aabb.GetMin();
+        const Vector3<double> max_aabb = aabb.GetMax();
+
+        Position cube_pos;
+        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
+        {
+            cube_pos.y = y;
+            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
+            {
+                cube_pos.z = z;
+                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
+                {
+                    cube_pos.x = x;
+                    const Blockstate* block = GetBlock(cube_pos);
+
+                    if (block == nullptr)
+                    {
+                        continue;
+                    }
+
+                    if (block->IsFluid())
+                    {
+                        if (!fluid_collide)
+                        {
+                            continue;
+                        }
+                    }
+                    else if (!block->IsSolid())
+                    {
+                        continue;
+                    }
+
+                    bool collide = false;
+                    block->ForEachColliderAtPos(cube_pos, [&](const AABB& collider)
+                        {
+                            collide = aabb.Collide(collider);
+                            return !collide;
+                        });
+                    if (collide)
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    std::vector<AABB> WorldView::GetColliders(const AABB& aabb, const Vector3<double>& movement)
+    {
+        std::vector<AABB> output;
+        output.reserve(32);
+        GetColliders(aabb, movement, output);
+        return output;
+    }
+
+    void WorldView::GetColliders(const AABB& aabb, const Vector3<double>& movement, std::vector<AABB>& output)
+    {
+        output.clear();
+        const AABB movement_extended_aabb(aabb.GetCenter() + movement * 0.5, aabb.GetHalfSize() + movement.Abs() * 0.5);
+        const Vector3<double> min_aabb = movement_extended_aabb.GetMin();
+        const Vector3<double> max_aabb = movement_extended_aabb.GetMax();
+        Position current_pos;
+        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
+        {
+            current_pos.y = y;
+            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
+            {
+                current_pos.z = z;
+                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
+                {
+                    current_pos.x = x;
+                    const Blockstate* block = GetBlock(current_pos);
+                    if (block == nullptr || !block->IsSolid())
+                    {
+                        continue;
+                    }
+
+                    block->CopyCollidersAtPos(current_pos, std::back_inserter(output));
+                }
+            }
+        }
+    }
+
+    std::optional<Position> WorldView::GetSupportingBlockPos(const AABB& aabb)
+    {
+        const Vector3<double> min_aabb = aabb.GetMin();
+        const Vector3<double> max_aabb = aabb.GetMax();
+
+        Position cube_pos;
+        std::optional<Position> output = std::optional<Position>();
+        double min_distance = std::numeric_limits<double>::max();
+        for (int y = static_cast<int>(std::floor(min_aabb.y)) - 1; y <= static_cast<int>(std::floor(max_aabb.y)); ++y)
+        {
+            cube_pos.y = y;
+            for (int z = static_cast<int>(std::floor(min_aabb.z)); z <= static_cast<int>(std::floor(max_aabb.z)); ++z)
+            {
+                cube_pos.z = z;
+                for (int x = static_cast<int>(std::floor(min_aabb.x)); x <= static_cast<int>(std::floor(max_aabb.x)); ++x)
+                {
+                    cube_pos.x = x;
+                    const Blockstate* block = GetBlock(cube_pos);
+
+                    if (block == nullptr || !block->IsSolid())
+                    {
+                        continue;
+                    }
+
+                    block->ForEachColliderAtPos(cube_pos, [&](const AABB& collider)
+                        {
+                            if (aabb.Collide(collider))
+                            {
+                                const double distance = aabb.GetCenter().SqrDist(collider.GetCenter());
+                                if (distance < min_distance)
+                                {
+                                    min_distance = distance;
+                                    output = cube_pos;
+                                }
+                            }
+                        });
+                }
+            }
+        }
+
+        return output;
+    }
+
+    Vector3<double> WorldView::GetFlow(const Position& pos)
+    {
+        Vector3<double> flow(0.0);
+        std::vector<Position> horizontal_neighbours = {
+            Position(0, 0, -1), Position(1, 0, 0),
+            Position(0, 0, 1), Position(-1, 0, 0)
+        };
+        const Blockstate* block = GetBlock(pos);
+        if (block == nullptr || !block->IsFluidOrWaterlogged())
+        {
+            return flow;
+        }
+
+        const float current_fluid_height = block->GetFluidHeight();
+        for (const Position& neighbour_pos : horizontal_neighbours)
+        {
+            const Blockstate* neighbour = GetBlock(pos + neighbour_pos);
+            if (neighbour == nullptr || (neighbour->IsFluidOrWaterlogged() && neighbour->IsWaterOrWaterlogged() != block->IsWaterOrWaterlogged()))
+            {
+                continue;
+            }
+            const float neighbour_fluid_height = neighbour->GetFluidHeight();
+            if (neighbour_fluid_height == 0.0f)
+            {
+                if (!neighbour->IsSolid())
+                {
+                    const Blockstate* block_below_neighbour = GetBlock(pos + neighbour_pos + Position(0, -1, 0));
+                    if (block_below_neighbour != nullptr &&
+                        (!block_below_neighbour->IsFluidOrWaterlogged() || block_below_neighbour->IsWaterOrWaterlogged() == block->IsWaterOrWaterlogged()))
+                    {
+                        const float block_below_neighbour_fluid_height = block_below_neighbour->GetFluidHeight();
+                        if (block_below_neighbour_fluid_height > 0.0f)
+                        {
+                            flow.x += (current_fluid_height - block_below_neighbour_fluid_height + 0.8888889f) * neighbour_pos.x;
+                            flow.z += (current_fluid_height - block_below_neighbour_fluid_height + 0.8888889f) * neighbour_pos.z;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                flow.x += (current_fluid_height - neighbour_fluid_height) * neighbour_pos.x;
+                flow.z += (current_fluid_height - neighbour_fluid_height) * neighbour_pos.z;
+            }
+        }
+
+        if (block->IsFluidFalling())
+        {
+            for (const Position& neighbour_pos : horizontal_neighbours)
+            {
+                const Blockstate* neighbour = GetBlock(pos + neighbour_pos);
+                if (neighbour == nullptr)
+                {
+                    continue;
+                }
+                const Blockstate* above_neighbour = GetBlock(pos + neighbour_pos + Position(0, 1, 0));
+                if (above_neighbour == nullptr)
+                {
+                    continue;
+                }
+                if (neighbour->IsSolid() && above_neighbour->IsSolid())
+                {
+                    flow.Normalize();
+                    flow.y -= 6.0;
+                    break;
+                }
+            }
+        }
+
+        flow.Normalize();
+        return flow;
+    }
+
+    std::vector<Position> WorldView::FindBlocks(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius, const size_t max_count)
+    {
+        std::vector<Position> output;
+        if (radius < 0 || max_count == 0)
+        {
+            return output;
+        }
+        const long long int sqr_radius = static_cast<long long int>(radius) * radius;
+
+        // Sections store blockstate ids, evaluate the predicate only once per id
+        std::unordered_map<unsigned short, bool> matching_ids;
+        const std::function<bool(const unsigned short)> id_predicate = [&](const unsigned short stored_id)
+        {
+            auto it = matching_ids.find(stored_id);
+            if (it == matching_ids.end())
+            {
+                const Blockstate* blockstate = TerrainChunkView::GetBlockstate(stored_id);
+                it = matching_ids.insert({ stored_id, blockstate != nullptr && predicate(blockstate) }).first;
+            }
+            return it->second;
+        };
+
+        // Get all the sections in range whose palette has a matching block
+        struct CandidateSection
+        {
+            long long int sqr_distance;
+            const Section* section;
+            Position origin;
+        };
+        std::vector<CandidateSection> candidates;
+        for (const auto& [coords, chunk_view] : terrain->chunks)
+        {
+            const TerrainChunkView* chunk = chunk_view.load(std::memory_order_seq_cst);
+            if (chunk == nullptr)
+            {
+                continue;
+            }
+            for (size_t i = 0; i < chunk->sections.size(); ++i)
+            {
+                const Section* section = chunk->sections[i].get();
+                if (section == nullptr)
+                {
+                    continue;
+                }
+                const Position origin(coords.first * CHUNK_WIDTH, chunk->min_y + static_cast<int>(i) * SECTION_HEIGHT, coords.second * CHUNK_WIDTH);
+                const long long int sqr_distance = SqrDistanceToBox(center, origin, origin + Position(CHUNK_WIDTH - 1, SECTION_HEIGHT - 1, CHUNK_WIDTH - 1));
+                if (sqr_distance > sqr_radius || !section->data_blocks.MayContain(id_predicate))
+                {
+                    continue;
+                }
+                candidates.push_back({ sqr_distance, section, origin });
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const CandidateSection& a, const CandidateSection& b)
+            {
+                return a.sqr_distance < b.sqr_distance;
+            });
+
+        // Scan candidate sections from the closest one, keeping only the max_count closest blocks
+        std::vector<std::pair<long long int, Position> > found;
+        long long int max_sqr_distance = sqr_radius;
+        for (const CandidateSection& candidate : candidates)
+        {
+            // Sections are sorted, none of the next ones can have a closer block
+            if (candidate.sqr_distance > max_sqr_distance)
+            {
+                break;
+            }
+
+            for (const size_t index : candidate.section->data_blocks.FindAll(id_predicate))
+            {
+                Position pos;
+                if (!Section::BlockIndexToCoords(index, pos.x, pos.y, pos.z))
+                {
+                    continue;
+                }
+                pos += candidate.origin;
+                const long long int sqr_distance = SqrDistance(center, pos);
+                if (sqr_distance <= max_sqr_distance)
+                {
+                    found.emplace_back(sqr_distance, pos);
+                }
+            }
+
+            if (found.size() >= max_count)
+            {
+                std::nth_element(found.begin(), found.begin() + (max_count - 1), found.end());
+                found.resize(max_count);
+                max_sqr_distance = found.back().first;
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        output.reserve(found.size());
+        for (const auto& [sqr_distance, pos] : found)
+        {
+            output.push_back(pos);
+        }
+        return output;
+    }
+
+    std::vector<Position> WorldView::FindBlocks(const std::unordered_set<std::string>& names, const Position& center, const int radius, const size_t max_count)
+    {
+        return FindBlocks([&](const Blockstate* blockstate)
+            {
+                return names.find(blockstate->GetName()) != names.end();
+            }, center, radius, max_count);
+    }
+
+    std::optional<Position> WorldView::FindNearest(const std::function<bool(const Blockstate*)>& predicate, const Position& center, const int radius)
+    {
+        const std::vector<Position> found = FindBlocks(predicate, center, radius, 1);
+        if (found.empty())
+        {
+            return std::optional<Position>();
+        }
+        return found[0];
+    }
+
+    std::optional<Position> WorldView::FindNearest(const std::unordered_set<std::string>& names, const Position& center, const int radius)
+    {
+        const std::vector<Position> found = FindBlocks(names, center, radius, 1);
+        if (found.empty())
+        {
+            return std::optional<Position>();
+        }
+        return found[0];
+    }
+
+    const TerrainChunkView* WorldView::GetChunkView(const int chunk_x, const int chunk_z)
+    {
+        if (has_cached_chunk && chunk_x == cached_chunk_x && chunk_z == cached_chunk_z)
+        {
+            return cached_chunk;
+        }
+
+        const std::atomic<const TerrainChunkView*>* chunk_view = terrain->chunks.Get(chunk_x, chunk_z);
+        has_cached_chunk = true;
+        cached_chunk_x = chunk_x;
+        cached_chunk_z = chunk_z;
+        cached_chunk = chunk_view == nullptr ? nullptr : chunk_view->load(std::memory_order_seq_cst);
+        return cached_chunk;
+    }
+} // Botcraft
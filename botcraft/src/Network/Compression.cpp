@@ -9,77 +9,176 @@
 namespace Botcraft
 {
     const unsigned long MAX_COMPRESSED_PACKET_LEN = 200 * 1024;
+    /// @brief Same limit as vanilla
+    const int MAX_DECOMPRESSED_PACKET_LEN = 8 * 1024 * 1024;
+    /// @brief Reused decompression buffers bigger than that are released
+    const size_t MAX_KEPT_BUFFER_LEN = 1024 * 1024;
 
-    std::vector<unsigned char> Compress(const std::vector<unsigned char>& raw)
+    namespace
     {
-        unsigned long size_to_compress = static_cast<unsigned long>(raw.size());
-        unsigned long compressed_size = compressBound(size_to_compress);
+        /// @brief Persistent inflate stream, reset between packets
+        class InflateStream
+        {
+        public:
+            InflateStream()
+            {
+                memset(&strm, 0, sizeof(strm));
+                const int res = inflateInit(&strm);
+                if (res != Z_OK)
+                {
+                    throw std::runtime_error("inflateInit failed: " + std::string(strm.msg == nullptr ? "" : strm.msg));
+                }
+            }
+
+            ~InflateStream()
+            {
+                inflateEnd(&strm);
+            }
+
+            z_stream& Reset()
+            {
+                inflateReset(&strm);
+                return strm;
+            }
+
+        private:
+            z_stream strm;
+        };
+
+        /// @brief Persistent deflate stream, reset between packets
+        class DeflateStream
+        {
+        public:
+            DeflateStream()
+            {
+                memset(&strm, 0, sizeof(strm));
+                const int res = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+                if (res != Z_OK)
+                {
+                    throw std::runtime_error("deflateInit failed: " + std::string(strm.msg == nullptr ? "" : strm.msg));
+                }
+            }
+
+            ~DeflateStream()
+            {
+                deflateEnd(&strm);
+            }
+
+            z_stream& Reset()
+            {
+                deflateReset(&strm);
+                return strm;
+            }
+
+        private:
+            z_stream strm;
+        };
+
+        z_stream& GetInflateStream()
+        {
+            thread_local InflateStream stream;
+            return stream.Reset();
+        }
 
+        z_stream& GetDeflateStream()
+        {
+            thread_local DeflateStream stream;
+            return stream.Reset();
+        }
+    }
+
+    void Compress(const std::vector<unsigned char>& raw, std::vector<unsigned char>& out)
+    {
+        z_stream& strm = GetDeflateStream();
+
+        const unsigned long compressed_size = deflateBound(&strm, static_cast<unsigned long>(raw.size()));
         if (compressed_size > MAX_COMPRESSED_PACKET_LEN)
         {
             throw std::runtime_error("Incoming packet is too big");
         }
 
-        std::vector<unsigned char> compressed_data(compressed_size);
-        int status = compress2(compressed_data.data(), &compressed_size, raw.data(), size_to_compress, Z_DEFAULT_COMPRESSION);
+        const size_t start = out.size();
+        out.resize(start + compressed_size);
+        strm.next_in = const_cast<unsigned char*>(raw.data());
+        strm.avail_in = static_cast<unsigned int>(raw.size());
+        strm.next_out = out.data() + start;
+        strm.avail_out = static_cast<unsigned int>(compressed_size);
 
-        if (status != Z_OK)
+        if (deflate(&strm, Z_FINISH) != Z_STREAM_END)
         {
             throw std::runtime_error("Error compressing packet");
         }
 
-        compressed_data.resize(compressed_size);
-        return compressed_data;
+        out.resize(start + strm.total_out);
     }
 
-    std::vector<unsigned char> Decompress(const std::vector<unsigned char>& compressed, const int start)
+    void Decompress(const unsigned char* compressed, const size_t compressed_size, unsigned char* out, const size_t decompressed_size)
     {
-        unsigned long size_to_decompress = static_cast<unsigned long>(compressed.size() - start);
-
-        std::vector<unsigned char> decompressed_data;
-        decompressed_data.reserve(size_to_decompress);
+        z_stream& strm = GetInflateStream();
+        strm.next_in = const_cast<unsigned char*>(compressed);
+        strm.avail_in = static_cast<unsigned int>(compressed_size);
+        strm.next_out = out;
+        strm.avail_out = static_cast<unsigned int>(decompressed_size);
 
-        std::vector<unsigned char> buffer(64 * 1024);
+        const int res = inflate(&strm, Z_FINISH);
+        if (res == Z_STREAM_END)
+        {
+            if (strm.total_out != decompressed_size)
+            {
+                throw std::runtime_error("Decompressed packet is smaller than announced");
+            }
+            return;
+        }
+        if (strm.avail_out == 0)
+        {
+            throw std::runtime_error("Decompressed packet is bigger than announced");
+        }
+        throw std::runtime_error("Inflate decompression failed: " + std::string(strm.msg == nullptr ? "" : strm.msg));
+    }
 
-        z_stream strm;
-        memset(&strm, 0, sizeof(strm));
-        strm.next_in = const_cast<unsigned char*>(compressed.data() + start);
-        strm.avail_in = size_to_decompress;
-        strm.next_out = buffer.data();
-        strm.avail_out = static_cast<unsigned int>(buffer.size());
+    void DecompressPacket(const unsigned char* compressed, const size_t compressed_size, const int decompressed_size, const int threshold, std::vector<unsigned char>& buffer)
+    {
+        if (decompressed_size < threshold || decompressed_size > MAX_DECOMPRESSED_PACKET_LEN)
+        {
+            throw std::runtime_error("Invalid decompressed packet size " + std::to_string(decompressed_size) + " (compression threshold is " + std::to_string(threshold) + ")");
+        }
 
-        int res = inflateInit(&strm);
-        if (res != Z_OK)
+        // Don't keep a big allocation for the whole connection because of one big packet
+        if (buffer.capacity() > MAX_KEPT_BUFFER_LEN && static_cast<size_t>(decompressed_size) <= MAX_KEPT_BUFFER_LEN)
         {
-            throw std::runtime_error("inflateInit failed: " + std::string(strm.msg));
+            std::vector<unsigned char>().swap(buffer);
         }
 
-        for (;;)
+        buffer.resize(decompressed_size);
+        Decompress(compressed, compressed_size, buffer.data(), decompressed_size);
+    }
+
+    std::vector<unsigned char> Decompress(const std::vector<unsigned char>& compressed, const int start, const size_t decompressed_size)
+    {
+        std::vector<unsigned char> decompressed_data(decompressed_size);
+        Decompress(compressed.data() + start, compressed.size() - start, decompressed_data.data(), decompressed_size);
+        return decompressed_data;
+    }
+
+    std::vector<unsigned char> DecompressPrefix(const std::vector<unsigned char>& compressed, const int start, const size_t max_size)
+    {
+        std::vector<unsigned char> decompressed_data(max_size);
+
+        z_stream& strm = GetInflateStream();
+        strm.next_in = const_cast<unsigned char*>(compressed.data() + start);
+        strm.avail_in = static_cast<unsigned int>(compressed.size() - start);
+        strm.next_out = decompressed_data.data();
+        strm.avail_out = static_cast<unsigned int>(max_size);
+
+        // Stop as soon as the output buffer is full
+        const int res = inflate(&strm, Z_SYNC_FLUSH);
+        if (res != Z_OK && res != Z_STREAM_END && res != Z_BUF_ERROR)
         {
-            res = inflate(&strm, Z_NO_FLUSH);
-            switch (res)
-            {
-            case Z_OK:
-                decompressed_data.insert(decompressed_data.end(), buffer.begin(), buffer.end() - strm.avail_out);
-                strm.next_out = buffer.data();
-                strm.avail_out = static_cast<unsigned int>(buffer.size());
-                if (strm.avail_in == 0)
-                {
-                    inflateEnd(&strm);
-                    return decompressed_data;
-                }
-                break;
-            case Z_STREAM_END:
-                decompressed_data.insert(decompressed_data.end(), buffer.begin(), buffer.end() - strm.avail_out);
-                inflateEnd(&strm);
-                return decompressed_data;
-                break;
-            default:
-                inflateEnd(&strm);
-                throw std::runtime_error("Inflate decompression failed: " + std::string(strm.msg));
-                break;
-            }
+            throw std::runtime_error("Inflate decompression failed: " + std::string(strm.msg == nullptr ? "" : strm.msg));
         }
+
+        decompressed_data.resize(max_size - strm.avail_out);
+        return decompressed_data;
     }
 } //Botcraft
 #endif
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <atomic>
+#include <string>
+
+#include "botcraft/Network/DecodePool.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        std::atomic<PreparedPacketId> next_prepared_packet_id = 1;
+
+        /// @brief 0 if no prepared packet is being dispatched on this thread
+        thread_local PreparedPacketId current_prepared_packet_id = 0;
+    }
+
+    PreparedPacketId NewPreparedPacketId()
+    {
+        return next_prepared_packet_id.fetch_add(1);
+    }
+
+    PreparedPacketId GetCurrentPreparedPacketId()
+    {
+        return current_prepared_packet_id;
+    }
+
+    ScopedPreparedPacketId::ScopedPreparedPacketId(const PreparedPacketId id)
+    {
+        previous_id = current_prepared_packet_id;
+        current_prepared_packet_id = id;
+    }
+
+    ScopedPreparedPacketId::~ScopedPreparedPacketId()
+    {
+        current_prepared_packet_id = previous_id;
+    }
+
+    DecodePool::DecodePool(const size_t num_threads)
+    {
+        running = true;
+
+        const size_t num_workers = num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : num_threads;
+        threads.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            threads.emplace_back(&DecodePool::Run, this, i);
+        }
+    }
+
+    DecodePool::~DecodePool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            running = false;
+        }
+        tasks_condition.notify_all();
+
+        for (std::thread& t : threads)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+    }
+
+    void DecodePool::Submit(std::function<void()>&& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(tasks_mutex);
+            tasks.push(std::move(task));
+        }
+        tasks_condition.notify_one();
+    }
+
+    size_t DecodePool::GetNumThreads() const
+    {
+        return threads.size();
+    }
+
+    void DecodePool::Run(const size_t index)
+    {
+        Logger::GetInstance().RegisterThread("DecodePool - " + std::to_string(index));
+
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(tasks_mutex);
+                tasks_condition.wait(lock, [this]() { return !running || !tasks.empty(); });
+                // Remaining tasks are still run when stopping, as someone may be waiting for them
+                if (tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception in decode pool task: " << e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR("Unknown exception in decode pool task");
+            }
+        }
+    }
+} // Botcraft
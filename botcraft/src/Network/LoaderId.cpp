@@ -0,0 +1,41 @@
+#include <atomic>
+
+#include "botcraft/Network/LoaderId.hpp"
+
+namespace Botcraft
+{
+    namespace
+    {
+        std::atomic<LoaderId> next_loader_id = 1;
+
+        /// @brief 0 if no connection is being processed on this thread
+        thread_local LoaderId current_loader_id = 0;
+    }
+
+    LoaderId NewLoaderId()
+    {
+        return next_loader_id.fetch_add(1);
+    }
+
+    LoaderId GetCurrentLoaderId()
+    {
+        if (current_loader_id == 0)
+        {
+            // Ids are only taken for threads actually loading chunks
+            thread_local const LoaderId thread_loader_id = NewLoaderId();
+            return thread_loader_id;
+        }
+        return current_loader_id;
+    }
+
+    ScopedLoaderId::ScopedLoaderId(const LoaderId id)
+    {
+        previous_id = current_loader_id;
+        current_loader_id = id;
+    }
+
+    ScopedLoaderId::~ScopedLoaderId()
+    {
+        current_loader_id = previous_id;
+    }
+} // Botcraft
@@ -1,7 +1,13 @@
 #include <functional>
 #include <optional>
 
+#include <asio/io_service_strand.hpp>
+
 #include "botcraft/Network/NetworkManager.hpp"
+#include "botcraft/Network/DecodePool.hpp"
+#include "botcraft/Network/IOContext.hpp"
+#include "botcraft/Network/NetworkPool.hpp"
+#include "botcraft/Network/PacketCapture.hpp"
 #include "botcraft/Network/TCP_Com.hpp"
 #include "botcraft/Network/Authentifier.hpp"
 #include "botcraft/Network/AESEncrypter.hpp"
@@ -21,9 +27,35 @@ using namespace ProtocolCraft;
 
 namespace Botcraft
 {
-    NetworkManager::NetworkManager(const std::string& address, const std::string& login, const bool force_microsoft_auth)
+    /// @brief Serialize the processing of the packets of one connection on a shared context
+    struct ProcessingStrand
+    {
+        ProcessingStrand(asio::io_service& io_service) : strand(io_service)
+        {
+
+        }
+
+        asio::io_service::strand strand;
+        /// @brief Reused for all decompressed packets, only used on the strand
+        std::vector<unsigned char> decompressed_packet;
+    };
+
+    NetworkManager::NetworkManager(const std::string& address, const std::string& login, const bool force_microsoft_auth, const std::shared_ptr<DecodePool>& decode_pool_, const std::string& capture_path, const std::shared_ptr<NetworkPool>& network_pool_)
     {
         com = nullptr;
+        decode_pool = decode_pool_;
+        queued_packets = 0;
+        loader_id = NewLoaderId();
+        std::shared_ptr<IOContext> io_context;
+        if (network_pool_)
+        {
+            io_context = network_pool_->GetNextContext();
+            processing_strand = std::make_shared<ProcessingStrand>(io_context->io_service);
+        }
+        if (!capture_path.empty())
+        {
+            capture_writer = std::make_shared<PacketCaptureWriter>(capture_path);
+        }
 
         // Online mode with Microsoft login flow
         if (login.empty() || force_microsoft_auth)
@@ -47,10 +79,13 @@ namespace Botcraft
 
         state = ConnectionState::Handshake;
 
-        //Start the thread to process the incoming packets
-        m_thread_process = std::thread(&NetworkManager::WaitForNewPackets, this);
+        //Start the thread to process the incoming packets, unless they are processed on the pool
+        if (processing_strand == nullptr)
+        {
+            m_thread_process = std::thread(&NetworkManager::WaitForNewPackets, this);
+        }
 
-        com = std::make_shared<TCP_Com>(address, std::bind(&NetworkManager::OnNewRawData, this, std::placeholders::_1));
+        com = std::make_shared<TCP_Com>(address, std::bind(&NetworkManager::OnNewRawData, this, std::placeholders::_1, std::placeholders::_2), io_context);
 
         //Let some time to initialize the communication before actually send data
         // TODO: make this in a cleaner way?
@@ -94,6 +129,43 @@ namespace Botcraft
     {
         state = constant_connection_state;
         compression = -1;
+        queued_packets = 0;
+        loader_id = NewLoaderId();
+    }
+
+    NetworkManager::NetworkManager(const std::string& capture_path, const std::string& login, const std::shared_ptr<DecodePool>& decode_pool_)
+    {
+        com = nullptr;
+        authentifier = nullptr;
+        decode_pool = decode_pool_;
+        replay_reader = std::make_shared<PacketCaptureReader>(capture_path);
+        name = login;
+        compression = -1;
+        queued_packets = 0;
+        loader_id = NewLoaderId();
+        AddHandler(this);
+
+        // Handshake is sent by the client, so a capture always starts in Login state
+        state = ConnectionState::Login;
+    }
+
+    std::shared_ptr<NetworkManager> NetworkManager::FromCapture(const std::string& capture_path, const std::string& login, const std::shared_ptr<DecodePool>& decode_pool_)
+    {
+        // Constructor is private, so std::make_shared can't be used
+        return std::shared_ptr<NetworkManager>(new NetworkManager(capture_path, login, decode_pool_));
+    }
+
+    void NetworkManager::StartReplay(const bool real_time)
+    {
+        if (replay_reader == nullptr)
+        {
+            throw std::runtime_error("Trying to start a replay on a NetworkManager not created from a packet capture");
+        }
+        if (m_thread_process.joinable())
+        {
+            throw std::runtime_error("Replay already started");
+        }
+        m_thread_process = std::thread(&NetworkManager::ReplayCapture, this, real_time);
     }
 
     NetworkManager::~NetworkManager()
@@ -116,6 +188,20 @@ namespace Botcraft
         {
             m_thread_process.join();
         }
+
+        if (processing_strand)
+        {
+            // Once com is destroyed no more packet can be posted,
+            // then wait for the ones already posted to the strand
+            com.reset();
+            if (!processing_strand->strand.running_in_this_thread())
+            {
+                std::promise<void> processed;
+                processing_strand->strand.post([&processed]() { processed.set_value(); });
+                processed.get_future().wait();
+            }
+            DiscardPendingPackets();
+        }
         compression = -1;
 
         com.reset();
@@ -126,6 +212,11 @@ namespace Botcraft
         subscribed.push_back(h);
     }
 
+    void NetworkManager::AddPreparer(PacketPreparer* p)
+    {
+        preparers.push_back(p);
+    }
+
     void NetworkManager::Send(const std::shared_ptr<Message> msg)
     {
         if (com)
@@ -149,8 +240,7 @@ namespace Botcraft
                 {
                     std::vector<unsigned char> compressed_msg;
                     WriteData<VarInt>(static_cast<int>(msg_data.size()), compressed_msg);
-                    std::vector<unsigned char> compressed_data = Compress(msg_data);
-                    compressed_msg.insert(compressed_msg.end(), compressed_data.begin(), compressed_data.end());
+                    Compress(msg_data, compressed_msg);
                     com->SendPacket(compressed_msg);
                 }
 #else
@@ -283,16 +373,19 @@ namespace Botcraft
         Send(chat_command);
     }
 
-    std::thread::id NetworkManager::GetProcessingThreadId() const
+    LoaderId NetworkManager::GetLoaderId() const
     {
-        return m_thread_process.get_id();
+        return loader_id;
     }
 
     void NetworkManager::WaitForNewPackets()
     {
         Logger::GetInstance().RegisterThread("NetworkPacketProcessing - " + name);
+        const ScopedLoaderId scoped_loader_id(loader_id);
         try
         {
+            // Reused for all decompressed packets, so it only grows up to the biggest packet
+            std::vector<unsigned char> decompressed_packet;
             while (state != ConnectionState::None)
             {
                 {
@@ -306,45 +399,23 @@ namespace Botcraft
                         std::lock_guard<std::mutex> process_guard(mutex_process);
                         if (!packets_to_process.empty())
                         {
-                            packet = packets_to_process.front();
+                            packet = std::move(packets_to_process.front());
                             packets_to_process.pop();
                         }
                     }
                     if (packet.size() > 0)
                     {
-                        if (compression == -1)
-                        {
-                            ProcessPacket(packet);
-                        }
-                        else
+                        if (capture_writer)
                         {
-#ifdef USE_COMPRESSION
-                            size_t length = packet.size();
-                            ReadIterator iter = packet.begin();
-                            int data_length = ReadData<VarInt>(iter, length);
-
-                            //Packet not compressed
-                            if (data_length == 0)
-                            {
-                                //Erase the first 0
-                                packet.erase(packet.begin());
-                                ProcessPacket(packet);
-                            }
-                            //Packet compressed
-                            else
-                            {
-                                const int size_varint = static_cast<int>(packet.size() - length);
-
-                                std::vector<unsigned char> uncompressed_msg = Decompress(packet, size_varint);
-                                ProcessPacket(uncompressed_msg);
-                            }
-#else
-                            throw std::runtime_error("Program compiled without USE_COMPRESSION. Cannot read compressed message");
-#endif
+                            capture_writer->Write(state, packet);
                         }
+                        ProcessRawPacket(std::move(packet), decompressed_packet);
                     }
                 }
+                // Nothing left to read for now, don't keep already received packets waiting
+                DispatchPendingPackets(0);
             }
+            DiscardPendingPackets();
         }
         catch (const std::exception& e)
         {
@@ -358,6 +429,99 @@ namespace Botcraft
         }
     }
 
+    void NetworkManager::ReplayCapture(const bool real_time)
+    {
+        Logger::GetInstance().RegisterThread("NetworkPacketReplay - " + name);
+        const ScopedLoaderId scoped_loader_id(loader_id);
+        try
+        {
+            std::vector<unsigned char> decompressed_packet;
+            CapturedPacket captured;
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            bool state_mismatch_logged = false;
+            while (state != ConnectionState::None && replay_reader->Read(captured))
+            {
+                if (real_time)
+                {
+                    // Wait on the process condition so Close doesn't have to wait for the next packet
+                    std::unique_lock<std::mutex> lck(mutex_process);
+                    process_condition.wait_until(lck, start + std::chrono::microseconds(captured.timestamp_us),
+                        [this]() { return state == ConnectionState::None; });
+                }
+                if (state == ConnectionState::None)
+                {
+                    break;
+                }
+                // State is driven by the replayed packets, so it should always match the captured one
+                if (captured.state != state && !state_mismatch_logged)
+                {
+                    LOG_WARNING("Replayed packet captured in state " << static_cast<int>(captured.state) << " but processed in state " << static_cast<int>(state));
+                    state_mismatch_logged = true;
+                }
+                if (captured.data.size() > 0)
+                {
+                    ProcessRawPacket(std::move(captured.data), decompressed_packet);
+                }
+            }
+            DispatchPendingPackets(0);
+            // End of the capture, behave as if the server closed the connection
+            state = ConnectionState::None;
+            DiscardPendingPackets();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_FATAL("Exception: " << e.what());
+            throw;
+        }
+        catch (...)
+        {
+            LOG_FATAL("Unknown exception");
+            throw;
+        }
+    }
+
+    void NetworkManager::ProcessRawPacket(std::vector<unsigned char>&& packet, std::vector<unsigned char>& decompressed_packet)
+    {
+        if (IsAsyncDecoded(packet))
+        {
+            DecodeAsync(std::move(packet));
+            return;
+        }
+
+        // Any other packet must be processed after all the previous ones
+        DispatchPendingPackets(0);
+        if (compression == -1)
+        {
+            ProcessPacket(packet);
+        }
+        else
+        {
+#ifdef USE_COMPRESSION
+            size_t length = packet.size();
+            ReadIterator iter = packet.begin();
+            int data_length = ReadData<VarInt>(iter, length);
+
+            //Packet not compressed
+            if (data_length == 0)
+            {
+                //Erase the first 0
+                packet.erase(packet.begin());
+                ProcessPacket(packet);
+            }
+            //Packet compressed
+            else
+            {
+                const int size_varint = static_cast<int>(packet.size() - length);
+
+                DecompressPacket(packet.data() + size_varint, length, data_length, compression, decompressed_packet);
+                ProcessPacket(decompressed_packet);
+            }
+#else
+            throw std::runtime_error("Program compiled without USE_COMPRESSION. Cannot read compressed message");
+#endif
+        }
+    }
+
     void NetworkManager::ProcessPacket(const std::vector<unsigned char>& packet)
     {
         if (packet.empty())
@@ -370,35 +534,261 @@ namespace Botcraft
 
         const int packet_id = ReadData<VarInt>(packet_iterator, length);
 
-        std::shared_ptr<Message> msg = CreateClientboundMessage(state, packet_id);
+        // Handlers don't keep the message after dispatch, so the same instances can be reused
+        Message* msg = message_pool.GetClientboundMessage(state, packet_id);
 
         if (msg)
         {
-            try
+            ReadMessage(*msg, packet_iterator, length);
+            for (size_t i = 0; i < subscribed.size(); i++)
             {
-                msg->Read(packet_iterator, length);
+                msg->Dispatch(subscribed[i]);
             }
-            catch (std::exception)
+        }
+    }
+
+    std::shared_ptr<Message> NetworkManager::ParsePacket(const std::vector<unsigned char>& packet, const ConnectionState connection_state)
+    {
+        if (packet.empty())
+        {
+            return nullptr;
+        }
+
+        std::vector<unsigned char>::const_iterator packet_iterator = packet.begin();
+        size_t length = packet.size();
+
+        const int packet_id = ReadData<VarInt>(packet_iterator, length);
+
+        std::shared_ptr<Message> msg = CreateClientboundMessage(connection_state, packet_id);
+
+        if (msg)
+        {
+            ReadMessage(*msg, packet_iterator, length);
+        }
+
+        return msg;
+    }
+
+    void NetworkManager::ReadMessage(Message& msg, ReadIterator& iter, size_t& length)
+    {
+        try
+        {
+            msg.Read(iter, length);
+        }
+        catch (std::exception)
+        {
+            LOG_FATAL("Parsing exception while parsing message \"" << msg.GetName() << '"');
+            throw;
+        }
+    }
+
+    bool NetworkManager::IsAsyncDecoded(const std::vector<unsigned char>& packet) const
+    {
+        if (decode_pool == nullptr || state != ConnectionState::Play)
+        {
+            return false;
+        }
+
+        ReadIterator iter = packet.begin();
+        size_t length = packet.size();
+        int packet_id = -1;
+        if (compression == -1)
+        {
+            packet_id = ReadData<VarInt>(iter, length);
+        }
+        else
+        {
+#ifdef USE_COMPRESSION
+            const int data_length = ReadData<VarInt>(iter, length);
+            if (data_length == 0)
             {
-                LOG_FATAL("Parsing exception while parsing message \"" << msg->GetName() << '"');
-                throw;
+                packet_id = ReadData<VarInt>(iter, length);
             }
-            for (size_t i = 0; i < subscribed.size(); i++)
+            else
             {
-                msg->Dispatch(subscribed[i]);
+                // Only inflate the first bytes, the whole packet
+                // will be decompressed on the decode pool if needed
+                const std::vector<unsigned char> prefix = DecompressPrefix(packet, static_cast<int>(packet.size() - length), 5);
+                ReadIterator prefix_iter = prefix.begin();
+                size_t prefix_length = prefix.size();
+                packet_id = ReadData<VarInt>(prefix_iter, prefix_length);
+            }
+#else
+            return false;
+#endif
+        }
+
+        switch (packet_id)
+        {
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        case ClientboundLevelChunkWithLightPacket::packet_id:
+#endif
+#if PROTOCOL_VERSION > 404 /* > 1.13.2 */
+        case ClientboundLightUpdatePacket::packet_id:
+#endif
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void NetworkManager::DecodeAsync(std::vector<unsigned char>&& packet)
+    {
+        const PreparedPacketId id = NewPreparedPacketId();
+        // Everything the task needs is copied, as state, compression
+        // and preparers can change before the task is run
+        std::shared_ptr<std::packaged_task<std::shared_ptr<Message>()> > task = std::make_shared<std::packaged_task<std::shared_ptr<Message>()> >(
+            [id, packet = std::move(packet), connection_state = state, compression_threshold = compression, current_preparers = preparers]()
+            {
+                std::shared_ptr<Message> msg;
+                if (compression_threshold == -1)
+                {
+                    msg = ParsePacket(packet, connection_state);
+                }
+                else
+                {
+#ifdef USE_COMPRESSION
+                    ReadIterator iter = packet.begin();
+                    size_t length = packet.size();
+                    const int data_length = ReadData<VarInt>(iter, length);
+                    const int size_varint = static_cast<int>(packet.size() - length);
+                    if (data_length == 0)
+                    {
+                        msg = ParsePacket(std::vector<unsigned char>(packet.begin() + size_varint, packet.end()), connection_state);
+                    }
+                    else
+                    {
+                        // Reused by all the packets decompressed on this pool thread
+                        thread_local std::vector<unsigned char> decompressed_packet;
+                        DecompressPacket(packet.data() + size_varint, length, data_length, compression_threshold, decompressed_packet);
+                        msg = ParsePacket(decompressed_packet, connection_state);
+                    }
+#else
+                    throw std::runtime_error("Program compiled without USE_COMPRESSION. Cannot read compressed message");
+#endif
+                }
+
+                if (msg)
+                {
+                    for (PacketPreparer* p : current_preparers)
+                    {
+                        p->Prepare(*msg, id);
+                    }
+                }
+                return msg;
+            }
+        );
+
+        pending_packets.emplace_back(id, task->get_future());
+        decode_pool->Submit([task]() { (*task)(); });
+
+        // Bound the number of packets in flight for this connection
+        DispatchPendingPackets(4 * decode_pool->GetNumThreads());
+    }
+
+    void NetworkManager::DispatchPendingPackets(const size_t max_pending)
+    {
+        while (!pending_packets.empty())
+        {
+            // Also dispatch all the packets that are already decoded
+            if (pending_packets.size() <= max_pending &&
+                pending_packets.front().second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            {
+                return;
+            }
+
+            const PreparedPacketId id = pending_packets.front().first;
+            // get() rethrows any exception that occured during decoding
+            std::shared_ptr<Message> msg = pending_packets.front().second.get();
+            pending_packets.pop_front();
+            if (msg)
+            {
+                // So handlers can find the data prepared for this packet
+                const ScopedPreparedPacketId scoped_prepared_packet_id(id);
+                for (size_t i = 0; i < subscribed.size(); i++)
+                {
+                    msg->Dispatch(subscribed[i]);
+                }
+            }
+        }
+    }
+
+    void NetworkManager::DiscardPendingPackets()
+    {
+        while (!pending_packets.empty())
+        {
+            const PreparedPacketId id = pending_packets.front().first;
+            // Any decoding exception is dropped with the future, as the packet is discarded anyway
+            pending_packets.front().second.wait();
+            pending_packets.pop_front();
+            // Even if parsing failed, some preparers may have been called before
+            for (PacketPreparer* p : preparers)
+            {
+                p->DiscardPrepared(id);
             }
         }
     }
 
-    void NetworkManager::OnNewRawData(const std::vector<unsigned char>& packet)
+    void NetworkManager::OnNewRawData(const unsigned char* data, const size_t length)
     {
+        if (processing_strand)
+        {
+            queued_packets.fetch_add(1);
+            // Only copy of the packet data, straight from the receive buffer
+            processing_strand->strand.post([this, packet = std::vector<unsigned char>(data, data + length)]() mutable
+                {
+                    ProcessOnStrand(packet);
+                });
+            return;
+        }
+
         {
             std::unique_lock<std::mutex> lck(mutex_process);
-            packets_to_process.push(packet);
+            // Only copy of the packet data, straight from the receive buffer
+            packets_to_process.emplace(data, data + length);
         }
         process_condition.notify_all();
     }
 
+    void NetworkManager::ProcessOnStrand(std::vector<unsigned char>& packet)
+    {
+        const bool last_queued = queued_packets.fetch_sub(1) == 1;
+        if (state == ConnectionState::None)
+        {
+            return;
+        }
+
+        // The thread is shared with other connections
+        const ScopedLoaderId scoped_loader_id(loader_id);
+        try
+        {
+            if (packet.size() > 0)
+            {
+                if (capture_writer)
+                {
+                    capture_writer->Write(state, packet);
+                }
+                ProcessRawPacket(std::move(packet), processing_strand->decompressed_packet);
+            }
+            // Nothing left to read for now, don't keep already received packets waiting
+            if (last_queued)
+            {
+                DispatchPendingPackets(0);
+            }
+        }
+        // The thread is shared with other connections, so only this one is stopped
+        catch (const std::exception& e)
+        {
+            LOG_FATAL("Exception: " << e.what());
+            state = ConnectionState::None;
+        }
+        catch (...)
+        {
+            LOG_FATAL("Unknown exception");
+            state = ConnectionState::None;
+        }
+    }
+
     void NetworkManager::Handle(Message& msg)
     {
 
@@ -422,6 +812,12 @@ namespace Botcraft
 
     void NetworkManager::Handle(ClientboundHelloPacket& msg)
     {
+        // Replayed packets are already decrypted
+        if (replay_reader)
+        {
+            return;
+        }
+
         if (authentifier == nullptr)
         {
             throw std::runtime_error("Authentication asked while no valid account has been provided, make sure to connect with a valid Microsoft Account, or to a server with online-mode=false");
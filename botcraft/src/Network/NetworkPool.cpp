@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "botcraft/Network/IOContext.hpp"
+#include "botcraft/Network/NetworkPool.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft
+{
+    NetworkPool::NetworkPool(const size_t num_threads) : next_context(0)
+    {
+        const size_t num_contexts = num_threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : num_threads;
+        contexts.reserve(num_contexts);
+        for (size_t i = 0; i < num_contexts; ++i)
+        {
+            std::shared_ptr<IOContext> context = std::make_shared<IOContext>();
+            context->work = std::make_unique<asio::io_service::work>(context->io_service);
+            IOContext* context_ptr = context.get();
+            context->thread = std::thread([context_ptr, i]()
+                {
+                    Logger::GetInstance().RegisterThread("NetworkPool - " + std::to_string(i));
+                    while (true)
+                    {
+                        try
+                        {
+                            context_ptr->io_service.run();
+                            return;
+                        }
+                        catch (const std::exception& e)
+                        {
+                            LOG_ERROR("Exception in network pool thread: " << e.what());
+                        }
+                        catch (...)
+                        {
+                            LOG_ERROR("Unknown exception in network pool thread");
+                        }
+                    }
+                });
+            contexts.push_back(context);
+        }
+    }
+
+    NetworkPool::~NetworkPool()
+    {
+        for (std::shared_ptr<IOContext>& context : contexts)
+        {
+            // Let the remaining handlers complete, then stop the thread
+            context->work.reset();
+        }
+        for (std::shared_ptr<IOContext>& context : contexts)
+        {
+            if (context->thread.joinable())
+            {
+                Logger::GetInstance().UnregisterThread(context->thread.get_id());
+                context->thread.join();
+            }
+        }
+    }
+
+    size_t NetworkPool::GetNumThreads() const
+    {
+        return contexts.size();
+    }
+
+    std::shared_ptr<IOContext> NetworkPool::GetNextContext()
+    {
+        return contexts[next_context.fetch_add(1, std::memory_order_relaxed) % contexts.size()];
+    }
+} // Botcraft
@@ -0,0 +1,151 @@
+#include <array>
+#include <stdexcept>
+
+#include "botcraft/Network/PacketCapture.hpp"
+
+#include "protocolCraft/BinaryReadWrite.hpp"
+
+using namespace ProtocolCraft;
+
+namespace Botcraft
+{
+    namespace
+    {
+        constexpr std::array<char, 4> capture_magic = { 'B', 'C', 'A', 'P' };
+        constexpr int capture_format_version = 1;
+        /// @brief Max size of a recorded packet, a packet length is a VarInt of at most 3 bytes on the wire
+        constexpr long long int max_packet_size = 2097151;
+
+        /// @brief Read a VarLong directly from a file, as records are read one by one
+        /// @return False if the end of the file is reached before the first byte, throw if it's reached in the middle of the value
+        bool ReadVarLong(std::ifstream& file, long long int& output)
+        {
+            unsigned long long int value = 0;
+            for (int i = 0; i < 10; ++i)
+            {
+                const int c = file.get();
+                if (c == std::ifstream::traits_type::eof())
+                {
+                    if (i == 0)
+                    {
+                        return false;
+                    }
+                    throw std::runtime_error("Truncated packet capture");
+                }
+                value |= static_cast<unsigned long long int>(c & 0x7F) << (7 * i);
+                if ((c & 0x80) == 0)
+                {
+                    output = static_cast<long long int>(value);
+                    return true;
+                }
+            }
+            throw std::runtime_error("Invalid VarLong in packet capture");
+        }
+    }
+
+    PacketCaptureWriter::PacketCaptureWriter(const std::string& path)
+    {
+        file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Can't open packet capture file " + path);
+        }
+
+        std::vector<unsigned char> header(capture_magic.begin(), capture_magic.end());
+        WriteData<VarInt>(capture_format_version, header);
+        WriteData<VarInt>(PROTOCOL_VERSION, header);
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+        start = std::chrono::steady_clock::now();
+        last_timestamp_us = 0;
+    }
+
+    void PacketCaptureWriter::Write(const ConnectionState state, const std::vector<unsigned char>& data)
+    {
+        const long long int timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::scoped_lock<std::mutex> lock(file_mutex);
+        // Timestamps are stored as delta with the previous record to keep them small
+        record_buffer.clear();
+        WriteData<VarLong>(timestamp_us - last_timestamp_us, record_buffer);
+        WriteData<VarInt>(static_cast<int>(state), record_buffer);
+        WriteData<VarInt>(static_cast<int>(data.size()), record_buffer);
+        file.write(reinterpret_cast<const char*>(record_buffer.data()), record_buffer.size());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        last_timestamp_us = timestamp_us;
+    }
+
+    PacketCaptureReader::PacketCaptureReader(const std::string& path)
+    {
+        file.open(path, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Can't open packet capture file " + path);
+        }
+
+        std::array<char, 4> magic;
+        long long int format_version = 0;
+        long long int protocol_version = 0;
+        if (!file.read(magic.data(), magic.size()) || magic != capture_magic ||
+            !ReadVarLong(file, format_version) || !ReadVarLong(file, protocol_version))
+        {
+            throw std::runtime_error(path + " is not a valid packet capture file");
+        }
+        if (format_version != capture_format_version)
+        {
+            throw std::runtime_error("Unsupported packet capture format version " + std::to_string(format_version));
+        }
+        if (protocol_version != PROTOCOL_VERSION)
+        {
+            throw std::runtime_error("Packet capture recorded with protocol version " + std::to_string(protocol_version) + ", expected " + std::to_string(PROTOCOL_VERSION));
+        }
+
+        last_timestamp_us = 0;
+    }
+
+    bool PacketCaptureReader::Read(CapturedPacket& packet)
+    {
+        long long int timestamp_delta = 0;
+        if (!ReadVarLong(file, timestamp_delta))
+        {
+            return false;
+        }
+
+        long long int state = 0;
+        long long int size = 0;
+        if (!ReadVarLong(file, state) || !ReadVarLong(file, size))
+        {
+            throw std::runtime_error("Truncated packet capture");
+        }
+
+        // Check the record before allocating anything, so a corrupted file can't trigger a huge allocation
+        if (timestamp_delta < 0)
+        {
+            throw std::runtime_error("Corrupted packet capture, invalid timestamp delta " + std::to_string(timestamp_delta));
+        }
+        if (state < static_cast<int>(ConnectionState::None) ||
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+            state > static_cast<int>(ConnectionState::Configuration))
+#else
+            state > static_cast<int>(ConnectionState::Play))
+#endif
+        {
+            throw std::runtime_error("Corrupted packet capture, invalid connection state " + std::to_string(state));
+        }
+        if (size < 0 || size > max_packet_size)
+        {
+            throw std::runtime_error("Corrupted packet capture, invalid packet size " + std::to_string(size));
+        }
+
+        packet.data.resize(static_cast<size_t>(size));
+        if (!file.read(reinterpret_cast<char*>(packet.data.data()), size))
+        {
+            throw std::runtime_error("Truncated packet capture");
+        }
+
+        last_timestamp_us += timestamp_delta;
+        packet.timestamp_us = last_timestamp_us;
+        packet.state = static_cast<ConnectionState>(static_cast<int>(state));
+        return true;
+    }
+} // Botcraft
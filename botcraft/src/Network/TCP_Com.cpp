@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <asio/connect.hpp>
 #include <asio/write.hpp>
 #include <asio/ip/udp.hpp>
@@ -7,6 +10,7 @@
 
 #include "botcraft/Network/DNS/DNSMessage.hpp"
 #include "botcraft/Network/DNS/DNSSrvData.hpp"
+#include "botcraft/Network/IOContext.hpp"
 #include "botcraft/Network/TCP_Com.hpp"
 #ifdef USE_ENCRYPTION
 #include "botcraft/Network/AESEncrypter.hpp"
@@ -17,15 +21,24 @@
 
 namespace Botcraft
 {
+    /// @brief Min free space in the receive buffer for each read
+    static constexpr size_t min_read_size = 64 * 1024;
+    /// @brief Max size of a packet, its length is a VarInt of at most 3 bytes
+    static constexpr int max_packet_length = 2097151;
+    /// @brief Receive buffers bigger than this are released once the big packet has been processed
+    static constexpr size_t max_kept_buffer_size = 4 * min_read_size;
+
     TCP_Com::TCP_Com(const std::string& address,
-        std::function<void(const std::vector<unsigned char>&)> callback)
-        : socket(io_service)
+        std::function<void(const unsigned char*, const size_t)> callback,
+        const std::shared_ptr<IOContext>& context_)
+        : context(context_ != nullptr ? context_ : std::make_shared<IOContext>()), owns_context(context_ == nullptr),
+        socket(context->io_service), input_start(0), input_end(0), pending_packet_size(0)
     {
         NewPacketCallback = callback;
 
         SetIPAndPortFromAddress(address);
 
-        asio::ip::tcp::resolver resolver(io_service);
+        asio::ip::tcp::resolver resolver(context->io_service);
         asio::ip::tcp::resolver::query query(ip, std::to_string(port));
         asio::ip::tcp::resolver::iterator iterator = resolver.resolve(query);
         LOG_INFO("Trying to connect to " << ip << ":" << port);
@@ -33,17 +46,41 @@ namespace Botcraft
             std::bind(&TCP_Com::handle_connect, this,
             std::placeholders::_1));
 
-        thread_com = std::thread([&] { io_service.run(); });
-        Logger::GetInstance().RegisterThread(thread_com.get_id(), "NetworkIOService");
+        if (owns_context)
+        {
+            context->thread = std::thread([this] { context->io_service.run(); });
+            Logger::GetInstance().RegisterThread(context->thread.get_id(), "NetworkIOService");
+        }
     }
 
     TCP_Com::~TCP_Com()
     {
-        if (thread_com.joinable())
+        if (owns_context)
+        {
+            if (context->thread.joinable())
+            {
+                Logger::GetInstance().UnregisterThread(context->thread.get_id());
+                context->thread.join();
+            }
+            return;
+        }
+
+        if (std::this_thread::get_id() == context->thread.get_id())
         {
-            Logger::GetInstance().UnregisterThread(thread_com.get_id());
-            thread_com.join();
+            LOG_ERROR("TCP_Com destroyed from its own network thread, pending handlers may still use it");
+            do_close();
+            return;
         }
+
+        // Closing the socket queues the completion of all its pending operations,
+        // so once a handler posted after the close has run, none of them is left
+        std::promise<void> closed;
+        context->io_service.post([this, &closed]()
+            {
+                do_close();
+                context->io_service.post([&closed]() { closed.set_value(); });
+            });
+        closed.get_future().wait();
     }
 
     void TCP_Com::SendPacket(const std::vector<unsigned char>& msg)
@@ -56,14 +93,14 @@ namespace Botcraft
         if (encrypter != nullptr)
         {
             std::vector<unsigned char> encrypted = encrypter->Encrypt(sized_packet);
-            io_service.post(std::bind(&TCP_Com::do_write, this, encrypted));
+            context->io_service.post(std::bind(&TCP_Com::do_write, this, encrypted));
         }
         else
         {
-            io_service.post(std::bind(&TCP_Com::do_write, this, sized_packet));
+            context->io_service.post(std::bind(&TCP_Com::do_write, this, sized_packet));
         }
 #else
-        io_service.post(std::bind(&TCP_Com::do_write, this, sized_packet));
+        context->io_service.post(std::bind(&TCP_Com::do_write, this, sized_packet));
 #endif
     }
 
@@ -86,7 +123,7 @@ namespace Botcraft
 
     void TCP_Com::close()
     {
-        io_service.post(std::bind(&TCP_Com::do_close, this));
+        context->io_service.post(std::bind(&TCP_Com::do_close, this));
     }
 
     void TCP_Com::handle_connect(const asio::error_code& error)
@@ -94,9 +131,7 @@ namespace Botcraft
         if (!error)
         {
             LOG_INFO("Connection to server established.");
-            socket.async_read_some(asio::buffer(read_msg.data(), read_msg.size()),
-                std::bind(&TCP_Com::handle_read, this,
-                std::placeholders::_1, std::placeholders::_2));
+            do_read();
         }
         else
         {
@@ -104,39 +139,59 @@ namespace Botcraft
         }
     }
 
-    void TCP_Com::handle_read(const asio::error_code& error, std::size_t bytes_transferred)
+    void TCP_Com::do_read()
     {
-        if (!error)
+        // Free space needed after the received bytes, enough to get
+        // the whole pending packet in one read if its size is known
+        const size_t pending = input_end - input_start;
+        const size_t required = std::max(min_read_size, pending_packet_size > pending ? pending_packet_size - pending : 0);
+        if (input_buffer.size() > max_kept_buffer_size && pending + required <= max_kept_buffer_size)
         {
-#ifdef USE_ENCRYPTION
-            if (encrypter != nullptr)
+            // Don't keep the memory used by a big packet for the rest of the connection
+            std::vector<unsigned char> smaller_buffer(pending + required);
+            std::memcpy(smaller_buffer.data(), input_buffer.data() + input_start, pending);
+            input_buffer.swap(smaller_buffer);
+            input_start = 0;
+            input_end = pending;
+        }
+        else if (input_buffer.size() - input_end < required)
+        {
+            // Move the incomplete packet to the front, only growing the buffer if that's not enough
+            if (input_start > 0)
             {
-                std::vector<unsigned char> decrypted(bytes_transferred);
-                std::copy_n(read_msg.begin(), bytes_transferred, decrypted.data());
-                decrypted = encrypter->Decrypt(decrypted);
-                for (int i = 0; i < decrypted.size(); ++i)
-                {
-                    input_msg.push_back(decrypted[i]);
-                }
+                std::memmove(input_buffer.data(), input_buffer.data() + input_start, pending);
+                input_start = 0;
+                input_end = pending;
             }
-            else
+            if (input_buffer.size() - input_end < required)
             {
-                for (int i = 0; i < bytes_transferred; ++i)
-                {
-                    input_msg.push_back(read_msg[i]);
-                }
+                input_buffer.resize(input_end + required);
             }
-#else
-            for (int i = 0; i < bytes_transferred; ++i)
+        }
+
+        socket.async_read_some(asio::buffer(input_buffer.data() + input_end, input_buffer.size() - input_end),
+            std::bind(&TCP_Com::handle_read, this,
+            std::placeholders::_1, std::placeholders::_2));
+    }
+
+    void TCP_Com::handle_read(const asio::error_code& error, std::size_t bytes_transferred)
+    {
+        if (!error)
+        {
+#ifdef USE_ENCRYPTION
+            if (encrypter != nullptr)
             {
-                input_msg.push_back(read_msg[i]);
+                encrypter->DecryptInPlace(input_buffer.data() + input_end, bytes_transferred);
             }
 #endif
+            input_end += bytes_transferred;
+            pending_packet_size = 0;
 
-            while (input_msg.size() != 0)
+            // Slice all complete packets directly from the receive buffer
+            while (input_start < input_end)
             {
-                std::vector<unsigned char>::const_iterator read_iter = input_msg.begin();
-                size_t max_length = input_msg.size();
+                std::vector<unsigned char>::const_iterator read_iter = input_buffer.cbegin() + input_start;
+                size_t max_length = input_end - input_start;
                 int packet_length;
                 try
                 {
@@ -146,25 +201,36 @@ namespace Botcraft
                 {
                     break;
                 }
-                const int bytes_read = static_cast<int>(std::distance<std::vector<unsigned char>::const_iterator>(input_msg.begin(), read_iter));
-                std::vector<unsigned char> data_packet;
+                const size_t bytes_read = (input_end - input_start) - max_length;
 
-                if (packet_length > 0 && input_msg.size() >= bytes_read + packet_length)
+                // Checked before anything is allocated for the packet, as the length comes straight from the server
+                if (packet_length <= 0 || packet_length > max_packet_length)
                 {
-                    data_packet = std::vector<unsigned char>(input_msg.begin() + bytes_read, input_msg.begin() + bytes_read + packet_length);
+                    LOG_ERROR("Invalid packet length received (" << packet_length << "), closing connection");
+                    do_close();
+                    return;
+                }
 
-                    NewPacketCallback(data_packet);
-                    input_msg.erase(input_msg.begin(), input_msg.begin() + bytes_read + packet_length);
+                if (max_length >= static_cast<size_t>(packet_length))
+                {
+                    NewPacketCallback(input_buffer.data() + input_start + bytes_read, static_cast<size_t>(packet_length));
+                    input_start += bytes_read + packet_length;
                 }
                 else
                 {
+                    pending_packet_size = bytes_read + packet_length;
                     break;
                 }
             }
 
-            socket.async_read_some(asio::buffer(read_msg.data(), read_msg.size()),
-                std::bind(&TCP_Com::handle_read, this,
-                std::placeholders::_1, std::placeholders::_2));
+            // Everything has been consumed, start again from the beginning of the buffer
+            if (input_start == input_end)
+            {
+                input_start = 0;
+                input_end = 0;
+            }
+
+            do_read();
         }
         else
         {
@@ -246,7 +312,7 @@ namespace Botcraft
 
         // If port is unknown we first try a SRV DNS lookup
         LOG_INFO("Performing SRV DNS lookup on " << "_minecraft._tcp." << address << " to find an endpoint");
-        asio::ip::udp::socket udp_socket(io_service);
+        asio::ip::udp::socket udp_socket(context->io_service);
 
         // Create the query
         DNSMessage query;
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#include "botcraft/Utilities/EpochReclamation.hpp"
+
+namespace Botcraft::Utilities
+{
+    namespace
+    {
+        /// @brief Epoch published by one reading thread, 0 if not reading.
+        /// Aligned on a cache line so readers don't share any written memory
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<unsigned long long int> epoch = 0;
+            std::atomic<bool> in_use = false;
+            ReaderSlot* next = nullptr;
+        };
+
+        std::atomic<unsigned long long int> global_epoch = 1;
+        /// @brief Slots are never freed, only reused when their thread exits
+        std::atomic<ReaderSlot*> slots_head = nullptr;
+
+        ReaderSlot* AcquireSlot()
+        {
+            for (ReaderSlot* slot = slots_head.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+            {
+                bool expected = false;
+                if (!slot->in_use.load(std::memory_order_relaxed) &&
+                    slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return slot;
+                }
+            }
+
+            ReaderSlot* slot = new ReaderSlot();
+            slot->in_use.store(true, std::memory_order_relaxed);
+            slot->next = slots_head.load(std::memory_order_relaxed);
+            while (!slots_head.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+            {
+
+            }
+            return slot;
+        }
+
+        struct ThreadReader
+        {
+            ~ThreadReader()
+            {
+                if (slot != nullptr)
+                {
+                    slot->epoch.store(0, std::memory_order_release);
+                    slot->in_use.store(false, std::memory_order_release);
+                }
+            }
+
+            ReaderSlot* slot = nullptr;
+            size_t depth = 0;
+        };
+
+        thread_local ThreadReader thread_reader;
+    }
+
+    EpochReadGuard::EpochReadGuard()
+    {
+        ThreadReader& reader = thread_reader;
+        if (reader.depth++ > 0)
+        {
+            return;
+        }
+        if (reader.slot == nullptr)
+        {
+            reader.slot = AcquireSlot();
+        }
+        // seq_cst so the epoch is visible to writers before any shared pointer is loaded
+        reader.slot->epoch.store(global_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    }
+
+    EpochReadGuard::~EpochReadGuard()
+    {
+        ThreadReader& reader = thread_reader;
+        if (--reader.depth == 0)
+        {
+            reader.slot->epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    unsigned long long int RetireEpoch()
+    {
+        return global_epoch.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    unsigned long long int GetOldestReadEpoch()
+    {
+        unsigned long long int oldest = global_epoch.load(std::memory_order_seq_cst);
+        for (const ReaderSlot* slot = slots_head.load(std::memory_order_acquire); slot != nullptr; slot = slot->next)
+        {
+            const unsigned long long int epoch = slot->epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0)
+            {
+                oldest = std::min(oldest, epoch);
+            }
+        }
+        return oldest;
+    }
+} // Botcraft::Utilities
@@ -0,0 +1,190 @@
+#include <stdexcept>
+
+#if _WIN32
+#include <Windows.h>
+#undef Yield // Because there is a Yield macro in Windows API somewhere :]
+#else
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
+
+#include "botcraft/Utilities/Fiber.hpp"
+#include "botcraft/Utilities/Logger.hpp"
+
+namespace Botcraft::Utilities
+{
+    namespace
+    {
+        thread_local Fiber* current_fiber = nullptr;
+    }
+
+    struct Fiber::Impl
+    {
+        std::function<void()> function;
+        bool started = false;
+        bool finished = false;
+
+#if _WIN32
+        LPVOID fiber = nullptr;
+        LPVOID caller = nullptr;
+
+        static void WINAPI Entry(LPVOID parameter)
+        {
+            Impl* impl = static_cast<Impl*>(parameter);
+            impl->Run();
+            SwitchToFiber(impl->caller);
+        }
+#else
+        ucontext_t context;
+        ucontext_t caller;
+        /// @brief Whole mapping, including the guard page at its lowest address
+        void* mapping = nullptr;
+        size_t mapping_size = 0;
+
+        // Also called if the Fiber constructor throws after the mapping is created
+        ~Impl()
+        {
+            if (mapping != nullptr)
+            {
+                munmap(mapping, mapping_size);
+            }
+        }
+
+        // makecontext only takes int arguments, so the pointer is split in two
+        static void Entry(const unsigned int high, const unsigned int low)
+        {
+            Impl* impl = reinterpret_cast<Impl*>((static_cast<unsigned long long int>(high) << 32) | static_cast<unsigned long long int>(low));
+            impl->Run();
+            setcontext(&impl->caller);
+        }
+#endif
+
+        void Run()
+        {
+            try
+            {
+                function();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception escaping from a fiber: " << e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR("Unknown exception escaping from a fiber");
+            }
+            finished = true;
+        }
+    };
+
+    Fiber::Fiber(std::function<void()>&& function_, const size_t stack_size) : impl(std::make_unique<Impl>())
+    {
+        impl->function = std::move(function_);
+
+#if _WIN32
+        // Fiber stacks can't be provided on Windows, but the one allocated by the
+        // system is only reserved here, committed on demand, and already has a guard page
+        impl->fiber = CreateFiberEx(0, stack_size, 0, &Impl::Entry, impl.get());
+        if (impl->fiber == nullptr)
+        {
+            throw std::runtime_error("Error creating fiber");
+        }
+#else
+        // The stack grows downward, so the PROT_NONE guard page is placed below it
+        // to turn a stack overflow into a segfault instead of a heap corruption
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t usable_size = (stack_size + page_size - 1) / page_size * page_size;
+        impl->mapping_size = usable_size + page_size;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_STACK
+        flags |= MAP_STACK;
+#endif
+        void* const mapping = mmap(nullptr, impl->mapping_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            throw std::runtime_error("Error allocating fiber stack");
+        }
+        impl->mapping = mapping;
+        if (mprotect(impl->mapping, page_size, PROT_NONE) != 0)
+        {
+            throw std::runtime_error("Error creating fiber stack guard page");
+        }
+        if (getcontext(&impl->context) != 0)
+        {
+            throw std::runtime_error("Error creating fiber");
+        }
+        impl->context.uc_stack.ss_sp = static_cast<char*>(impl->mapping) + page_size;
+        impl->context.uc_stack.ss_size = usable_size;
+        impl->context.uc_link = nullptr;
+        const unsigned long long int ptr = reinterpret_cast<unsigned long long int>(impl.get());
+        makecontext(&impl->context, reinterpret_cast<void(*)()>(&Impl::Entry), 2, static_cast<unsigned int>(ptr >> 32), static_cast<unsigned int>(ptr & 0xFFFFFFFF));
+#endif
+    }
+
+    Fiber::~Fiber()
+    {
+        if (impl->started && !impl->finished)
+        {
+            LOG_WARNING("Destroying a suspended fiber, objects on its stack won't be destroyed");
+        }
+#if _WIN32
+        DeleteFiber(impl->fiber);
+#endif
+    }
+
+    bool Fiber::Resume()
+    {
+        if (impl->finished)
+        {
+            return true;
+        }
+
+        // Fibers can be resumed from another fiber
+        Fiber* const previous = current_fiber;
+        current_fiber = this;
+        impl->started = true;
+#if _WIN32
+        if (!IsThreadAFiber())
+        {
+            ConvertThreadToFiber(nullptr);
+        }
+        impl->caller = GetCurrentFiber();
+        SwitchToFiber(impl->fiber);
+#else
+        swapcontext(&impl->caller, &impl->context);
+#endif
+        current_fiber = previous;
+
+        return impl->finished;
+    }
+
+    void Fiber::Suspend()
+    {
+        Fiber* const fiber = current_fiber;
+        if (fiber == nullptr)
+        {
+            throw std::runtime_error("Fiber::Suspend called outside of a fiber");
+        }
+#if _WIN32
+        SwitchToFiber(fiber->impl->caller);
+#else
+        swapcontext(&fiber->impl->context, &fiber->impl->caller);
+#endif
+    }
+
+    Fiber* Fiber::GetCurrent()
+    {
+        return current_fiber;
+    }
+
+    bool Fiber::IsStarted() const
+    {
+        return impl->started;
+    }
+
+    bool Fiber::IsFinished() const
+    {
+        return impl->finished;
+    }
+} // Botcraft::Utilities
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "protocolCraft/enums.hpp"
 
@@ -10,4 +12,37 @@ namespace ProtocolCraft
 
     std::shared_ptr<Message> CreateClientboundMessage(const ConnectionState state, const int id);
     std::shared_ptr<Message> CreateServerboundMessage(const ConnectionState state, const int id);
+
+    /// @brief Reusable storage for parsed messages. One instance of each
+    /// message type is created the first time it's needed, then reset
+    /// and given back for all the following messages of the same type,
+    /// so parsing a packet doesn't allocate a new message each time.
+    /// A message from the pool is only valid until the next request for
+    /// the same type, use Clone to keep it longer. Not thread-safe
+    class MessagePool
+    {
+    public:
+        MessagePool();
+        ~MessagePool();
+
+        MessagePool(const MessagePool&) = delete;
+        MessagePool& operator=(const MessagePool&) = delete;
+
+        /// @brief Get a default constructed clientbound message
+        /// @param state Current connection state
+        /// @param id Packet id
+        /// @return A pointer to the message owned by the pool, nullptr if id is unknown in this state
+        Message* GetClientboundMessage(const ConnectionState state, const int id);
+
+        /// @brief Get a default constructed serverbound message
+        /// @param state Current connection state
+        /// @param id Packet id
+        /// @return A pointer to the message owned by the pool, nullptr if id is unknown in this state
+        Message* GetServerboundMessage(const ConnectionState state, const int id);
+
+    private:
+        static constexpr size_t num_states = 5;
+        std::array<std::vector<std::unique_ptr<Message> >, num_states> clientbound_messages;
+        std::array<std::vector<std::unique_ptr<Message> >, num_states> serverbound_messages;
+    };
 } //ProtocolCraft
@@ -3,69 +3,185 @@
 #include "protocolCraft/AllClientboundMessages.hpp"
 #include "protocolCraft/AllServerboundMessages.hpp"
 
-#include "protocolCraft/Utilities/PrivateTemplates.hpp"
+#include <algorithm>
+#include <tuple>
+#include <utility>
 
 namespace ProtocolCraft
 {
     namespace
     {
+        struct MessageConstructors
+        {
+            std::shared_ptr<Message>(*make_shared)() = nullptr;
+            std::unique_ptr<Message>(*make_unique)() = nullptr;
+            void(*reset)(Message&) = nullptr;
+        };
+
+        template<typename T>
+        std::shared_ptr<Message> MakeShared()
+        {
+            return std::make_shared<T>();
+        }
+
+        template<typename T>
+        std::unique_ptr<Message> MakeUnique()
+        {
+            return std::make_unique<T>();
+        }
+
+        template<typename T>
+        void Reset(Message& msg)
+        {
+            static_cast<T&>(msg) = T();
+        }
+
+        /// @brief Constructors of all the messages of a tuple, indexed by packet id and built at compile time
+        template<typename TypesTuple>
+        class JumpTable
+        {
+        private:
+            template<size_t... I>
+            static constexpr size_t GetSize(std::index_sequence<I...>)
+            {
+                int max_id = -1;
+                ((max_id = std::max(max_id, static_cast<int>(std::tuple_element_t<I, TypesTuple>::packet_id))), ...);
+                return static_cast<size_t>(max_id + 1);
+            }
+
+        public:
+            static constexpr size_t size = GetSize(std::make_index_sequence<std::tuple_size_v<TypesTuple>>{});
+
+        private:
+            template<size_t... I>
+            static constexpr std::array<MessageConstructors, size> Build(std::index_sequence<I...>)
+            {
+                std::array<MessageConstructors, size> output{};
+                ((output[std::tuple_element_t<I, TypesTuple>::packet_id] = MessageConstructors{
+                    &MakeShared<std::tuple_element_t<I, TypesTuple> >,
+                    &MakeUnique<std::tuple_element_t<I, TypesTuple> >,
+                    &Reset<std::tuple_element_t<I, TypesTuple> >
+                }), ...);
+                return output;
+            }
+
+        public:
+            static constexpr std::array<MessageConstructors, size> table = Build(std::make_index_sequence<std::tuple_size_v<TypesTuple>>{});
+        };
+
         template<typename TypesTuple>
-        std::shared_ptr<Message> AutomaticMessageFactory(const int id)
+        const MessageConstructors* GetConstructors(const int id)
+        {
+            using Table = JumpTable<TypesTuple>;
+            if (id < 0 || static_cast<size_t>(id) >= Table::size || Table::table[id].make_shared == nullptr)
+            {
+                return nullptr;
+            }
+            return &Table::table[id];
+        }
+
+        const MessageConstructors* GetClientboundConstructors(const ConnectionState state, const int id)
+        {
+            switch (state)
+            {
+            case ConnectionState::Login:
+                return GetConstructors<AllClientboundLoginMessages>(id);
+            case ConnectionState::Status:
+                return GetConstructors<AllClientboundStatusMessages>(id);
+            case ConnectionState::Play:
+                return GetConstructors<AllClientboundPlayMessages>(id);
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+            case ConnectionState::Configuration:
+                return GetConstructors<AllClientboundConfigurationMessages>(id);
+#endif
+            default:
+                return nullptr;
+            }
+        }
+
+        const MessageConstructors* GetServerboundConstructors(const ConnectionState state, const int id)
+        {
+            switch (state)
+            {
+            case ConnectionState::Handshake:
+                return GetConstructors<AllServerboundHandshakeMessages>(id);
+            case ConnectionState::Login:
+                return GetConstructors<AllServerboundLoginMessages>(id);
+            case ConnectionState::Status:
+                return GetConstructors<AllServerboundStatusMessages>(id);
+            case ConnectionState::Play:
+                return GetConstructors<AllServerboundPlayMessages>(id);
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+            case ConnectionState::Configuration:
+                return GetConstructors<AllServerboundConfigurationMessages>(id);
+#endif
+            default:
+                return nullptr;
+            }
+        }
+
+        Message* GetPooledMessage(std::vector<std::unique_ptr<Message> >& messages, const MessageConstructors* constructors, const int id)
         {
-            std::shared_ptr<Message> output = nullptr;
-
-            loop < std::tuple_size<TypesTuple>{} > (
-                [&](auto i)
-                {
-                    using TupleElement = std::tuple_element_t<i, TypesTuple>;
-                    if (id == TupleElement::packet_id)
-                    {
-                        output = std::make_shared<TupleElement>();
-                    }
-                }
-            );
-
-            return output;
+            if (constructors == nullptr)
+            {
+                return nullptr;
+            }
+
+            if (messages.size() <= static_cast<size_t>(id))
+            {
+                messages.resize(id + 1);
+            }
+
+            std::unique_ptr<Message>& msg = messages[id];
+            if (msg == nullptr)
+            {
+                msg = constructors->make_unique();
+            }
+            else
+            {
+                constructors->reset(*msg);
+            }
+            return msg.get();
         }
     }
 
     std::shared_ptr<Message> CreateClientboundMessage(const ConnectionState state, const int id)
     {
-        switch (state)
+        const MessageConstructors* constructors = GetClientboundConstructors(state, id);
+        return constructors == nullptr ? nullptr : constructors->make_shared();
+    }
+
+    std::shared_ptr<Message> CreateServerboundMessage(const ConnectionState state, const int id)
+    {
+        const MessageConstructors* constructors = GetServerboundConstructors(state, id);
+        return constructors == nullptr ? nullptr : constructors->make_shared();
+    }
+
+    MessagePool::MessagePool()
+    {
+
+    }
+
+    MessagePool::~MessagePool()
+    {
+
+    }
+
+    Message* MessagePool::GetClientboundMessage(const ConnectionState state, const int id)
+    {
+        if (state == ConnectionState::None)
         {
-        case ConnectionState::Login:
-            return AutomaticMessageFactory<AllClientboundLoginMessages>(id);
-        case ConnectionState::Status:
-            return AutomaticMessageFactory<AllClientboundStatusMessages>(id);
-        case ConnectionState::Play:
-            return AutomaticMessageFactory<AllClientboundPlayMessages>(id);
-#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
-        case ConnectionState::Configuration:
-            return AutomaticMessageFactory<AllClientboundConfigurationMessages>(id);
-#endif
-        default:
             return nullptr;
         }
+        return GetPooledMessage(clientbound_messages[static_cast<size_t>(state)], GetClientboundConstructors(state, id), id);
     }
 
-    std::shared_ptr<Message> CreateServerboundMessage(const ConnectionState state, const int id)
+    Message* MessagePool::GetServerboundMessage(const ConnectionState state, const int id)
     {
-        switch (state)
+        if (state == ConnectionState::None)
         {
-        case ConnectionState::Handshake:
-            return AutomaticMessageFactory<AllServerboundHandshakeMessages>(id);
-        case ConnectionState::Login:
-            return AutomaticMessageFactory<AllServerboundLoginMessages>(id);
-        case ConnectionState::Status:
-            return AutomaticMessageFactory<AllServerboundStatusMessages>(id);
-        case ConnectionState::Play:
-            return AutomaticMessageFactory<AllServerboundPlayMessages>(id);
-#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
-        case ConnectionState::Configuration:
-            return AutomaticMessageFactory<AllServerboundConfigurationMessages>(id);
-#endif
-        default:
             return nullptr;
         }
+        return GetPooledMessage(serverbound_messages[static_cast<size_t>(state)], GetServerboundConstructors(state, id), id);
     }
 }
@@ -3,6 +3,10 @@
 
 #include <botcraft/Game/World/Blockstate.hpp>
 
+#include <iterator>
+#include <set>
+#include <vector>
+
 using namespace Botcraft;
 
 TEST_CASE("Testing mining time calculation")
@@ -176,3 +180,112 @@ TEST_CASE("Testing mining time calculation")
         REQUIRE_THAT(blockstate.GetMiningTimeSeconds(ToolType::Hoe, ToolMaterial::Diamond), Catch::Matchers::WithinAbs(0.0, 0.04));
     }
 }
+
+TEST_CASE("Colliders at position")
+{
+    Model model;
+    model.SetColliders({
+        AABB(Vector3<double>(0.5, 0.25, 0.5), Vector3<double>(0.5, 0.25, 0.5)),
+        AABB(Vector3<double>(0.5, 0.75, 0.25), Vector3<double>(0.125, 0.25, 0.25))
+    });
+
+    BlockstateProperties blockstate_properties;
+    blockstate_properties.name = "collider_test";
+
+    SECTION("no offset")
+    {
+        Blockstate blockstate(blockstate_properties, model);
+
+        const Position pos(3, 64, -7);
+        const std::set<AABB> expected = blockstate.GetCollidersAtPos(pos);
+        REQUIRE(expected.size() == 2);
+
+        std::vector<AABB> colliders;
+        blockstate.ForEachColliderAtPos(pos, [&](const AABB& c) { colliders.push_back(c); });
+        CHECK(colliders == std::vector<AABB>(expected.begin(), expected.end()));
+        CHECK(colliders[0] == AABB(Vector3<double>(3.5, 64.25, -6.5), Vector3<double>(0.5, 0.25, 0.5)));
+    }
+
+    SECTION("horizontal offset")
+    {
+        blockstate_properties.horizontal_offset = 0.25f;
+        Blockstate blockstate(blockstate_properties, model);
+
+        for (int x = -20; x < 20; ++x)
+        {
+            for (int z = -20; z < 20; ++z)
+            {
+                const Position pos(x, 12, z);
+                const std::set<AABB> expected = blockstate.GetCollidersAtPos(pos);
+
+                std::vector<AABB> colliders;
+                blockstate.CopyCollidersAtPos(pos, std::back_inserter(colliders));
+                REQUIRE(colliders == std::vector<AABB>(expected.begin(), expected.end()));
+            }
+        }
+    }
+
+    SECTION("early stop")
+    {
+        Blockstate blockstate(blockstate_properties, model);
+
+        int num_calls = 0;
+        blockstate.ForEachColliderAtPos(Position(0, 0, 0), [&](const AABB&) { num_calls += 1; return false; });
+        CHECK(num_calls == 1);
+    }
+}
+
+#if !USE_GUI
+TEST_CASE("Binary serialization")
+{
+    Model model;
+    model.SetColliders({
+        AABB(Vector3<double>(0.5, 0.25, 0.5), Vector3<double>(0.5, 0.25, 0.5)),
+        AABB(Vector3<double>(0.5, 0.75, 0.25), Vector3<double>(0.125, 0.25, 0.25))
+    });
+
+    BlockstateProperties blockstate_properties;
+    blockstate_properties.name = "binary_test";
+    blockstate_properties.solid = true;
+    blockstate_properties.climbable = true;
+    blockstate_properties.hardness = 50.0f;
+    blockstate_properties.friction = 0.98f;
+    blockstate_properties.horizontal_offset = 0.125f;
+    blockstate_properties.variables = { "facing=north", "half=top" };
+    blockstate_properties.best_tools = {
+        BestTool {
+            ToolType::Pickaxe, //tool_type
+            ToolMaterial::Diamond, //tool_material
+            1.0f //multiplier
+        }
+    };
+    const Blockstate blockstate(blockstate_properties, model);
+
+    std::vector<unsigned char> data;
+    Blockstate::WriteModelsBinary(data);
+    blockstate.WriteBinary(data);
+
+    ProtocolCraft::ReadIterator iter = data.begin();
+    size_t length = data.size();
+    const std::vector<size_t> models_mapping = Blockstate::ReadModelsBinary(iter, length);
+    const Blockstate read_blockstate(iter, length, models_mapping);
+    CHECK(length == 0);
+
+    CHECK(read_blockstate.GetId() == blockstate.GetId());
+    CHECK(read_blockstate.GetName() == "binary_test");
+    CHECK(read_blockstate.IsSolid());
+    CHECK(read_blockstate.IsClimbable());
+    CHECK_FALSE(read_blockstate.IsAir());
+    CHECK(read_blockstate.GetFriction() == blockstate.GetFriction());
+    CHECK(read_blockstate.GetVariableValue("facing") == "north");
+    CHECK(read_blockstate.GetVariableValue("half") == "top");
+    CHECK(read_blockstate.GetWalkability() == blockstate.GetWalkability());
+    CHECK(read_blockstate.GetNumModels() == 1);
+    REQUIRE_THAT(read_blockstate.GetMiningTimeSeconds(ToolType::Pickaxe, ToolMaterial::Diamond), Catch::Matchers::WithinAbs(9.4, 0.04));
+    for (int x = -5; x < 5; ++x)
+    {
+        const Position pos(x, 64, 2 * x);
+        CHECK(read_blockstate.GetCollidersAtPos(pos) == blockstate.GetCollidersAtPos(pos));
+    }
+}
+#endif
@@ -0,0 +1,204 @@
+#ifdef USE_COMPRESSION
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <botcraft/Network/Compression.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+    /// @brief Packet-like data, mostly repeating palette indices as in chunk packets
+    std::vector<unsigned char> MakePacketData(const size_t size, std::mt19937& rng)
+    {
+        std::vector<unsigned char> data(size);
+        unsigned char value = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (rng() % 8 == 0)
+            {
+                value = static_cast<unsigned char>(rng() % 16);
+            }
+            data[i] = value;
+        }
+        return data;
+    }
+
+    /// @brief Stream of packets with the size distribution of a chunk loading burst
+    std::vector<std::vector<unsigned char> > MakePacketStream()
+    {
+        std::mt19937 rng(42);
+        std::vector<std::vector<unsigned char> > packets;
+        for (int i = 0; i < 200; ++i)
+        {
+            // One chunk packet for every 4 small packets (entity updates, block changes...)
+            packets.push_back(MakePacketData(i % 5 == 0 ? 20000 + rng() % 40000 : 256 + rng() % 512, rng));
+        }
+        return packets;
+    }
+
+    /// @brief Decompression as it was done before persistent streams: new stream, scratch buffer and growing output for each packet
+    std::vector<unsigned char> DecompressWithNewStream(const std::vector<unsigned char>& compressed)
+    {
+        std::vector<unsigned char> decompressed_data;
+        decompressed_data.reserve(compressed.size());
+        std::vector<unsigned char> buffer(64 * 1024);
+
+        z_stream strm;
+        memset(&strm, 0, sizeof(strm));
+        strm.next_in = const_cast<unsigned char*>(compressed.data());
+        strm.avail_in = static_cast<unsigned int>(compressed.size());
+        inflateInit(&strm);
+        int res = Z_OK;
+        while (res == Z_OK)
+        {
+            strm.next_out = buffer.data();
+            strm.avail_out = static_cast<unsigned int>(buffer.size());
+            res = inflate(&strm, Z_NO_FLUSH);
+            decompressed_data.insert(decompressed_data.end(), buffer.begin(), buffer.end() - strm.avail_out);
+        }
+        inflateEnd(&strm);
+        return decompressed_data;
+    }
+}
+
+TEST_CASE("Compression round trip")
+{
+    const std::vector<std::vector<unsigned char> > packets = MakePacketStream();
+
+    // Same thread, so all iterations reuse the same streams
+    for (const std::vector<unsigned char>& packet : packets)
+    {
+        std::vector<unsigned char> compressed = { 0x01, 0x02 };
+        Compress(packet, compressed);
+        // Compressed data are appended
+        REQUIRE(compressed.size() > 2);
+        CHECK(compressed[0] == 0x01);
+        CHECK(compressed[1] == 0x02);
+
+        CHECK(Decompress(compressed, 2, packet.size()) == packet);
+
+        const std::vector<unsigned char> prefix = DecompressPrefix(compressed, 2, 5);
+        CHECK(prefix == std::vector<unsigned char>(packet.begin(), packet.begin() + 5));
+    }
+}
+
+TEST_CASE("Decompression with wrong size")
+{
+    std::mt19937 rng(0);
+    const std::vector<unsigned char> packet = MakePacketData(1000, rng);
+    std::vector<unsigned char> compressed;
+    Compress(packet, compressed);
+
+    CHECK_THROWS_AS(Decompress(compressed, 0, packet.size() - 1), std::runtime_error);
+    CHECK_THROWS_AS(Decompress(compressed, 0, packet.size() + 1), std::runtime_error);
+    // Stream is still usable after an error
+    CHECK(Decompress(compressed, 0, packet.size()) == packet);
+}
+
+TEST_CASE("Packet decompression size check")
+{
+    std::mt19937 rng(1);
+    const std::vector<unsigned char> packet = MakePacketData(1000, rng);
+    std::vector<unsigned char> compressed;
+    Compress(packet, compressed);
+    std::vector<unsigned char> buffer;
+
+    SECTION("valid size")
+    {
+        DecompressPacket(compressed.data(), compressed.size(), static_cast<int>(packet.size()), 256, buffer);
+        CHECK(buffer == packet);
+    }
+
+    SECTION("invalid size")
+    {
+        CHECK_THROWS_AS(DecompressPacket(compressed.data(), compressed.size(), -1, 256, buffer), std::runtime_error);
+        CHECK_THROWS_AS(DecompressPacket(compressed.data(), compressed.size(), 100, 256, buffer), std::runtime_error);
+        CHECK_THROWS_AS(DecompressPacket(compressed.data(), compressed.size(), 64 * 1024 * 1024, 256, buffer), std::runtime_error);
+        // Rejected before allocating anything
+        CHECK(buffer.capacity() == 0);
+    }
+
+    SECTION("big buffer released")
+    {
+        const std::vector<unsigned char> big_packet = MakePacketData(4 * 1024 * 1024, rng);
+        unsigned long big_compressed_size = compressBound(static_cast<unsigned long>(big_packet.size()));
+        std::vector<unsigned char> big_compressed(big_compressed_size);
+        compress2(big_compressed.data(), &big_compressed_size, big_packet.data(), static_cast<unsigned long>(big_packet.size()), Z_DEFAULT_COMPRESSION);
+
+        DecompressPacket(big_compressed.data(), big_compressed_size, static_cast<int>(big_packet.size()), 256, buffer);
+        CHECK(buffer == big_packet);
+
+        DecompressPacket(compressed.data(), compressed.size(), static_cast<int>(packet.size()), 256, buffer);
+        CHECK(buffer == packet);
+        CHECK(buffer.capacity() < big_packet.size());
+    }
+}
+
+TEST_CASE("Packet stream compression", "[.benchmark]")
+{
+    const std::vector<std::vector<unsigned char> > packets = MakePacketStream();
+    std::vector<std::vector<unsigned char> > compressed_packets;
+    for (const std::vector<unsigned char>& packet : packets)
+    {
+        compressed_packets.emplace_back();
+        Compress(packet, compressed_packets.back());
+    }
+
+    BENCHMARK("Decompress, new stream per packet")
+    {
+        size_t total = 0;
+        for (const std::vector<unsigned char>& compressed : compressed_packets)
+        {
+            total += DecompressWithNewStream(compressed).size();
+        }
+        return total;
+    };
+
+    BENCHMARK("Decompress, persistent stream")
+    {
+        std::vector<unsigned char> buffer;
+        size_t total = 0;
+        for (size_t i = 0; i < compressed_packets.size(); ++i)
+        {
+            buffer.resize(packets[i].size());
+            Decompress(compressed_packets[i].data(), compressed_packets[i].size(), buffer.data(), buffer.size());
+            total += buffer.size();
+        }
+        return total;
+    };
+
+    BENCHMARK("Compress, new stream per packet")
+    {
+        size_t total = 0;
+        for (const std::vector<unsigned char>& packet : packets)
+        {
+            unsigned long compressed_size = compressBound(static_cast<unsigned long>(packet.size()));
+            std::vector<unsigned char> compressed(compressed_size);
+            compress2(compressed.data(), &compressed_size, packet.data(), static_cast<unsigned long>(packet.size()), Z_DEFAULT_COMPRESSION);
+            total += compressed_size;
+        }
+        return total;
+    };
+
+    BENCHMARK("Compress, persistent stream")
+    {
+        std::vector<unsigned char> compressed;
+        size_t total = 0;
+        for (const std::vector<unsigned char>& packet : packets)
+        {
+            compressed.clear();
+            Compress(packet, compressed);
+            total += compressed.size();
+        }
+        return total;
+    };
+}
+#endif
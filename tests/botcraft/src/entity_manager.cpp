@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <botcraft/Game/Entities/EntityManager.hpp>
+#include <botcraft/Game/Entities/EntityPredictor.hpp>
+#include <botcraft/Game/Entities/entities/Entity.hpp>
+#include <botcraft/Game/Physics/AABB.hpp>
+
+#include <protocolCraft/Messages/Play/Clientbound/ClientboundTeleportEntityPacket.hpp>
+#if PROTOCOL_VERSION == 755 /* 1.17 */
+#include <protocolCraft/Messages/Play/Clientbound/ClientboundRemoveEntityPacket.hpp>
+#else
+#include <protocolCraft/Messages/Play/Clientbound/ClientboundRemoveEntitiesPacket.hpp>
+#endif
+
+using namespace Botcraft;
+
+namespace
+{
+    std::shared_ptr<Entity> AddEntity(EntityManager& entity_manager, const int id, const EntityType type, const Vector3<double>& position)
+    {
+        std::shared_ptr<Entity> entity = Entity::CreateEntity(type);
+        entity->SetEntityID(id);
+        entity->SetPosition(position);
+        entity_manager.AddEntity(entity);
+        return entity;
+    }
+
+    std::vector<int> GetIds(const std::vector<std::shared_ptr<Entity>>& entities)
+    {
+        std::vector<int> ids;
+        for (const auto& e : entities)
+        {
+            ids.push_back(e->GetEntityID());
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+}
+
+TEST_CASE("Entity spatial queries")
+{
+    EntityManager entity_manager;
+    AddEntity(entity_manager, 1, EntityType::Zombie, Vector3<double>(0.5, 64.0, 0.5));
+    AddEntity(entity_manager, 2, EntityType::Pig, Vector3<double>(3.0, 64.0, 0.0));
+    AddEntity(entity_manager, 3, EntityType::Zombie, Vector3<double>(-7.5, 64.0, 2.0));
+    AddEntity(entity_manager, 4, EntityType::Zombie, Vector3<double>(100.0, 70.0, -100.0));
+
+    SECTION("Radius")
+    {
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 4.0)) == std::vector<int>{ 1, 2 });
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 10.0)) == std::vector<int>{ 1, 2, 3 });
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 10.0, EntityType::Zombie)) == std::vector<int>{ 1, 3 });
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 1000.0)) == std::vector<int>{ 1, 2, 3, 4 });
+    }
+
+    SECTION("AABB")
+    {
+        CHECK(GetIds(entity_manager.QueryAABB(AABB(Vector3<double>(0.0, 64.0, 0.0), Vector3<double>(8.0, 1.0, 1.0)))) == std::vector<int>{ 1, 2 });
+        CHECK(GetIds(entity_manager.QueryAABB(AABB(Vector3<double>(100.0, 70.0, -100.0), Vector3<double>(0.5)))) == std::vector<int>{ 4 });
+    }
+
+    SECTION("Nearest")
+    {
+        const std::vector<std::shared_ptr<Entity>> nearest = entity_manager.Nearest(Vector3<double>(90.0, 64.0, -90.0), 2);
+        REQUIRE(nearest.size() == 2);
+        CHECK(nearest[0]->GetEntityID() == 4);
+        CHECK(nearest[1]->GetEntityID() == 2);
+
+        const std::vector<std::shared_ptr<Entity>> nearest_pig = entity_manager.Nearest(Vector3<double>(-10.0, 64.0, 0.0), 5, EntityType::Pig);
+        REQUIRE(nearest_pig.size() == 1);
+        CHECK(nearest_pig[0]->GetEntityID() == 2);
+
+        CHECK(entity_manager.Nearest(Vector3<double>(0.0, 64.0, 0.0), 0).empty());
+    }
+
+    SECTION("Teleport")
+    {
+        ProtocolCraft::ClientboundTeleportEntityPacket msg;
+        msg.SetId_(1);
+        msg.SetX(100.0);
+        msg.SetY(70.0);
+        msg.SetZ(-99.0);
+        static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(msg);
+
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 4.0)) == std::vector<int>{ 2 });
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(100.0, 70.0, -100.0), 2.0)) == std::vector<int>{ 1, 4 });
+    }
+
+    SECTION("Remove")
+    {
+#if PROTOCOL_VERSION == 755 /* 1.17 */
+        ProtocolCraft::ClientboundRemoveEntityPacket msg;
+        msg.SetEntityId(2);
+#else
+        ProtocolCraft::ClientboundRemoveEntitiesPacket msg;
+        msg.SetEntityIds({ 2 });
+#endif
+        static_cast<ProtocolCraft::Handler&>(entity_manager).Handle(msg);
+
+        CHECK(entity_manager.GetEntity(2) == nullptr);
+        CHECK(GetIds(entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 10.0)) == std::vector<int>{ 1, 3 });
+    }
+}
+
+TEST_CASE("Entity queries in a crowd", "[.benchmark]")
+{
+    EntityManager entity_manager;
+    // Crowded mob farm around the player and a few entities further away
+    for (int i = 0; i < 1000; ++i)
+    {
+        AddEntity(entity_manager, i + 1, i % 3 == 0 ? EntityType::Pig : EntityType::Zombie, Vector3<double>((i * 37) % 64 - 32.0, 64.0 + i % 5, (i * 53) % 64 - 32.0));
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        AddEntity(entity_manager, 2000 + i, EntityType::Zombie, Vector3<double>(i * 20.0, 64.0, -i * 20.0));
+    }
+
+    BENCHMARK("Radius")
+    {
+        return entity_manager.QueryRadius(Vector3<double>(0.0, 64.0, 0.0), 4.0);
+    };
+
+    BENCHMARK("Nearest")
+    {
+        return entity_manager.Nearest(Vector3<double>(0.0, 64.0, 0.0), 5, EntityType::Zombie);
+    };
+
+    BENCHMARK("Linear scan")
+    {
+        std::vector<std::shared_ptr<Entity>> output;
+        auto entities = entity_manager.GetEntities();
+        for (const auto& [id, entity] : *entities)
+        {
+            if ((entity->GetPosition() - Vector3<double>(0.0, 64.0, 0.0)).SqrNorm() <= 16.0)
+            {
+                output.push_back(entity);
+            }
+        }
+        return output;
+    };
+}
+
+TEST_CASE("Entity factory")
+{
+    SECTION("Pooled entities")
+    {
+        const Entity::PoolStats initial_stats = Entity::GetPoolStats();
+        std::shared_ptr<Entity> item = Entity::CreateEntity(EntityType::ItemEntity);
+        REQUIRE(item != nullptr);
+        CHECK(item->GetType() == EntityType::ItemEntity);
+        const Entity::PoolStats created_stats = Entity::GetPoolStats();
+        CHECK(created_stats.num_in_use == initial_stats.num_in_use + 1);
+        CHECK(created_stats.num_in_use <= created_stats.num_blocks);
+        {
+            std::weak_ptr<Entity> weak_item = item;
+            item.reset();
+            CHECK(weak_item.expired());
+            // The block is shared with the control block, so it's still in use until the last weak_ptr is gone
+            CHECK(Entity::GetPoolStats().num_in_use == created_stats.num_in_use);
+        }
+        CHECK(Entity::GetPoolStats().num_in_use == initial_stats.num_in_use);
+
+        // Freed memory is reused by the next entity of the same type
+        item = Entity::CreateEntity(EntityType::ItemEntity);
+        const Entity::PoolStats recreated_stats = Entity::GetPoolStats();
+        CHECK(recreated_stats.num_reused == created_stats.num_reused + 1);
+        CHECK(recreated_stats.num_blocks == created_stats.num_blocks);
+        CHECK(item->GetPosition() == Vector3<double>(0.0, 0.0, 0.0));
+    }
+
+    SECTION("Equipment")
+    {
+        std::shared_ptr<Entity> zombie = Entity::CreateEntity(EntityType::Zombie);
+        CHECK(zombie->GetEquipment(EquipmentSlot::Helmet).IsEmptySlot());
+        CHECK(zombie->GetEquipments().size() == 6);
+
+        ProtocolCraft::Slot helmet;
+#if PROTOCOL_VERSION < 350 /* < 1.13 */
+        helmet.SetBlockId(1);
+#elif PROTOCOL_VERSION < 402 /* < 1.13.2 */
+        helmet.SetItemId(1);
+#elif PROTOCOL_VERSION < 766 /* < 1.20.5 */
+        helmet.SetPresent(true);
+        helmet.SetItemId(1);
+#else
+        helmet.SetItemId(1);
+#endif
+        helmet.SetItemCount(1);
+        zombie->SetEquipment(EquipmentSlot::Helmet, helmet);
+        CHECK(!zombie->GetEquipment(EquipmentSlot::Helmet).IsEmptySlot());
+        CHECK(zombie->GetEquipment(EquipmentSlot::MainHand).IsEmptySlot());
+        CHECK(zombie->GetEquipments().at(EquipmentSlot::Helmet).GetItemCount() == 1);
+    }
+}
+
+TEST_CASE("Entity prediction")
+{
+    EntityPredictor predictor;
+    const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    const auto tick = [&](const double n)
+    {
+        return t0 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(n * EntityPredictor::tick_duration);
+    };
+
+    SECTION("Gravity and drag")
+    {
+        std::shared_ptr<Entity> item = Entity::CreateEntity(EntityType::ItemEntity);
+        predictor.AddEntity(1, EntityPredictor::GetMotionModel(*item), Vector3<double>(0.0, 64.0, 0.0), Vector3<double>(0.1, 0.2, 0.0), t0);
+
+        const Vector3<double> position = predictor.PredictPosition(1, tick(1.0)).value();
+        CHECK_THAT(position.x, Catch::Matchers::WithinAbs(0.1, 1e-6));
+        CHECK_THAT(position.y, Catch::Matchers::WithinAbs(64.16, 1e-6));
+        const Vector3<double> velocity = predictor.PredictVelocity(1, tick(1.0)).value();
+        CHECK_THAT(velocity.x, Catch::Matchers::WithinAbs(0.098, 1e-6));
+        CHECK_THAT(velocity.y, Catch::Matchers::WithinAbs(0.16 * 0.98, 1e-6));
+
+        // Falls after a few ticks, and extrapolation stops after max_prediction_ticks
+        CHECK(predictor.PredictPosition(1, tick(10.0)).value().y < 64.0);
+        const Vector3<double> last_position = predictor.PredictPosition(1, tick(EntityPredictor::max_prediction_ticks)).value();
+        const Vector3<double> far_position = predictor.PredictPosition(1, tick(1000.0)).value();
+        CHECK_THAT(far_position.x, Catch::Matchers::WithinAbs(last_position.x, 1e-9));
+        CHECK_THAT(far_position.y, Catch::Matchers::WithinAbs(last_position.y, 1e-9));
+        CHECK_THAT(far_position.z, Catch::Matchers::WithinAbs(last_position.z, 1e-9));
+    }
+
+    SECTION("Velocity estimate")
+    {
+        std::shared_ptr<Entity> zombie = Entity::CreateEntity(EntityType::Zombie);
+        predictor.AddEntity(1, EntityPredictor::GetMotionModel(*zombie), Vector3<double>(0.0, 64.0, 0.0), Vector3<double>(0.0), t0);
+        // Not moving, on ground, doesn't fall
+        CHECK(predictor.PredictPosition(1, tick(5.0)).value() == Vector3<double>(0.0, 64.0, 0.0));
+
+        // Walking at 0.2 block/tick
+        for (int i = 1; i < 8; ++i)
+        {
+            predictor.UpdatePosition(1, Vector3<double>(0.6 * i, 64.0, 0.0), true, tick(3.0 * i));
+        }
+        const Vector3<double> velocity = predictor.PredictVelocity(1, tick(21.0)).value();
+        CHECK_THAT(velocity.x, Catch::Matchers::WithinAbs(0.2, 0.01));
+        CHECK(velocity.y == 0.0);
+        CHECK_THAT(predictor.PredictPosition(1, tick(24.0)).value().x, Catch::Matchers::WithinAbs(4.8, 0.05));
+    }
+
+    SECTION("Batch")
+    {
+        const EntityPredictor::MotionModel model{ 0.08, 1.0, 0.98, 1.0 };
+        for (int i = 0; i < 10; ++i)
+        {
+            predictor.AddEntity(i, model, Vector3<double>(i, 64.0, 0.0), Vector3<double>(0.1 * i, 0.1, 0.0), t0);
+        }
+        predictor.RemoveEntity(3);
+        predictor.SetVelocity(5, Vector3<double>(0.0, 0.5, 0.0), tick(2.0));
+        REQUIRE(predictor.GetNumEntities() == 9);
+
+        const std::vector<std::pair<int, Vector3<double>>> positions = predictor.PredictPositions(tick(4.0));
+        REQUIRE(positions.size() == 9);
+        for (const auto& [id, position] : positions)
+        {
+            CHECK(id != 3);
+            const Vector3<double> expected = predictor.PredictPosition(id, tick(4.0)).value();
+            CHECK_THAT(position.x, Catch::Matchers::WithinAbs(expected.x, 1e-9));
+            CHECK_THAT(position.y, Catch::Matchers::WithinAbs(expected.y, 1e-9));
+            CHECK_THAT(position.z, Catch::Matchers::WithinAbs(expected.z, 1e-9));
+        }
+        CHECK(!predictor.PredictPosition(3, tick(4.0)).has_value());
+    }
+
+    SECTION("Interception")
+    {
+        predictor.AddEntity(1, EntityPredictor::MotionModel{}, Vector3<double>(10.0, 64.0, 0.0), Vector3<double>(0.0, 0.0, 0.2), t0);
+        const Vector3<double> target = predictor.PredictInterception(1, Vector3<double>(0.0, 64.0, 0.0), 2.0, t0).value();
+        // Projectile takes ~5 ticks to get there, aim ~1 block ahead
+        CHECK_THAT(target.z, Catch::Matchers::WithinAbs(1.0, 0.05));
+        CHECK_THAT(target.x, Catch::Matchers::WithinAbs(10.0, 1e-9));
+    }
+}
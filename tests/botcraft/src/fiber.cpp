@@ -0,0 +1,190 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <botcraft/AI/BehaviourExecutor.hpp>
+#include <botcraft/Utilities/Fiber.hpp>
+
+using namespace Botcraft;
+using namespace Botcraft::Utilities;
+
+namespace
+{
+    struct DestructionCounter
+    {
+        DestructionCounter(int& counter_) : counter(counter_) {}
+        ~DestructionCounter() { counter += 1; }
+        int& counter;
+    };
+
+    // Use ~64 KiB of stack per call
+    size_t DeepRecursion(const size_t depth)
+    {
+        volatile char frame[64 * 1024];
+        frame[0] = static_cast<char>(depth);
+        frame[sizeof(frame) - 1] = static_cast<char>(depth);
+        return depth == 0 ? frame[0] : DeepRecursion(depth - 1) + frame[sizeof(frame) - 1];
+    }
+}
+
+TEST_CASE("Fiber")
+{
+    SECTION("Suspend and resume")
+    {
+        std::vector<int> steps;
+        Fiber fiber([&]()
+            {
+                CHECK(Fiber::GetCurrent() != nullptr);
+                for (int i = 0; i < 3; ++i)
+                {
+                    steps.push_back(i);
+                    Fiber::Suspend();
+                }
+            });
+        CHECK_FALSE(fiber.IsStarted());
+        CHECK(Fiber::GetCurrent() == nullptr);
+
+        CHECK_FALSE(fiber.Resume());
+        CHECK(steps == std::vector<int>{ 0 });
+        CHECK(fiber.IsStarted());
+        CHECK(Fiber::GetCurrent() == nullptr);
+
+        CHECK_FALSE(fiber.Resume());
+        CHECK_FALSE(fiber.Resume());
+        CHECK(steps == std::vector<int>{ 0, 1, 2 });
+        CHECK(fiber.Resume());
+        CHECK(fiber.IsFinished());
+        // Finished fibers are not run anymore
+        CHECK(fiber.Resume());
+        CHECK(steps.size() == 3);
+    }
+
+    SECTION("Unwinding")
+    {
+        int destroyed = 0;
+        bool stop = false;
+        Fiber fiber([&]()
+            {
+                try
+                {
+                    DestructionCounter counter(destroyed);
+                    while (true)
+                    {
+                        Fiber::Suspend();
+                        if (stop)
+                        {
+                            throw std::runtime_error("stop");
+                        }
+                    }
+                }
+                catch (const std::runtime_error&)
+                {
+
+                }
+            });
+        fiber.Resume();
+        fiber.Resume();
+        CHECK(destroyed == 0);
+        stop = true;
+        CHECK(fiber.Resume());
+        CHECK(destroyed == 1);
+    }
+
+    SECTION("Suspend outside of a fiber")
+    {
+        CHECK_THROWS_AS(Fiber::Suspend(), std::runtime_error);
+    }
+
+    SECTION("Deep stack")
+    {
+        // ~4 MiB of stack, more than a thread stack on some platforms
+        size_t result = 0;
+        Fiber fiber([&]()
+            {
+                result = DeepRecursion(64);
+            });
+        CHECK(fiber.Resume());
+        CHECK(result == 64 * 65 / 2);
+    }
+}
+
+TEST_CASE("Behaviour executor")
+{
+    BehaviourExecutor executor(2, std::chrono::milliseconds(1));
+    REQUIRE(executor.GetNumThreads() == 2);
+
+    std::atomic<int> counter = 0;
+    std::thread::id step_thread_id;
+    bool same_thread = true;
+    const size_t id = executor.Add([&]()
+        {
+            if (counter == 0)
+            {
+                step_thread_id = std::this_thread::get_id();
+            }
+            same_thread &= step_thread_id == std::this_thread::get_id();
+            return ++counter < 10;
+        });
+    executor.WaitRemoved(id);
+    CHECK(counter == 10);
+    CHECK(same_thread);
+}
+
+TEST_CASE("Yield", "[.benchmark]")
+{
+    constexpr int num_yields = 1000;
+
+    BENCHMARK("thread + condition variable")
+    {
+        // Same ping-pong as TemplatedBehaviourClient Yield/BehaviourStep
+        std::mutex mutex;
+        std::condition_variable cond_var;
+        bool tree_turn = false;
+        int count = 0;
+        std::thread tree_thread([&]()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                for (int i = 0; i < num_yields; ++i)
+                {
+                    cond_var.wait(lock, [&]() { return tree_turn; });
+                    count += 1;
+                    tree_turn = false;
+                    cond_var.notify_all();
+                }
+            });
+        for (int i = 0; i < num_yields; ++i)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            tree_turn = true;
+            cond_var.notify_all();
+            cond_var.wait(lock, [&]() { return !tree_turn; });
+        }
+        tree_thread.join();
+        return count;
+    };
+
+    BENCHMARK("fiber")
+    {
+        int count = 0;
+        Fiber fiber([&]()
+            {
+                for (int i = 0; i < num_yields; ++i)
+                {
+                    count += 1;
+                    Fiber::Suspend();
+                }
+            });
+        while (!fiber.Resume())
+        {
+
+        }
+        return count;
+    };
+}
@@ -0,0 +1,155 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <botcraft/Network/NetworkManager.hpp>
+#include <botcraft/Network/PacketCapture.hpp>
+
+#include <protocolCraft/AllClientboundMessages.hpp>
+
+using namespace Botcraft;
+using namespace ProtocolCraft;
+
+namespace
+{
+    class KeepAliveCounter : public Handler
+    {
+    public:
+        std::vector<long long int> ids;
+
+    protected:
+        using Handler::Handle;
+        virtual void Handle(ClientboundKeepAlivePacket& msg) override
+        {
+            ids.push_back(msg.GetId_());
+        }
+    };
+
+    std::vector<unsigned char> GetPacketData(const Message& msg)
+    {
+        std::vector<unsigned char> data;
+        msg.Write(data);
+        return data;
+    }
+}
+
+TEST_CASE("Packet capture")
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "botcraft_test_capture.bin").string();
+
+    SECTION("Write/Read")
+    {
+        {
+            PacketCaptureWriter writer(path);
+            writer.Write(ConnectionState::Login, { 0x01, 0x02, 0x03 });
+            writer.Write(ConnectionState::Play, {});
+            writer.Write(ConnectionState::Play, std::vector<unsigned char>(1000, 0x42));
+        }
+
+        PacketCaptureReader reader(path);
+        CapturedPacket packet;
+
+        REQUIRE(reader.Read(packet));
+        CHECK(packet.state == ConnectionState::Login);
+        CHECK(packet.data == std::vector<unsigned char>{ 0x01, 0x02, 0x03 });
+        const long long int first_timestamp = packet.timestamp_us;
+
+        REQUIRE(reader.Read(packet));
+        CHECK(packet.state == ConnectionState::Play);
+        CHECK(packet.data.empty());
+        CHECK(packet.timestamp_us >= first_timestamp);
+
+        REQUIRE(reader.Read(packet));
+        CHECK(packet.data == std::vector<unsigned char>(1000, 0x42));
+
+        CHECK_FALSE(reader.Read(packet));
+    }
+
+    SECTION("Replay")
+    {
+        {
+            PacketCaptureWriter writer(path);
+            writer.Write(ConnectionState::Login, GetPacketData(ClientboundGameProfilePacket()));
+#if PROTOCOL_VERSION > 763 /* > 1.20.1 */
+            writer.Write(ConnectionState::Configuration, GetPacketData(ClientboundFinishConfigurationPacket()));
+#endif
+            for (int i = 0; i < 100; ++i)
+            {
+                ClientboundKeepAlivePacket keep_alive;
+                keep_alive.SetId_(i);
+                writer.Write(ConnectionState::Play, GetPacketData(keep_alive));
+            }
+        }
+
+        KeepAliveCounter counter;
+        std::shared_ptr<NetworkManager> network_manager = NetworkManager::FromCapture(path, "replay");
+        network_manager->AddHandler(&counter);
+        network_manager->StartReplay(false);
+
+        const auto start = std::chrono::steady_clock::now();
+        while (network_manager->GetConnectionState() != ConnectionState::None &&
+            std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        network_manager->Close();
+
+        REQUIRE(counter.ids.size() == 100);
+        for (int i = 0; i < 100; ++i)
+        {
+            CHECK(counter.ids[i] == i);
+        }
+    }
+
+    SECTION("Invalid file")
+    {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "not a capture";
+        }
+        CHECK_THROWS_AS(PacketCaptureReader(path), std::runtime_error);
+    }
+
+    SECTION("Truncated record")
+    {
+        {
+            PacketCaptureWriter writer(path);
+            writer.Write(ConnectionState::Play, { 0x01, 0x02, 0x03 });
+            writer.Write(ConnectionState::Play, std::vector<unsigned char>(1000, 0x42));
+        }
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+
+        PacketCaptureReader reader(path);
+        CapturedPacket packet;
+        REQUIRE(reader.Read(packet));
+        CHECK_THROWS_AS(reader.Read(packet), std::runtime_error);
+    }
+
+    SECTION("Corrupted record")
+    {
+        {
+            PacketCaptureWriter writer(path);
+            writer.Write(ConnectionState::Play, { 0x01, 0x02, 0x03 });
+        }
+        {
+            // Timestamp delta 0, Play state, packet size 2^32 - 1
+            std::ofstream file(path, std::ios::binary | std::ios::app);
+            const unsigned char record[] = { 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+            file.write(reinterpret_cast<const char*>(record), sizeof(record));
+        }
+
+        PacketCaptureReader reader(path);
+        CapturedPacket packet;
+        REQUIRE(reader.Read(packet));
+        CHECK_THROWS_AS(reader.Read(packet), std::runtime_error);
+        CHECK(packet.data.capacity() < 1000);
+    }
+
+    std::filesystem::remove(path);
+}
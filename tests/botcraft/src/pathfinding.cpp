@@ -0,0 +1,370 @@
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <botcraft/AI/HierarchicalPathfinder.hpp>
+#include <botcraft/AI/PathfindingEngine.hpp>
+#include <botcraft/Game/World/World.hpp>
+
+using namespace Botcraft;
+
+namespace
+{
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId air_id = { 0,0 };
+    const BlockstateId stone_id = { 1,0 };
+#else
+    const BlockstateId air_id = 0;
+    const BlockstateId stone_id = 1;
+#endif
+
+    /// @brief Load chunks from -num_chunks to num_chunks - 1 with a stone floor at y = 0
+    void CreateFloor(World& world, const int num_chunks)
+    {
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+        const Dimension dimension = Dimension::Overworld;
+#else
+        const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+        world.SetDimensionMinY(dimension, 0);
+        world.SetDimensionHeight(dimension, 256);
+#endif
+        world.SetCurrentDimension(dimension);
+
+        for (int x = -num_chunks; x < num_chunks; ++x)
+        {
+            for (int z = -num_chunks; z < num_chunks; ++z)
+            {
+                world.LoadChunk(x, z, dimension);
+            }
+        }
+        for (int x = -num_chunks * CHUNK_WIDTH; x < num_chunks * CHUNK_WIDTH; ++x)
+        {
+            for (int z = -num_chunks * CHUNK_WIDTH; z < num_chunks * CHUNK_WIDTH; ++z)
+            {
+                world.SetBlock(Position(x, 0, z), stone_id);
+            }
+        }
+    }
+}
+
+TEST_CASE("Pathfinding engine")
+{
+    World world = World(false);
+    CreateFloor(world, 2);
+
+    PathfindingEngine engine;
+
+    SECTION("Walk")
+    {
+        const std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(5, 1, 0), 0, 0, 0, true);
+        REQUIRE(path.size() == 5);
+        CHECK(path.back().first == Position(5, 1, 0));
+        for (size_t i = 0; i < path.size(); ++i)
+        {
+            CHECK(path[i].first == Position(static_cast<int>(i) + 1, 1, 0));
+            CHECK(path[i].second == 1.0f);
+        }
+        CHECK(engine.GetLastVisitCount() > 0);
+    }
+
+    SECTION("Step up")
+    {
+        for (int z = -2 * CHUNK_WIDTH; z < 2 * CHUNK_WIDTH; ++z)
+        {
+            world.SetBlock(Position(3, 1, z), stone_id);
+        }
+        const std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(5, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(5, 1, 0));
+        bool on_wall = false;
+        for (const auto& [pos, height] : path)
+        {
+            on_wall |= pos == Position(3, 2, 0) && height == 2.0f;
+        }
+        CHECK(on_wall);
+    }
+
+    SECTION("Jump over a gap")
+    {
+        for (int z = -2 * CHUNK_WIDTH; z < 2 * CHUNK_WIDTH; ++z)
+        {
+            world.SetBlock(Position(3, 0, z), air_id);
+        }
+
+        // Without jumping, the gap can't be crossed, get as close as possible
+        std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(5, 1, 0), 0, 0, 0, false);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(2, 1, 0));
+
+        path = engine.FindPath(world, true, Position(0, 1, 0), Position(5, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(5, 1, 0));
+    }
+
+    SECTION("Distance criteria")
+    {
+        const std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(10, 1, 0), 3, 2, 2, true);
+        REQUIRE(!path.empty());
+        const Position diff = path.back().first - Position(10, 1, 0);
+        const int dist = std::abs(diff.x) + std::abs(diff.y) + std::abs(diff.z);
+        CHECK(dist <= 3);
+        CHECK(dist >= 2);
+    }
+}
+
+TEST_CASE("Pathfinding path cache")
+{
+    World world = World(false);
+    CreateFloor(world, 2);
+
+    PathfindingEngine engine(PathfindingEngine::default_budget, 4, false);
+    const std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+    REQUIRE(path.size() == 8);
+    CHECK(engine.GetLastVisitCount() > 0);
+
+    SECTION("Same query")
+    {
+        CHECK(engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true) == path);
+        CHECK(engine.GetLastVisitCount() == 0);
+    }
+
+    SECTION("Start on the path")
+    {
+        CHECK(engine.FindPath(world, true, Position(3, 1, 0), Position(8, 1, 0), 0, 0, 0, true) == std::vector<std::pair<Position, float>>(path.begin() + 3, path.end()));
+        CHECK(engine.GetLastVisitCount() == 0);
+    }
+
+    SECTION("Different options")
+    {
+        engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, false);
+        CHECK(engine.GetLastVisitCount() > 0);
+    }
+
+    SECTION("Block changes")
+    {
+        // Far from the path, the cached one is still valid
+        world.SetBlock(Position(20, 1, 20), stone_id);
+        CHECK(engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true) == path);
+        CHECK(engine.GetLastVisitCount() == 0);
+
+        // On the path
+        world.SetBlock(Position(5, 1, 0), stone_id);
+        world.SetBlock(Position(5, 2, 0), stone_id);
+        const std::vector<std::pair<Position, float>> new_path = engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+        CHECK(engine.GetLastVisitCount() > 0);
+        REQUIRE(!new_path.empty());
+        CHECK(new_path.back().first == Position(8, 1, 0));
+        for (const auto& [pos, height] : new_path)
+        {
+            CHECK(pos != Position(5, 1, 0));
+        }
+    }
+}
+
+TEST_CASE("Pathfinding incremental replanning")
+{
+    World world = World(false);
+    CreateFloor(world, 2);
+
+    PathfindingEngine engine(PathfindingEngine::default_budget, 0, true);
+    std::vector<std::pair<Position, float>> path = engine.FindPath(world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+    REQUIRE(path.size() == 8);
+
+    // Move along the path and block it
+    world.SetBlock(Position(5, 1, 0), stone_id);
+    world.SetBlock(Position(5, 2, 0), stone_id);
+    path = engine.FindPath(world, true, Position(2, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+
+    // Same path length as a search from scratch
+    PathfindingEngine reference_engine;
+    const std::vector<std::pair<Position, float>> reference_path = reference_engine.FindPath(world, true, Position(2, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+    REQUIRE(!path.empty());
+    CHECK(path.size() == reference_path.size());
+    CHECK(path.back().first == Position(8, 1, 0));
+    for (const auto& [pos, height] : path)
+    {
+        CHECK(pos != Position(5, 1, 0));
+    }
+}
+
+TEST_CASE("Hierarchical pathfinding")
+{
+    World world = World(false);
+    CreateFloor(world, 6);
+
+    HierarchicalPathfinder pathfinder;
+
+    SECTION("Short path")
+    {
+        const std::vector<std::pair<Position, float>> path = pathfinder.FindPath(world, true, Position(0, 1, 0), Position(5, 1, 0), 0, 0, 0, true);
+        REQUIRE(path.size() == 5);
+        CHECK(pathfinder.GetLastVisitCount() == 0);
+        CHECK(pathfinder.GetNumSections() == 0);
+    }
+
+    SECTION("Long path")
+    {
+        const std::vector<std::pair<Position, float>> path = pathfinder.FindPath(world, true, Position(-90, 1, 0), Position(90, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(90, 1, 0));
+        CHECK(pathfinder.GetLastVisitCount() > 0);
+        CHECK(pathfinder.GetNumSections() > 0);
+        CHECK(!pathfinder.GetLastWaypoints().empty());
+        // Each step is a move to a neighbour block
+        Position previous(-90, 1, 0);
+        for (const auto& [pos, height] : path)
+        {
+            const Position diff = pos - previous;
+            CHECK(std::abs(diff.x) + std::abs(diff.z) <= 2);
+            previous = pos;
+        }
+    }
+
+    SECTION("Block changes")
+    {
+        // Wall with a one block gap
+        for (int z = -6 * CHUNK_WIDTH; z < 6 * CHUNK_WIDTH; ++z)
+        {
+            for (int y = 1; y < 4; ++y)
+            {
+                world.SetBlock(Position(0, y, z), z == 50 ? air_id : stone_id);
+            }
+        }
+        const auto crosses_at = [](const std::vector<std::pair<Position, float>>& path, const int z)
+        {
+            for (const auto& [pos, height] : path)
+            {
+                if (pos.x == 0)
+                {
+                    return pos.z == z;
+                }
+            }
+            return false;
+        };
+
+        std::vector<std::pair<Position, float>> path = pathfinder.FindPath(world, true, Position(-90, 1, 0), Position(90, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(90, 1, 0));
+        CHECK(crosses_at(path, 50));
+
+        // Move the gap, the modified sections are computed again
+        for (int y = 1; y < 4; ++y)
+        {
+            world.SetBlock(Position(0, y, 50), stone_id);
+            world.SetBlock(Position(0, y, -50), air_id);
+        }
+        path = pathfinder.FindPath(world, true, Position(-90, 1, 0), Position(90, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(90, 1, 0));
+        CHECK(crosses_at(path, -50));
+    }
+}
+
+TEST_CASE("Pathfinding with a new world at the same address")
+{
+    // Both worlds are built in the same storage, so the second one has the address of the first one.
+    // They also get the same block revision, only their instance id differ
+    alignas(World) unsigned char storage[sizeof(World)];
+
+    SECTION("Path cache and search tree")
+    {
+        PathfindingEngine engine(PathfindingEngine::default_budget, 4, true);
+
+        World* world = new (storage) World(false);
+        CreateFloor(*world, 2);
+        world->SetBlock(Position(-20, 1, -20), stone_id);
+        world->SetBlock(Position(-20, 2, -20), stone_id);
+        std::vector<std::pair<Position, float>> path = engine.FindPath(*world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+        REQUIRE(path.size() == 8);
+        const unsigned long long int revision = world->GetBlockRevision();
+        world->~World();
+
+        world = new (storage) World(false);
+        CreateFloor(*world, 2);
+        world->SetBlock(Position(4, 1, 0), stone_id);
+        world->SetBlock(Position(4, 2, 0), stone_id);
+        REQUIRE(world->GetBlockRevision() == revision);
+        path = engine.FindPath(*world, true, Position(0, 1, 0), Position(8, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(8, 1, 0));
+        for (const auto& [pos, height] : path)
+        {
+            CHECK(pos != Position(4, 1, 0));
+        }
+        world->~World();
+    }
+
+    SECTION("Hierarchical graph")
+    {
+        HierarchicalPathfinder pathfinder;
+        const auto build_world = [&](const int gap_z)
+        {
+            World* world = new (storage) World(false);
+            CreateFloor(*world, 6);
+            for (int z = -6 * CHUNK_WIDTH; z < 6 * CHUNK_WIDTH; ++z)
+            {
+                for (int y = 1; y < 4; ++y)
+                {
+                    world->SetBlock(Position(0, y, z), z == gap_z ? air_id : stone_id);
+                }
+            }
+            return world;
+        };
+        const auto crosses_at = [](const std::vector<std::pair<Position, float>>& path, const int z)
+        {
+            for (const auto& [pos, height] : path)
+            {
+                if (pos.x == 0)
+                {
+                    return pos.z == z;
+                }
+            }
+            return false;
+        };
+
+        World* world = build_world(50);
+        std::vector<std::pair<Position, float>> path = pathfinder.FindPath(*world, true, Position(-90, 1, 0), Position(90, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(crosses_at(path, 50));
+        const unsigned long long int revision = world->GetBlockRevision();
+        world->~World();
+
+        world = build_world(-50);
+        REQUIRE(world->GetBlockRevision() == revision);
+        path = pathfinder.FindPath(*world, true, Position(-90, 1, 0), Position(90, 1, 0), 0, 0, 0, true);
+        REQUIRE(!path.empty());
+        CHECK(path.back().first == Position(90, 1, 0));
+        CHECK(crosses_at(path, -50));
+        world->~World();
+    }
+}
+
+TEST_CASE("Pathfinding", "[.benchmark]")
+{
+    World world = World(false);
+    CreateFloor(world, 4);
+    // Pillars every few blocks to force a few detours
+    for (int x = -4 * CHUNK_WIDTH; x < 4 * CHUNK_WIDTH; x += 3)
+    {
+        for (int z = -4 * CHUNK_WIDTH; z < 4 * CHUNK_WIDTH; z += 4)
+        {
+            for (int y = 1; y < 4; ++y)
+            {
+                world.SetBlock(Position(x, y, z), stone_id);
+            }
+        }
+    }
+
+    PathfindingEngine engine;
+    BENCHMARK("Cross the area")
+    {
+        return engine.FindPath(world, true, Position(-60, 1, -61), Position(60, 1, 61), 0, 0, 0, true);
+    };
+}
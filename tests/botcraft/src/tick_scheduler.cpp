@@ -0,0 +1,72 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <botcraft/Game/Physics/TickScheduler.hpp>
+
+using namespace Botcraft;
+
+TEST_CASE("Tick scheduler")
+{
+    TickScheduler scheduler(2, std::chrono::milliseconds(10));
+    REQUIRE(scheduler.GetNumThreads() == 2);
+
+    SECTION("Periodic ticks")
+    {
+        std::atomic<int> counter = 0;
+        const size_t id = scheduler.Register([&]() { counter++; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(105));
+        scheduler.Unregister(id);
+        const int ticks = counter;
+        // First tick at registration, then one every 10 ms
+        CHECK(ticks >= 5);
+        CHECK(ticks <= 12);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        CHECK(counter == ticks);
+        CHECK(scheduler.GetStats().ticks == ticks);
+    }
+
+    SECTION("Expensive task")
+    {
+        std::atomic<int> slow_counter = 0;
+        std::atomic<int> fast_counter = 0;
+        const size_t slow_id = scheduler.Register([&]() { slow_counter++; std::this_thread::sleep_for(std::chrono::milliseconds(25)); });
+        const size_t fast_id = scheduler.Register([&]() { fast_counter++; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(105));
+        scheduler.Unregister(slow_id);
+        scheduler.Unregister(fast_id);
+
+        // The slow task is never run twice at the same time and misses ticks,
+        // the other worker keeps running the fast one
+        CHECK(slow_counter <= 5);
+        CHECK(fast_counter >= 5);
+        const TickStats stats = scheduler.GetStats();
+        CHECK(stats.overruns >= slow_counter);
+        CHECK(stats.missed_ticks > 0);
+        CHECK(stats.max_duration >= std::chrono::milliseconds(25));
+    }
+
+    SECTION("Unregister from task")
+    {
+        std::atomic<int> counter = 0;
+        size_t id = 0;
+        std::atomic<bool> registered = false;
+        id = scheduler.Register([&]()
+            {
+                while (!registered)
+                {
+                    std::this_thread::yield();
+                }
+                if (++counter == 3)
+                {
+                    scheduler.Unregister(id);
+                }
+            });
+        registered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        CHECK(counter == 3);
+    }
+}
@@ -1,9 +1,22 @@
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <botcraft/Game/AssetsManager.hpp>
+#include <botcraft/Game/World/ChunkIndex.hpp>
 #include <botcraft/Game/World/World.hpp>
+#include <botcraft/Game/World/WorldView.hpp>
 #include <botcraft/Game/World/Biome.hpp>
 
+#include <protocolCraft/BinaryReadWrite.hpp>
+
 using namespace Botcraft;
 
 TEST_CASE("Add/Remove chunks")
@@ -68,6 +81,158 @@ TEST_CASE("Set/Get blocks")
     REQUIRE(world.GetBlock(Position(0, 0, 0)) != nullptr);
 }
 
+TEST_CASE("Block changes")
+{
+    World world = World(false);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId id = { 1,0 };
+#else
+    const BlockstateId id = 1;
+#endif
+
+    std::vector<std::pair<Position, Position> > changes;
+    const unsigned long long int start_revision = world.GetBlockRevision();
+
+    // Not loaded, nothing changes
+    world.SetBlock(Position(0, 0, 0), id);
+    CHECK(world.GetBlockRevision() == start_revision);
+
+    world.LoadChunk(0, 1, dimension);
+    const unsigned long long int loaded_revision = world.GetBlockRevision();
+    CHECK(loaded_revision > start_revision);
+    world.SetBlock(Position(1, 2, 17), id);
+
+    REQUIRE(world.GetBlockChanges(start_revision, changes));
+    REQUIRE(changes.size() == 2);
+    // Whole chunk column
+    CHECK(changes[0].first.x == 0);
+    CHECK(changes[0].first.z == CHUNK_WIDTH);
+    CHECK(changes[0].second.x == CHUNK_WIDTH - 1);
+    CHECK(changes[0].second.z == 2 * CHUNK_WIDTH - 1);
+    CHECK(changes[0].first.y <= 0);
+    CHECK(changes[0].second.y >= 255);
+    // Single block
+    CHECK(changes[1] == std::make_pair(Position(1, 2, 17), Position(1, 2, 17)));
+
+    REQUIRE(world.GetBlockChanges(loaded_revision, changes));
+    CHECK(changes.size() == 1);
+
+    REQUIRE(world.GetBlockChanges(world.GetBlockRevision(), changes));
+    CHECK(changes.empty());
+
+    // Unknown revision
+    CHECK_FALSE(world.GetBlockChanges(world.GetBlockRevision() + 1, changes));
+
+    // Too many changes, the oldest ones are forgotten
+    for (int i = 0; i < 10000; ++i)
+    {
+        world.SetBlock(Position(i % CHUNK_WIDTH, i / CHUNK_WIDTH % 256, CHUNK_WIDTH), id);
+    }
+    CHECK_FALSE(world.GetBlockChanges(start_revision, changes));
+}
+
+TEST_CASE("Chunk index")
+{
+    ChunkIndex<int> index;
+    for (int x = -20; x < 20; ++x)
+    {
+        for (int z = -20; z < 20; ++z)
+        {
+            CHECK(index.try_emplace({ x, z }, x * 1000 + z).second);
+        }
+    }
+    REQUIRE(index.size() == 1600);
+    CHECK_FALSE(index.insert({ { 0, 0 }, 42 }).second);
+    CHECK(index.at({ 0, 0 }) == 0);
+    CHECK(index.at({ -20, 19 }) == -19981);
+    REQUIRE(index.Get(20, 0) == nullptr);
+    REQUIRE(index.Get(-3, 7) != nullptr);
+    CHECK(*index.Get(-3, 7) == -2993);
+
+    // Erase while iterating
+    for (auto it = index.begin(); it != index.end();)
+    {
+        if (it->first.first % 2 == 0)
+        {
+            index.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    CHECK(index.size() == 800);
+    // Cached lookup must see the erased chunk
+    CHECK(index.Get(-4, 7) == nullptr);
+    REQUIRE(index.Get(-3, 7) != nullptr);
+    CHECK(*index.Get(-3, 7) == -2993);
+
+    size_t count = 0;
+    for (const auto& [coords, value] : index)
+    {
+        CHECK(value == coords.first * 1000 + coords.second);
+        count += 1;
+    }
+    CHECK(count == 800);
+
+    // Reinsert after erase
+    CHECK(index.try_emplace({ -4, 7 }, 12).second);
+    REQUIRE(index.Get(-4, 7) != nullptr);
+    CHECK(*index.Get(-4, 7) == 12);
+    CHECK(index.erase({ -4, 7 }) == 1);
+    CHECK(index.erase({ -4, 7 }) == 0);
+}
+
+#if PROTOCOL_VERSION > 340 /* > 1.12.2 */
+TEST_CASE("Set/Get many blocks in one section")
+{
+    World world = World(false);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+    world.LoadChunk(0, 0, dimension);
+
+    // More than 256 different blockstates forces the section storage
+    // to go through all palette sizes and then to direct storage
+    const int num_ids = 300;
+    for (int i = 0; i < num_ids; ++i)
+    {
+        world.SetBlock(Position(i % CHUNK_WIDTH, (i / (CHUNK_WIDTH * CHUNK_WIDTH)) % SECTION_HEIGHT, (i / CHUNK_WIDTH) % CHUNK_WIDTH), i + 1);
+    }
+
+    for (int i = 0; i < num_ids; ++i)
+    {
+        const Blockstate* block = world.GetBlock(Position(i % CHUNK_WIDTH, (i / (CHUNK_WIDTH * CHUNK_WIDTH)) % SECTION_HEIGHT, (i / CHUNK_WIDTH) % CHUNK_WIDTH));
+        REQUIRE(block != nullptr);
+        CHECK(block->GetId() == i + 1);
+    }
+    // Untouched blocks are still air
+    REQUIRE(world.GetBlock(Position(CHUNK_WIDTH - 1, SECTION_HEIGHT - 1, CHUNK_WIDTH - 1)) != nullptr);
+    CHECK(world.GetBlock(Position(CHUNK_WIDTH - 1, SECTION_HEIGHT - 1, CHUNK_WIDTH - 1))->IsAir());
+}
+#endif
+
 TEST_CASE("Set/Get biomes")
 {
     World world = World(false);
@@ -139,12 +304,8 @@ TEST_CASE("Neighbour chunk update")
 
 TEST_CASE("Shared world")
 {
-    std::thread thread1 = std::thread([]() {});
-    std::thread thread2 = std::thread([]() {});
-    const std::thread::id thread_id1 = thread1.get_id();
-    const std::thread::id thread_id2 = thread2.get_id();
-    thread1.join();
-    thread2.join();
+    const LoaderId loader_id1 = NewLoaderId();
+    const LoaderId loader_id2 = NewLoaderId();
 
     World world = World(true);
 
@@ -163,34 +324,476 @@ TEST_CASE("Shared world")
 
     SECTION("Load same chunk")
     {
-        world.LoadChunk(0, 0, dimension, thread_id1);
-        world.LoadChunk(0, 0, dimension, thread_id2);
+        world.LoadChunk(0, 0, dimension, loader_id1);
+        world.LoadChunk(0, 0, dimension, loader_id2);
         REQUIRE(world.GetChunks()->size() == 1);
 
-        world.UnloadChunk(0, 0, thread_id1);
+        world.UnloadChunk(0, 0, loader_id1);
         REQUIRE(world.GetChunks()->size() == 1);
-        world.UnloadChunk(0, 0, thread_id1);
+        world.UnloadChunk(0, 0, loader_id1);
         REQUIRE(world.GetChunks()->size() == 1);
-        world.UnloadChunk(0, 0, thread_id2);
+        world.UnloadChunk(0, 0, loader_id2);
         REQUIRE(world.GetChunks()->size() == 0);
     }
 
     SECTION("Load different chunks")
     {
-        world.LoadChunk(0, 0, dimension, thread_id1);
-        world.LoadChunk(0, 1, dimension, thread_id2);
+        world.LoadChunk(0, 0, dimension, loader_id1);
+        world.LoadChunk(0, 1, dimension, loader_id2);
         REQUIRE(world.GetChunks()->size() == 2);
 
-        world.UnloadAllChunks(thread_id1);
+        world.UnloadAllChunks(loader_id1);
         REQUIRE(world.GetChunks()->size() == 1);
-        world.UnloadAllChunks(thread_id1);
+        world.UnloadAllChunks(loader_id1);
         REQUIRE(world.GetChunks()->size() == 1);
-        world.UnloadAllChunks(thread_id2);
+        world.UnloadAllChunks(loader_id2);
+        REQUIRE(world.GetChunks()->size() == 0);
+    }
+
+    SECTION("Connections sharing a thread")
+    {
+        {
+            const ScopedLoaderId scoped_loader_id(loader_id1);
+            world.LoadChunk(0, 0, dimension);
+        }
+        {
+            const ScopedLoaderId scoped_loader_id(loader_id2);
+            world.LoadChunk(0, 1, dimension);
+        }
+        REQUIRE(world.GetChunks()->size() == 2);
+
+        world.UnloadAllChunks(loader_id1);
+        REQUIRE(world.GetChunks()->size() == 1);
+        world.UnloadAllChunks(loader_id2);
         REQUIRE(world.GetChunks()->size() == 0);
     }
 }
 
 
+TEST_CASE("Concurrent block reads")
+{
+    World world = World(true);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId air_id = { 0,0 };
+    const BlockstateId id = { 1,0 };
+#else
+    const BlockstateId air_id = 0;
+    const BlockstateId id = 1;
+#endif
+    const Blockstate* air = AssetsManager::getInstance().GetBlockstate(air_id);
+    const Blockstate* block = AssetsManager::getInstance().GetBlockstate(id);
+
+    world.LoadChunk(0, 0, dimension);
+    // Keep the section non empty
+    world.SetBlock(Position(2, 1, 1), id);
+
+    std::atomic<bool> stop = false;
+    std::atomic<int> wrong_reads = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+            {
+                while (!stop)
+                {
+                    const Blockstate* read = world.GetBlock(Position(1, 1, 1));
+                    if (read != air && read != block)
+                    {
+                        wrong_reads += 1;
+                    }
+                    // Chunk is loaded/unloaded, just make sure nothing crashes
+                    world.IsFree(AABB(Vector3<double>(16.5, 1.5, 0.5), Vector3<double>(0.5)), false);
+                }
+            }
+        );
+    }
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        world.SetBlock(Position(1, 1, 1), i % 2 == 0 ? id : air_id);
+        if (i % 100 == 0)
+        {
+            world.LoadChunk(1, 0, dimension);
+            world.SetBlock(Position(16, 1, 0), id);
+        }
+        else if (i % 100 == 50)
+        {
+            world.UnloadChunk(1, 0);
+        }
+    }
+    stop = true;
+    for (std::thread& t : readers)
+    {
+        t.join();
+    }
+
+    CHECK(wrong_reads == 0);
+    // Modifications are visible as soon as they return
+    world.SetBlock(Position(1, 1, 1), id);
+    CHECK(world.GetBlock(Position(1, 1, 1)) == block);
+    world.SetBlock(Position(1, 1, 1), air_id);
+    CHECK(world.GetBlock(Position(1, 1, 1)) == air);
+    world.UnloadChunk(0, 0);
+    CHECK(world.GetBlock(Position(1, 1, 1)) == nullptr);
+}
+
+/// @brief Get a block the way World did before lock-free reads, with the world shared lock
+TEST_CASE("World view")
+{
+    World world = World(true);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId id = { 1,0 };
+#else
+    const BlockstateId id = 1;
+#endif
+    const Blockstate* block = AssetsManager::getInstance().GetBlockstate(id);
+
+    world.LoadChunk(0, 0, dimension);
+    world.LoadChunk(-1, 0, dimension);
+    world.LoadChunk(-1, -1, dimension);
+    world.SetBlock(Position(0, 1, 0), id);
+    world.SetBlock(Position(-1, 1, 0), id);
+    world.SetBlock(Position(-16, 2, -1), id);
+    world.SetBlock(Position(15, 3, 15), id);
+
+    WorldView view(world);
+
+    SECTION("Get blocks")
+    {
+        for (const Position& pos : { Position(0, 1, 0), Position(-1, 1, 0), Position(-16, 2, -1), Position(15, 3, 15), Position(-17, 2, -1), Position(3, 4, 5) })
+        {
+            CHECK(view.GetBlock(pos) == world.GetBlock(pos));
+        }
+        CHECK(view.GetBlock(Position(-1, 1, 0)) == block);
+        CHECK(view.GetBlock(Position(-16, 2, -1)) == block);
+        CHECK(view.IsLoaded(Position(-16, 2, -1)));
+        CHECK_FALSE(view.IsLoaded(Position(16, 2, 0)));
+        CHECK(view.GetBlock(Position(16, 2, 0)) == nullptr);
+        CHECK(view.GetBlock(Position(0, -1, 0)) == nullptr);
+    }
+
+    SECTION("Box iteration")
+    {
+        int num_blocks = 0;
+        int num_solid = 0;
+        view.ForEachBlockInBox(Position(-2, 0, -1), Position(1, 3, 0), [&](const Position& pos, const Blockstate* b)
+            {
+                num_blocks += 1;
+                num_solid += b == block;
+            }
+        );
+        CHECK(num_blocks == 4 * 4 * 2);
+        CHECK(num_solid == 2);
+
+        int num_visited = 0;
+        view.ForEachBlockInBox(Position(-2, 0, -1), Position(1, 3, 0), [&](const Position& pos, const Blockstate* b)
+            {
+                num_visited += 1;
+                return b != block;
+            }
+        );
+        // y = 0 layer (8 blocks), then (-2, 1, -1) to (1, 1, -1) and (-2, 1, 0) to (-1, 1, 0)
+        CHECK(num_visited == 8 + 4 + 2);
+    }
+
+    SECTION("Neighbours")
+    {
+        int num_neighbours = 0;
+        int num_solid = 0;
+        view.ForEachNeighbour(Position(-1, 2, 0), [&](const Position& pos, const Blockstate* b)
+            {
+                num_neighbours += 1;
+                num_solid += b == block;
+            }
+        );
+        CHECK(num_neighbours == 6);
+        CHECK(num_solid == 1);
+    }
+
+    SECTION("Colliders")
+    {
+        CHECK_FALSE(view.IsFree(AABB(Vector3<double>(-0.5, 1.5, 0.5), Vector3<double>(0.4)), false));
+        CHECK(view.IsFree(AABB(Vector3<double>(-0.5, 2.5, 0.5), Vector3<double>(0.4)), false));
+        // Box overlapping both (-1, 1, 0) and (0, 1, 0), across the chunk border
+        CHECK(view.GetColliders(AABB(Vector3<double>(0.0, 1.5, 0.5), Vector3<double>(0.6, 0.4, 0.4))).size() == 2);
+    }
+
+    SECTION("Walkability")
+    {
+        for (const Position& pos : { Position(0, 1, 0), Position(-16, 2, -1), Position(3, 4, 5), Position(-17, 2, -1) })
+        {
+            const Blockstate* b = view.GetBlock(pos);
+            CHECK(view.GetWalkability(pos) == (b == nullptr ? Walkability() : b->GetWalkability()));
+        }
+        CHECK(view.GetWalkability(Position(0, 1, 0)).GetKind() == Walkability::Kind::Solid);
+        CHECK(view.GetWalkability(Position(0, 1, 0)).GetTopHeight() == 1.0f);
+        CHECK(view.GetWalkability(Position(0, 2, 0)).GetKind() == Walkability::Kind::Empty);
+        CHECK(view.GetWalkability(Position(16, 2, 0)) == Walkability());
+    }
+}
+
+TEST_CASE("Find blocks")
+{
+    World world = World(true);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId air_id = { 0,0 };
+    const BlockstateId id = { 1,0 };
+#else
+    const BlockstateId air_id = 0;
+    const BlockstateId id = 1;
+#endif
+    const Blockstate* block = AssetsManager::getInstance().GetBlockstate(id);
+    const auto is_block = [&](const Blockstate* b) { return b == block; };
+
+    world.LoadChunk(0, 0, dimension);
+    world.LoadChunk(-1, 0, dimension);
+    world.LoadChunk(3, 3, dimension);
+    world.SetBlock(Position(2, 10, 3), id);
+    world.SetBlock(Position(-5, 70, 8), id);
+    world.SetBlock(Position(50, 5, 60), id);
+    world.SetBlock(Position(0, 3, 1), id);
+
+    const std::vector<Position> all = world.FindBlocks(is_block, Position(0, 0, 0), 1000);
+    REQUIRE(all.size() == 4);
+    // Sorted by distance to center
+    CHECK(all[0] == Position(0, 3, 1));
+    CHECK(all[1] == Position(2, 10, 3));
+    CHECK(all[2] == Position(-5, 70, 8));
+    CHECK(all[3] == Position(50, 5, 60));
+
+    CHECK(world.FindBlocks(is_block, Position(0, 0, 0), 1000, 2) == std::vector<Position>{ Position(0, 3, 1), Position(2, 10, 3) });
+    CHECK(world.FindBlocks(is_block, Position(0, 0, 0), 11).size() == 2);
+    CHECK(world.FindBlocks(is_block, Position(0, 0, 0), 1).empty());
+    CHECK(world.FindBlocks({ block->GetName() }, Position(0, 0, 0), 1000).size() == 4);
+
+    CHECK(world.FindNearest(is_block, Position(-10, 70, 10), 1000) == Position(-5, 70, 8));
+    CHECK(world.FindNearest(is_block, Position(50, 5, 59), 1000) == Position(50, 5, 60));
+    CHECK_FALSE(world.FindNearest(is_block, Position(50, 200, 59), 10).has_value());
+
+    // Blocks removed, either directly or by unloading their chunk
+    world.SetBlock(Position(0, 3, 1), air_id);
+    world.UnloadChunk(3, 3);
+    CHECK(world.FindBlocks(is_block, Position(0, 0, 0), 1000) == std::vector<Position>{ Position(2, 10, 3), Position(-5, 70, 8) });
+}
+
+const Blockstate* GetBlockLocked(const World& world, const Position& pos)
+{
+    auto chunks = world.GetChunks();
+    const Chunk* chunk = chunks->Get(
+        static_cast<int>(std::floor(pos.x / static_cast<double>(CHUNK_WIDTH))),
+        static_cast<int>(std::floor(pos.z / static_cast<double>(CHUNK_WIDTH)))
+    );
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+    return chunk->GetBlock(Position((pos.x % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH, pos.y, (pos.z % CHUNK_WIDTH + CHUNK_WIDTH) % CHUNK_WIDTH));
+}
+
+TEST_CASE("World read contention", "[.benchmark]")
+{
+    World world = World(true);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId air_id = { 0,0 };
+    const BlockstateId id = { 1,0 };
+#else
+    const BlockstateId air_id = 0;
+    const BlockstateId id = 1;
+#endif
+
+    for (int x = -4; x < 4; ++x)
+    {
+        for (int z = -4; z < 4; ++z)
+        {
+            world.LoadChunk(x, z, dimension);
+            world.SetBlock(Position(x * CHUNK_WIDTH, 64, z * CHUNK_WIDTH), id);
+        }
+    }
+
+    // One writer thread updating blocks, as when a server sends block updates
+    std::atomic<bool> stop = false;
+    std::thread writer([&]()
+        {
+            int i = 0;
+            while (!stop)
+            {
+                world.SetBlock(Position((i * 7) % 128 - 64, 64, (i * 13) % 128 - 64), i % 2 == 0 ? id : air_id);
+                i += 1;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    );
+
+    // Each reader does a small collision check-like burst of reads
+    const auto run_readers = [&](const size_t num_threads, const bool locked)
+    {
+        std::atomic<size_t> num_solid = 0;
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < num_threads; ++t)
+        {
+            readers.emplace_back([&, t]()
+                {
+                    size_t solid = 0;
+                    for (int i = 0; i < 2000; ++i)
+                    {
+                        for (int j = 0; j < 8; ++j)
+                        {
+                            const Position pos((static_cast<int>(t) * 31 + i * 3 + j) % 128 - 64, 63 + j % 3, (i * 5 + j) % 128 - 64);
+                            const Blockstate* block = locked ? GetBlockLocked(world, pos) : world.GetBlock(pos);
+                            solid += block != nullptr && block->IsSolid();
+                        }
+                    }
+                    num_solid += solid;
+                }
+            );
+        }
+        for (std::thread& t : readers)
+        {
+            t.join();
+        }
+        return num_solid.load();
+    };
+
+    for (const size_t num_threads : { 1, 8, 32 })
+    {
+        BENCHMARK("shared_mutex, " + std::to_string(num_threads) + " readers")
+        {
+            return run_readers(num_threads, true);
+        };
+        BENCHMARK("lock-free, " + std::to_string(num_threads) + " readers")
+        {
+            return run_readers(num_threads, false);
+        };
+    }
+
+    stop = true;
+    writer.join();
+}
+
+TEST_CASE("Find blocks search", "[.benchmark]")
+{
+    World world = World(true);
+
+#if PROTOCOL_VERSION < 719 /* < 1.16 */
+    const Dimension dimension = Dimension::Overworld;
+#else
+    const std::string dimension = "minecraft:overworld";
+#endif
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+#endif
+    world.SetCurrentDimension(dimension);
+#if PROTOCOL_VERSION < 347 /* < 1.13 */
+    const BlockstateId id = { 1,0 };
+    const BlockstateId other_id = { 3,0 };
+#else
+    const BlockstateId id = 1;
+    const BlockstateId other_id = 10;
+#endif
+    const Blockstate* block = AssetsManager::getInstance().GetBlockstate(id);
+
+    // 16x16 chunks with non empty sections, and a few blocks to find
+    for (int x = -8; x < 8; ++x)
+    {
+        for (int z = -8; z < 8; ++z)
+        {
+            world.LoadChunk(x, z, dimension);
+            for (int y = 0; y < 64; y += 4)
+            {
+                world.SetBlock(Position(x * CHUNK_WIDTH + 1, y, z * CHUNK_WIDTH + 1), other_id);
+            }
+        }
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        world.SetBlock(Position(i * 13 - 50, 20 + i, i * 7 - 30), id);
+    }
+
+    BENCHMARK("Loop through all blocks")
+    {
+        std::vector<Position> found;
+        auto chunks = world.GetChunks();
+        for (const auto& [coords, chunk] : *chunks)
+        {
+            Position pos;
+            for (pos.y = chunk.GetMinY(); pos.y < chunk.GetMinY() + chunk.GetHeight(); ++pos.y)
+            {
+                for (pos.z = 0; pos.z < CHUNK_WIDTH; ++pos.z)
+                {
+                    for (pos.x = 0; pos.x < CHUNK_WIDTH; ++pos.x)
+                    {
+                        if (chunk.GetBlock(pos) == block)
+                        {
+                            found.push_back(Position(coords.first * CHUNK_WIDTH + pos.x, pos.y, coords.second * CHUNK_WIDTH + pos.z));
+                        }
+                    }
+                }
+            }
+        }
+        return found;
+    };
+
+    BENCHMARK("FindBlocks")
+    {
+        return world.FindBlocks([&](const Blockstate* b) { return b == block; }, Position(0, 0, 0), std::numeric_limits<int>::max());
+    };
+
+    BENCHMARK("FindNearest")
+    {
+        return world.FindNearest([&](const Blockstate* b) { return b == block; }, Position(0, 0, 0), std::numeric_limits<int>::max());
+    };
+}
+
 TEST_CASE("Set/Get lights")
 {
     World world = World(false);
@@ -226,3 +829,293 @@ TEST_CASE("Set/Get lights")
     CHECK(world.GetSkyLight(Position(0, 0, 0)) == 12);
     CHECK(world.GetSkyLight(Position(1, 0, 0)) == 6);
 }
+
+TEST_CASE("Load section light")
+{
+#if PROTOCOL_VERSION < 757 /* < 1.18 */
+    Chunk chunk(0, true);
+#else
+    Chunk chunk(0, 256, 0, true);
+#endif
+
+    // Two 4 bits values per byte, first one in the low bits
+    std::vector<char> data(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<char>((i % 16) | (((i + 3) % 16) << 4));
+    }
+    chunk.LoadSectionLight(1, data, true);
+    chunk.LoadSectionLight(1, std::vector<char>(data.size(), static_cast<char>(0x77)), false);
+
+    int wrong_sky_values = 0;
+    int wrong_block_values = 0;
+    for (int y = 0; y < SECTION_HEIGHT; ++y)
+    {
+        for (int z = 0; z < CHUNK_WIDTH; ++z)
+        {
+            for (int x = 0; x < CHUNK_WIDTH; ++x)
+            {
+                const int index = (y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x;
+                const int expected = index % 2 == 0 ? (index / 2) % 16 : (index / 2 + 3) % 16;
+                wrong_sky_values += chunk.GetSkyLight(Position(x, SECTION_HEIGHT + y, z)) != expected;
+                wrong_block_values += chunk.GetBlockLight(Position(x, SECTION_HEIGHT + y, z)) != 7;
+            }
+        }
+    }
+    CHECK(wrong_sky_values == 0);
+    CHECK(wrong_block_values == 0);
+    // Other sections are untouched
+    CHECK(chunk.GetSkyLight(Position(0, 0, 0)) == 0);
+
+    // Empty data sets everything to 0
+    chunk.LoadSectionLight(1, {}, true);
+    CHECK(chunk.GetSkyLight(Position(1, SECTION_HEIGHT, 0)) == 0);
+    CHECK(chunk.GetSkyLight(Position(CHUNK_WIDTH - 1, 2 * SECTION_HEIGHT - 1, CHUNK_WIDTH - 1)) == 0);
+}
+
+#if PROTOCOL_VERSION > 756 /* > 1.17.1 */
+ProtocolCraft::ClientboundLevelChunkWithLightPacket MakeSingleValueChunkPacket(const int x, const int z, const unsigned char block_id = 1)
+{
+    // 16 sections filled with a single blockstate, each with a single biome
+    std::vector<unsigned char> buffer;
+    for (int i = 0; i < 256 / SECTION_HEIGHT; ++i)
+    {
+        // Block count (short)
+        buffer.push_back(0x10);
+        buffer.push_back(0x00);
+        // Bits per entry, single value, data array length
+        buffer.push_back(0x00);
+        buffer.push_back(block_id);
+        buffer.push_back(0x00);
+        // Biomes: bits per entry, single value, data array length
+        buffer.push_back(0x00);
+        buffer.push_back(0x00);
+        buffer.push_back(0x00);
+    }
+
+    ProtocolCraft::ClientboundLevelChunkPacketData chunk_data;
+    chunk_data.SetBuffer(buffer);
+    ProtocolCraft::ClientboundLevelChunkWithLightPacket msg;
+    msg.SetX(x);
+    msg.SetZ(z);
+    msg.SetChunkData(chunk_data);
+
+    return msg;
+}
+
+TEST_CASE("Load chunk packet")
+{
+    World world = World(false);
+    const std::string dimension = "minecraft:overworld";
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+    world.SetCurrentDimension(dimension);
+
+    ProtocolCraft::ClientboundLevelChunkWithLightPacket msg = MakeSingleValueChunkPacket(1, -1);
+
+    static_cast<ProtocolCraft::Handler&>(world).Handle(msg);
+
+    REQUIRE(world.GetChunks()->size() == 1);
+    REQUIRE(world.GetBlock(Position(CHUNK_WIDTH, 0, -1)) != nullptr);
+    CHECK(world.GetBlock(Position(CHUNK_WIDTH, 0, -1))->GetId() == 1);
+    CHECK(world.GetBlock(Position(2 * CHUNK_WIDTH - 1, 255, -CHUNK_WIDTH))->GetId() == 1);
+    CHECK(world.GetBlock(Position(0, 0, 0)) == nullptr);
+
+    const ChunkLoadStats stats = world.GetChunkLoadStats();
+    CHECK(stats.num_chunks == 1);
+    CHECK(stats.lock_hold_max_ns <= stats.lock_hold_total_ns);
+
+    world.ResetChunkLoadStats();
+    CHECK(world.GetChunkLoadStats().num_chunks == 0);
+}
+
+TEST_CASE("Prepare chunk packet")
+{
+    World world = World(false);
+    const std::string dimension = "minecraft:overworld";
+    world.SetDimensionMinY(dimension, 0);
+    world.SetDimensionHeight(dimension, 256);
+    world.SetCurrentDimension(dimension);
+
+    ProtocolCraft::ClientboundLevelChunkWithLightPacket msg = MakeSingleValueChunkPacket(0, 0);
+
+    const PreparedPacketId id = NewPreparedPacketId();
+
+    SECTION("Handle")
+    {
+        std::thread t([&]() { world.Prepare(msg, id); });
+        t.join();
+        // Preparing the chunk doesn't change the terrain
+        CHECK(world.GetChunks()->size() == 0);
+
+        const ScopedPreparedPacketId scoped_id(id);
+        static_cast<ProtocolCraft::Handler&>(world).Handle(msg);
+        REQUIRE(world.GetChunks()->size() == 1);
+        REQUIRE(world.GetBlock(Position(0, 0, 0)) != nullptr);
+        CHECK(world.GetBlock(Position(0, 0, 0))->GetId() == 1);
+        CHECK(world.GetChunkLoadStats().num_chunks == 1);
+    }
+
+    SECTION("Discard")
+    {
+        world.Prepare(msg, id);
+        world.DiscardPrepared(id);
+        CHECK(world.GetChunks()->size() == 0);
+        CHECK(world.GetChunkLoadStats().num_chunks == 0);
+    }
+
+    SECTION("Reused message")
+    {
+        world.Prepare(msg, id);
+        // Same message object used for another packet that was not prepared
+        msg = MakeSingleValueChunkPacket(0, 0, 2);
+        {
+            const ScopedPreparedPacketId scoped_id(NewPreparedPacketId());
+            static_cast<ProtocolCraft::Handler&>(world).Handle(msg);
+        }
+        REQUIRE(world.GetBlock(Position(0, 0, 0)) != nullptr);
+        CHECK(world.GetBlock(Position(0, 0, 0))->GetId() == 2);
+        world.DiscardPrepared(id);
+    }
+}
+
+void WritePackedSectionData(std::vector<unsigned char>& buffer, const unsigned char bits_per_entry, const std::vector<int>& palette, const std::vector<unsigned short>& values)
+{
+    ProtocolCraft::WriteData<unsigned char>(bits_per_entry, buffer);
+    if (!palette.empty())
+    {
+        ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(palette.size()), buffer);
+        for (const int p : palette)
+        {
+            ProtocolCraft::WriteData<ProtocolCraft::VarInt>(p, buffer);
+        }
+    }
+    // Entries don't span across multiple longs
+    const size_t entries_per_long = 64 / bits_per_entry;
+    std::vector<unsigned long long int> data_array((values.size() + entries_per_long - 1) / entries_per_long, 0);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        data_array[i / entries_per_long] |= static_cast<unsigned long long int>(values[i]) << ((i % entries_per_long) * bits_per_entry);
+    }
+    ProtocolCraft::WriteData<ProtocolCraft::VarInt>(static_cast<int>(data_array.size()), buffer);
+    for (const unsigned long long int l : data_array)
+    {
+        ProtocolCraft::WriteData<unsigned long long int>(l, buffer);
+    }
+}
+
+/// @brief Create chunk data with the given number of sections, cycling through
+/// section palette, global palette and single value sections for blocks and biomes
+std::vector<unsigned char> MakePackedChunkData(const int num_sections)
+{
+    const std::vector<int> block_palette = { 0, 1, 2, 3, 9, 14, 33, 48, 81 };
+    const std::vector<int> biome_palette = { 1, 4, 7 };
+    std::vector<unsigned char> buffer;
+    for (int s = 0; s < num_sections; ++s)
+    {
+        ProtocolCraft::WriteData<short>(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT, buffer);
+        std::vector<unsigned short> blocks(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT);
+        std::vector<unsigned short> biomes(64);
+        switch (s % 3)
+        {
+        case 0:
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                blocks[i] = static_cast<unsigned short>((i + s) % block_palette.size());
+            }
+            WritePackedSectionData(buffer, 4, block_palette, blocks);
+            for (size_t i = 0; i < biomes.size(); ++i)
+            {
+                biomes[i] = static_cast<unsigned short>(i % biome_palette.size());
+            }
+            WritePackedSectionData(buffer, 2, biome_palette, biomes);
+            break;
+        case 1:
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                blocks[i] = static_cast<unsigned short>(i % 1000 + 1);
+            }
+            WritePackedSectionData(buffer, 15, {}, blocks);
+            for (size_t i = 0; i < biomes.size(); ++i)
+            {
+                biomes[i] = static_cast<unsigned short>(i % 40);
+            }
+            WritePackedSectionData(buffer, 6, {}, biomes);
+            break;
+        default:
+            // Single value blocks and biomes
+            buffer.push_back(0x00);
+            buffer.push_back(0x01);
+            buffer.push_back(0x00);
+            buffer.push_back(0x00);
+            buffer.push_back(0x02);
+            buffer.push_back(0x00);
+            break;
+        }
+    }
+    return buffer;
+}
+
+TEST_CASE("Load packed chunk data")
+{
+    const std::vector<unsigned char> buffer = MakePackedChunkData(3);
+
+    Chunk chunk(0, 3 * SECTION_HEIGHT, 0, true);
+    chunk.LoadChunkData(buffer);
+
+    const std::vector<int> block_palette = { 0, 1, 2, 3, 9, 14, 33, 48, 81 };
+    const std::vector<int> biome_palette = { 1, 4, 7 };
+    int wrong_blocks = 0;
+    for (int y = 0; y < SECTION_HEIGHT; ++y)
+    {
+        for (int z = 0; z < CHUNK_WIDTH; ++z)
+        {
+            for (int x = 0; x < CHUNK_WIDTH; ++x)
+            {
+                const int index = (y * CHUNK_WIDTH + z) * CHUNK_WIDTH + x;
+                const Blockstate* paletted = chunk.GetBlock(Position(x, y, z));
+                const Blockstate* global = chunk.GetBlock(Position(x, SECTION_HEIGHT + y, z));
+                const Blockstate* single = chunk.GetBlock(Position(x, 2 * SECTION_HEIGHT + y, z));
+                wrong_blocks += paletted == nullptr || paletted->GetId() != block_palette[index % block_palette.size()];
+                wrong_blocks += global == nullptr || global->GetId() != index % 1000 + 1;
+                wrong_blocks += single == nullptr || single->GetId() != 1;
+            }
+        }
+    }
+    CHECK(wrong_blocks == 0);
+
+    const AssetsManager& assets_manager = AssetsManager::getInstance();
+    int wrong_biomes = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        wrong_biomes += chunk.GetBiome(i) != assets_manager.GetBiome(biome_palette[i % biome_palette.size()]);
+        wrong_biomes += chunk.GetBiome(64 + i) != assets_manager.GetBiome(i % 40);
+        wrong_biomes += chunk.GetBiome(128 + i) != assets_manager.GetBiome(2);
+    }
+    CHECK(wrong_biomes == 0);
+}
+
+TEST_CASE("Chunk data decoding", "[.benchmark]")
+{
+    // 24 sections, as in a 1.18+ overworld chunk
+    const std::vector<unsigned char> buffer = MakePackedChunkData(24);
+    const std::vector<char> light_data(CHUNK_WIDTH * CHUNK_WIDTH * SECTION_HEIGHT / 2, static_cast<char>(0x5A));
+
+    BENCHMARK("LoadChunkData")
+    {
+        Chunk chunk(-64, 24 * SECTION_HEIGHT, 0, true);
+        chunk.LoadChunkData(buffer);
+        return chunk.HasSection(0);
+    };
+
+    Chunk chunk(-64, 24 * SECTION_HEIGHT, 0, true);
+    BENCHMARK("LoadSectionLight")
+    {
+        for (int i = 0; i < 24; ++i)
+        {
+            chunk.LoadSectionLight(i, light_data, true);
+        }
+        return chunk.HasSection(0);
+    };
+}
+#endif
@@ -0,0 +1,189 @@
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "protocolCraft/AllClientboundMessages.hpp"
+#include "protocolCraft/Handler.hpp"
+#include "protocolCraft/MessageFactory.hpp"
+#include "protocolCraft/Utilities/PrivateTemplates.hpp"
+
+using namespace ProtocolCraft;
+
+TEST_CASE("Message factory")
+{
+    MessagePool pool;
+
+    loop<std::tuple_size_v<AllClientboundPlayMessages> >([&](auto i)
+        {
+            using MessageType = std::tuple_element_t<i, AllClientboundPlayMessages>;
+
+            const std::shared_ptr<Message> msg = CreateClientboundMessage(ConnectionState::Play, MessageType::packet_id);
+            REQUIRE(msg != nullptr);
+            CHECK(msg->GetId() == MessageType::packet_id);
+            CHECK(msg->GetName() == MessageType::packet_name);
+
+            Message* pooled_msg = pool.GetClientboundMessage(ConnectionState::Play, MessageType::packet_id);
+            REQUIRE(pooled_msg != nullptr);
+            CHECK(pooled_msg->GetName() == MessageType::packet_name);
+        }
+    );
+
+    CHECK(CreateClientboundMessage(ConnectionState::Play, -1) == nullptr);
+    CHECK(CreateClientboundMessage(ConnectionState::Play, 0x7FFF) == nullptr);
+    CHECK(CreateClientboundMessage(ConnectionState::None, 0) == nullptr);
+    CHECK(pool.GetClientboundMessage(ConnectionState::Play, 0x7FFF) == nullptr);
+    CHECK(pool.GetClientboundMessage(ConnectionState::None, 0) == nullptr);
+}
+
+TEST_CASE("Message pool reuse")
+{
+    MessagePool pool;
+
+    Message* msg = pool.GetClientboundMessage(ConnectionState::Play, ClientboundKeepAlivePacket::packet_id);
+    REQUIRE(msg != nullptr);
+    static_cast<ClientboundKeepAlivePacket*>(msg)->SetId_(42);
+
+    Message* reused_msg = pool.GetClientboundMessage(ConnectionState::Play, ClientboundKeepAlivePacket::packet_id);
+    REQUIRE(reused_msg == msg);
+    CHECK(static_cast<ClientboundKeepAlivePacket*>(reused_msg)->GetId_() == 0);
+}
+
+namespace
+{
+    class CountingHandler : public Handler
+    {
+    public:
+        size_t num_handled = 0;
+
+    protected:
+        using Handler::Handle;
+        virtual void Handle(Message& msg) override
+        {
+            num_handled += 1;
+        }
+    };
+
+    /// @brief Previous factory implementation, linear search in all the message types
+    std::shared_ptr<Message> CreateMessageLinear(const int id)
+    {
+        std::shared_ptr<Message> output = nullptr;
+        loop<std::tuple_size_v<AllClientboundPlayMessages> >([&](auto i)
+            {
+                using MessageType = std::tuple_element_t<i, AllClientboundPlayMessages>;
+                if (id == MessageType::packet_id)
+                {
+                    output = std::make_shared<MessageType>();
+                }
+            }
+        );
+        return output;
+    }
+
+    /// @brief A play session made of the most frequent packets when a bot
+    /// is idle in a populated area, mostly entity movements
+    std::vector<std::vector<unsigned char> > GetPlaySession()
+    {
+        std::vector<std::vector<unsigned char> > packets;
+        packets.reserve(10000);
+        for (int i = 0; i < 10000; ++i)
+        {
+            std::vector<unsigned char> packet;
+            switch (i % 10)
+            {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            {
+                ClientboundMoveEntityPacketPos msg;
+                msg.SetEntityId(i % 97);
+                msg.SetXA(static_cast<short>(i % 300));
+                msg.Write(packet);
+                break;
+            }
+            case 4:
+            case 5:
+            {
+                ClientboundMoveEntityPacketPosRot msg;
+                msg.SetEntityId(i % 97);
+                msg.Write(packet);
+                break;
+            }
+            case 6:
+            case 7:
+            {
+                ClientboundSetEntityMotionPacket msg;
+                msg.SetId_(i % 97);
+                msg.Write(packet);
+                break;
+            }
+            case 8:
+            {
+                ClientboundBlockUpdatePacket msg;
+                msg.Write(packet);
+                break;
+            }
+            case 9:
+            {
+                ClientboundSetTimePacket msg;
+                msg.SetGameTime(i);
+                msg.Write(packet);
+                break;
+            }
+            }
+            packets.push_back(std::move(packet));
+        }
+        return packets;
+    }
+}
+
+TEST_CASE("Message parsing and dispatch", "[.benchmark]")
+{
+    const std::vector<std::vector<unsigned char> > packets = GetPlaySession();
+    CountingHandler handler;
+
+    BENCHMARK("linear search + shared_ptr")
+    {
+        for (const std::vector<unsigned char>& packet : packets)
+        {
+            ReadIterator iter = packet.begin();
+            size_t length = packet.size();
+            const int id = ReadData<VarInt>(iter, length);
+            std::shared_ptr<Message> msg = CreateMessageLinear(id);
+            msg->Read(iter, length);
+            msg->Dispatch(&handler);
+        }
+        return handler.num_handled;
+    };
+
+    BENCHMARK("jump table + shared_ptr")
+    {
+        for (const std::vector<unsigned char>& packet : packets)
+        {
+            ReadIterator iter = packet.begin();
+            size_t length = packet.size();
+            const int id = ReadData<VarInt>(iter, length);
+            std::shared_ptr<Message> msg = CreateClientboundMessage(ConnectionState::Play, id);
+            msg->Read(iter, length);
+            msg->Dispatch(&handler);
+        }
+        return handler.num_handled;
+    };
+
+    MessagePool pool;
+    BENCHMARK("jump table + message pool")
+    {
+        for (const std::vector<unsigned char>& packet : packets)
+        {
+            ReadIterator iter = packet.begin();
+            size_t length = packet.size();
+            const int id = ReadData<VarInt>(iter, length);
+            Message* msg = pool.GetClientboundMessage(ConnectionState::Play, id);
+            msg->Read(iter, length);
+            msg->Dispatch(&handler);
+        }
+        return handler.num_handled;
+    };
+}